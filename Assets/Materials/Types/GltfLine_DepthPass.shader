@@ -0,0 +1,26 @@
+{
+    "Source" : "./GltfLine_DepthPass.azsl",
+
+    "DepthStencilState" : { 
+        "Depth" : { "Enable" : true, "CompareFunc" : "GreaterEqual" }
+    },
+
+    "RasterState" : { "CullMode" : "None" },
+
+    "CompilerHints" : { 
+        "DisableOptimizations" : false
+    },
+
+    "ProgramSettings":
+    {
+      "EntryPoints":
+      [
+        {
+          "name": "MainVS",
+          "type": "Vertex"
+        }
+      ]
+    },
+
+    "DrawList" : "depth"
+}
@@ -0,0 +1,38 @@
+{
+    "Source" : "./GltfLine_ForwardPass.azsl",
+
+    "DepthStencilState" :
+    {
+        "Depth" :
+        {
+            "Enable" : true,
+            "CompareFunc" : "GreaterEqual"
+        }
+    },
+
+    "RasterState" :
+    {
+        "CullMode" : "None"
+    },
+
+    "CompilerHints" : { 
+        "DisableOptimizations" : false
+    },
+
+    "ProgramSettings":
+    {
+      "EntryPoints":
+      [
+        {
+          "name": "Line_ForwardPassVS",
+          "type": "Vertex"
+        },
+        {
+          "name": "Line_ForwardPassPS",
+          "type": "Fragment"
+        }
+      ]
+    },
+
+    "DrawList" : "forward"
+}
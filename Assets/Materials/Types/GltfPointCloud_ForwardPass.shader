@@ -0,0 +1,38 @@
+{
+    "Source" : "./GltfPointCloud_ForwardPass.azsl",
+
+    "DepthStencilState" :
+    {
+        "Depth" :
+        {
+            "Enable" : true,
+            "CompareFunc" : "GreaterEqual"
+        }
+    },
+
+    "RasterState" :
+    {
+        "CullMode" : "None"
+    },
+
+    "CompilerHints" : { 
+        "DisableOptimizations" : false
+    },
+
+    "ProgramSettings":
+    {
+      "EntryPoints":
+      [
+        {
+          "name": "PointCloud_ForwardPassVS",
+          "type": "Vertex"
+        },
+        {
+          "name": "PointCloud_ForwardPassPS",
+          "type": "Fragment"
+        }
+      ]
+    },
+
+    "DrawList" : "forward"
+}
@@ -5,9 +5,13 @@
 #include <AzCore/Component/TransformBus.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
 #include <AzCore/std/string/string.h>
+#include <cstdint>
+#include <memory>
 
 namespace Cesium
 {
+    struct GltfLoadModel;
+
     class GltfModelComponent
         : public AZ::Component
         , public GltfModelRequestBus::Handler
@@ -22,6 +26,10 @@ namespace Cesium
 
         void LoadModel(const AZStd::string& filePath) override;
 
+        void SetGeneratedLodCount(std::uint32_t lodCount) override;
+
+        std::uint32_t GetGeneratedLodCount() const override;
+
     private:
         void Init() override;
 
@@ -35,6 +43,8 @@ namespace Cesium
 
         void SetNonUniformScale(const AZ::Vector3& scale);
 
+        void OnModelLoaded(const AZStd::string& filePath, const std::shared_ptr<const GltfLoadModel>& loadModel);
+
         struct Impl;
         AZStd::unique_ptr<Impl> m_impl;
     };
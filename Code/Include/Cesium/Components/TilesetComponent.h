@@ -57,6 +57,18 @@ namespace Cesium
 
         void BindTilesetLoadedHandler(TilesetLoadedEvent::Handler& handler) override;
 
+        TilesetRaycastResult RaycastInECEF(const glm::dvec3& origin, const glm::dvec3& direction, double maxDistance) override;
+
+        AZStd::vector<TilesetHeightSample> SampleHeightsInCartographic(const AZStd::vector<Cartographic>& positions) override;
+
+        std::uint64_t RequestHeightsInCartographic(const AZStd::vector<Cartographic>& positions) override;
+
+        void BindHeightsSampledHandler(TilesetHeightsSampledEvent::Handler& handler) override;
+
+        void SetCollisionFocusEntities(const AZStd::vector<AZ::EntityId>& entities) override;
+
+        const AZStd::vector<AZ::EntityId>& GetCollisionFocusEntities() const override;
+
         void Init() override;
 
         void Activate() override;
@@ -2,14 +2,36 @@
 
 #include <AzCore/Component/ComponentBus.h>
 #include <AzCore/std/string/string.h>
+#include <cstdint>
 
 namespace Cesium
 {
     class GltfModelRequest : public AZ::ComponentBus
     {
     public:
+        // Load the model in the background. GltfModelNotificationBus is notified once it is displayed or if it fails to load.
+        // The previous model stays displayed until then
         virtual void LoadModel(const AZStd::string& filePath) = 0;
+
+        // Number of simplified LODs generated for each mesh in addition to the full detail one. The model is reloaded if it is changed
+        virtual void SetGeneratedLodCount(std::uint32_t lodCount) = 0;
+
+        virtual std::uint32_t GetGeneratedLodCount() const = 0;
     };
 
     using GltfModelRequestBus = AZ::EBus<GltfModelRequest>;
+
+    class GltfModelNotification : public AZ::ComponentBus
+    {
+    public:
+        virtual void OnModelLoaded([[maybe_unused]] const AZStd::string& filePath)
+        {
+        }
+
+        virtual void OnModelLoadFailed([[maybe_unused]] const AZStd::string& filePath)
+        {
+        }
+    };
+
+    using GltfModelNotificationBus = AZ::EBus<GltfModelNotification>;
 } // namespace Cesium
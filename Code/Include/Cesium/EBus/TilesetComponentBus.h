@@ -1,10 +1,12 @@
 #pragma once
 
 #include <Cesium/Math/TilesetBoundingVolume.h>
+#include <Cesium/Math/Cartographic.h>
 #include <AzCore/RTTI/ReflectContext.h>
 #include <AzCore/Component/ComponentBus.h>
 #include <AzCore/EBus/Event.h>
 #include <AzCore/std/string/string.h>
+#include <AzCore/std/containers/vector.h>
 #include <AzCore/std/utils.h>
 #include <AzCore/Memory/SystemAllocator.h>
 #include <cstdint>
@@ -38,6 +40,13 @@ namespace Cesium
         bool m_forbidHole;
     };
 
+    enum class TilesetTextureCompression
+    {
+        None,
+        Fast,
+        HighQuality
+    };
+
     struct TilesetRenderConfiguration final
     {
         AZ_RTTI(TilesetRenderConfiguration, "{141F2DE1-CEEB-4ACD-BCCA-2F7F6CEF60B6}");
@@ -47,10 +56,48 @@ namespace Cesium
 
         TilesetRenderConfiguration()
             : m_generateMissingNormalAsSmooth{ true }
+            , m_mergeMeshPrimitives{ false }
+            , m_optimizeMeshVertexOrder{ false }
+            , m_meshClusterTriangleCount{ 0 }
+            , m_textureCompression{ TilesetTextureCompression::None }
+            , m_pointCloudAttenuation{ true }
+            , m_pointCloudPointSize{ 0.1f }
+            , m_pointCloudSpacingScale{ 1.0f }
+            , m_pointCloudMaximumPointSize{ 5.0f }
+            , m_lineWidth{ 1.0f }
+            , m_enableRaycast{ false }
+            , m_enableCollision{ false }
+            , m_collisionSimplificationError{ 0.005f }
+            , m_collisionFocusRadius{ 500.0f }
         {
         }
 
         bool m_generateMissingNormalAsSmooth;
+        bool m_mergeMeshPrimitives;
+        bool m_optimizeMeshVertexOrder;
+
+        // Split the primitives of tiles that have more triangles than this into clusters that are culled on their own. Zero disables
+        // the split
+        std::uint32_t m_meshClusterTriangleCount;
+
+        // Block compress the textures of tiles and raster overlays on the load threads, trading encoding time for GPU memory
+        TilesetTextureCompression m_textureCompression;
+
+        bool m_pointCloudAttenuation;
+        float m_pointCloudPointSize;
+        float m_pointCloudSpacingScale;
+        float m_pointCloudMaximumPointSize;
+        float m_lineWidth;
+
+        // Build a bounding volume hierarchy for the triangles of each tile, so that RaycastInECEF can hit them. Off by default, since
+        // the hierarchy holds a copy of the positions of every loaded tile
+        bool m_enableRaycast;
+
+        // Cook a simplified collision mesh for the triangles of each tile on the load thread. Colliders are only added for the
+        // rendered tiles within the focus radius of the collision focus entities
+        bool m_enableCollision;
+        float m_collisionSimplificationError;
+        float m_collisionFocusRadius;
     };
 
     struct TilesetLocalFileSource final
@@ -137,8 +184,51 @@ namespace Cesium
         TilesetCesiumIonSource m_cesiumIon;
     };
 
+    struct TilesetRaycastResult final
+    {
+        AZ_RTTI(TilesetRaycastResult, "{56616052-37BF-4A08-8C6D-0E0273F6A049}");
+        AZ_CLASS_ALLOCATOR(TilesetRaycastResult, AZ::SystemAllocator, 0);
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        TilesetRaycastResult()
+            : m_hit{ false }
+            , m_position{ 0.0 }
+            , m_normal{ 0.0, 0.0, 1.0 }
+            , m_distance{ 0.0 }
+        {
+        }
+
+        bool m_hit;
+        glm::dvec3 m_position;
+        glm::dvec3 m_normal;
+        double m_distance;
+    };
+
+    struct TilesetHeightSample final
+    {
+        AZ_RTTI(TilesetHeightSample, "{4B1F7E0A-93C6-4E5D-A2B8-6F1D0C3E7A54}");
+        AZ_CLASS_ALLOCATOR(TilesetHeightSample, AZ::SystemAllocator, 0);
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        TilesetHeightSample()
+            : m_hit{ false }
+            , m_height{ 0.0 }
+        {
+        }
+
+        bool m_hit;
+
+        // height above the WGS84 ellipsoid in meters
+        double m_height;
+    };
+
     using TilesetLoadedEvent = AZ::Event<>;
 
+    // request id returned by RequestHeightsInCartographic and the samples in the order of the requested positions
+    using TilesetHeightsSampledEvent = AZ::Event<std::uint64_t, const AZStd::vector<TilesetHeightSample>&>;
+
     class TilesetRequest : public AZ::ComponentBus
     {
     public:
@@ -165,6 +255,26 @@ namespace Cesium
         virtual void ApplyTransformToRoot(const glm::dmat4& transform) = 0;
 
         virtual void BindTilesetLoadedHandler(TilesetLoadedEvent::Handler& handler) = 0;
+
+        // Find the closest triangle of the tiles rendered in the current frame that is hit by a ray in ECEF. The distance is in units
+        // of the direction. Tiles are only hit if the render configuration enables ray casts
+        virtual TilesetRaycastResult RaycastInECEF(const glm::dvec3& origin, const glm::dvec3& direction, double maxDistance) = 0;
+
+        // Sample the surface height at each position from the most detailed tile loaded there, whether it is rendered or not.
+        // The height of the positions is ignored. Positions without a loaded tile are not hit
+        virtual AZStd::vector<TilesetHeightSample> SampleHeightsInCartographic(const AZStd::vector<Cartographic>& positions) = 0;
+
+        // Same as SampleHeightsInCartographic, but the tiles missing at the positions are loaded first. The samples are sent to the
+        // heights sampled event once the tiles are loaded, which may take several frames
+        virtual std::uint64_t RequestHeightsInCartographic(const AZStd::vector<Cartographic>& positions) = 0;
+
+        virtual void BindHeightsSampledHandler(TilesetHeightsSampledEvent::Handler& handler) = 0;
+
+        // Tiles get colliders around these entities, which also make the tileset load tiles around them. The camera is the focus
+        // when there is no entity
+        virtual void SetCollisionFocusEntities(const AZStd::vector<AZ::EntityId>& entities) = 0;
+
+        virtual const AZStd::vector<AZ::EntityId>& GetCollisionFocusEntities() const = 0;
     };
 
     using TilesetRequestBus = AZ::EBus<TilesetRequest>;
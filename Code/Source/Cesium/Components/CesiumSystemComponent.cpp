@@ -32,6 +32,8 @@ namespace Cesium
         TilesetConfiguration::Reflect(context);
         TilesetRenderConfiguration::Reflect(context);
         TilesetSource::Reflect(context);
+        TilesetRaycastResult::Reflect(context);
+        TilesetHeightSample::Reflect(context);
         TilesetRequest::Reflect(context);
 
         GeoreferenceCameraFlyConfiguration::Reflect(context);
@@ -42,9 +44,13 @@ namespace Cesium
 
         OriginShiftAnchorRequest::Reflect(context);
 
+        GltfBakedModelAsset::Reflect(context);
+
         if (AZ::SerializeContext* serialize = azrtti_cast<AZ::SerializeContext*>(context))
         {
-            serialize->Class<CesiumSystemComponent, AZ::Component>()->Version(0);
+            // the glTF asset builder converts models with the Cesium system, so it is also activated in the asset builder
+            serialize->Class<CesiumSystemComponent, AZ::Component>()->Version(0)->Attribute(
+                AZ::Edit::Attributes::SystemComponentTags, AZStd::vector<AZ::Crc32>({ AZ_CRC_CE("AssetBuilder") }));
 
             if (AZ::EditContext* ec = serialize->GetEditContext())
             {
@@ -98,6 +104,10 @@ namespace Cesium
     {
         CesiumSystemRequestBus::Handler::BusConnect();
         AZ::TickBus::Handler::BusConnect();
+
+        m_bakedModelAssetHandler = AZStd::make_unique<AzFramework::GenericAssetHandler<GltfBakedModelAsset>>(
+            GltfBakedModelAsset::DISPLAY_NAME, GltfBakedModelAsset::GROUP, GltfBakedModelAsset::EXTENSION);
+        m_bakedModelAssetHandler->Register();
     }
 
     void CesiumSystemComponent::Deactivate()
@@ -105,6 +115,12 @@ namespace Cesium
         CesiumSystemRequestBus::Handler::BusDisconnect();
         AZ::TickBus::Handler::BusDisconnect();
 
+        if (m_bakedModelAssetHandler)
+        {
+            m_bakedModelAssetHandler->Unregister();
+            m_bakedModelAssetHandler.reset();
+        }
+
         if (CesiumInterface::Get() == m_cesiumSystem.get())
         {
             CesiumInterface::Unregister(m_cesiumSystem.get());
@@ -113,6 +129,7 @@ namespace Cesium
 
     void CesiumSystemComponent::OnTick([[maybe_unused]] float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
     {
+        m_cesiumSystem->GetGltfModelCache().DispatchMainThreadTasks();
     }
 
 } // namespace Cesium
@@ -2,6 +2,8 @@
 
 #include "Cesium/EBus/CesiumSystemComponentBus.h"
 #include "Cesium/Systems/CesiumSystem.h"
+#include "Cesium/Gltf/GltfBakedModelAsset.h"
+#include <AzFramework/Asset/GenericAssetHandler.h>
 #include <AzCore/Jobs/JobManager.h>
 #include <AzCore/Jobs/JobContext.h>
 #include <AzCore/Component/Component.h>
@@ -43,6 +45,7 @@ namespace Cesium
 
     private:
         AZStd::unique_ptr<CesiumSystem> m_cesiumSystem;
+        AZStd::unique_ptr<AzFramework::GenericAssetHandler<GltfBakedModelAsset>> m_bakedModelAssetHandler;
     };
 
 } // namespace Cesium
@@ -1,6 +1,5 @@
 #include <Cesium/Components/GltfModelComponent.h>
-#include "Cesium/Gltf/GltfModelBuilder.h"
-#include "Cesium/Gltf/GltfPBRMaterialBuilder.h"
+#include "Cesium/Gltf/GltfModelCache.h"
 #include "Cesium/Gltf/GltfLoadContext.h"
 #include "Cesium/Gltf/GltfModel.h"
 #include "Cesium/Systems/CesiumSystem.h"
@@ -9,14 +8,21 @@
 #include <Atom/RPI.Public/Scene.h>
 #include <AzCore/Component/NonUniformScaleBus.h>
 #include <AzCore/Serialization/SerializeContext.h>
+#include <memory>
 
 namespace Cesium
 {
     struct GltfModelComponent::Impl
     {
         AZStd::string m_filePath;
+        std::uint32_t m_generatedLodCount{ 0 };
+        std::shared_ptr<const GltfLoadModel> m_loadModel;
         AZStd::unique_ptr<GltfModel> m_gltfModel;
         AZ::NonUniformScaleChangedEvent::Handler m_nonUniformScaleChangedHandler;
+
+        // Only the result of the latest load is displayed. Load continuations hold a weak reference to it,
+        // so they can tell whether the component still exists
+        std::shared_ptr<std::uint64_t> m_latestLoadId{ std::make_shared<std::uint64_t>(0) };
     };
 
     void GltfModelComponent::Reflect(AZ::ReflectContext* context)
@@ -40,14 +46,36 @@ namespace Cesium
 
         m_impl->m_filePath = filePath;
 
-        // Load model
-        GltfModelBuilder builder(AZStd::make_unique<GltfPBRMaterialBuilder>());
-        GltfModelBuilderOption option{ glm::dmat4(1.0) };
-        GltfLoadModel loadModel;
-        builder.Create(CesiumInterface::Get()->GetIOManager(IOKind::LocalFile), filePath, option, loadModel);
+        // Entities displaying the same file share the model. It is read, decoded and built on worker threads the first time
+        std::uint64_t loadId = ++*m_impl->m_latestLoadId;
+        std::weak_ptr<std::uint64_t> latestLoadId = m_impl->m_latestLoadId;
+        CesiumInterface::Get()
+            ->GetGltfModelCache()
+            .Load(CesiumInterface::Get()->GetIOManager(IOKind::LocalFile), filePath, m_impl->m_generatedLodCount)
+            .thenInMainThread(
+                [this, latestLoadId, loadId, filePath](const std::shared_ptr<const GltfLoadModel>& loadModel)
+                {
+                    std::shared_ptr<std::uint64_t> currentLoadId = latestLoadId.lock();
+                    if (currentLoadId && *currentLoadId == loadId)
+                    {
+                        OnModelLoaded(filePath, loadModel);
+                    }
+                });
+    }
+
+    void GltfModelComponent::OnModelLoaded(const AZStd::string& filePath, const std::shared_ptr<const GltfLoadModel>& loadModel)
+    {
+        if (!loadModel)
+        {
+            GltfModelNotificationBus::Event(GetEntityId(), &GltfModelNotificationBus::Events::OnModelLoadFailed, filePath);
+            return;
+        }
+
+        // only the mesh acquisition needs the main thread
         AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor =
             AZ::RPI::Scene::GetFeatureProcessorForEntity<AZ::Render::MeshFeatureProcessorInterface>(GetEntityId());
-        m_impl->m_gltfModel = AZStd::make_unique<GltfModel>(meshFeatureProcessor, loadModel);
+        m_impl->m_gltfModel = AZStd::make_unique<GltfModel>(meshFeatureProcessor, *loadModel);
+        m_impl->m_loadModel = loadModel;
 
         // Set the model transform
         AZ::Transform worldTransform;
@@ -57,6 +85,27 @@ namespace Cesium
         AZ::NonUniformScaleRequestBus::EventResult(worldScale, GetEntityId(), &AZ::NonUniformScaleRequestBus::Events::GetScale);
 
         SetWorldTransform(worldTransform, worldScale);
+
+        GltfModelNotificationBus::Event(GetEntityId(), &GltfModelNotificationBus::Events::OnModelLoaded, filePath);
+    }
+
+    void GltfModelComponent::SetGeneratedLodCount(std::uint32_t lodCount)
+    {
+        if (m_impl->m_generatedLodCount == lodCount)
+        {
+            return;
+        }
+
+        m_impl->m_generatedLodCount = lodCount;
+        if (GltfModelRequestBus::Handler::BusIsConnected())
+        {
+            LoadModel(m_impl->m_filePath);
+        }
+    }
+
+    std::uint32_t GltfModelComponent::GetGeneratedLodCount() const
+    {
+        return m_impl->m_generatedLodCount;
     }
 
     void GltfModelComponent::Init()
@@ -80,10 +129,13 @@ namespace Cesium
 
     void GltfModelComponent::Deactivate()
     {
+        // drop the results of the loads that are still in flight
+        ++*m_impl->m_latestLoadId;
         GltfModelRequestBus::Handler::BusDisconnect();
         AZ::TransformNotificationBus::Handler::BusDisconnect();
         m_impl->m_nonUniformScaleChangedHandler.Disconnect();
         m_impl->m_gltfModel.reset();
+        m_impl->m_loadModel.reset();
     }
 
     void GltfModelComponent::OnTransformChanged([[maybe_unused]] const AZ::Transform& local, const AZ::Transform& world)
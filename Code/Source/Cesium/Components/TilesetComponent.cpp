@@ -2,14 +2,21 @@
 #include "Cesium/EBus/RasterOverlayContainerBus.h"
 #include "Cesium/TilesetUtility/RenderResourcesPreparer.h"
 #include "Cesium/TilesetUtility/TilesetCameraConfigurations.h"
+#include "Cesium/TilesetUtility/TilesetQueryViews.h"
 #include "Cesium/Systems/CesiumSystem.h"
 #include "Cesium/Math/BoundingVolumeConverters.h"
 #include <Cesium/Math/MathHelper.h>
 #include <Cesium/Math/MathReflect.h>
+#include <Cesium/Math/GeospatialHelper.h>
 #include <Atom/RPI.Public/Scene.h>
+#include <Atom/RPI.Public/ViewportContext.h>
+#include <Atom/RPI.Public/ViewportContextBus.h>
+#include <AzCore/Component/TransformBus.h>
 #include <AzCore/Serialization/SerializeContext.h>
 #include <AzCore/RTTI/BehaviorContext.h>
 #include <AzCore/JSON/rapidjson.h>
+#include <AzCore/std/containers/deque.h>
+#include <AzCore/std/algorithm.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <vector>
@@ -43,11 +50,35 @@ namespace Cesium
             AllChange = TilesetConfigChange | SourceChange | TransformChange
         };
 
+        // Positions of a height request that are loaded together by a view looking straight down at them
+        struct HeightRequestGroup
+        {
+            std::size_t m_begin;
+            std::size_t m_end;
+            std::uint32_t m_frameCount;
+
+            // position in ECEF of the camera of the view
+            glm::dvec3 m_cameraPosition;
+        };
+
+        struct HeightRequest
+        {
+            std::uint64_t m_id;
+
+            // positions sorted along the Morton curve, and the index of each of them in the request
+            AZStd::vector<Cartographic> m_positions;
+            AZStd::vector<std::uint32_t> m_order;
+            AZStd::vector<TilesetHeightSample> m_samples;
+            std::size_t m_nextPosition;
+            AZStd::vector<HeightRequestGroup> m_activeGroups;
+        };
+
         Impl(const AZ::EntityId& selfEntity, const TilesetSource& tilesetSource, const TilesetRenderConfiguration& renderConfiguration)
             : m_selfEntity{ selfEntity }
             , m_absToRelWorld{ 1.0 }
             , m_configFlags{ ConfigurationDirtyFlags::None }
             , m_tilesetLoaded{ false }
+            , m_nextHeightRequestId{ 0 }
         {
             // mark all configs to be dirty so that tileset will be updated with the current config accordingly
             m_configFlags = Impl::ConfigurationDirtyFlags::AllChange;
@@ -97,12 +128,12 @@ namespace Cesium
             }
         }
 
-        Cesium3DTilesSelection::TilesetExternals CreateTilesetExternal(IOKind kind)
+        Cesium3DTilesSelection::TilesetExternals CreateTilesetExternal(IOKind kind, const TilesetRenderConfiguration& renderConfiguration)
         {
             // create render resources preparer if not exist
             AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor =
                 AZ::RPI::Scene::GetFeatureProcessorForEntity<AZ::Render::MeshFeatureProcessorInterface>(m_selfEntity);
-            m_renderResourcesPreparer = std::make_shared<RenderResourcesPreparer>(meshFeatureProcessor);
+            m_renderResourcesPreparer = std::make_shared<RenderResourcesPreparer>(meshFeatureProcessor, renderConfiguration);
 
             return Cesium3DTilesSelection::TilesetExternals{
                 CesiumInterface::Get()->GetAssetAccessor(kind),
@@ -120,7 +151,7 @@ namespace Cesium
                 return;
             }
 
-            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::LocalFile);
+            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::LocalFile, renderConfiguration);
             Cesium3DTilesSelection::TilesetOptions options;
             options.contentOptions.generateMissingNormalsSmooth = renderConfiguration.m_generateMissingNormalAsSmooth;
             m_tileset = AZStd::make_unique<Cesium3DTilesSelection::Tileset>(externals, source.m_filePath.c_str(), options);
@@ -133,7 +164,7 @@ namespace Cesium
                 return;
             }
 
-            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http);
+            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http, renderConfiguration);
             Cesium3DTilesSelection::TilesetOptions options;
             options.contentOptions.generateMissingNormalsSmooth = renderConfiguration.m_generateMissingNormalAsSmooth;
             m_tileset = AZStd::make_unique<Cesium3DTilesSelection::Tileset>(externals, source.m_url.c_str(), options);
@@ -146,7 +177,7 @@ namespace Cesium
                 return;
             }
 
-            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http);
+            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http, renderConfiguration);
             Cesium3DTilesSelection::TilesetOptions options;
             options.contentOptions.generateMissingNormalsSmooth = renderConfiguration.m_generateMissingNormalAsSmooth;
             m_tileset = AZStd::make_unique<Cesium3DTilesSelection::Tileset>(
@@ -262,16 +293,232 @@ namespace Cesium
             }
         }
 
+        AZStd::vector<TilesetHeightSample> SampleHeights(const AZStd::vector<Cartographic>& positions)
+        {
+            AZStd::vector<TilesetHeightSample> samples(positions.size());
+            if (!m_renderResourcesPreparer || positions.empty())
+            {
+                return samples;
+            }
+
+            // Rays go down along the ellipsoid normal from above the highest surface on Earth. Queries are sorted so that the
+            // batches of the preparer only overlap a few tiles
+            AZStd::vector<std::uint32_t> order = TilesetQueryViews::SortAlongMortonCurve(positions);
+            AZStd::vector<TileRaycastQuery> queries(positions.size());
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                const Cartographic& position = positions[order[i]];
+                glm::dvec3 origin = GeospatialHelper::CartographicToECEFCartesian(
+                    Cartographic(position.m_longitude, position.m_latitude, HEIGHT_SAMPLE_MAXIMUM));
+                glm::dvec3 direction = -GeospatialHelper::GeodeticSurfaceNormal(origin);
+                queries[i].m_origin = m_absToRelWorld * glm::dvec4(origin, 1.0);
+                queries[i].m_direction = m_absToRelWorld * glm::dvec4(direction, 0.0);
+                queries[i].m_maxDistance = HEIGHT_SAMPLE_MAXIMUM - HEIGHT_SAMPLE_MINIMUM;
+            }
+
+            m_renderResourcesPreparer->RaycastMostDetailed(queries);
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                if (queries[i].m_isHit)
+                {
+                    TilesetHeightSample& sample = samples[order[i]];
+                    sample.m_hit = true;
+                    sample.m_height = HEIGHT_SAMPLE_MAXIMUM - queries[i].m_hit.m_distance;
+                }
+            }
+
+            return samples;
+        }
+
+        std::uint64_t RequestHeights(const AZStd::vector<Cartographic>& positions)
+        {
+            HeightRequest& request = m_heightRequests.emplace_back();
+            request.m_id = m_nextHeightRequestId++;
+            request.m_order = TilesetQueryViews::SortAlongMortonCurve(positions);
+            request.m_positions.reserve(positions.size());
+            for (std::uint32_t index : request.m_order)
+            {
+                request.m_positions.emplace_back(positions[index]);
+            }
+
+            request.m_samples.resize(positions.size());
+            request.m_nextPosition = 0;
+            return request.m_id;
+        }
+
+        static HeightRequestGroup CreateHeightRequestGroup(
+            const AZStd::vector<Cartographic>& positions, std::size_t begin, std::size_t end)
+        {
+            // look straight down at the center of the positions, from high enough to see all of them
+            glm::dvec3 center{ 0.0 };
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                center +=
+                    GeospatialHelper::CartographicToECEFCartesian(Cartographic(positions[i].m_longitude, positions[i].m_latitude, 0.0));
+            }
+
+            center /= static_cast<double>(end - begin);
+            double radius = 0.0;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                glm::dvec3 position =
+                    GeospatialHelper::CartographicToECEFCartesian(Cartographic(positions[i].m_longitude, positions[i].m_latitude, 0.0));
+                radius = glm::max(radius, glm::distance(center, position));
+            }
+
+            glm::dvec3 up = GeospatialHelper::GeodeticSurfaceNormal(center);
+            HeightRequestGroup group;
+            group.m_begin = begin;
+            group.m_end = end;
+            group.m_frameCount = 0;
+            double cameraHeight = radius / glm::tan(TilesetQueryViews::DOWNWARD_VIEW_FOV * 0.5);
+            group.m_cameraPosition = center + up * glm::max(cameraHeight, HEIGHT_REQUEST_MINIMUM_CAMERA_HEIGHT);
+            return group;
+        }
+
+        // Add a view that looks straight down from a position in ECEF, so that the tileset loads the tiles under it
+        void AppendDownwardViewState(const glm::dvec3& cameraPosition)
+        {
+            m_viewStates.emplace_back(
+                TilesetQueryViews::CreateDownwardViewState(cameraPosition, m_cameraConfigurations.GetTransform() * m_absToRelWorld));
+        }
+
+        const std::vector<Cesium3DTilesSelection::ViewState>& GetViewStates(
+            const std::vector<Cesium3DTilesSelection::ViewState>& cameraViewStates)
+        {
+            if (m_heightRequests.empty() && m_collisionFocusPoints.empty())
+            {
+                return cameraViewStates;
+            }
+
+            m_viewStates = cameraViewStates;
+
+            // the tiles around the collision focus entities are loaded even if the camera doesn't look at them
+            glm::dmat4 relToAbsWorld = glm::affineInverse(m_absToRelWorld);
+            for (const glm::dvec3& focusPoint : m_collisionFocusPoints)
+            {
+                AppendDownwardViewState(relToAbsWorld * glm::dvec4(focusPoint, 1.0));
+            }
+
+            if (!m_heightRequests.empty())
+            {
+                // requests are loaded one after another, a few groups at a time
+                HeightRequest& request = m_heightRequests.front();
+                while (request.m_activeGroups.size() < MAX_HEIGHT_REQUEST_GROUPS && request.m_nextPosition < request.m_positions.size())
+                {
+                    std::size_t begin = request.m_nextPosition;
+                    std::size_t end = AZStd::min(begin + HEIGHT_REQUEST_GROUP_SIZE, request.m_positions.size());
+                    request.m_activeGroups.emplace_back(CreateHeightRequestGroup(request.m_positions, begin, end));
+                    request.m_nextPosition = end;
+                }
+
+                for (const HeightRequestGroup& group : request.m_activeGroups)
+                {
+                    AppendDownwardViewState(group.m_cameraPosition);
+                }
+            }
+
+            return m_viewStates;
+        }
+
+        void UpdateCollisionFocusPoints(const TilesetRenderConfiguration& renderConfiguration)
+        {
+            m_collisionFocusPoints.clear();
+            if (!renderConfiguration.m_enableCollision || !m_renderResourcesPreparer)
+            {
+                return;
+            }
+
+            for (const AZ::EntityId& entity : m_collisionFocusEntities)
+            {
+                AZ::Vector3 translation = AZ::Vector3::CreateZero();
+                AZ::TransformBus::EventResult(translation, entity, &AZ::TransformBus::Events::GetWorldTranslation);
+                m_collisionFocusPoints.emplace_back(translation.GetX(), translation.GetY(), translation.GetZ());
+            }
+
+            // The camera views already load the tiles around the camera, so the camera doesn't need a view of its own. It is only
+            // given to the preparer
+            AZStd::vector<glm::dvec3> focusPoints = m_collisionFocusPoints;
+            if (m_collisionFocusEntities.empty())
+            {
+                auto viewportContextManager = AZ::Interface<AZ::RPI::ViewportContextRequestsInterface>::Get();
+                auto defaultViewportContext = viewportContextManager ? viewportContextManager->GetDefaultViewportContext() : nullptr;
+                if (defaultViewportContext)
+                {
+                    AZ::Vector3 cameraPosition = defaultViewportContext->GetCameraTransform().GetTranslation();
+                    focusPoints.emplace_back(cameraPosition.GetX(), cameraPosition.GetY(), cameraPosition.GetZ());
+                }
+            }
+
+            m_renderResourcesPreparer->SetCollisionFocusPoints(focusPoints);
+        }
+
+        void UpdateHeightRequests(bool isLoadingTiles)
+        {
+            if (m_heightRequests.empty())
+            {
+                return;
+            }
+
+            HeightRequest& request = m_heightRequests.front();
+            for (auto group = request.m_activeGroups.begin(); group != request.m_activeGroups.end();)
+            {
+                // The tiles of a new view are only selected for loading after its first update. Groups are sampled with whatever is
+                // loaded if the tileset keeps loading for too long
+                ++group->m_frameCount;
+                bool isLoaded = group->m_frameCount >= HEIGHT_REQUEST_MINIMUM_FRAMES && !isLoadingTiles;
+                if (!isLoaded && group->m_frameCount < HEIGHT_REQUEST_MAXIMUM_FRAMES)
+                {
+                    ++group;
+                    continue;
+                }
+
+                AZStd::vector<Cartographic> positions(
+                    request.m_positions.begin() + group->m_begin, request.m_positions.begin() + group->m_end);
+                AZStd::vector<TilesetHeightSample> samples = SampleHeights(positions);
+                for (std::size_t i = 0; i < samples.size(); ++i)
+                {
+                    request.m_samples[request.m_order[group->m_begin + i]] = samples[i];
+                }
+
+                group = request.m_activeGroups.erase(group);
+            }
+
+            if (request.m_activeGroups.empty() && request.m_nextPosition == request.m_positions.size())
+            {
+                // handlers may make new requests, so the request is removed first
+                HeightRequest finishedRequest = AZStd::move(request);
+                m_heightRequests.pop_front();
+                m_heightsSampledEvent.Signal(finishedRequest.m_id, finishedRequest.m_samples);
+            }
+        }
+
+        static constexpr double HEIGHT_SAMPLE_MAXIMUM = 10000.0;
+        static constexpr double HEIGHT_SAMPLE_MINIMUM = -12000.0;
+        static constexpr std::size_t HEIGHT_REQUEST_GROUP_SIZE = 64;
+        static constexpr std::size_t MAX_HEIGHT_REQUEST_GROUPS = 4;
+        static constexpr std::uint32_t HEIGHT_REQUEST_MINIMUM_FRAMES = 2;
+        static constexpr std::uint32_t HEIGHT_REQUEST_MAXIMUM_FRAMES = 600;
+        static constexpr double HEIGHT_REQUEST_MINIMUM_CAMERA_HEIGHT = 100.0;
+
         AZ::EntityId m_selfEntity;
         TilesetCameraConfigurations m_cameraConfigurations;
         std::shared_ptr<RenderResourcesPreparer> m_renderResourcesPreparer;
         AZStd::unique_ptr<Cesium3DTilesSelection::Tileset> m_tileset;
         TilesetLoadedEvent m_tilesetLoadedEvent;
+        TilesetHeightsSampledEvent m_heightsSampledEvent;
+        AZStd::deque<HeightRequest> m_heightRequests;
+        AZStd::vector<AZ::EntityId> m_collisionFocusEntities;
+
+        // relative world positions of the collision focus entities in the current frame
+        AZStd::vector<glm::dvec3> m_collisionFocusPoints;
+        std::vector<Cesium3DTilesSelection::ViewState> m_viewStates;
         RasterOverlayContainerLoadedEvent m_rasterOverlayContainerLoadedEvent;
         RasterOverlayContainerUnloadedEvent m_rasterOverlayContainerUnloadedEvent;
         glm::dmat4 m_absToRelWorld;
         int m_configFlags;
         bool m_tilesetLoaded;
+        std::uint64_t m_nextHeightRequestId;
     };
 
     void TilesetComponent::Reflect(AZ::ReflectContext* context)
@@ -455,6 +702,56 @@ namespace Cesium
         handler.Connect(m_impl->m_tilesetLoadedEvent);
     }
 
+    TilesetRaycastResult TilesetComponent::RaycastInECEF(const glm::dvec3& origin, const glm::dvec3& direction, double maxDistance)
+    {
+        TilesetRaycastResult result;
+        if (!m_impl->m_renderResourcesPreparer)
+        {
+            return result;
+        }
+
+        // The tiles are rendered relative to the origin shift, which is a rigid transform. The distance along the ray is the same in
+        // both spaces, so only the normal needs to be brought back to ECEF
+        glm::dvec3 relOrigin = m_impl->m_absToRelWorld * glm::dvec4(origin, 1.0);
+        glm::dvec3 relDirection = m_impl->m_absToRelWorld * glm::dvec4(direction, 0.0);
+        GltfRaycastHit hit;
+        if (!m_impl->m_renderResourcesPreparer->Raycast(relOrigin, relDirection, maxDistance, hit))
+        {
+            return result;
+        }
+
+        result.m_hit = true;
+        result.m_distance = hit.m_distance;
+        result.m_position = origin + direction * hit.m_distance;
+        result.m_normal = glm::normalize(glm::dvec3(glm::affineInverse(m_impl->m_absToRelWorld) * glm::dvec4(hit.m_normal, 0.0)));
+        return result;
+    }
+
+    AZStd::vector<TilesetHeightSample> TilesetComponent::SampleHeightsInCartographic(const AZStd::vector<Cartographic>& positions)
+    {
+        return m_impl->SampleHeights(positions);
+    }
+
+    std::uint64_t TilesetComponent::RequestHeightsInCartographic(const AZStd::vector<Cartographic>& positions)
+    {
+        return m_impl->RequestHeights(positions);
+    }
+
+    void TilesetComponent::BindHeightsSampledHandler(TilesetHeightsSampledEvent::Handler& handler)
+    {
+        handler.Connect(m_impl->m_heightsSampledEvent);
+    }
+
+    void TilesetComponent::SetCollisionFocusEntities(const AZStd::vector<AZ::EntityId>& entities)
+    {
+        m_impl->m_collisionFocusEntities = entities;
+    }
+
+    const AZStd::vector<AZ::EntityId>& TilesetComponent::GetCollisionFocusEntities() const
+    {
+        return m_impl->m_collisionFocusEntities;
+    }
+
     void TilesetComponent::ApplyTransformToRoot(const glm::dmat4& transform)
     {
         m_transform = transform;
@@ -471,8 +768,11 @@ namespace Cesium
 
         if (m_impl->m_tileset)
         {
-            // update view tileset
-            const std::vector<Cesium3DTilesSelection::ViewState>& viewStates = m_impl->m_cameraConfigurations.UpdateAndGetViewStates();
+            // update view tileset. Height requests and collision focus entities add views that load the tiles under them
+            const std::vector<Cesium3DTilesSelection::ViewState>& cameraViewStates =
+                m_impl->m_cameraConfigurations.UpdateAndGetViewStates();
+            m_impl->UpdateCollisionFocusPoints(m_renderConfiguration);
+            const std::vector<Cesium3DTilesSelection::ViewState>& viewStates = m_impl->GetViewStates(cameraViewStates);
 
             if (!viewStates.empty())
             {
@@ -509,6 +809,7 @@ namespace Cesium
                     {
                         void* renderResources = tile->getRendererResources();
                         m_impl->m_renderResourcesPreparer->SetVisible(renderResources, false);
+                        m_impl->m_renderResourcesPreparer->SetSelected(renderResources, false);
                     }
                 }
 
@@ -516,10 +817,20 @@ namespace Cesium
                 {
                     if (tile->getState() == Cesium3DTilesSelection::Tile::LoadState::Done)
                     {
+                        // tiles only selected by the views of height requests and collision focus entities stay hidden
+                        bool isVisible = TilesetQueryViews::IsVisibleFromCameras(
+                            cameraViewStates, &viewStates != &cameraViewStates, tile->getBoundingVolume());
                         void* renderResources = tile->getRendererResources();
-                        m_impl->m_renderResourcesPreparer->SetVisible(renderResources, true);
+                        m_impl->m_renderResourcesPreparer->SetVisible(renderResources, isVisible);
+                        m_impl->m_renderResourcesPreparer->SetSelected(renderResources, true);
                     }
                 }
+
+                m_impl->m_renderResourcesPreparer->UpdateCollision();
+
+                std::uint32_t tilesLoading = viewUpdate.tilesLoadingLowPriority + viewUpdate.tilesLoadingMediumPriority +
+                    viewUpdate.tilesLoadingHighPriority;
+                m_impl->UpdateHeightRequests(tilesLoading > 0);
             }
         }
     }
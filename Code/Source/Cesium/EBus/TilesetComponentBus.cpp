@@ -38,16 +38,59 @@ namespace Cesium
     {
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
         {
-            serializeContext->Class<TilesetRenderConfiguration>()->Version(0)->Field(
-                "GenerateMissingNormalAsSmooth", &TilesetRenderConfiguration::m_generateMissingNormalAsSmooth);
+            serializeContext->Class<TilesetRenderConfiguration>()
+                ->Version(0)
+                ->Field("GenerateMissingNormalAsSmooth", &TilesetRenderConfiguration::m_generateMissingNormalAsSmooth)
+                ->Field("MergeMeshPrimitives", &TilesetRenderConfiguration::m_mergeMeshPrimitives)
+                ->Field("OptimizeMeshVertexOrder", &TilesetRenderConfiguration::m_optimizeMeshVertexOrder)
+                ->Field("MeshClusterTriangleCount", &TilesetRenderConfiguration::m_meshClusterTriangleCount)
+                ->Field("TextureCompression", &TilesetRenderConfiguration::m_textureCompression)
+                ->Field("PointCloudAttenuation", &TilesetRenderConfiguration::m_pointCloudAttenuation)
+                ->Field("PointCloudPointSize", &TilesetRenderConfiguration::m_pointCloudPointSize)
+                ->Field("PointCloudSpacingScale", &TilesetRenderConfiguration::m_pointCloudSpacingScale)
+                ->Field("PointCloudMaximumPointSize", &TilesetRenderConfiguration::m_pointCloudMaximumPointSize)
+                ->Field("LineWidth", &TilesetRenderConfiguration::m_lineWidth)
+                ->Field("EnableRaycast", &TilesetRenderConfiguration::m_enableRaycast)
+                ->Field("EnableCollision", &TilesetRenderConfiguration::m_enableCollision)
+                ->Field("CollisionSimplificationError", &TilesetRenderConfiguration::m_collisionSimplificationError)
+                ->Field("CollisionFocusRadius", &TilesetRenderConfiguration::m_collisionFocusRadius);
         }
 
         if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
         {
+            behaviorContext->Enum<static_cast<int>(TilesetTextureCompression::None)>("TilesetTextureCompression_None")
+                ->Enum<static_cast<int>(TilesetTextureCompression::Fast)>("TilesetTextureCompression_Fast")
+                ->Enum<static_cast<int>(TilesetTextureCompression::HighQuality)>("TilesetTextureCompression_HighQuality");
+
+            auto getTextureCompression = [](TilesetRenderConfiguration* configuration) -> int
+            {
+                return static_cast<int>(configuration->m_textureCompression);
+            };
+
+            auto setTextureCompression = [](TilesetRenderConfiguration* configuration, const int& textureCompression)
+            {
+                configuration->m_textureCompression = static_cast<TilesetTextureCompression>(textureCompression);
+            };
+
             behaviorContext->Class<TilesetRenderConfiguration>("TilesetRenderConfiguration")
                 ->Attribute(AZ::Script::Attributes::Category, "Cesium/3DTiles")
                 ->Property(
-                    "GenerateMissingNormalAsSmooth", BehaviorValueProperty(&TilesetRenderConfiguration::m_generateMissingNormalAsSmooth));
+                    "GenerateMissingNormalAsSmooth", BehaviorValueProperty(&TilesetRenderConfiguration::m_generateMissingNormalAsSmooth))
+                ->Property("MergeMeshPrimitives", BehaviorValueProperty(&TilesetRenderConfiguration::m_mergeMeshPrimitives))
+                ->Property("OptimizeMeshVertexOrder", BehaviorValueProperty(&TilesetRenderConfiguration::m_optimizeMeshVertexOrder))
+                ->Property("MeshClusterTriangleCount", BehaviorValueProperty(&TilesetRenderConfiguration::m_meshClusterTriangleCount))
+                ->Property("TextureCompression", getTextureCompression, setTextureCompression)
+                ->Property("PointCloudAttenuation", BehaviorValueProperty(&TilesetRenderConfiguration::m_pointCloudAttenuation))
+                ->Property("PointCloudPointSize", BehaviorValueProperty(&TilesetRenderConfiguration::m_pointCloudPointSize))
+                ->Property(
+                    "PointCloudSpacingScale", BehaviorValueProperty(&TilesetRenderConfiguration::m_pointCloudSpacingScale))
+                ->Property("PointCloudMaximumPointSize", BehaviorValueProperty(&TilesetRenderConfiguration::m_pointCloudMaximumPointSize))
+                ->Property("LineWidth", BehaviorValueProperty(&TilesetRenderConfiguration::m_lineWidth))
+                ->Property("EnableRaycast", BehaviorValueProperty(&TilesetRenderConfiguration::m_enableRaycast))
+                ->Property("EnableCollision", BehaviorValueProperty(&TilesetRenderConfiguration::m_enableCollision))
+                ->Property(
+                    "CollisionSimplificationError", BehaviorValueProperty(&TilesetRenderConfiguration::m_collisionSimplificationError))
+                ->Property("CollisionFocusRadius", BehaviorValueProperty(&TilesetRenderConfiguration::m_collisionFocusRadius));
         }
     }
 
@@ -209,6 +252,30 @@ namespace Cesium
         return nullptr;
     }
 
+    void TilesetRaycastResult::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
+        {
+            behaviorContext->Class<TilesetRaycastResult>("TilesetRaycastResult")
+                ->Attribute(AZ::Script::Attributes::Category, "Cesium/3DTiles")
+                ->Property("Hit", BehaviorValueProperty(&TilesetRaycastResult::m_hit))
+                ->Property("Position", BehaviorValueProperty(&TilesetRaycastResult::m_position))
+                ->Property("Normal", BehaviorValueProperty(&TilesetRaycastResult::m_normal))
+                ->Property("Distance", BehaviorValueProperty(&TilesetRaycastResult::m_distance));
+        }
+    }
+
+    void TilesetHeightSample::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
+        {
+            behaviorContext->Class<TilesetHeightSample>("TilesetHeightSample")
+                ->Attribute(AZ::Script::Attributes::Category, "Cesium/3DTiles")
+                ->Property("Hit", BehaviorValueProperty(&TilesetHeightSample::m_hit))
+                ->Property("Height", BehaviorValueProperty(&TilesetHeightSample::m_height));
+        }
+    }
+
     void TilesetRequest::Reflect(AZ::ReflectContext* context)
     {
         if (AZ::BehaviorContext* behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
@@ -224,7 +291,12 @@ namespace Cesium
                 ->Event("LoadTileset", &TilesetRequestBus::Events::LoadTileset)
                 ->Event("GetRootTransform", &TilesetRequestBus::Events::GetRootTransform)
                 ->Event("GetTransform", &TilesetRequestBus::Events::GetTransform)
-                ->Event("ApplyTransformToRoot", &TilesetRequestBus::Events::ApplyTransformToRoot);
+                ->Event("ApplyTransformToRoot", &TilesetRequestBus::Events::ApplyTransformToRoot)
+                ->Event("RaycastInECEF", &TilesetRequestBus::Events::RaycastInECEF)
+                ->Event("SampleHeightsInCartographic", &TilesetRequestBus::Events::SampleHeightsInCartographic)
+                ->Event("RequestHeightsInCartographic", &TilesetRequestBus::Events::RequestHeightsInCartographic)
+                ->Event("SetCollisionFocusEntities", &TilesetRequestBus::Events::SetCollisionFocusEntities)
+                ->Event("GetCollisionFocusEntities", &TilesetRequestBus::Events::GetCollisionFocusEntities);
         }
     }
 } // namespace Cesium
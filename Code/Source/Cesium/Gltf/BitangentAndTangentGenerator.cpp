@@ -10,8 +10,8 @@ namespace Cesium
         AZStd::span<glm::vec2> uvs{};
         AZStd::span<glm::u8vec2> unorm_u8_uvs{};
         AZStd::span<glm::u16vec2> unorm_u16_uvs{};
-        AZStd::vector<glm::vec4>* tangents{ nullptr };
-        AZStd::vector<glm::vec3>* bitangents{ nullptr };
+        AZStd::span<glm::vec4> tangents{};
+        AZStd::span<glm::vec3> bitangents{};
     };
 
     struct BitangentAndTangentGenerator::MikktspaceMethods
@@ -114,8 +114,8 @@ namespace Cesium
             const int vert)
         {
             MikktspaceCustomData* customData = static_cast<MikktspaceCustomData*>(context->m_pUserData);
-            AZStd::vector<glm::vec4>& tangents = *customData->tangents;
-            AZStd::vector<glm::vec3>& bitangents = *customData->bitangents;
+            AZStd::span<glm::vec4>& tangents = customData->tangents;
+            AZStd::span<glm::vec3>& bitangents = customData->bitangents;
             std::size_t vertexIndex = static_cast<std::size_t>(face * 3 + vert);
             float sign = isOrientationPreserving ? 1.0f : -1.0f;
             tangents[vertexIndex] = glm::vec4(tangent[0] * magS, tangent[1] * magS, tangent[2] * magS, sign);
@@ -127,11 +127,13 @@ namespace Cesium
         const AZStd::span<glm::vec3>& positions,
         const AZStd::span<glm::vec3>& normals,
         const AZStd::span<glm::vec2>& uvs,
-        AZStd::vector<glm::vec4>& tangents,
-        AZStd::vector<glm::vec3>& bitangents)
+        AZStd::span<glm::vec4> tangents,
+        AZStd::span<glm::vec3> bitangents)
     {
-        tangents.resize(positions.size());
-        bitangents.resize(positions.size());
+        if (tangents.size() != positions.size() || bitangents.size() != positions.size())
+        {
+            return false;
+        }
 
         SMikkTSpaceInterface mikkInterface;
         mikkInterface.m_getNumFaces = MikktspaceMethods::GetNumFaces;
@@ -147,8 +149,8 @@ namespace Cesium
         customData.positions = positions;
         customData.normals = normals;
         customData.uvs = uvs;
-        customData.tangents = &tangents;
-        customData.bitangents = &bitangents;
+        customData.tangents = tangents;
+        customData.bitangents = bitangents;
 
         // Generate the tangents.
         SMikkTSpaceContext mikkContext;
@@ -161,11 +163,13 @@ namespace Cesium
         const AZStd::span<glm::vec3>& positions,
         const AZStd::span<glm::vec3>& normals,
         const AZStd::span<glm::u8vec2>& uvs,
-        AZStd::vector<glm::vec4>& tangents,
-        AZStd::vector<glm::vec3>& bitangents)
+        AZStd::span<glm::vec4> tangents,
+        AZStd::span<glm::vec3> bitangents)
     {
-        tangents.resize(positions.size());
-        bitangents.resize(positions.size());
+        if (tangents.size() != positions.size() || bitangents.size() != positions.size())
+        {
+            return false;
+        }
 
         SMikkTSpaceInterface mikkInterface;
         mikkInterface.m_getNumFaces = MikktspaceMethods::GetNumFaces;
@@ -181,8 +185,8 @@ namespace Cesium
         customData.positions = positions;
         customData.normals = normals;
         customData.unorm_u8_uvs = uvs;
-        customData.tangents = &tangents;
-        customData.bitangents = &bitangents;
+        customData.tangents = tangents;
+        customData.bitangents = bitangents;
 
         // Generate the tangents.
         SMikkTSpaceContext mikkContext;
@@ -195,11 +199,13 @@ namespace Cesium
         const AZStd::span<glm::vec3>& positions,
         const AZStd::span<glm::vec3>& normals,
         const AZStd::span<glm::u16vec2>& uvs,
-        AZStd::vector<glm::vec4>& tangents,
-        AZStd::vector<glm::vec3>& bitangents)
+        AZStd::span<glm::vec4> tangents,
+        AZStd::span<glm::vec3> bitangents)
     {
-        tangents.resize(positions.size());
-        bitangents.resize(positions.size());
+        if (tangents.size() != positions.size() || bitangents.size() != positions.size())
+        {
+            return false;
+        }
 
         SMikkTSpaceInterface mikkInterface;
         mikkInterface.m_getNumFaces = MikktspaceMethods::GetNumFaces;
@@ -215,8 +221,8 @@ namespace Cesium
         customData.positions = positions;
         customData.normals = normals;
         customData.unorm_u16_uvs = uvs;
-        customData.tangents = &tangents;
-        customData.bitangents = &bitangents;
+        customData.tangents = tangents;
+        customData.bitangents = bitangents;
 
         // Generate the tangents.
         SMikkTSpaceContext mikkContext;
@@ -0,0 +1,125 @@
+#include "Cesium/Gltf/FreeListAllocator.h"
+#include "Cesium/Math/MathHelper.h"
+#include <AzCore/Debug/Trace.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/iterator.h>
+
+namespace Cesium
+{
+    FreeListAllocator::FreeListAllocator(std::size_t capacity, std::size_t alignment)
+        : m_capacity{ capacity - capacity % alignment }
+        , m_alignment{ alignment }
+        , m_usedSize{ 0 }
+    {
+        if (m_capacity > 0)
+        {
+            m_freeRanges.emplace(0, m_capacity);
+        }
+    }
+
+    bool FreeListAllocator::Allocate(std::size_t size, std::size_t& offset)
+    {
+        size = AlignSize(size);
+        for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it)
+        {
+            if (it->second < size)
+            {
+                continue;
+            }
+
+            offset = it->first;
+            std::size_t remainingSize = it->second - size;
+            m_freeRanges.erase(it);
+            if (remainingSize > 0)
+            {
+                m_freeRanges.emplace(offset + size, remainingSize);
+            }
+
+            m_usedSize += size;
+            return true;
+        }
+
+        return false;
+    }
+
+    void FreeListAllocator::Free(std::size_t offset, std::size_t size)
+    {
+        size = AlignSize(size);
+        AZ_Assert(offset + size <= m_capacity && size <= m_usedSize, "The range was not allocated by this allocator");
+        m_usedSize -= size;
+
+        // merge with the free range that ends where this one starts, and with the one that starts where it ends
+        auto next = m_freeRanges.lower_bound(offset);
+        if (next != m_freeRanges.begin())
+        {
+            auto previous = AZStd::prev(next);
+            if (previous->first + previous->second == offset)
+            {
+                offset = previous->first;
+                size += previous->second;
+                m_freeRanges.erase(previous);
+            }
+        }
+
+        if (next != m_freeRanges.end() && offset + size == next->first)
+        {
+            size += next->second;
+            m_freeRanges.erase(next);
+        }
+
+        m_freeRanges.emplace(offset, size);
+    }
+
+    void FreeListAllocator::FreeDeferred(std::size_t offset, std::size_t size, std::uint64_t frame)
+    {
+        AZ_Assert(m_deferredFrees.empty() || m_deferredFrees.back().m_frame <= frame, "Frees must be deferred in frame order");
+        m_deferredFrees.push_back(DeferredFree{ offset, size, frame });
+    }
+
+    void FreeListAllocator::ReleaseDeferredFrees(std::uint64_t frame)
+    {
+        auto end = m_deferredFrees.begin();
+        for (; end != m_deferredFrees.end() && end->m_frame <= frame; ++end)
+        {
+            Free(end->m_offset, end->m_size);
+        }
+
+        m_deferredFrees.erase(m_deferredFrees.begin(), end);
+    }
+
+    bool FreeListAllocator::IsEmpty() const
+    {
+        return m_usedSize == 0;
+    }
+
+    std::size_t FreeListAllocator::GetCapacity() const
+    {
+        return m_capacity;
+    }
+
+    std::size_t FreeListAllocator::GetUsedSize() const
+    {
+        return m_usedSize;
+    }
+
+    std::size_t FreeListAllocator::GetFreeRangeCount() const
+    {
+        return m_freeRanges.size();
+    }
+
+    std::size_t FreeListAllocator::GetLargestFreeRange() const
+    {
+        std::size_t largest = 0;
+        for (const auto& freeRange : m_freeRanges)
+        {
+            largest = AZStd::max(largest, freeRange.second);
+        }
+
+        return largest;
+    }
+
+    std::size_t FreeListAllocator::AlignSize(std::size_t size) const
+    {
+        return MathHelper::AlignToMultiple(AZStd::max(size, std::size_t{ 1 }), m_alignment);
+    }
+} // namespace Cesium
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <AzCore/std/containers/map.h>
+#include <AzCore/std/containers/vector.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // First-fit allocator of ranges in a space of fixed capacity. Offsets and sizes are multiples of the alignment, and freed ranges
+    // are merged with the free ranges next to them, so that the space doesn't fragment into ranges too small to be reused
+    class FreeListAllocator final
+    {
+    public:
+        FreeListAllocator(std::size_t capacity, std::size_t alignment);
+
+        // The size is rounded up to the alignment. Return false if no free range is large enough
+        bool Allocate(std::size_t size, std::size_t& offset);
+
+        // The range must have been returned by Allocate, with the same size
+        void Free(std::size_t offset, std::size_t size);
+
+        // Free the range once ReleaseDeferredFrees is called for the frame or a later one. The range stays used until then, so that
+        // the GPU can finish reading it
+        void FreeDeferred(std::size_t offset, std::size_t size, std::uint64_t frame);
+
+        // Free the ranges deferred up to the frame
+        void ReleaseDeferredFrees(std::uint64_t frame);
+
+        bool IsEmpty() const;
+
+        std::size_t GetCapacity() const;
+
+        std::size_t GetUsedSize() const;
+
+        std::size_t GetFreeRangeCount() const;
+
+        std::size_t GetLargestFreeRange() const;
+
+    private:
+        std::size_t AlignSize(std::size_t size) const;
+
+        std::size_t m_capacity;
+        std::size_t m_alignment;
+        std::size_t m_usedSize;
+
+        struct DeferredFree final
+        {
+            std::size_t m_offset;
+            std::size_t m_size;
+            std::uint64_t m_frame;
+        };
+
+        // size of the free ranges, by offset
+        AZStd::map<std::size_t, std::size_t> m_freeRanges;
+
+        // in the order they were deferred, so by frame
+        AZStd::vector<DeferredFree> m_deferredFrees;
+    };
+} // namespace Cesium
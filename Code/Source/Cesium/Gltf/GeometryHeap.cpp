@@ -0,0 +1,219 @@
+#include "Cesium/Gltf/GeometryHeap.h"
+#include "Cesium/Gltf/FreeListAllocator.h"
+#include "Cesium/Math/MathHelper.h"
+#include "Cesium/Systems/CesiumSystem.h"
+#include <Atom/RPI.Public/Buffer/Buffer.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAssetCreator.h>
+#include <AzCore/std/algorithm.h>
+
+namespace Cesium
+{
+    struct GeometryHeapBlock final
+    {
+        GeometryHeapBlock(std::size_t size)
+            : m_allocator{ size, GeometryHeap::ALIGNMENT }
+        {
+        }
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> m_bufferAsset;
+
+        // created by the first upload to the block, on the main thread
+        AZ::Data::Instance<AZ::RPI::Buffer> m_buffer;
+
+        // ranges freed by allocations are deferred until NextFrame releases them
+        FreeListAllocator m_allocator;
+    };
+
+    GeometryHeapStatistics::GeometryHeapStatistics()
+        : m_blockCount{ 0 }
+        , m_capacity{ 0 }
+        , m_usedSize{ 0 }
+    {
+    }
+
+    GeometryHeapAllocation::GeometryHeapAllocation(
+        const AZStd::shared_ptr<GeometryHeap>& heap,
+        GeometryHeapBlock* block,
+        const AZ::Data::Asset<AZ::RPI::BufferAsset>& bufferAsset,
+        std::size_t offset,
+        std::size_t size)
+        : m_heap{ heap }
+        , m_block{ block }
+        , m_bufferAsset{ bufferAsset }
+        , m_offset{ offset }
+        , m_size{ size }
+    {
+    }
+
+    GeometryHeapAllocation::~GeometryHeapAllocation() noexcept
+    {
+        if (AZStd::shared_ptr<GeometryHeap> heap = m_heap.lock())
+        {
+            heap->Free(m_block, m_offset, m_size);
+        }
+    }
+
+    const AZ::Data::Asset<AZ::RPI::BufferAsset>& GeometryHeapAllocation::GetBufferAsset() const
+    {
+        return m_bufferAsset;
+    }
+
+    std::size_t GeometryHeapAllocation::GetOffset() const
+    {
+        return m_offset;
+    }
+
+    std::size_t GeometryHeapAllocation::GetSize() const
+    {
+        return m_size;
+    }
+
+    AZ::RHI::BufferViewDescriptor GeometryHeapAllocation::GetBlockBufferView(const AZ::RHI::BufferViewDescriptor& bufferView) const
+    {
+        AZ_Assert(m_offset % bufferView.m_elementSize == 0, "The allocation is not aligned to the elements of the view");
+        AZ::RHI::BufferViewDescriptor blockBufferView = bufferView;
+        blockBufferView.m_elementOffset += static_cast<std::uint32_t>(m_offset / bufferView.m_elementSize);
+        return blockBufferView;
+    }
+
+    GeometryHeap::GeometryHeap(std::size_t blockSize)
+        : m_blockSize{ MathHelper::AlignToMultiple(blockSize, ALIGNMENT) }
+        , m_frame{ 0 }
+    {
+    }
+
+    GeometryHeap::~GeometryHeap() noexcept
+    {
+    }
+
+    AZStd::shared_ptr<const GeometryHeapAllocation> GeometryHeap::Allocate(const AZStd::span<const std::byte>& data)
+    {
+        AZStd::vector<std::byte> uploadData(data.begin(), data.end());
+        GeometryHeapBlock* block = nullptr;
+        std::size_t offset = 0;
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            for (const AZStd::unique_ptr<GeometryHeapBlock>& candidate : m_blocks)
+            {
+                if (candidate->m_allocator.Allocate(data.size(), offset))
+                {
+                    block = candidate.get();
+                    break;
+                }
+            }
+
+            if (!block)
+            {
+                block = CreateBlock(AZStd::max(data.size(), m_blockSize));
+                block->m_allocator.Allocate(data.size(), offset);
+            }
+
+            m_pendingUploads.push_back(PendingUpload{ block, offset, AZStd::move(uploadData) });
+        }
+
+        return AZStd::make_shared<const GeometryHeapAllocation>(shared_from_this(), block, block->m_bufferAsset, offset, data.size());
+    }
+
+    void GeometryHeap::Upload()
+    {
+        AZStd::vector<PendingUpload> pendingUploads;
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            pendingUploads.swap(m_pendingUploads);
+        }
+
+        // blocks are only released on the main thread, and never while one of their ranges is waiting to be uploaded
+        for (const PendingUpload& upload : pendingUploads)
+        {
+            GeometryHeapBlock& block = *upload.m_block;
+            if (!block.m_buffer)
+            {
+                block.m_buffer = AZ::RPI::Buffer::FindOrCreate(block.m_bufferAsset);
+            }
+
+            if (!block.m_buffer || !block.m_buffer->UpdateData(upload.m_data.data(), upload.m_data.size(), upload.m_offset))
+            {
+                AZ_Error("GeometryHeap", false, "Failed to upload %zu bytes of geometry to the heap", upload.m_data.size());
+            }
+        }
+    }
+
+    void GeometryHeap::NextFrame()
+    {
+        Upload();
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        ++m_frame;
+        if (m_frame >= FRAME_LATENCY)
+        {
+            for (const AZStd::unique_ptr<GeometryHeapBlock>& block : m_blocks)
+            {
+                block->m_allocator.ReleaseDeferredFrees(m_frame - FRAME_LATENCY);
+            }
+        }
+
+        // one empty block of the default size is kept, so that the next tiles don't recreate it right away
+        bool isEmptyBlockKept = false;
+        auto blockEnd = AZStd::remove_if(
+            m_blocks.begin(), m_blocks.end(),
+            [this, &isEmptyBlockKept](const AZStd::unique_ptr<GeometryHeapBlock>& block)
+            {
+                if (!block->m_allocator.IsEmpty())
+                {
+                    return false;
+                }
+
+                if (!isEmptyBlockKept && block->m_allocator.GetCapacity() == m_blockSize)
+                {
+                    isEmptyBlockKept = true;
+                    return false;
+                }
+
+                return true;
+            });
+        m_blocks.erase(blockEnd, m_blocks.end());
+    }
+
+    GeometryHeapStatistics GeometryHeap::GetStatistics() const
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        GeometryHeapStatistics statistics;
+        statistics.m_blockCount = m_blocks.size();
+        for (const AZStd::unique_ptr<GeometryHeapBlock>& block : m_blocks)
+        {
+            statistics.m_capacity += block->m_allocator.GetCapacity();
+            statistics.m_usedSize += block->m_allocator.GetUsedSize();
+        }
+
+        return statistics;
+    }
+
+    void GeometryHeap::Free(GeometryHeapBlock* block, std::size_t offset, std::size_t size)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        block->m_allocator.FreeDeferred(offset, size, m_frame);
+    }
+
+    GeometryHeapBlock* GeometryHeap::CreateBlock(std::size_t size)
+    {
+        size = MathHelper::AlignToMultiple(size, ALIGNMENT);
+        AZStd::unique_ptr<GeometryHeapBlock> block = AZStd::make_unique<GeometryHeapBlock>(size);
+
+        AZ::RHI::BufferDescriptor bufferDescriptor;
+        bufferDescriptor.m_bindFlags =
+            AZ::RHI::BufferBindFlags::InputAssembly | AZ::RHI::BufferBindFlags::ShaderRead | AZ::RHI::BufferBindFlags::CopyWrite;
+        bufferDescriptor.m_byteCount = size;
+
+        // the content is written by Upload, so the asset doesn't keep a CPU copy of the block
+        AZ::RPI::BufferAssetCreator creator;
+        creator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId());
+        creator.SetBuffer(nullptr, 0, bufferDescriptor);
+        creator.SetBufferViewDescriptor(
+            AZ::RHI::BufferViewDescriptor::CreateTyped(0, static_cast<std::uint32_t>(size), AZ::RHI::Format::R8_UINT));
+        creator.SetUseCommonPool(AZ::RPI::CommonBufferPoolType::StaticInputAssembly);
+        creator.End(block->m_bufferAsset);
+
+        m_blocks.push_back(AZStd::move(block));
+        return m_blocks.back().get();
+    }
+} // namespace Cesium
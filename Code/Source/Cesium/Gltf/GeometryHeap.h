@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Atom/RHI.Reflect/BufferViewDescriptor.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/enable_shared_from_this.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/smart_ptr/weak_ptr.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    class GeometryHeap;
+
+    struct GeometryHeapBlock;
+
+    struct GeometryHeapStatistics final
+    {
+        GeometryHeapStatistics();
+
+        std::size_t m_blockCount;
+        std::size_t m_capacity;
+        std::size_t m_usedSize;
+    };
+
+    // Range of a heap block that holds the vertices and indices of a primitive. The range goes back to the heap once the last
+    // reference to the allocation is dropped. Allocations are created by GeometryHeap::Allocate
+    class GeometryHeapAllocation final
+    {
+    public:
+        GeometryHeapAllocation(
+            const AZStd::shared_ptr<GeometryHeap>& heap,
+            GeometryHeapBlock* block,
+            const AZ::Data::Asset<AZ::RPI::BufferAsset>& bufferAsset,
+            std::size_t offset,
+            std::size_t size);
+
+        GeometryHeapAllocation(const GeometryHeapAllocation&) = delete;
+
+        GeometryHeapAllocation& operator=(const GeometryHeapAllocation&) = delete;
+
+        ~GeometryHeapAllocation() noexcept;
+
+        const AZ::Data::Asset<AZ::RPI::BufferAsset>& GetBufferAsset() const;
+
+        std::size_t GetOffset() const;
+
+        std::size_t GetSize() const;
+
+        // Move a view of the data given to Allocate to where the data is in the block
+        AZ::RHI::BufferViewDescriptor GetBlockBufferView(const AZ::RHI::BufferViewDescriptor& bufferView) const;
+
+    private:
+        AZStd::weak_ptr<GeometryHeap> m_heap;
+        GeometryHeapBlock* m_block;
+        AZ::Data::Asset<AZ::RPI::BufferAsset> m_bufferAsset;
+        std::size_t m_offset;
+        std::size_t m_size;
+    };
+
+    // Large vertex and index buffers that the primitives of a tileset are sub-allocated from, so that loading a tile doesn't create
+    // a GPU buffer per primitive. Freed ranges are only reused once the frames that could still draw them are done
+    class GeometryHeap final : public AZStd::enable_shared_from_this<GeometryHeap>
+    {
+        friend class GeometryHeapAllocation;
+
+        struct PendingUpload final
+        {
+            GeometryHeapBlock* m_block;
+            std::size_t m_offset;
+            AZStd::vector<std::byte> m_data;
+        };
+
+    public:
+        GeometryHeap(std::size_t blockSize);
+
+        ~GeometryHeap() noexcept;
+
+        // Copy the data into a free range of the heap. Data larger than a block gets a block of its own. Thread safe
+        AZStd::shared_ptr<const GeometryHeapAllocation> Allocate(const AZStd::span<const std::byte>& data);
+
+        // Write the data of the new allocations to the GPU buffers. Must be called on the main thread, before the meshes that
+        // use the new allocations are acquired
+        void Upload();
+
+        // Upload, then return the ranges freed FRAME_LATENCY frames ago to the free lists. Empty blocks are released, except for
+        // one that is kept for the next tiles. Must be called on the main thread once per frame
+        void NextFrame();
+
+        GeometryHeapStatistics GetStatistics() const;
+
+        // multiple of the size of every vertex and index format, so that the views of a primitive stay aligned in the block
+        static constexpr std::size_t ALIGNMENT = 48;
+        static constexpr std::size_t DEFAULT_BLOCK_SIZE = ALIGNMENT * (std::size_t{ 1 } << 18);
+
+    private:
+        void Free(GeometryHeapBlock* block, std::size_t offset, std::size_t size);
+
+        GeometryHeapBlock* CreateBlock(std::size_t size);
+
+        // the RHI keeps up to 3 frames in flight
+        static constexpr std::uint64_t FRAME_LATENCY = 3;
+
+        mutable AZStd::mutex m_mutex;
+        std::size_t m_blockSize;
+        std::uint64_t m_frame;
+        AZStd::vector<AZStd::unique_ptr<GeometryHeapBlock>> m_blocks;
+        AZStd::vector<PendingUpload> m_pendingUploads;
+    };
+} // namespace Cesium
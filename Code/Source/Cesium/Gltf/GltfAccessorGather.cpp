@@ -0,0 +1,257 @@
+#include "Cesium/Gltf/GltfAccessorGather.h"
+#include <AzCore/std/algorithm.h>
+
+// Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
+// This only happens with unity build
+#include <AzCore/PlatformDef.h>
+#ifdef AZ_COMPILER_MSVC
+#pragma push_macro("OPAQUE")
+#undef OPAQUE
+#endif
+
+#include <CesiumGltf/Model.h>
+#include <CesiumGltf/MeshPrimitive.h>
+#include <CesiumGltf/AccessorView.h>
+
+#ifdef AZ_COMPILER_MSVC
+#pragma pop_macro("OPAQUE")
+#endif
+
+#include <type_traits>
+
+namespace Cesium
+{
+    bool GltfAccessorGather::GatherPositions(
+        const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, AZStd::vector<glm::vec3>& positions)
+    {
+        if (accessor.type != CesiumGltf::AccessorSpec::Type::VEC3)
+        {
+            return false;
+        }
+
+        switch (accessor.componentType)
+        {
+        case CesiumGltf::AccessorSpec::ComponentType::FLOAT:
+            return GatherPositions<float>(model, accessor, positions);
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
+            return GatherPositions<std::uint16_t>(model, accessor, positions);
+        case CesiumGltf::AccessorSpec::ComponentType::SHORT:
+            return GatherPositions<std::int16_t>(model, accessor, positions);
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
+            return GatherPositions<std::uint8_t>(model, accessor, positions);
+        case CesiumGltf::AccessorSpec::ComponentType::BYTE:
+            return GatherPositions<std::int8_t>(model, accessor, positions);
+        default:
+            return false;
+        }
+    }
+
+    bool GltfAccessorGather::GatherColors(
+        const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, AZStd::vector<glm::u8vec4>& colors)
+    {
+        bool isVec3 = accessor.type == CesiumGltf::AccessorSpec::Type::VEC3;
+        if (!isVec3 && accessor.type != CesiumGltf::AccessorSpec::Type::VEC4)
+        {
+            return false;
+        }
+
+        switch (accessor.componentType)
+        {
+        case CesiumGltf::AccessorSpec::ComponentType::FLOAT:
+            return isVec3 ? GatherColors<glm::vec3>(model, accessor, colors) : GatherColors<glm::vec4>(model, accessor, colors);
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
+            return isVec3 ? GatherColors<glm::u8vec3>(model, accessor, colors) : GatherColors<glm::u8vec4>(model, accessor, colors);
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
+            return isVec3 ? GatherColors<glm::u16vec3>(model, accessor, colors) : GatherColors<glm::u16vec4>(model, accessor, colors);
+        default:
+            return false;
+        }
+    }
+
+    bool GltfAccessorGather::GatherLineSegments(
+        const CesiumGltf::Model& model,
+        const CesiumGltf::MeshPrimitive& primitive,
+        std::size_t vertexCount,
+        AZStd::vector<std::uint32_t>& segments)
+    {
+        if (!IsLineMode(primitive.mode))
+        {
+            return false;
+        }
+
+        // un-indexed lines go through the vertices in order
+        AZStd::vector<std::uint32_t> indices;
+        const CesiumGltf::Accessor* indicesAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, primitive.indices);
+        if (indicesAccessor)
+        {
+            if (indicesAccessor->type != CesiumGltf::AccessorSpec::Type::SCALAR)
+            {
+                return false;
+            }
+
+            bool gathered = false;
+            switch (indicesAccessor->componentType)
+            {
+            case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
+                gathered = GatherIndices<std::uint8_t>(model, *indicesAccessor, indices);
+                break;
+            case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
+                gathered = GatherIndices<std::uint16_t>(model, *indicesAccessor, indices);
+                break;
+            case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_INT:
+                gathered = GatherIndices<std::uint32_t>(model, *indicesAccessor, indices);
+                break;
+            default:
+                break;
+            }
+
+            if (!gathered)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            indices.resize(vertexCount);
+            for (std::size_t i = 0; i < vertexCount; ++i)
+            {
+                indices[i] = static_cast<std::uint32_t>(i);
+            }
+        }
+
+        // indices that are out of range are dropped along with their segment
+        auto appendSegment = [&segments, vertexCount](std::uint32_t start, std::uint32_t end)
+        {
+            if (start < vertexCount && end < vertexCount)
+            {
+                segments.push_back(start);
+                segments.push_back(end);
+            }
+        };
+
+        segments.clear();
+        if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::LINES)
+        {
+            segments.reserve(indices.size());
+            for (std::size_t i = 0; i + 1 < indices.size(); i += 2)
+            {
+                appendSegment(indices[i], indices[i + 1]);
+            }
+        }
+        else
+        {
+            segments.reserve(indices.size() * 2);
+            for (std::size_t i = 0; i + 1 < indices.size(); ++i)
+            {
+                appendSegment(indices[i], indices[i + 1]);
+            }
+
+            if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::LINE_LOOP && indices.size() > 2)
+            {
+                appendSegment(indices.back(), indices.front());
+            }
+        }
+
+        return true;
+    }
+
+    bool GltfAccessorGather::IsLineMode(std::int32_t mode)
+    {
+        return mode == CesiumGltf::MeshPrimitive::Mode::LINES || mode == CesiumGltf::MeshPrimitive::Mode::LINE_STRIP ||
+            mode == CesiumGltf::MeshPrimitive::Mode::LINE_LOOP;
+    }
+
+    template<typename ComponentType>
+    bool GltfAccessorGather::GatherPositions(
+        const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, AZStd::vector<glm::vec3>& positions)
+    {
+        CesiumGltf::AccessorView<glm::vec<3, ComponentType>> view{ model, accessor };
+        if (view.status() != CesiumGltf::AccessorViewStatus::Valid)
+        {
+            return false;
+        }
+
+        positions.resize(static_cast<std::size_t>(view.size()));
+        for (std::int64_t i = 0; i < view.size(); ++i)
+        {
+            const glm::vec<3, ComponentType>& position = view[i];
+            positions[static_cast<std::size_t>(i)] = glm::vec3(
+                ToFloat(position.x, accessor.normalized), ToFloat(position.y, accessor.normalized),
+                ToFloat(position.z, accessor.normalized));
+        }
+
+        return true;
+    }
+
+    template<typename ColorType>
+    bool GltfAccessorGather::GatherColors(
+        const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, AZStd::vector<glm::u8vec4>& colors)
+    {
+        using ComponentType = typename ColorType::value_type;
+
+        CesiumGltf::AccessorView<ColorType> view{ model, accessor };
+        if (view.status() != CesiumGltf::AccessorViewStatus::Valid)
+        {
+            return false;
+        }
+
+        colors.resize(static_cast<std::size_t>(view.size()));
+        for (std::int64_t i = 0; i < view.size(); ++i)
+        {
+            const ColorType& color = view[i];
+            glm::u8vec4 packedColor{ 255 };
+            for (glm::length_t component = 0; component < ColorType::length(); ++component)
+            {
+                if constexpr (std::is_same_v<ComponentType, std::uint8_t>)
+                {
+                    packedColor[component] = color[component];
+                }
+                else
+                {
+                    packedColor[component] = ToUnorm<std::uint8_t>(ToFloat(color[component], true));
+                }
+            }
+
+            colors[static_cast<std::size_t>(i)] = packedColor;
+        }
+
+        return true;
+    }
+
+    template<typename IndexType>
+    bool GltfAccessorGather::GatherIndices(
+        const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, AZStd::vector<std::uint32_t>& indices)
+    {
+        CesiumGltf::AccessorView<IndexType> view{ model, accessor };
+        if (view.status() != CesiumGltf::AccessorViewStatus::Valid)
+        {
+            return false;
+        }
+
+        indices.resize(static_cast<std::size_t>(view.size()));
+        for (std::int64_t i = 0; i < view.size(); ++i)
+        {
+            indices[static_cast<std::size_t>(i)] = static_cast<std::uint32_t>(view[i]);
+        }
+
+        return true;
+    }
+
+    template<typename ComponentType>
+    float GltfAccessorGather::ToFloat(ComponentType value, bool normalized)
+    {
+        if constexpr (std::is_floating_point_v<ComponentType>)
+        {
+            return static_cast<float>(value);
+        }
+        else
+        {
+            if (!normalized)
+            {
+                return static_cast<float>(value);
+            }
+
+            return AZStd::max(static_cast<float>(value) / static_cast<float>(std::numeric_limits<ComponentType>::max()), -1.0f);
+        }
+    }
+} // namespace Cesium
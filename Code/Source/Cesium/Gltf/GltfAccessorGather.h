@@ -0,0 +1,67 @@
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <cstdint>
+#include <limits>
+
+namespace CesiumGltf
+{
+    struct Model;
+    struct Accessor;
+    struct MeshPrimitive;
+} // namespace CesiumGltf
+
+namespace Cesium
+{
+    // Read accessors of any component type into the element types used by the point and line builders. Normalized integers are
+    // converted following the glTF rules, so quantized attributes of KHR_mesh_quantization can be read like float ones
+    struct GltfAccessorGather
+    {
+    public:
+        // Read VEC3 positions. Return false if the accessor cannot be read
+        static bool GatherPositions(
+            const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, AZStd::vector<glm::vec3>& positions);
+
+        // Read VEC3 or VEC4 colors, either float or normalized unsigned, as RGBA8. Colors without alpha are opaque.
+        // Return false if the accessor cannot be read
+        static bool GatherColors(const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, AZStd::vector<glm::u8vec4>& colors);
+
+        // Convert the vertices of a LINES, LINE_STRIP or LINE_LOOP primitive into a list of segments, two indices per segment.
+        // Return false if the primitive is not made of lines or its indices cannot be read
+        static bool GatherLineSegments(
+            const CesiumGltf::Model& model,
+            const CesiumGltf::MeshPrimitive& primitive,
+            std::size_t vertexCount,
+            AZStd::vector<std::uint32_t>& segments);
+
+        static bool IsLineMode(std::int32_t mode);
+
+        // Convert a value in [0, 1] to an unsigned normalized integer
+        template<typename UnormType>
+        static UnormType ToUnorm(float value);
+
+    private:
+        template<typename ComponentType>
+        static bool GatherPositions(
+            const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, AZStd::vector<glm::vec3>& positions);
+
+        template<typename ColorType>
+        static bool GatherColors(const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, AZStd::vector<glm::u8vec4>& colors);
+
+        template<typename IndexType>
+        static bool GatherIndices(
+            const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, AZStd::vector<std::uint32_t>& indices);
+
+        template<typename ComponentType>
+        static float ToFloat(ComponentType value, bool normalized);
+    };
+
+    template<typename UnormType>
+    UnormType GltfAccessorGather::ToUnorm(float value)
+    {
+        float maximum = static_cast<float>(std::numeric_limits<UnormType>::max());
+        return static_cast<UnormType>(glm::clamp(value, 0.0f, 1.0f) * maximum + 0.5f);
+    }
+} // namespace Cesium
@@ -0,0 +1,226 @@
+#include "Cesium/Gltf/GltfBakedModelAsset.h"
+#include <AzCore/Serialization/SerializeContext.h>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace Cesium
+{
+    namespace
+    {
+        void AppendMatrix(const glm::dmat4& matrix, AZStd::vector<double>& values)
+        {
+            const double* begin = glm::value_ptr(matrix);
+            values.insert(values.end(), begin, begin + 16);
+        }
+
+        glm::dmat4 ReadMatrix(const AZStd::vector<double>& values, std::size_t offset)
+        {
+            return glm::make_mat4(values.data() + offset);
+        }
+    } // namespace
+
+    void GltfBakedVertexAttribute::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<GltfBakedVertexAttribute>()
+                ->Version(0)
+                ->Field("name", &GltfBakedVertexAttribute::m_name)
+                ->Field("shaderSemanticName", &GltfBakedVertexAttribute::m_shaderSemanticName)
+                ->Field("shaderSemanticIndex", &GltfBakedVertexAttribute::m_shaderSemanticIndex)
+                ->Field("shaderAttributeName", &GltfBakedVertexAttribute::m_shaderAttributeName)
+                ->Field("format", &GltfBakedVertexAttribute::m_format);
+        }
+    }
+
+    GltfBakedVertexAttribute::GltfBakedVertexAttribute()
+        : m_shaderSemanticIndex{ 0 }
+        , m_format{ static_cast<AZ::u32>(AZ::RHI::Format::Unknown) }
+    {
+    }
+
+    void GltfBakedShaderBuffer::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<GltfBakedShaderBuffer>()
+                ->Version(0)
+                ->Field("shaderInputName", &GltfBakedShaderBuffer::m_shaderInputName)
+                ->Field("bufferAsset", &GltfBakedShaderBuffer::m_bufferAsset);
+        }
+    }
+
+    GltfBakedShaderBuffer::GltfBakedShaderBuffer()
+    {
+    }
+
+    void GltfBakedMaterial::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<GltfBakedMaterial>()
+                ->Version(1)
+                ->Field("materialAsset", &GltfBakedMaterial::m_materialAsset)
+                ->Field("customVertexAttributes", &GltfBakedMaterial::m_customVertexAttributes)
+                ->Field("shaderBuffers", &GltfBakedMaterial::m_shaderBuffers)
+                ->Field("needTangents", &GltfBakedMaterial::m_needTangents);
+        }
+    }
+
+    GltfBakedMaterial::GltfBakedMaterial()
+        : m_needTangents{ false }
+    {
+    }
+
+    void GltfBakedPrimitive::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<GltfBakedPrimitive>()
+                ->Version(0)
+                ->Field("modelAsset", &GltfBakedPrimitive::m_modelAsset)
+                ->Field("materialId", &GltfBakedPrimitive::m_materialId);
+        }
+    }
+
+    GltfBakedPrimitive::GltfBakedPrimitive()
+        : m_materialId{ -1 }
+    {
+    }
+
+    void GltfBakedMesh::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<GltfBakedMesh>()
+                ->Version(0)
+                ->Field("primitives", &GltfBakedMesh::m_primitives)
+                ->Field("transform", &GltfBakedMesh::m_transform)
+                ->Field("instanceTransforms", &GltfBakedMesh::m_instanceTransforms);
+        }
+    }
+
+    GltfBakedMesh::GltfBakedMesh()
+    {
+    }
+
+    void GltfBakedModelAsset::Reflect(AZ::ReflectContext* context)
+    {
+        GltfBakedVertexAttribute::Reflect(context);
+        GltfBakedShaderBuffer::Reflect(context);
+        GltfBakedMaterial::Reflect(context);
+        GltfBakedPrimitive::Reflect(context);
+        GltfBakedMesh::Reflect(context);
+        if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<GltfBakedModelAsset, AZ::Data::AssetData>()
+                ->Version(0)
+                ->Field("materials", &GltfBakedModelAsset::m_materials)
+                ->Field("meshes", &GltfBakedModelAsset::m_meshes);
+        }
+    }
+
+    AZStd::string GltfBakedModelAsset::GetProductPath(const AZStd::string& sourcePath)
+    {
+        return AZStd::string::format("%s.%s", sourcePath.c_str(), EXTENSION);
+    }
+
+    void GltfBakedModelAsset::SetLoadModel(const GltfLoadModel& loadModel)
+    {
+        // the referenced assets are preloaded, so that the whole model is ready once this asset is
+        m_materials.clear();
+        m_materials.reserve(loadModel.m_materials.size());
+        for (const GltfLoadMaterial& loadMaterial : loadModel.m_materials)
+        {
+            GltfBakedMaterial& material = m_materials.emplace_back();
+            material.m_materialAsset = loadMaterial.m_materialAsset;
+            material.m_materialAsset.SetAutoLoadBehavior(AZ::Data::AssetLoadBehavior::PreLoad);
+            material.m_needTangents = loadMaterial.m_needTangents;
+            for (const auto& [name, customAttribute] : loadMaterial.m_customVertexAttributes)
+            {
+                GltfBakedVertexAttribute& attribute = material.m_customVertexAttributes.emplace_back();
+                attribute.m_name = name;
+                attribute.m_shaderSemanticName = customAttribute.m_shaderSemantic.m_name;
+                attribute.m_shaderSemanticIndex = customAttribute.m_shaderSemantic.m_index;
+                attribute.m_shaderAttributeName = customAttribute.m_shaderAttributeName;
+                attribute.m_format = static_cast<AZ::u32>(customAttribute.m_format);
+            }
+
+            for (const GltfShaderBuffer& loadShaderBuffer : loadMaterial.m_shaderBuffers)
+            {
+                GltfBakedShaderBuffer& shaderBuffer = material.m_shaderBuffers.emplace_back();
+                shaderBuffer.m_shaderInputName = loadShaderBuffer.m_shaderInputName;
+                shaderBuffer.m_bufferAsset = loadShaderBuffer.m_bufferAsset;
+                shaderBuffer.m_bufferAsset.SetAutoLoadBehavior(AZ::Data::AssetLoadBehavior::PreLoad);
+            }
+        }
+
+        m_meshes.clear();
+        m_meshes.reserve(loadModel.m_meshes.size());
+        for (const GltfLoadMesh& loadMesh : loadModel.m_meshes)
+        {
+            GltfBakedMesh& mesh = m_meshes.emplace_back();
+            AppendMatrix(loadMesh.m_transform, mesh.m_transform);
+            for (const glm::dmat4& instanceTransform : loadMesh.m_instanceTransforms)
+            {
+                AppendMatrix(instanceTransform, mesh.m_instanceTransforms);
+            }
+
+            mesh.m_primitives.reserve(loadMesh.m_primitives.size());
+            for (const GltfLoadPrimitive& loadPrimitive : loadMesh.m_primitives)
+            {
+                GltfBakedPrimitive& primitive = mesh.m_primitives.emplace_back();
+                primitive.m_modelAsset = loadPrimitive.m_modelAsset;
+                primitive.m_modelAsset.SetAutoLoadBehavior(AZ::Data::AssetLoadBehavior::PreLoad);
+                primitive.m_materialId = loadPrimitive.m_materialId;
+            }
+        }
+    }
+
+    void GltfBakedModelAsset::CreateLoadModel(GltfLoadModel& loadModel) const
+    {
+        loadModel.m_materials.reserve(loadModel.m_materials.size() + m_materials.size());
+        for (const GltfBakedMaterial& material : m_materials)
+        {
+            GltfLoadMaterial& loadMaterial = loadModel.m_materials.emplace_back(
+                AZ::Data::Asset<AZ::RPI::MaterialAsset>(material.m_materialAsset), material.m_needTangents);
+            for (const GltfBakedVertexAttribute& attribute : material.m_customVertexAttributes)
+            {
+                loadMaterial.m_customVertexAttributes.insert_or_assign(
+                    attribute.m_name,
+                    GltfShaderVertexAttribute(
+                        AZ::RHI::ShaderSemantic(attribute.m_shaderSemanticName, attribute.m_shaderSemanticIndex),
+                        attribute.m_shaderAttributeName,
+                        static_cast<AZ::RHI::Format>(attribute.m_format)));
+            }
+
+            for (const GltfBakedShaderBuffer& shaderBuffer : material.m_shaderBuffers)
+            {
+                loadMaterial.m_shaderBuffers.emplace_back(
+                    shaderBuffer.m_shaderInputName, AZ::Data::Asset<AZ::RPI::BufferAsset>(shaderBuffer.m_bufferAsset));
+            }
+        }
+
+        loadModel.m_meshes.reserve(loadModel.m_meshes.size() + m_meshes.size());
+        for (const GltfBakedMesh& mesh : m_meshes)
+        {
+            if (mesh.m_transform.size() != 16 || mesh.m_instanceTransforms.size() % 16 != 0)
+            {
+                continue;
+            }
+
+            AZStd::vector<GltfLoadPrimitive> primitives;
+            primitives.reserve(mesh.m_primitives.size());
+            for (const GltfBakedPrimitive& primitive : mesh.m_primitives)
+            {
+                primitives.emplace_back(AZ::Data::Asset<AZ::RPI::ModelAsset>(primitive.m_modelAsset), primitive.m_materialId);
+            }
+
+            GltfLoadMesh& loadMesh = loadModel.m_meshes.emplace_back(AZStd::move(primitives), ReadMatrix(mesh.m_transform, 0));
+            loadMesh.m_instanceTransforms.reserve(mesh.m_instanceTransforms.size() / 16);
+            for (std::size_t i = 0; i < mesh.m_instanceTransforms.size(); i += 16)
+            {
+                loadMesh.m_instanceTransforms.emplace_back(ReadMatrix(mesh.m_instanceTransforms, i));
+            }
+        }
+    }
+} // namespace Cesium
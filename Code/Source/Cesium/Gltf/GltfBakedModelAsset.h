@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Cesium/Gltf/GltfLoadContext.h"
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
+#include <Atom/RPI.Reflect/Material/MaterialAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/Name/Name.h>
+#include <AzCore/RTTI/RTTI.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/string/string.h>
+#include <cstdint>
+
+namespace AZ
+{
+    class ReflectContext;
+}
+
+namespace Cesium
+{
+    struct GltfBakedVertexAttribute final
+    {
+        AZ_RTTI(GltfBakedVertexAttribute, "{0E6B3C52-7A1D-4F8E-9B24-5C7D1A3E8F60}");
+        AZ_CLASS_ALLOCATOR(GltfBakedVertexAttribute, AZ::SystemAllocator, 0);
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        GltfBakedVertexAttribute();
+
+        AZStd::string m_name;
+        AZ::Name m_shaderSemanticName;
+        AZ::u32 m_shaderSemanticIndex;
+        AZ::Name m_shaderAttributeName;
+        AZ::u32 m_format;
+    };
+
+    struct GltfBakedShaderBuffer final
+    {
+        AZ_RTTI(GltfBakedShaderBuffer, "{D85A5011-04DE-4907-A754-39F338B5B8A9}");
+        AZ_CLASS_ALLOCATOR(GltfBakedShaderBuffer, AZ::SystemAllocator, 0);
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        GltfBakedShaderBuffer();
+
+        AZ::Name m_shaderInputName;
+        AZ::Data::Asset<AZ::RPI::BufferAsset> m_bufferAsset;
+    };
+
+    struct GltfBakedMaterial final
+    {
+        AZ_RTTI(GltfBakedMaterial, "{7C2E9A41-3B5F-4D06-8E1A-2F9B6C4D7E13}");
+        AZ_CLASS_ALLOCATOR(GltfBakedMaterial, AZ::SystemAllocator, 0);
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        GltfBakedMaterial();
+
+        AZ::Data::Asset<AZ::RPI::MaterialAsset> m_materialAsset;
+        AZStd::vector<GltfBakedVertexAttribute> m_customVertexAttributes;
+        AZStd::vector<GltfBakedShaderBuffer> m_shaderBuffers;
+        bool m_needTangents;
+    };
+
+    struct GltfBakedPrimitive final
+    {
+        AZ_RTTI(GltfBakedPrimitive, "{B83D5F16-2C9E-4A7B-91D4-6E0A3F8C5B27}");
+        AZ_CLASS_ALLOCATOR(GltfBakedPrimitive, AZ::SystemAllocator, 0);
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        GltfBakedPrimitive();
+
+        AZ::Data::Asset<AZ::RPI::ModelAsset> m_modelAsset;
+        std::int32_t m_materialId;
+    };
+
+    struct GltfBakedMesh final
+    {
+        AZ_RTTI(GltfBakedMesh, "{4F1A8D3C-6E2B-47C9-A05D-9B3E7C1F2A84}");
+        AZ_CLASS_ALLOCATOR(GltfBakedMesh, AZ::SystemAllocator, 0);
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        GltfBakedMesh();
+
+        AZStd::vector<GltfBakedPrimitive> m_primitives;
+
+        // column major matrices. The instance transforms are stored one after another
+        AZStd::vector<double> m_transform;
+        AZStd::vector<double> m_instanceTransforms;
+    };
+
+    // Product that the glTF asset builder bakes from a glTF file. It references the model, material and image assets that the
+    // builder wrote next to it, so that the file can be displayed without being converted at runtime
+    class GltfBakedModelAsset final : public AZ::Data::AssetData
+    {
+    public:
+        AZ_RTTI(GltfBakedModelAsset, "{D5E2A7C9-1F4B-4E83-B6A0-3C8D9F2E5A71}", AZ::Data::AssetData);
+        AZ_CLASS_ALLOCATOR(GltfBakedModelAsset, AZ::SystemAllocator, 0);
+
+        static constexpr const char* const DISPLAY_NAME = "Cesium glTF Model";
+        static constexpr const char* const GROUP = "Cesium";
+        static constexpr const char* const EXTENSION = "cesiumgltf";
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        // Path of the product baked from a glTF file. The products are placed next to the source in the cache
+        static AZStd::string GetProductPath(const AZStd::string& sourcePath);
+
+        void SetLoadModel(const GltfLoadModel& loadModel);
+
+        void CreateLoadModel(GltfLoadModel& loadModel) const;
+
+        AZStd::vector<GltfBakedMaterial> m_materials;
+        AZStd::vector<GltfBakedMesh> m_meshes;
+    };
+} // namespace Cesium
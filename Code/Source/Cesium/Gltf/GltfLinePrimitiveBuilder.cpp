@@ -0,0 +1,314 @@
+#include "Cesium/Gltf/GltfLinePrimitiveBuilder.h"
+#include "Cesium/Gltf/GltfAccessorGather.h"
+#include "Cesium/Systems/CesiumSystem.h"
+#include "Cesium/Systems/CriticalAssetManager.h"
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAsset.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAssetCreator.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAssetCreator.h>
+#include <Atom/RPI.Reflect/Model/ModelAssetCreator.h>
+#include <Atom/RPI.Reflect/Material/MaterialAssetCreator.h>
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/algorithm.h>
+
+// Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
+// This only happens with unity build
+#include <AzCore/PlatformDef.h>
+#ifdef AZ_COMPILER_MSVC
+#pragma push_macro("OPAQUE")
+#undef OPAQUE
+#endif
+
+#include <CesiumGltf/Model.h>
+#include <CesiumGltf/MeshPrimitive.h>
+#include <CesiumGltf/Material.h>
+
+#ifdef AZ_COMPILER_MSVC
+#pragma pop_macro("OPAQUE")
+#endif
+
+#include <limits>
+
+namespace Cesium
+{
+    static_assert(sizeof(GltfLinePrimitiveBuilder::SegmentRecord) == 24, "SegmentRecord must match the records read by the shader");
+
+    GltfLinePrimitiveBuilderOption::GltfLinePrimitiveBuilderOption()
+        : m_lineWidth{ 1.0f }
+    {
+    }
+
+    GltfLinePrimitiveBuilder::GltfLinePrimitiveBuilder()
+        : GltfLinePrimitiveBuilder(GltfLinePrimitiveBuilderOption{})
+    {
+    }
+
+    GltfLinePrimitiveBuilder::GltfLinePrimitiveBuilder(const GltfLinePrimitiveBuilderOption& option)
+        : m_option{ option }
+        , m_segmentCount{ 0 }
+        , m_minimum{ 0.0f }
+        , m_extent{ 0.0f }
+        , m_indexFormat{ AZ::RHI::Format::R16_UINT }
+    {
+    }
+
+    void GltfLinePrimitiveBuilder::Create(
+        const CesiumGltf::Model& model,
+        const CesiumGltf::MeshPrimitive& primitive,
+        AZStd::vector<GltfLoadMaterial>& materials,
+        GltfLoadPrimitive& result)
+    {
+        Reset();
+
+        auto positionAttribute = primitive.attributes.find("POSITION");
+        if (positionAttribute == primitive.attributes.end())
+        {
+            return;
+        }
+
+        const CesiumGltf::Accessor* positionAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, positionAttribute->second);
+        if (!positionAccessor)
+        {
+            return;
+        }
+
+        AZStd::vector<glm::vec3> positions;
+        AZStd::vector<std::uint32_t> segments;
+        if (!GltfAccessorGather::GatherPositions(model, *positionAccessor, positions) ||
+            !GltfAccessorGather::GatherLineSegments(model, primitive, positions.size(), segments) || segments.empty())
+        {
+            return;
+        }
+
+        AZStd::vector<glm::u8vec4> colors;
+        auto colorAttribute = primitive.attributes.find("COLOR_0");
+        if (colorAttribute != primitive.attributes.end())
+        {
+            const CesiumGltf::Accessor* colorAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, colorAttribute->second);
+            if (!colorAccessor || !GltfAccessorGather::GatherColors(model, *colorAccessor, colors) || colors.size() != positions.size())
+            {
+                colors.clear();
+            }
+        }
+
+        // segments without colors are white
+        m_segmentCount = segments.size() / 2;
+        m_records.resize(m_segmentCount, SegmentRecord{ glm::u16vec4{ 0 }, glm::u16vec4{ 0 }, glm::u8vec4{ 255 }, glm::u8vec4{ 255 } });
+        CreatePositionsAttributes(positions, segments);
+        CreateColorsAttribute(colors, segments);
+        if (m_segmentCount <= MAX_SEGMENTS_PER_CHUNK)
+        {
+            CreateIndices<std::uint16_t>();
+        }
+        else
+        {
+            CreateIndices<std::uint32_t>();
+        }
+
+        AZ::RPI::ModelAssetCreator modelCreator;
+        modelCreator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId());
+        modelCreator.AddLodAsset(CreateLodAsset(CreateIndexBufferAsset()));
+
+        AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset;
+        modelCreator.End(modelAsset);
+
+        result.m_modelAsset = std::move(modelAsset);
+        result.m_materialId = static_cast<MaterialId>(materials.size());
+        GltfLoadMaterial& material = materials.emplace_back(CreateMaterial(GetMaterialColor(model, primitive)));
+        material.m_shaderBuffers.emplace_back(AZ::Name("m_segments"), CreateRecordsBufferAsset());
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelLodAsset> GltfLinePrimitiveBuilder::CreateLodAsset(
+        const AZ::Data::Asset<AZ::RPI::BufferAsset>& indexBufferAsset)
+    {
+        AZ::RPI::ModelLodAssetCreator lodCreator;
+        lodCreator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId());
+        lodCreator.AddLodStreamBuffer(indexBufferAsset);
+
+        // every chunk is a mesh of the LOD that draws its range of the indices. The meshes have no vertex streams, since the shader
+        // reads the records of the segments from the material
+        for (std::size_t chunk = 0; chunk < m_chunkAabbs.size(); ++chunk)
+        {
+            std::size_t firstSegment = chunk * MAX_SEGMENTS_PER_CHUNK;
+            std::size_t segmentCount = AZStd::min(MAX_SEGMENTS_PER_CHUNK, m_segmentCount - firstSegment);
+            AZ::RHI::BufferViewDescriptor indicesBufferView = AZ::RHI::BufferViewDescriptor::CreateTyped(
+                static_cast<std::uint32_t>(firstSegment * INDICES_PER_SEGMENT),
+                static_cast<std::uint32_t>(segmentCount * INDICES_PER_SEGMENT), m_indexFormat);
+
+            lodCreator.BeginMesh();
+            lodCreator.SetMeshIndexBuffer(AZ::RPI::BufferAssetView(indexBufferAsset, indicesBufferView));
+            lodCreator.SetMeshAabb(AZ::Aabb(m_chunkAabbs[chunk]));
+            lodCreator.EndMesh();
+        }
+
+        AZ::Data::Asset<AZ::RPI::ModelLodAsset> lodAsset;
+        lodCreator.End(lodAsset);
+        return lodAsset;
+    }
+
+    void GltfLinePrimitiveBuilder::CreatePositionsAttributes(
+        const AZStd::vector<glm::vec3>& positions, const AZStd::vector<std::uint32_t>& segments)
+    {
+        // only the vertices used by a segment are part of the bounding box
+        glm::vec3 minimum{ std::numeric_limits<float>::max() };
+        glm::vec3 maximum{ std::numeric_limits<float>::lowest() };
+        for (std::uint32_t index : segments)
+        {
+            minimum = glm::min(minimum, positions[index]);
+            maximum = glm::max(maximum, positions[index]);
+        }
+
+        m_minimum = minimum;
+        m_extent = maximum - minimum;
+        glm::vec3 quantizationScale{ 0.0f };
+        for (glm::length_t axis = 0; axis < 3; ++axis)
+        {
+            if (m_extent[axis] > 0.0f)
+            {
+                quantizationScale[axis] = 1.0f / m_extent[axis];
+            }
+        }
+
+        auto quantize = [this, &quantizationScale](const glm::vec3& position)
+        {
+            glm::vec3 normalizedPosition = (position - m_minimum) * quantizationScale;
+            return glm::u16vec4{ GltfAccessorGather::ToUnorm<std::uint16_t>(normalizedPosition.x),
+                                 GltfAccessorGather::ToUnorm<std::uint16_t>(normalizedPosition.y),
+                                 GltfAccessorGather::ToUnorm<std::uint16_t>(normalizedPosition.z), 0 };
+        };
+
+        // the ribbon extends half the width around the segment, and as much past its ends
+        AZ::Vector3 halfWidth{ 0.5f * m_option.m_lineWidth };
+
+        m_chunkAabbs.resize((m_segmentCount + MAX_SEGMENTS_PER_CHUNK - 1) / MAX_SEGMENTS_PER_CHUNK, AZ::Aabb::CreateNull());
+        for (std::size_t i = 0; i < m_segmentCount; ++i)
+        {
+            const glm::vec3& start = positions[segments[i * 2]];
+            const glm::vec3& end = positions[segments[i * 2 + 1]];
+            m_records[i].m_start = quantize(start);
+            m_records[i].m_end = quantize(end);
+
+            AZ::Aabb& chunkAabb = m_chunkAabbs[i / MAX_SEGMENTS_PER_CHUNK];
+            AZ::Vector3 startPoint{ start.x, start.y, start.z };
+            AZ::Vector3 endPoint{ end.x, end.y, end.z };
+            chunkAabb.AddAabb(AZ::Aabb::CreateFromMinMax(startPoint - halfWidth, startPoint + halfWidth));
+            chunkAabb.AddAabb(AZ::Aabb::CreateFromMinMax(endPoint - halfWidth, endPoint + halfWidth));
+        }
+    }
+
+    void GltfLinePrimitiveBuilder::CreateColorsAttribute(
+        const AZStd::vector<glm::u8vec4>& colors, const AZStd::vector<std::uint32_t>& segments)
+    {
+        if (colors.empty())
+        {
+            return;
+        }
+
+        for (std::size_t i = 0; i < m_segmentCount; ++i)
+        {
+            m_records[i].m_startColor = colors[segments[i * 2]];
+            m_records[i].m_endColor = colors[segments[i * 2 + 1]];
+        }
+    }
+
+    template<typename IndexType>
+    void GltfLinePrimitiveBuilder::CreateIndices()
+    {
+        m_indexFormat = sizeof(IndexType) == sizeof(std::uint16_t) ? AZ::RHI::Format::R16_UINT : AZ::RHI::Format::R32_UINT;
+        m_indices.resize(m_segmentCount * INDICES_PER_SEGMENT * sizeof(IndexType));
+
+        // the first two corners of a quad are at the start of the segment and the last two at its end, one on each side of the line
+        IndexType* indices = reinterpret_cast<IndexType*>(m_indices.data());
+        for (std::size_t i = 0; i < m_segmentCount; ++i)
+        {
+            IndexType first = static_cast<IndexType>(i * VERTICES_PER_SEGMENT);
+            IndexType* segmentIndices = indices + i * INDICES_PER_SEGMENT;
+            segmentIndices[0] = first;
+            segmentIndices[1] = static_cast<IndexType>(first + 1);
+            segmentIndices[2] = static_cast<IndexType>(first + 2);
+            segmentIndices[3] = static_cast<IndexType>(first + 2);
+            segmentIndices[4] = static_cast<IndexType>(first + 1);
+            segmentIndices[5] = static_cast<IndexType>(first + 3);
+        }
+    }
+
+    AZ::Data::Asset<AZ::RPI::BufferAsset> GltfLinePrimitiveBuilder::CreateRecordsBufferAsset() const
+    {
+        AZ::RHI::BufferViewDescriptor bufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateStructured(
+            0, static_cast<std::uint32_t>(m_records.size()), static_cast<std::uint32_t>(sizeof(SegmentRecord)));
+
+        AZ::RHI::BufferDescriptor bufferDescriptor;
+        bufferDescriptor.m_bindFlags = AZ::RHI::BufferBindFlags::ShaderRead;
+        bufferDescriptor.m_byteCount = m_records.size() * sizeof(SegmentRecord);
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> bufferAsset;
+        AZ::RPI::BufferAssetCreator creator;
+        creator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId());
+        creator.SetBuffer(m_records.data(), bufferDescriptor.m_byteCount, bufferDescriptor);
+        creator.SetBufferViewDescriptor(bufferViewDescriptor);
+        creator.SetUseCommonPool(AZ::RPI::CommonBufferPoolType::ReadOnly);
+        creator.End(bufferAsset);
+        return bufferAsset;
+    }
+
+    AZ::Data::Asset<AZ::RPI::BufferAsset> GltfLinePrimitiveBuilder::CreateIndexBufferAsset() const
+    {
+        AZ::RHI::BufferViewDescriptor bufferViewDescriptor =
+            AZ::RHI::BufferViewDescriptor::CreateTyped(0, static_cast<std::uint32_t>(m_indices.size()), AZ::RHI::Format::R8_UINT);
+
+        AZ::RHI::BufferDescriptor bufferDescriptor;
+        bufferDescriptor.m_bindFlags = AZ::RHI::BufferBindFlags::InputAssembly | AZ::RHI::BufferBindFlags::ShaderRead;
+        bufferDescriptor.m_byteCount = m_indices.size();
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> bufferAsset;
+        AZ::RPI::BufferAssetCreator creator;
+        creator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId());
+        creator.SetBuffer(m_indices.data(), bufferDescriptor.m_byteCount, bufferDescriptor);
+        creator.SetBufferViewDescriptor(bufferViewDescriptor);
+        creator.SetUseCommonPool(AZ::RPI::CommonBufferPoolType::StaticInputAssembly);
+        creator.End(bufferAsset);
+        return bufferAsset;
+    }
+
+    GltfLoadMaterial GltfLinePrimitiveBuilder::CreateMaterial(const AZ::Color& color) const
+    {
+        AZ::RPI::MaterialAssetCreator materialCreator;
+        materialCreator.Begin(
+            CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId(),
+            CesiumInterface::Get()->GetCriticalAssetManager().m_lineMaterialType, true);
+        materialCreator.SetPropertyValue(AZ::Name("line.positionOffset"), AZ::Vector3(m_minimum.x, m_minimum.y, m_minimum.z));
+        materialCreator.SetPropertyValue(AZ::Name("line.positionScale"), AZ::Vector3(m_extent.x, m_extent.y, m_extent.z));
+        materialCreator.SetPropertyValue(AZ::Name("line.width"), m_option.m_lineWidth);
+        materialCreator.SetPropertyValue(AZ::Name("line.color"), color);
+
+        AZ::Data::Asset<AZ::RPI::MaterialAsset> materialAsset;
+        materialCreator.End(materialAsset);
+        return GltfLoadMaterial(std::move(materialAsset), false);
+    }
+
+    void GltfLinePrimitiveBuilder::Reset()
+    {
+        m_segmentCount = 0;
+        m_minimum = glm::vec3{ 0.0f };
+        m_extent = glm::vec3{ 0.0f };
+        m_chunkAabbs.clear();
+        m_indexFormat = AZ::RHI::Format::R16_UINT;
+        m_records.clear();
+        m_indices.clear();
+    }
+
+    AZ::Color GltfLinePrimitiveBuilder::GetMaterialColor(const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive)
+    {
+        const CesiumGltf::Material* material = model.getSafe<CesiumGltf::Material>(&model.materials, primitive.material);
+        if (!material || !material->pbrMetallicRoughness || material->pbrMetallicRoughness->baseColorFactor.size() != 4)
+        {
+            return AZ::Color::CreateOne();
+        }
+
+        const std::vector<double>& baseColorFactor = material->pbrMetallicRoughness->baseColorFactor;
+        return AZ::Color(
+            static_cast<float>(baseColorFactor[0]), static_cast<float>(baseColorFactor[1]), static_cast<float>(baseColorFactor[2]),
+            static_cast<float>(baseColorFactor[3]));
+    }
+} // namespace Cesium
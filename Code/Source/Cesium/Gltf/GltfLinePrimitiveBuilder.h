@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Cesium/Gltf/GltfLoadContext.h"
+#include <Atom/RHI.Reflect/Format.h>
+#include <AzCore/Math/Aabb.h>
+#include <AzCore/Math/Color.h>
+#include <AzCore/std/containers/vector.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumGltf
+{
+    struct Model;
+    struct MeshPrimitive;
+} // namespace CesiumGltf
+
+namespace AZ
+{
+    namespace RPI
+    {
+        class ModelLodAsset;
+        class BufferAsset;
+    } // namespace RPI
+
+    namespace Data
+    {
+        template<typename T>
+        class Asset;
+    }
+} // namespace AZ
+
+namespace Cesium
+{
+    struct GltfLinePrimitiveBuilderOption final
+    {
+        GltfLinePrimitiveBuilderOption();
+
+        // Width of the lines in meters
+        float m_lineWidth;
+    };
+
+    // Build LINES, LINE_STRIP and LINE_LOOP primitives. Every segment is stored once, as a record of a structured buffer that the
+    // shader reads. Atom only draws indexed triangle lists, so every segment is drawn as a quad of four vertices: the vertex id
+    // divided by 4 is the segment, and its remainder is the corner of the camera facing ribbon. Like points, the end points of the
+    // segments are quantized to 16 bits in the bounding box of the primitive, and colors are RGBA8
+    class GltfLinePrimitiveBuilder final
+    {
+    public:
+        // Layout of the records, which has to match SegmentRecord in GltfLine_Common.azsli
+        struct SegmentRecord final
+        {
+            glm::u16vec4 m_start;
+            glm::u16vec4 m_end;
+            glm::u8vec4 m_startColor;
+            glm::u8vec4 m_endColor;
+        };
+
+        GltfLinePrimitiveBuilder();
+
+        GltfLinePrimitiveBuilder(const GltfLinePrimitiveBuilderOption& option);
+
+        // The dequantization of the positions and the records of the segments are bound to the material, so the primitive gets its
+        // own material, which is appended to materials. The color of the glTF material tints the lines
+        void Create(
+            const CesiumGltf::Model& model,
+            const CesiumGltf::MeshPrimitive& primitive,
+            AZStd::vector<GltfLoadMaterial>& materials,
+            GltfLoadPrimitive& result);
+
+    private:
+        AZ::Data::Asset<AZ::RPI::ModelLodAsset> CreateLodAsset(const AZ::Data::Asset<AZ::RPI::BufferAsset>& indexBufferAsset);
+
+        void CreatePositionsAttributes(const AZStd::vector<glm::vec3>& positions, const AZStd::vector<std::uint32_t>& segments);
+
+        void CreateColorsAttribute(const AZStd::vector<glm::u8vec4>& colors, const AZStd::vector<std::uint32_t>& segments);
+
+        template<typename IndexType>
+        void CreateIndices();
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> CreateRecordsBufferAsset() const;
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> CreateIndexBufferAsset() const;
+
+        GltfLoadMaterial CreateMaterial(const AZ::Color& color) const;
+
+        void Reset();
+
+        static AZ::Color GetMaterialColor(const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive);
+
+        static constexpr std::size_t VERTICES_PER_SEGMENT = 4;
+        static constexpr std::size_t INDICES_PER_SEGMENT = 6;
+
+        // Segments are drawn in chunks that are culled with their own bounds. A primitive that fits in one chunk has 16-bit indices
+        static constexpr std::size_t MAX_SEGMENTS_PER_CHUNK = 65536 / VERTICES_PER_SEGMENT;
+
+        GltfLinePrimitiveBuilderOption m_option;
+        std::size_t m_segmentCount;
+        glm::vec3 m_minimum;
+        glm::vec3 m_extent;
+        AZStd::vector<AZ::Aabb> m_chunkAabbs;
+
+        // The indices are the vertex ids, since the draws of the chunks all start at the first vertex. The capacity of the records
+        // and the indices is kept between primitives of the same model
+        AZ::RHI::Format m_indexFormat;
+        AZStd::vector<SegmentRecord> m_records;
+        AZStd::vector<std::byte> m_indices;
+    };
+} // namespace Cesium
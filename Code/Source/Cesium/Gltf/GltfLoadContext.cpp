@@ -10,6 +10,12 @@ namespace Cesium
     {
     }
 
+    GltfShaderBuffer::GltfShaderBuffer(const AZ::Name& shaderInputName, AZ::Data::Asset<AZ::RPI::BufferAsset>&& bufferAsset)
+        : m_shaderInputName{ shaderInputName }
+        , m_bufferAsset{ std::move(bufferAsset) }
+    {
+    }
+
     GltfLoadTexture::GltfLoadTexture()
         : m_imageAsset{}
     {
@@ -42,6 +48,12 @@ namespace Cesium
         return !m_materialAsset;
     }
 
+    GltfCollisionMesh::GltfCollisionMesh()
+        : m_minimum{ 0.0f }
+        , m_maximum{ 0.0f }
+    {
+    }
+
     GltfLoadPrimitive::GltfLoadPrimitive()
         : m_modelAsset{}
         , m_materialId{ -1 }
@@ -62,12 +74,14 @@ namespace Cesium
     GltfLoadMesh::GltfLoadMesh()
         : m_primitives{}
         , m_transform{ glm::dmat4(1.0) }
+        , m_instanceTransforms{}
     {
     }
 
     GltfLoadMesh::GltfLoadMesh(AZStd::vector<GltfLoadPrimitive>&& primitives, const glm::dmat4& transform)
         : m_primitives{ std::move(primitives) }
         , m_transform{ transform }
+        , m_instanceTransforms{}
     {
     }
 
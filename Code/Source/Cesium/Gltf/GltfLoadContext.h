@@ -2,10 +2,13 @@
 
 #include <Atom/RHI.Reflect/ShaderSemantic.h>
 #include <Atom/RHI.Reflect/Format.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
 #include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
 #include <Atom/RPI.Reflect/Material/MaterialAsset.h>
 #include <Atom/RPI.Reflect/Model/ModelAsset.h>
 #include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
 #include <AzCore/std/string/string.h>
 #include <AzCore/Name/Name.h>
 #include <glm/glm.hpp>
@@ -13,6 +16,12 @@
 
 namespace Cesium
 {
+    class TriangleBvh;
+
+    class GeometryHeapAllocation;
+
+    struct GltfSharedPrimitive;
+
     using TextureId = AZStd::string;
     using MaterialId = std::int32_t;
 
@@ -26,6 +35,16 @@ namespace Cesium
         AZ::RHI::Format m_format;
     };
 
+    // Buffer that the shaders of a material read directly instead of through the vertex streams, such as the records that point and
+    // line primitives are expanded from. It is bound to the material SRG input of the same name
+    struct GltfShaderBuffer final
+    {
+        GltfShaderBuffer(const AZ::Name& shaderInputName, AZ::Data::Asset<AZ::RPI::BufferAsset>&& bufferAsset);
+
+        AZ::Name m_shaderInputName;
+        AZ::Data::Asset<AZ::RPI::BufferAsset> m_bufferAsset;
+    };
+
     struct GltfLoadTexture final
     {
         GltfLoadTexture();
@@ -47,9 +66,20 @@ namespace Cesium
 
         AZ::Data::Asset<AZ::RPI::MaterialAsset> m_materialAsset;
         AZStd::map<AZStd::string, GltfShaderVertexAttribute> m_customVertexAttributes;
+        AZStd::vector<GltfShaderBuffer> m_shaderBuffers;
         bool m_needTangents;
     };
 
+    // Triangle mesh cooked by the physics system on the load thread, in the space of the primitive
+    struct GltfCollisionMesh final
+    {
+        GltfCollisionMesh();
+
+        AZStd::vector<AZ::u8> m_cookedData;
+        glm::vec3 m_minimum;
+        glm::vec3 m_maximum;
+    };
+
     struct GltfLoadPrimitive final
     {
         GltfLoadPrimitive();
@@ -60,6 +90,23 @@ namespace Cesium
 
         AZ::Data::Asset<AZ::RPI::ModelAsset> m_modelAsset;
         MaterialId m_materialId;
+
+        // Models of the spatial clusters of the primitive, which are drawn in place of the model of the whole primitive so that each
+        // of them is culled on its own. It is empty if the primitive is not split
+        AZStd::vector<AZ::Data::Asset<AZ::RPI::ModelAsset>> m_clusterModelAssets;
+
+        // Hierarchy of the triangles of the full detail mesh for ray casts on the CPU. It is only built when requested
+        AZStd::shared_ptr<const TriangleBvh> m_raycastBvh;
+
+        // Simplified mesh for the colliders of the primitive. It is only cooked when requested
+        AZStd::shared_ptr<const GltfCollisionMesh> m_collisionMesh;
+
+        // Range of the geometry heap that holds the vertices and indices of the model. It is null if the model has its own buffer
+        AZStd::shared_ptr<const GeometryHeapAllocation> m_geometryAllocation;
+
+        // Keeps the primitive in the primitive cache, so that identical primitives of other models reuse it. It is null if the primitive
+        // is not cached
+        AZStd::shared_ptr<const GltfSharedPrimitive> m_sharedPrimitive;
     };
 
     struct GltfLoadMesh final
@@ -72,6 +119,10 @@ namespace Cesium
 
         AZStd::vector<GltfLoadPrimitive> m_primitives;
         glm::dmat4 m_transform;
+
+        // Transforms of the instances of the mesh relative to m_transform. Every instance shares the same model assets.
+        // The mesh has a single instance at m_transform if it is empty
+        AZStd::vector<glm::dmat4> m_instanceTransforms;
     };
 
     struct GltfLoadModel final
@@ -1,12 +1,103 @@
 #include "Cesium/Gltf/GltfModel.h"
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/TriangleBvh.h"
+#include "Cesium/Math/MathHelper.h"
+#include <Atom/RPI.Public/Buffer/Buffer.h>
 #include <Atom/RPI.Public/Image/StreamingImage.h>
+#include <Atom/RPI.Public/Shader/ShaderResourceGroup.h>
 #include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+#include <AzFramework/Physics/PhysicsScene.h>
+#include <AzFramework/Physics/Shape.h>
+#include <AzFramework/Physics/ShapeConfiguration.h>
+#include <AzFramework/Physics/Configuration/StaticRigidBodyConfiguration.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <limits>
 
 namespace Cesium
 {
+    namespace
+    {
+        bool IntersectRayBounds(
+            const glm::dvec3& origin, const glm::dvec3& direction, double maxDistance, const glm::dvec3& minimum, const glm::dvec3& maximum)
+        {
+            double entry = 0.0;
+            double exit = maxDistance;
+            for (glm::length_t axis = 0; axis < 3; ++axis)
+            {
+                if (direction[axis] == 0.0)
+                {
+                    if (origin[axis] < minimum[axis] || origin[axis] > maximum[axis])
+                    {
+                        return false;
+                    }
+
+                    continue;
+                }
+
+                double inverseDirection = 1.0 / direction[axis];
+                double nearDistance = (minimum[axis] - origin[axis]) * inverseDirection;
+                double farDistance = (maximum[axis] - origin[axis]) * inverseDirection;
+                entry = glm::max(entry, glm::min(nearDistance, farDistance));
+                exit = glm::min(exit, glm::max(nearDistance, farDistance));
+            }
+
+            return entry <= exit;
+        }
+
+        void GrowWorldBounds(
+            const glm::dmat4& transform,
+            const glm::vec3& localMinimum,
+            const glm::vec3& localMaximum,
+            glm::dvec3& worldMinimum,
+            glm::dvec3& worldMaximum)
+        {
+            for (std::uint32_t corner = 0; corner < 8; ++corner)
+            {
+                glm::dvec4 localCorner{ (corner & 1) ? localMaximum.x : localMinimum.x, (corner & 2) ? localMaximum.y : localMinimum.y,
+                                        (corner & 4) ? localMaximum.z : localMinimum.z, 1.0 };
+                glm::dvec3 worldCorner = transform * localCorner;
+                worldMinimum = glm::min(worldMinimum, worldCorner);
+                worldMaximum = glm::max(worldMaximum, worldCorner);
+            }
+        }
+    } // namespace
+
+    GltfRaycastHit::GltfRaycastHit()
+        : m_distance{ 0.0 }
+        , m_normal{ 0.0, 0.0, 1.0 }
+    {
+    }
+
+    void GltfMaterial::BindShaderBuffers()
+    {
+        if (!m_material || m_shaderBuffers.empty())
+        {
+            return;
+        }
+
+        const AZ::Data::Instance<AZ::RPI::ShaderResourceGroup>& shaderResourceGroup = m_material->GetShaderResourceGroup();
+        if (!shaderResourceGroup)
+        {
+            return;
+        }
+
+        for (const GltfShaderBuffer& shaderBuffer : m_shaderBuffers)
+        {
+            AZ::RHI::ShaderInputBufferIndex bufferIndex = shaderResourceGroup->FindShaderInputBufferIndex(shaderBuffer.m_shaderInputName);
+            AZ::Data::Instance<AZ::RPI::Buffer> buffer = AZ::RPI::Buffer::FindOrCreate(shaderBuffer.m_bufferAsset);
+            if (bufferIndex.IsValid() && buffer)
+            {
+                shaderResourceGroup->SetBuffer(bufferIndex, buffer);
+            }
+        }
+
+        // buffers are not material properties, so the material doesn't know that its SRG has to be compiled again
+        shaderResourceGroup->Compile();
+    }
+
     GltfPrimitive::GltfPrimitive()
         : m_materialIndex{ -1 }
     {
@@ -20,6 +111,11 @@ namespace Cesium
     GltfModel::GltfModel(AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor, const GltfLoadModel& loadModel)
         : m_visible{ true }
         , m_transform{ glm::dmat4(1.0) }
+        , m_raycastMinimum{ std::numeric_limits<double>::max() }
+        , m_raycastMaximum{ std::numeric_limits<double>::lowest() }
+        , m_collisionEnabled{ false }
+        , m_collisionMinimum{ std::numeric_limits<double>::max() }
+        , m_collisionMaximum{ std::numeric_limits<double>::lowest() }
         , m_meshFeatureProcessor{ meshFeatureProcessor }
         , m_meshes{}
     {
@@ -28,12 +124,14 @@ namespace Cesium
         m_meshes.reserve(loadModel.m_meshes.size());
         for (const auto& loadMesh : loadModel.m_meshes)
         {
-            AZ::Transform o3deTransform;
-            AZ::Vector3 o3deScale;
-            ConvertMat4ToTransformAndScale(loadMesh.m_transform, o3deTransform, o3deScale);
-
             GltfMesh& gltfMesh = m_meshes.emplace_back();
             gltfMesh.m_transform = loadMesh.m_transform;
+            gltfMesh.m_instanceTransforms = loadMesh.m_instanceTransforms;
+            if (gltfMesh.m_instanceTransforms.empty())
+            {
+                gltfMesh.m_instanceTransforms.emplace_back(1.0);
+            }
+
             gltfMesh.m_primitives.reserve(loadMesh.m_primitives.size());
             for (std::size_t i = 0; i < loadMesh.m_primitives.size(); ++i)
             {
@@ -44,30 +142,61 @@ namespace Cesium
                     const GltfLoadMaterial& loadMaterial = loadModel.m_materials[loadPrimitive.m_materialId];
                     const AZ::Data::Asset<AZ::RPI::MaterialAsset>& materialAsset = loadMaterial.m_materialAsset;
                     AZ::Data::Instance<AZ::RPI::Material> materialInstance = AZ::RPI::Material::FindOrCreate(materialAsset);
-                    m_materials[loadPrimitive.m_materialId].m_material = std::move(materialInstance);
+                    GltfMaterial& material = m_materials[loadPrimitive.m_materialId];
+                    material.m_material = std::move(materialInstance);
+                    material.m_shaderBuffers = loadMaterial.m_shaderBuffers;
+                    material.BindShaderBuffers();
                 }
 
                 if (loadPrimitive.m_materialId >= 0 && loadPrimitive.m_materialId < m_materials.size())
                 {
-                    auto meshHandle = m_meshFeatureProcessor->AcquireMesh(
-                        AZ::Render::MeshHandleDescriptor{ loadPrimitive.m_modelAsset, false, false, {} },
-                        m_materials[loadPrimitive.m_materialId].m_material);
-                    m_meshFeatureProcessor->SetTransform(meshHandle, o3deTransform, o3deScale);
+                    // A split primitive is drawn as one primitive per cluster, so that each cluster is culled with its own bounds. The
+                    // first one keeps the data of the whole primitive for ray casts and collisions
+                    AZStd::span<const AZ::Data::Asset<AZ::RPI::ModelAsset>> modelAssets(&loadPrimitive.m_modelAsset, 1);
+                    if (!loadPrimitive.m_clusterModelAssets.empty())
+                    {
+                        modelAssets = loadPrimitive.m_clusterModelAssets;
+                    }
+
+                    for (std::size_t cluster = 0; cluster < modelAssets.size(); ++cluster)
+                    {
+                        // every instance acquires the same model asset, so the mesh feature processor shares its buffers between them
+                        GltfPrimitive primitive;
+                        primitive.m_materialIndex = loadPrimitive.m_materialId;
+                        if (cluster == 0)
+                        {
+                            primitive.m_raycastBvh = loadPrimitive.m_raycastBvh;
+                            primitive.m_collisionMesh = loadPrimitive.m_collisionMesh;
+                            primitive.m_geometryAllocation = loadPrimitive.m_geometryAllocation;
+                            primitive.m_sharedPrimitive = loadPrimitive.m_sharedPrimitive;
+                        }
 
-                    GltfPrimitive primitive;
-                    primitive.m_meshHandle = std::move(meshHandle);
-                    primitive.m_materialIndex = loadPrimitive.m_materialId;
+                        primitive.m_meshHandles.reserve(gltfMesh.m_instanceTransforms.size());
+                        for (std::size_t instance = 0; instance < gltfMesh.m_instanceTransforms.size(); ++instance)
+                        {
+                            primitive.m_meshHandles.emplace_back(m_meshFeatureProcessor->AcquireMesh(
+                                AZ::Render::MeshHandleDescriptor{ modelAssets[cluster], false, false, {} },
+                                m_materials[loadPrimitive.m_materialId].m_material));
+                        }
 
-                    gltfMesh.m_primitives.emplace_back(std::move(primitive));
+                        gltfMesh.m_primitives.emplace_back(std::move(primitive));
+                    }
                 }
             }
         }
+
+        SetTransform(m_transform);
     }
 
     GltfModel::GltfModel(GltfModel&& rhs) noexcept
     {
         m_visible = rhs.m_visible;
         m_transform = rhs.m_transform;
+        m_raycastMinimum = rhs.m_raycastMinimum;
+        m_raycastMaximum = rhs.m_raycastMaximum;
+        m_collisionEnabled = rhs.m_collisionEnabled;
+        m_collisionMinimum = rhs.m_collisionMinimum;
+        m_collisionMaximum = rhs.m_collisionMaximum;
         m_meshFeatureProcessor = rhs.m_meshFeatureProcessor;
         m_meshes = std::move(rhs.m_meshes);
         m_materials = std::move(rhs.m_materials);
@@ -80,6 +209,11 @@ namespace Cesium
         {
             swap(m_visible, rhs.m_visible);
             swap(m_transform, rhs.m_transform);
+            swap(m_raycastMinimum, rhs.m_raycastMinimum);
+            swap(m_raycastMaximum, rhs.m_raycastMaximum);
+            swap(m_collisionEnabled, rhs.m_collisionEnabled);
+            swap(m_collisionMinimum, rhs.m_collisionMinimum);
+            swap(m_collisionMaximum, rhs.m_collisionMaximum);
             swap(m_meshFeatureProcessor, rhs.m_meshFeatureProcessor);
             swap(m_meshes, rhs.m_meshes);
             swap(m_materials, rhs.m_materials);
@@ -117,7 +251,10 @@ namespace Cesium
     {
         if (primitive.m_materialIndex >= 0)
         {
-            m_meshFeatureProcessor->SetMaterialAssignmentMap(primitive.m_meshHandle, m_materials[primitive.m_materialIndex].m_material);
+            for (auto& meshHandle : primitive.m_meshHandles)
+            {
+                m_meshFeatureProcessor->SetMaterialAssignmentMap(meshHandle, m_materials[primitive.m_materialIndex].m_material);
+            }
         }
     }
 
@@ -133,7 +270,10 @@ namespace Cesium
         {
             for (auto& primitive : mesh.m_primitives)
             {
-                m_meshFeatureProcessor->SetVisible(primitive.m_meshHandle, m_visible);
+                for (auto& meshHandle : primitive.m_meshHandles)
+                {
+                    m_meshFeatureProcessor->SetVisible(meshHandle, m_visible);
+                }
             }
         }
     }
@@ -141,17 +281,65 @@ namespace Cesium
     void GltfModel::SetTransform(const glm::dmat4& transform)
     {
         m_transform = transform;
+        m_raycastMinimum = glm::dvec3(std::numeric_limits<double>::max());
+        m_raycastMaximum = glm::dvec3(std::numeric_limits<double>::lowest());
+        m_collisionMinimum = glm::dvec3(std::numeric_limits<double>::max());
+        m_collisionMaximum = glm::dvec3(std::numeric_limits<double>::lowest());
         for (GltfMesh& mesh : m_meshes)
         {
-            glm::dmat4 newTransform = transform * mesh.m_transform;
-            AZ::Transform o3deTransform;
-            AZ::Vector3 o3deScale;
-            ConvertMat4ToTransformAndScale(newTransform, o3deTransform, o3deScale);
-            for (auto& primitive : mesh.m_primitives)
+            bool hasRaycastBvh = AZStd::any_of(
+                mesh.m_primitives.begin(), mesh.m_primitives.end(),
+                [](const GltfPrimitive& primitive)
+                {
+                    return primitive.m_raycastBvh != nullptr;
+                });
+            mesh.m_inverseWorldTransforms.clear();
+
+            glm::dmat4 meshTransform = transform * mesh.m_transform;
+            for (std::size_t instance = 0; instance < mesh.m_instanceTransforms.size(); ++instance)
             {
-                m_meshFeatureProcessor->SetTransform(primitive.m_meshHandle, o3deTransform, o3deScale);
+                glm::dmat4 newTransform = meshTransform * mesh.m_instanceTransforms[instance];
+                AZ::Transform o3deTransform;
+                AZ::Vector3 o3deScale;
+                ConvertMat4ToTransformAndScale(newTransform, o3deTransform, o3deScale);
+                for (auto& primitive : mesh.m_primitives)
+                {
+                    m_meshFeatureProcessor->SetTransform(primitive.m_meshHandles[instance], o3deTransform, o3deScale);
+                }
+
+                // instances scaled to zero have no surface to hit
+                if (hasRaycastBvh && MathHelper::IsInvertibleMatrix(newTransform))
+                {
+                    mesh.m_inverseWorldTransforms.emplace_back(glm::inverse(newTransform));
+                    for (const auto& primitive : mesh.m_primitives)
+                    {
+                        if (primitive.m_raycastBvh && !primitive.m_raycastBvh->IsEmpty())
+                        {
+                            GrowWorldBounds(
+                                newTransform, primitive.m_raycastBvh->GetMinimum(), primitive.m_raycastBvh->GetMaximum(), m_raycastMinimum,
+                                m_raycastMaximum);
+                        }
+                    }
+                }
+
+                for (const auto& primitive : mesh.m_primitives)
+                {
+                    if (primitive.m_collisionMesh)
+                    {
+                        GrowWorldBounds(
+                            newTransform, primitive.m_collisionMesh->m_minimum, primitive.m_collisionMesh->m_maximum, m_collisionMinimum,
+                            m_collisionMaximum);
+                    }
+                }
             }
         }
+
+        // the static bodies are created again at the new transform
+        if (m_collisionEnabled)
+        {
+            DestroyCollisionBodies();
+            CreateCollisionBodies();
+        }
     }
 
     const glm::dmat4& GltfModel::GetTransform() const
@@ -159,6 +347,99 @@ namespace Cesium
         return m_transform;
     }
 
+    bool GltfModel::Raycast(const glm::dvec3& origin, const glm::dvec3& direction, double maxDistance, GltfRaycastHit& hit) const
+    {
+        if (!CanRaycast() || !IntersectRayBounds(origin, direction, maxDistance, m_raycastMinimum, m_raycastMaximum))
+        {
+            return false;
+        }
+
+        // the BVH is traversed in single precision, so an unbounded distance is narrowed to the largest finite float
+        bool found = false;
+        double closest = AZStd::min(maxDistance, static_cast<double>(std::numeric_limits<float>::max()));
+        for (const GltfMesh& mesh : m_meshes)
+        {
+            for (const glm::dmat4& inverseWorldTransform : mesh.m_inverseWorldTransforms)
+            {
+                // The direction is transformed without being normalized, so the distance along the local ray is the same as along
+                // the world ray even if the instance is scaled
+                glm::vec3 localOrigin{ inverseWorldTransform * glm::dvec4(origin, 1.0) };
+                glm::vec3 localDirection{ inverseWorldTransform * glm::dvec4(direction, 0.0) };
+                for (const GltfPrimitive& primitive : mesh.m_primitives)
+                {
+                    TriangleBvhHit primitiveHit;
+                    if (!primitive.m_raycastBvh ||
+                        !primitive.m_raycastBvh->Raycast(localOrigin, localDirection, static_cast<float>(closest), primitiveHit))
+                    {
+                        continue;
+                    }
+
+                    // normals are transformed by the inverse transpose of the world transform
+                    glm::dvec3 normal = glm::transpose(glm::dmat3(inverseWorldTransform)) * glm::dvec3(primitiveHit.m_normal);
+                    closest = primitiveHit.m_distance;
+                    hit.m_distance = closest;
+                    hit.m_normal = glm::normalize(normal);
+                    found = true;
+                }
+            }
+        }
+
+        return found;
+    }
+
+    bool GltfModel::CanRaycast() const
+    {
+        return m_raycastMinimum.x <= m_raycastMaximum.x;
+    }
+
+    const glm::dvec3& GltfModel::GetRaycastMinimum() const
+    {
+        return m_raycastMinimum;
+    }
+
+    const glm::dvec3& GltfModel::GetRaycastMaximum() const
+    {
+        return m_raycastMaximum;
+    }
+
+    bool GltfModel::HasCollision() const
+    {
+        return m_collisionMinimum.x <= m_collisionMaximum.x;
+    }
+
+    bool GltfModel::IsCollisionEnabled() const
+    {
+        return m_collisionEnabled;
+    }
+
+    void GltfModel::SetCollisionEnabled(bool enabled)
+    {
+        if (m_collisionEnabled == enabled)
+        {
+            return;
+        }
+
+        m_collisionEnabled = enabled;
+        if (m_collisionEnabled)
+        {
+            CreateCollisionBodies();
+        }
+        else
+        {
+            DestroyCollisionBodies();
+        }
+    }
+
+    const glm::dvec3& GltfModel::GetCollisionMinimum() const
+    {
+        return m_collisionMinimum;
+    }
+
+    const glm::dvec3& GltfModel::GetCollisionMaximum() const
+    {
+        return m_collisionMaximum;
+    }
+
     void GltfModel::Destroy() noexcept
     {
         if (m_meshes.empty())
@@ -166,11 +447,16 @@ namespace Cesium
             return;
         }
 
+        DestroyCollisionBodies();
+
         for (auto& mesh : m_meshes)
         {
             for (auto& primitive : mesh.m_primitives)
             {
-                m_meshFeatureProcessor->ReleaseMesh(primitive.m_meshHandle);
+                for (auto& meshHandle : primitive.m_meshHandles)
+                {
+                    m_meshFeatureProcessor->ReleaseMesh(meshHandle);
+                }
             }
         }
 
@@ -178,6 +464,78 @@ namespace Cesium
         m_materials.clear();
     }
 
+    void GltfModel::CreateCollisionBodies()
+    {
+        auto sceneInterface = AZ::Interface<AzPhysics::SceneInterface>::Get();
+        if (!sceneInterface || !HasCollision())
+        {
+            return;
+        }
+
+        AzPhysics::SceneHandle sceneHandle = sceneInterface->GetSceneHandle(AzPhysics::DefaultPhysicsSceneName);
+        if (sceneHandle == AzPhysics::InvalidSceneHandle)
+        {
+            return;
+        }
+
+        for (GltfMesh& mesh : m_meshes)
+        {
+            glm::dmat4 meshTransform = m_transform * mesh.m_transform;
+            for (std::size_t instance = 0; instance < mesh.m_instanceTransforms.size(); ++instance)
+            {
+                AZ::Transform o3deTransform;
+                AZ::Vector3 o3deScale;
+                ConvertMat4ToTransformAndScale(meshTransform * mesh.m_instanceTransforms[instance], o3deTransform, o3deScale);
+                for (GltfPrimitive& primitive : mesh.m_primitives)
+                {
+                    if (!primitive.m_collisionMesh)
+                    {
+                        continue;
+                    }
+
+                    const AZStd::vector<AZ::u8>& cookedData = primitive.m_collisionMesh->m_cookedData;
+                    auto shapeConfiguration = AZStd::make_shared<Physics::CookedMeshShapeConfiguration>();
+                    shapeConfiguration->SetCookedMeshData(
+                        cookedData.data(), cookedData.size(), Physics::CookedMeshShapeConfiguration::MeshType::TriangleMesh);
+                    shapeConfiguration->m_scale = o3deScale;
+
+                    AzPhysics::StaticRigidBodyConfiguration bodyConfiguration;
+                    bodyConfiguration.m_position = o3deTransform.GetTranslation();
+                    bodyConfiguration.m_orientation = o3deTransform.GetRotation();
+                    bodyConfiguration.m_colliderAndShapeData =
+                        AzPhysics::ShapeColliderPair(AZStd::make_shared<Physics::ColliderConfiguration>(), shapeConfiguration);
+                    AzPhysics::SimulatedBodyHandle bodyHandle = sceneInterface->AddSimulatedBody(sceneHandle, &bodyConfiguration);
+                    if (bodyHandle != AzPhysics::InvalidSimulatedBodyHandle)
+                    {
+                        primitive.m_collisionBodies.emplace_back(bodyHandle);
+                    }
+                }
+            }
+        }
+    }
+
+    void GltfModel::DestroyCollisionBodies()
+    {
+        auto sceneInterface = AZ::Interface<AzPhysics::SceneInterface>::Get();
+        AzPhysics::SceneHandle sceneHandle =
+            sceneInterface ? sceneInterface->GetSceneHandle(AzPhysics::DefaultPhysicsSceneName) : AzPhysics::InvalidSceneHandle;
+        for (GltfMesh& mesh : m_meshes)
+        {
+            for (GltfPrimitive& primitive : mesh.m_primitives)
+            {
+                if (sceneHandle != AzPhysics::InvalidSceneHandle)
+                {
+                    for (AzPhysics::SimulatedBodyHandle& bodyHandle : primitive.m_collisionBodies)
+                    {
+                        sceneInterface->RemoveSimulatedBody(sceneHandle, bodyHandle);
+                    }
+                }
+
+                primitive.m_collisionBodies.clear();
+            }
+        }
+    }
+
     void GltfModel::ConvertMat4ToTransformAndScale(const glm::dmat4& mat4, AZ::Transform& o3deTransform, AZ::Vector3& o3deScale)
     {
         // set transformation. Since AZ::Transform doesn' accept non-uniform scale, we
@@ -1,27 +1,65 @@
 #pragma once
 
+#include "Cesium/Gltf/GltfLoadContext.h"
 #include <Atom/Feature/Mesh/MeshFeatureProcessorInterface.h>
 #include <Atom/RPI.Public/Material/Material.h>
 #include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzFramework/Physics/Common/PhysicsTypes.h>
 #include <glm/glm.hpp>
 
 namespace Cesium
 {
     struct GltfLoadModel;
 
+    struct GltfCollisionMesh;
+
+    class TriangleBvh;
+
+    class GeometryHeapAllocation;
+
+    struct GltfSharedPrimitive;
+
+    struct GltfRaycastHit final
+    {
+        GltfRaycastHit();
+
+        // Distance along the ray in units of the ray direction
+        double m_distance;
+
+        // Unit normal of the triangle that is hit, facing the origin of the ray
+        glm::dvec3 m_normal;
+    };
+
     struct GltfMaterial
     {
         GltfMaterial() = default;
 
+        // Bind the shader buffers to the SRG of the material instance. It has to be called again whenever the instance is replaced
+        void BindShaderBuffers();
+
         AZ::Data::Instance<AZ::RPI::Material> m_material;
+        AZStd::vector<GltfShaderBuffer> m_shaderBuffers;
     };
 
     struct GltfPrimitive
     {
         GltfPrimitive();
 
-        AZ::Render::MeshFeatureProcessorInterface::MeshHandle m_meshHandle;
+        // one mesh handle per instance of the mesh. All of them share the same model asset
+        AZStd::vector<AZ::Render::MeshFeatureProcessorInterface::MeshHandle> m_meshHandles;
         std::int32_t m_materialIndex;
+        AZStd::shared_ptr<const TriangleBvh> m_raycastBvh;
+
+        // one static body per instance of the mesh while collision is enabled. All of them share the same cooked mesh
+        AZStd::shared_ptr<const GltfCollisionMesh> m_collisionMesh;
+        AZStd::vector<AzPhysics::SimulatedBodyHandle> m_collisionBodies;
+
+        // keeps the range of the geometry heap used by the meshes until they are released
+        AZStd::shared_ptr<const GeometryHeapAllocation> m_geometryAllocation;
+
+        // keeps the model in the primitive cache while it is displayed
+        AZStd::shared_ptr<const GltfSharedPrimitive> m_sharedPrimitive;
     };
 
     struct GltfMesh
@@ -30,6 +68,11 @@ namespace Cesium
 
         AZStd::vector<GltfPrimitive> m_primitives;
         glm::dmat4 m_transform;
+        AZStd::vector<glm::dmat4> m_instanceTransforms;
+
+        // Inverse of the world transform of each instance, so that rays are brought into the space of the primitives.
+        // It is only kept for meshes that have a primitive to ray cast
+        AZStd::vector<glm::dmat4> m_inverseWorldTransforms;
     };
 
     class GltfModel
@@ -65,13 +108,45 @@ namespace Cesium
 
         const glm::dmat4& GetTransform() const;
 
+        // Find the closest triangle hit by a ray in world space, among the primitives that were built with a ray cast hierarchy.
+        // The direction doesn't need to be normalized, and the distance of the hit is in units of the direction
+        bool Raycast(const glm::dvec3& origin, const glm::dvec3& direction, double maxDistance, GltfRaycastHit& hit) const;
+
+        bool CanRaycast() const;
+
+        // World bounds of the primitives that can be ray cast. They are empty when CanRaycast() is false
+        const glm::dvec3& GetRaycastMinimum() const;
+
+        const glm::dvec3& GetRaycastMaximum() const;
+
+        bool HasCollision() const;
+
+        bool IsCollisionEnabled() const;
+
+        // Add or remove the static bodies of the primitives that have a collision mesh to the default physics scene
+        void SetCollisionEnabled(bool enabled);
+
+        // World bounds of the primitives that have a collision mesh. They are empty when HasCollision() is false
+        const glm::dvec3& GetCollisionMinimum() const;
+
+        const glm::dvec3& GetCollisionMaximum() const;
+
         void Destroy() noexcept;
 
     private:
         void ConvertMat4ToTransformAndScale(const glm::dmat4& mat4, AZ::Transform& o3deTransform, AZ::Vector3& o3deScale);
 
+        void CreateCollisionBodies();
+
+        void DestroyCollisionBodies();
+
         bool m_visible;
         glm::dmat4 m_transform;
+        glm::dvec3 m_raycastMinimum;
+        glm::dvec3 m_raycastMaximum;
+        bool m_collisionEnabled;
+        glm::dvec3 m_collisionMinimum;
+        glm::dvec3 m_collisionMaximum;
         AZ::Render::MeshFeatureProcessorInterface* m_meshFeatureProcessor;
         AZStd::vector<GltfMesh> m_meshes;
         AZStd::vector<GltfMaterial> m_materials;
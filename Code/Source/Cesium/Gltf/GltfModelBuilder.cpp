@@ -1,9 +1,16 @@
 #include "Cesium/Gltf/GltfModelBuilder.h"
 #include "Cesium/Gltf/GltfPrimitiveBuilder.h"
+#include "Cesium/Gltf/GltfPointPrimitiveBuilder.h"
+#include "Cesium/Gltf/GltfLinePrimitiveBuilder.h"
+#include "Cesium/Gltf/GltfAccessorGather.h"
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/MeshoptDecoder.h"
+#include "Cesium/Math/MathHelper.h"
 #include "Cesium/Systems/GenericIOManager.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/containers/unordered_map.h>
 
 // Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
 // This only happens with unity build
@@ -19,6 +26,9 @@
 #include <CesiumGltf/Node.h>
 #include <CesiumGltf/MeshPrimitive.h>
 #include <CesiumGltf/Material.h>
+#include <CesiumGltf/Accessor.h>
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumUtility/JsonValue.h>
 #include <CesiumGltfReader/GltfReader.h>
 
 #ifdef AZ_COMPILER_MSVC
@@ -29,6 +39,17 @@ namespace Cesium
 {
     GltfModelBuilderOption::GltfModelBuilderOption(const glm::dmat4& transform)
         : m_transform{ transform }
+        , m_mergePrimitives{ false }
+        , m_primitiveBuilderOption{}
+        , m_pointPrimitiveBuilderOption{}
+        , m_linePrimitiveBuilderOption{}
+    {
+    }
+
+    GltfModelBuilder::MeshInstance::MeshInstance(std::size_t meshIndex, const glm::dmat4& transform)
+        : m_meshIndex{ meshIndex }
+        , m_transform{ transform }
+        , m_instanceTransforms{}
     {
     }
 
@@ -40,70 +61,236 @@ namespace Cesium
     void GltfModelBuilder::Create(
         GenericIOManager& io, const AZStd::string& filePath, const GltfModelBuilderOption& option, GltfLoadModel& result)
     {
-        auto fileContent = io.GetFileContent({ "", filePath });
+        // The reader copies the binary chunk of GLBs into the model, so the file content is released before anything else is read
         CesiumGltfReader::GltfReader reader;
-        auto load = reader.readModel(gsl::span<const std::byte>(fileContent.data(), fileContent.size()));
+        CesiumGltfReader::GltfReaderResult load;
+        {
+            IOContent fileContent = io.GetFileContent({ "", filePath });
+            load = reader.readModel(gsl::span<const std::byte>(fileContent.data(), fileContent.size()));
+        }
+
         if (load.model)
         {
             AZStd::string parentPath = io.GetParentPath(filePath);
             ResolveExternalImages(parentPath, reader, *load.model, io);
             ResolveExternalBuffers(parentPath, *load.model, io);
+            MeshoptDecoder::DecodeBufferViews(*load.model);
 
-            return Create(*load.model, option, result);
+            LoadModel(*load.model, *load.model, option, load.model.get(), result);
         }
     }
 
+    CesiumAsync::Future<std::optional<GltfLoadModel>> GltfModelBuilder::CreateAsync(
+        const CesiumAsync::AsyncSystem& asyncSystem,
+        GenericIOManager& io,
+        const AZStd::string& filePath,
+        const GltfModelBuilderOption& option)
+    {
+        AZStd::string parentPath = io.GetParentPath(filePath);
+        return io.GetFileContentAsync(asyncSystem, IORequestParameter{ "", filePath })
+            .thenInWorkerThread(
+                [this, asyncSystem, &io, parentPath, option](IOContent&& fileContent)
+                {
+                    CesiumGltfReader::GltfReader reader;
+                    auto load = reader.readModel(gsl::span<const std::byte>(fileContent.data(), fileContent.size()));
+                    if (!load.model)
+                    {
+                        return asyncSystem.createResolvedFuture<std::optional<GltfLoadModel>>(std::nullopt);
+                    }
+
+                    std::shared_ptr<CesiumGltf::Model> model = std::make_shared<CesiumGltf::Model>(std::move(*load.model));
+                    return ResolveExternalResourcesAsync(asyncSystem, parentPath, model, io)
+                        .thenInWorkerThread(
+                            [this, model, option]([[maybe_unused]] std::vector<bool>&& resolved)
+                            {
+                                MeshoptDecoder::DecodeBufferViews(*model);
+
+                                GltfLoadModel result;
+                                LoadModel(*model, *model, option, model.get(), result);
+                                return std::optional<GltfLoadModel>(std::move(result));
+                            });
+                });
+    }
+
     void GltfModelBuilder::Create(const CesiumGltf::Model& model, const GltfModelBuilderOption& option, GltfLoadModel& result)
+    {
+        // Accessor views can only read plain buffer views, so compressed ones are decoded first. Tiles hand us a const model,
+        // so the decoded data goes into a copy of its geometry. The images are left out of the copy, since they are usually
+        // the largest part of a tile, and materials are built from the tile itself
+        if (MeshoptDecoder::HasCompressedBufferViews(model))
+        {
+            CesiumGltf::Model decodedModel = CopyGeometry(model);
+            MeshoptDecoder::DecodeBufferViews(decodedModel);
+            LoadModel(decodedModel, model, option, &decodedModel, result);
+            return;
+        }
+
+        LoadModel(model, model, option, nullptr, result);
+    }
+
+    CesiumGltf::Model GltfModelBuilder::CopyGeometry(const CesiumGltf::Model& model)
+    {
+        CesiumGltf::Model geometry;
+        geometry.extensionsUsed = model.extensionsUsed;
+        geometry.extensionsRequired = model.extensionsRequired;
+        geometry.accessors = model.accessors;
+        geometry.buffers = model.buffers;
+        geometry.bufferViews = model.bufferViews;
+        geometry.materials = model.materials;
+        geometry.meshes = model.meshes;
+        geometry.nodes = model.nodes;
+        geometry.scene = model.scene;
+        geometry.scenes = model.scenes;
+        geometry.extensions = model.extensions;
+        geometry.extras = model.extras;
+        return geometry;
+    }
+
+    void GltfModelBuilder::LoadModel(
+        const CesiumGltf::Model& model,
+        const CesiumGltf::Model& materialModel,
+        const GltfModelBuilderOption& option,
+        CesiumGltf::Model* ownedModel,
+        GltfLoadModel& result)
     {
         // Resize materials to be the same with gltf materials, so that we can use it as a cache.
         // It maybe wasteful when some gltfs has more materials than what are used in the its primitives.
         result.m_materials.resize(model.materials.size());
 
-        // Resize meshes the same with gltf meshes for caching
-        result.m_meshes.resize(model.meshes.size());
-
+        // collect the meshes to be displayed along with their world transform
+        AZStd::vector<MeshInstance> meshInstances;
+        glm::dmat4 worldTransform = option.m_transform * GLTF_TO_O3DE;
         if (model.scene >= 0 && model.scene < model.scenes.size())
         {
             // display default scene
-            LoadScene(model, model.scenes[model.scene], option, result);
+            LoadScene(model, model.scenes[model.scene], worldTransform, meshInstances);
         }
         else if (model.scenes.size() > 0)
         {
             // no default scene, display the first one
-            LoadScene(model, model.scenes.front(), option, result);
+            LoadScene(model, model.scenes.front(), worldTransform, meshInstances);
         }
         else if (model.nodes.size() > 0)
         {
             // no default scene, display the first node
-            glm::dmat4 worldTransform = option.m_transform * GLTF_TO_O3DE;
-            LoadNode(model, model.nodes.front(), worldTransform, result);
+            LoadNode(model, model.nodes.front(), worldTransform, meshInstances);
         }
         else
         {
             // load all meshes in the gltf
-            glm::dmat4 worldTransform = option.m_transform * GLTF_TO_O3DE;
+            meshInstances.reserve(model.meshes.size());
             for (std::size_t i = 0; i < model.meshes.size(); ++i)
             {
-                LoadMesh(model, i, worldTransform, result);
+                meshInstances.emplace_back(i, worldTransform);
+            }
+        }
+
+        if (option.m_mergePrimitives)
+        {
+            LoadMergedMeshes(model, materialModel, option, meshInstances, result);
+            return;
+        }
+
+        // The buffers of a model owned by the builder are freed as soon as the last mesh reading them is built,
+        // so that the glTF data and the vertex buffers built from it are not both held in memory until the end
+        AZStd::vector<std::size_t> buffersLastUse;
+        if (ownedModel)
+        {
+            FindBuffersLastUse(model, meshInstances, buffersLastUse);
+        }
+
+        // Resize meshes the same with gltf meshes for caching
+        result.m_meshes.resize(model.meshes.size());
+        for (std::size_t i = 0; i < meshInstances.size(); ++i)
+        {
+            const MeshInstance& meshInstance = meshInstances[i];
+            LoadMesh(model, materialModel, option, meshInstance, result.m_meshes[meshInstance.m_meshIndex], result);
+
+            for (std::size_t buffer = 0; buffer < buffersLastUse.size(); ++buffer)
+            {
+                if (buffersLastUse[buffer] == i)
+                {
+                    ownedModel->buffers[buffer].cesium.data = std::vector<std::byte>();
+                }
+            }
+        }
+    }
+
+    void GltfModelBuilder::FindBuffersLastUse(
+        const CesiumGltf::Model& model, const AZStd::vector<MeshInstance>& meshInstances, AZStd::vector<std::size_t>& buffersLastUse)
+    {
+        // buffers that no mesh reads are left alone
+        buffersLastUse.clear();
+        buffersLastUse.resize(model.buffers.size(), meshInstances.size());
+
+        auto markAccessor = [&model, &buffersLastUse](std::int32_t accessorIndex, std::size_t meshInstanceIndex)
+        {
+            const CesiumGltf::Accessor* accessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, accessorIndex);
+            if (!accessor)
+            {
+                return;
+            }
+
+            const CesiumGltf::BufferView* bufferView = model.getSafe<CesiumGltf::BufferView>(&model.bufferViews, accessor->bufferView);
+            if (bufferView && bufferView->buffer >= 0 && static_cast<std::size_t>(bufferView->buffer) < buffersLastUse.size())
+            {
+                buffersLastUse[static_cast<std::size_t>(bufferView->buffer)] = meshInstanceIndex;
+            }
+        };
+
+        for (std::size_t i = 0; i < meshInstances.size(); ++i)
+        {
+            for (const CesiumGltf::MeshPrimitive& primitive : model.meshes[meshInstances[i].m_meshIndex].primitives)
+            {
+                markAccessor(primitive.indices, i);
+                for (const auto& attribute : primitive.attributes)
+                {
+                    markAccessor(attribute.second, i);
+                }
+            }
+        }
+
+        // KTX2 images are read from their buffer view when materials are built, so their buffers are left alone as well
+        for (const CesiumGltf::Texture& texture : model.textures)
+        {
+            const CesiumUtility::JsonValue* extension = texture.getGenericExtension(KHR_TEXTURE_BASISU);
+            const CesiumUtility::JsonValue* source = extension ? extension->getValuePtrForKey("source") : nullptr;
+            if (!source)
+            {
+                continue;
+            }
+
+            const CesiumGltf::Image* image =
+                model.getSafe<CesiumGltf::Image>(&model.images, source->getSafeNumber<std::int32_t>().value_or(-1));
+            const CesiumGltf::BufferView* bufferView =
+                image ? model.getSafe<CesiumGltf::BufferView>(&model.bufferViews, image->bufferView) : nullptr;
+            if (bufferView && bufferView->buffer >= 0 && static_cast<std::size_t>(bufferView->buffer) < buffersLastUse.size())
+            {
+                buffersLastUse[static_cast<std::size_t>(bufferView->buffer)] = meshInstances.size();
             }
         }
     }
 
     void GltfModelBuilder::LoadScene(
-        const CesiumGltf::Model& model, const CesiumGltf::Scene& scene, const GltfModelBuilderOption& option, GltfLoadModel& result)
+        const CesiumGltf::Model& model,
+        const CesiumGltf::Scene& scene,
+        const glm::dmat4& worldTransform,
+        AZStd::vector<MeshInstance>& meshInstances)
     {
-        glm::dmat4 worldTransform = option.m_transform * GLTF_TO_O3DE;
         for (std::int32_t rootIndex : scene.nodes)
         {
-            if (rootIndex >= 0 && rootIndex <= model.nodes.size())
+            if (rootIndex >= 0 && rootIndex < model.nodes.size())
             {
-                LoadNode(model, model.nodes[static_cast<std::size_t>(rootIndex)], worldTransform, result);
+                LoadNode(model, model.nodes[static_cast<std::size_t>(rootIndex)], worldTransform, meshInstances);
             }
         }
     }
 
     void GltfModelBuilder::LoadNode(
-        const CesiumGltf::Model& model, const CesiumGltf::Node& node, const glm::dmat4& parentTransform, GltfLoadModel& result)
+        const CesiumGltf::Model& model,
+        const CesiumGltf::Node& node,
+        const glm::dmat4& parentTransform,
+        AZStd::vector<MeshInstance>& meshInstances)
     {
         glm::dmat4 currentTransform = parentTransform;
         if (node.matrix.size() == 16 && !IsIdentityMatrix(node.matrix))
@@ -133,49 +320,217 @@ namespace Cesium
             }
         }
 
-        if (node.mesh >= 0 && node.mesh <= model.meshes.size())
+        // a node scaled to zero is hidden, and its transform can't be inverted to place it relative to other instances
+        if (node.mesh >= 0 && node.mesh < model.meshes.size() && MathHelper::IsInvertibleMatrix(currentTransform))
         {
-            LoadMesh(model, static_cast<std::size_t>(node.mesh), currentTransform, result);
+            MeshInstance& meshInstance = meshInstances.emplace_back(static_cast<std::size_t>(node.mesh), currentTransform);
+            LoadGpuInstances(model, node, meshInstance.m_instanceTransforms);
         }
 
         for (std::int32_t child : node.children)
         {
             if (child >= 0 && child < model.nodes.size())
             {
-                LoadNode(model, model.nodes[static_cast<std::size_t>(child)], currentTransform, result);
+                LoadNode(model, model.nodes[static_cast<std::size_t>(child)], currentTransform, meshInstances);
             }
         }
     }
 
     void GltfModelBuilder::LoadMesh(
-        const CesiumGltf::Model& model, std::size_t meshIndex, const glm::dmat4& transform, GltfLoadModel& result)
+        const CesiumGltf::Model& model,
+        const CesiumGltf::Model& materialModel,
+        const GltfModelBuilderOption& option,
+        const MeshInstance& meshInstance,
+        GltfLoadMesh& gltfLoadMesh,
+        GltfLoadModel& result)
     {
-        const CesiumGltf::Mesh& mesh = model.meshes[meshIndex];
-        GltfLoadMesh& gltfLoadMesh = result.m_meshes[meshIndex];
-        gltfLoadMesh.m_transform = transform;
+        if (!gltfLoadMesh.IsEmpty())
+        {
+            // the mesh is already loaded for another node, so the node is drawn as more instances of the same model
+            AddMeshInstance(meshInstance, gltfLoadMesh);
+            return;
+        }
+
+        const CesiumGltf::Mesh& mesh = model.meshes[meshInstance.m_meshIndex];
+        gltfLoadMesh.m_transform = meshInstance.m_transform;
+        gltfLoadMesh.m_instanceTransforms = meshInstance.m_instanceTransforms;
         gltfLoadMesh.m_primitives.reserve(mesh.primitives.size());
+
+        // share one builder between primitives so that its vertex buffer is reused instead of reallocated
+        GltfTrianglePrimitiveBuilder primitiveBuilder{ option.m_primitiveBuilderOption };
+        GltfPointPrimitiveBuilder pointPrimitiveBuilder{ option.m_pointPrimitiveBuilderOption };
+        GltfLinePrimitiveBuilder linePrimitiveBuilder{ option.m_linePrimitiveBuilderOption };
         for (const CesiumGltf::MeshPrimitive& primitive : mesh.primitives)
         {
-            // create material asset
-            const CesiumGltf::Material* material = model.getSafe<CesiumGltf::Material>(&model.materials, primitive.material);
-            if (!material)
+            // points and lines don't use the glTF material. Their builders create a material for each primitive
+            if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS)
+            {
+                GltfLoadPrimitive& loadPrimitive = gltfLoadMesh.m_primitives.emplace_back();
+                pointPrimitiveBuilder.Create(model, primitive, result.m_materials, loadPrimitive);
+                continue;
+            }
+
+            if (GltfAccessorGather::IsLineMode(primitive.mode))
             {
+                GltfLoadPrimitive& loadPrimitive = gltfLoadMesh.m_primitives.emplace_back();
+                linePrimitiveBuilder.Create(model, primitive, result.m_materials, loadPrimitive);
                 continue;
             }
 
-            GltfLoadMaterial& loadMaterial = result.m_materials[primitive.material];
-            if (loadMaterial.IsEmpty())
+            // create material asset
+            GltfLoadMaterial* loadMaterial = LoadMaterial(materialModel, primitive.material, result);
+            if (!loadMaterial)
             {
-                m_materialBuilder->Create(model, *material, result.m_textures, loadMaterial);
+                continue;
             }
 
             // load primitive
             GltfLoadPrimitive& loadPrimitive = gltfLoadMesh.m_primitives.emplace_back();
-            GltfTrianglePrimitiveBuilder primitiveBuilder;
-            primitiveBuilder.Create(model, primitive, loadMaterial, loadPrimitive);
+            primitiveBuilder.Create(model, primitive, *loadMaterial, loadPrimitive);
         }
     }
 
+    void GltfModelBuilder::LoadMergedMeshes(
+        const CesiumGltf::Model& model,
+        const CesiumGltf::Model& materialModel,
+        const GltfModelBuilderOption& option,
+        const AZStd::vector<MeshInstance>& meshInstances,
+        GltfLoadModel& result)
+    {
+        // Primitives that share the same material and UV formats can be concatenated without converting their attributes.
+        // Each group is placed at the transform of its first primitive, and the other primitives are baked relative to it,
+        // so that the vertices stay close to the origin and keep their float precision
+        struct PrimitiveGroup
+        {
+            std::int32_t m_materialId;
+            AZStd::array<std::int32_t, 2> m_uvComponentTypes;
+            glm::dmat4 m_transform;
+            glm::dmat4 m_inverseTransform;
+            AZStd::vector<GltfTrianglePrimitiveBuilder::PrimitivePart> m_parts;
+        };
+
+        // Meshes that are instanced are not merged. Their instances share one model instead of duplicating the vertices
+        AZStd::vector<std::size_t> meshReferenceCounts(model.meshes.size(), 0);
+        for (const MeshInstance& meshInstance : meshInstances)
+        {
+            ++meshReferenceCounts[meshInstance.m_meshIndex];
+        }
+
+        AZStd::unordered_map<std::size_t, std::size_t> instancedMeshes;
+        AZStd::vector<PrimitiveGroup> groups;
+        GltfPointPrimitiveBuilder pointPrimitiveBuilder{ option.m_pointPrimitiveBuilderOption };
+        GltfLinePrimitiveBuilder linePrimitiveBuilder{ option.m_linePrimitiveBuilderOption };
+        for (const MeshInstance& meshInstance : meshInstances)
+        {
+            if (!meshInstance.m_instanceTransforms.empty() || meshReferenceCounts[meshInstance.m_meshIndex] > 1)
+            {
+                auto instancedMesh = instancedMeshes.find(meshInstance.m_meshIndex);
+                if (instancedMesh == instancedMeshes.end())
+                {
+                    instancedMesh = instancedMeshes.emplace(meshInstance.m_meshIndex, result.m_meshes.size()).first;
+                    result.m_meshes.emplace_back();
+                }
+
+                LoadMesh(model, materialModel, option, meshInstance, result.m_meshes[instancedMesh->second], result);
+                continue;
+            }
+
+            const CesiumGltf::Mesh& mesh = model.meshes[meshInstance.m_meshIndex];
+            for (const CesiumGltf::MeshPrimitive& primitive : mesh.primitives)
+            {
+                // points and lines are not concatenated, since each primitive has its own material
+                if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS)
+                {
+                    GltfLoadMesh& pointMesh = result.m_meshes.emplace_back();
+                    pointMesh.m_transform = meshInstance.m_transform;
+                    pointPrimitiveBuilder.Create(model, primitive, result.m_materials, pointMesh.m_primitives.emplace_back());
+                    continue;
+                }
+
+                if (GltfAccessorGather::IsLineMode(primitive.mode))
+                {
+                    GltfLoadMesh& lineMesh = result.m_meshes.emplace_back();
+                    lineMesh.m_transform = meshInstance.m_transform;
+                    linePrimitiveBuilder.Create(model, primitive, result.m_materials, lineMesh.m_primitives.emplace_back());
+                    continue;
+                }
+
+                if (!LoadMaterial(materialModel, primitive.material, result))
+                {
+                    continue;
+                }
+
+                AZStd::array<std::int32_t, 2> uvComponentTypes;
+                for (std::size_t i = 0; i < uvComponentTypes.size(); ++i)
+                {
+                    uvComponentTypes[i] = -1;
+                    auto uvAttribute = primitive.attributes.find("TEXCOORD_" + std::to_string(i));
+                    if (uvAttribute == primitive.attributes.end())
+                    {
+                        continue;
+                    }
+
+                    const CesiumGltf::Accessor* uvAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, uvAttribute->second);
+                    if (uvAccessor)
+                    {
+                        uvComponentTypes[i] = uvAccessor->componentType;
+                    }
+                }
+
+                PrimitiveGroup* group = nullptr;
+                for (PrimitiveGroup& existingGroup : groups)
+                {
+                    if (existingGroup.m_materialId == primitive.material && existingGroup.m_uvComponentTypes == uvComponentTypes)
+                    {
+                        group = &existingGroup;
+                        break;
+                    }
+                }
+
+                if (!group)
+                {
+                    group = &groups.emplace_back();
+                    group->m_materialId = primitive.material;
+                    group->m_uvComponentTypes = uvComponentTypes;
+                    group->m_transform = meshInstance.m_transform;
+                    group->m_inverseTransform = glm::inverse(meshInstance.m_transform);
+                }
+
+                group->m_parts.emplace_back(primitive, group->m_inverseTransform * meshInstance.m_transform);
+            }
+        }
+
+        // share one builder between groups so that its vertex buffer is reused instead of reallocated
+        GltfTrianglePrimitiveBuilder primitiveBuilder{ option.m_primitiveBuilderOption };
+        result.m_meshes.reserve(groups.size());
+        for (const PrimitiveGroup& group : groups)
+        {
+            GltfLoadMesh& gltfLoadMesh = result.m_meshes.emplace_back();
+            gltfLoadMesh.m_transform = group.m_transform;
+
+            GltfLoadPrimitive& loadPrimitive = gltfLoadMesh.m_primitives.emplace_back();
+            const GltfLoadMaterial& loadMaterial = result.m_materials[static_cast<std::size_t>(group.m_materialId)];
+            primitiveBuilder.Create(model, group.m_parts, loadMaterial, loadPrimitive);
+        }
+    }
+
+    GltfLoadMaterial* GltfModelBuilder::LoadMaterial(const CesiumGltf::Model& model, std::int32_t materialIndex, GltfLoadModel& result)
+    {
+        const CesiumGltf::Material* material = model.getSafe<CesiumGltf::Material>(&model.materials, materialIndex);
+        if (!material)
+        {
+            return nullptr;
+        }
+
+        GltfLoadMaterial& loadMaterial = result.m_materials[static_cast<std::size_t>(materialIndex)];
+        if (loadMaterial.IsEmpty())
+        {
+            m_materialBuilder->Create(model, *material, result.m_textures, loadMaterial);
+        }
+
+        return &loadMaterial;
+    }
+
     void GltfModelBuilder::ResolveExternalImages(
         const AZStd::string& parentPath, const CesiumGltfReader::GltfReader& gltfReader, CesiumGltf::Model& model, GenericIOManager& io)
     {
@@ -229,14 +584,188 @@ namespace Cesium
             IORequestParameter param;
             param.m_parentPath = parentPath;
             param.m_path = std::move(path);
-            auto content = io.GetFileContent(param);
+            IOContent content = io.GetFileContent(param);
             if (content.empty())
             {
                 continue;
             }
 
-            buffer.cesium.data.resize(content.size());
-            std::memcpy(buffer.cesium.data.data(), content.data(), content.size());
+            buffer.cesium.data = std::move(content);
+        }
+    }
+
+    CesiumAsync::Future<std::vector<bool>> GltfModelBuilder::ResolveExternalResourcesAsync(
+        const CesiumAsync::AsyncSystem& asyncSystem,
+        const AZStd::string& parentPath,
+        const std::shared_ptr<CesiumGltf::Model>& model,
+        GenericIOManager& io)
+    {
+        // Every request is in flight at the same time. Each continuation only writes to its own image or buffer,
+        // so they can decode in parallel without locking the model
+        std::vector<CesiumAsync::Future<bool>> requests;
+        for (std::size_t i = 0; i < model->images.size(); ++i)
+        {
+            const CesiumGltf::Image& image = model->images[i];
+            if (!image.cesium.pixelData.empty() || !image.uri.has_value())
+            {
+                continue;
+            }
+
+            IORequestParameter param{ parentPath, image.uri.value().c_str() };
+            requests.emplace_back(io.GetFileContentAsync(asyncSystem, std::move(param))
+                                      .thenInWorkerThread(
+                                          [model, i](IOContent&& content)
+                                          {
+                                              return ReadExternalImage(content, model->images[i]);
+                                          }));
+        }
+
+        for (std::size_t i = 0; i < model->buffers.size(); ++i)
+        {
+            const CesiumGltf::Buffer& buffer = model->buffers[i];
+            if (!buffer.cesium.data.empty() || !buffer.uri.has_value())
+            {
+                continue;
+            }
+
+            IORequestParameter param{ parentPath, buffer.uri.value().c_str() };
+            requests.emplace_back(io.GetFileContentAsync(asyncSystem, std::move(param))
+                                      .thenInWorkerThread(
+                                          [model, i](IOContent&& content)
+                                          {
+                                              if (content.empty())
+                                              {
+                                                  return false;
+                                              }
+
+                                              model->buffers[i].cesium.data = std::move(content);
+                                              return true;
+                                          }));
+        }
+
+        return asyncSystem.all(std::move(requests));
+    }
+
+    bool GltfModelBuilder::ReadExternalImage(const IOContent& content, CesiumGltf::Image& image)
+    {
+        if (content.empty())
+        {
+            return false;
+        }
+
+        CesiumGltfReader::GltfReader reader;
+        auto readResult = reader.readImage(gsl::span<const std::byte>(content.data(), content.size()));
+        if (!readResult.image)
+        {
+            return false;
+        }
+
+        image.cesium = std::move(*readResult.image);
+        return true;
+    }
+
+    void GltfModelBuilder::LoadGpuInstances(
+        const CesiumGltf::Model& model, const CesiumGltf::Node& node, AZStd::vector<glm::dmat4>& instanceTransforms)
+    {
+        const CesiumUtility::JsonValue* extension = node.getGenericExtension(EXT_MESH_GPU_INSTANCING);
+        if (!extension)
+        {
+            return;
+        }
+
+        const CesiumUtility::JsonValue* attributes = extension->getValuePtrForKey("attributes");
+        if (!attributes)
+        {
+            return;
+        }
+
+        // retrieve instance attributes. Only float attributes are supported at the moment
+        auto getAccessorIndex = [attributes](const char* name) -> std::int32_t
+        {
+            const CesiumUtility::JsonValue* value = attributes->getValuePtrForKey(name);
+            if (!value)
+            {
+                return -1;
+            }
+
+            return value->getSafeNumber<std::int32_t>().value_or(-1);
+        };
+
+        CesiumGltf::AccessorView<glm::vec3> translations{ model, getAccessorIndex("TRANSLATION") };
+        CesiumGltf::AccessorView<glm::vec4> rotations{ model, getAccessorIndex("ROTATION") };
+        CesiumGltf::AccessorView<glm::vec3> scales{ model, getAccessorIndex("SCALE") };
+        bool hasTranslations = translations.status() == CesiumGltf::AccessorViewStatus::Valid;
+        bool hasRotations = rotations.status() == CesiumGltf::AccessorViewStatus::Valid;
+        bool hasScales = scales.status() == CesiumGltf::AccessorViewStatus::Valid;
+
+        // every attribute must have the same number of instances
+        std::int64_t instanceCount = 0;
+        if (hasTranslations)
+        {
+            instanceCount = translations.size();
+        }
+        else if (hasRotations)
+        {
+            instanceCount = rotations.size();
+        }
+        else if (hasScales)
+        {
+            instanceCount = scales.size();
+        }
+
+        if ((hasTranslations && translations.size() != instanceCount) || (hasRotations && rotations.size() != instanceCount) ||
+            (hasScales && scales.size() != instanceCount))
+        {
+            return;
+        }
+
+        if (instanceCount <= 0)
+        {
+            return;
+        }
+
+        instanceTransforms.reserve(static_cast<std::size_t>(instanceCount));
+        for (std::int64_t i = 0; i < instanceCount; ++i)
+        {
+            glm::dmat4 instanceTransform{ 1.0 };
+            if (hasTranslations)
+            {
+                instanceTransform = glm::translate(instanceTransform, glm::dvec3(translations[i]));
+            }
+
+            if (hasRotations)
+            {
+                const glm::vec4& rotation = rotations[i];
+                instanceTransform *= glm::dmat4(glm::dquat(rotation.w, rotation.x, rotation.y, rotation.z));
+            }
+
+            if (hasScales)
+            {
+                instanceTransform = glm::scale(instanceTransform, glm::dvec3(scales[i]));
+            }
+
+            instanceTransforms.emplace_back(instanceTransform);
+        }
+    }
+
+    void GltfModelBuilder::AddMeshInstance(const MeshInstance& meshInstance, GltfLoadMesh& gltfLoadMesh)
+    {
+        // the existing single instance becomes an explicit one before adding the others
+        if (gltfLoadMesh.m_instanceTransforms.empty())
+        {
+            gltfLoadMesh.m_instanceTransforms.emplace_back(1.0);
+        }
+
+        glm::dmat4 relativeTransform = glm::inverse(gltfLoadMesh.m_transform) * meshInstance.m_transform;
+        if (meshInstance.m_instanceTransforms.empty())
+        {
+            gltfLoadMesh.m_instanceTransforms.emplace_back(relativeTransform);
+            return;
+        }
+
+        for (const glm::dmat4& instanceTransform : meshInstance.m_instanceTransforms)
+        {
+            gltfLoadMesh.m_instanceTransforms.emplace_back(relativeTransform * instanceTransform);
         }
     }
 
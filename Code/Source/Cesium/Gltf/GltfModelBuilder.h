@@ -1,10 +1,19 @@
 #pragma once
 
 #include "Cesium/Gltf/GltfMaterialBuilder.h"
+#include "Cesium/Gltf/GltfPrimitiveBuilder.h"
+#include "Cesium/Gltf/GltfPointPrimitiveBuilder.h"
+#include "Cesium/Gltf/GltfLinePrimitiveBuilder.h"
 #include <AzCore/std/string/string.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/containers/vector.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/Future.h>
 #include <glm/glm.hpp>
+#include <memory>
+#include <optional>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
 namespace CesiumGltf
@@ -12,6 +21,7 @@ namespace CesiumGltf
     struct Model;
     struct Scene;
     struct Node;
+    struct Image;
 } // namespace CesiumGltf
 
 namespace CesiumGltfReader
@@ -23,31 +33,95 @@ namespace Cesium
 {
     class GenericIOManager;
     struct GltfLoadModel;
+    struct GltfLoadMaterial;
+    struct GltfLoadMesh;
 
     struct GltfModelBuilderOption
     {
         GltfModelBuilderOption(const glm::dmat4& transform);
 
         glm::dmat4 m_transform;
+
+        // Merge primitives that share the same material and vertex layout into a single primitive, so that the model needs less
+        // draw calls. Node transforms are baked into the vertices of the merged primitives
+        bool m_mergePrimitives;
+
+        GltfTrianglePrimitiveBuilderOption m_primitiveBuilderOption;
+
+        GltfPointPrimitiveBuilderOption m_pointPrimitiveBuilderOption;
+
+        GltfLinePrimitiveBuilderOption m_linePrimitiveBuilderOption;
     };
 
     class GltfModelBuilder
     {
+        struct MeshInstance final
+        {
+            MeshInstance(std::size_t meshIndex, const glm::dmat4& transform);
+
+            std::size_t m_meshIndex;
+            glm::dmat4 m_transform;
+
+            // instance transforms of EXT_mesh_gpu_instancing relative to m_transform
+            AZStd::vector<glm::dmat4> m_instanceTransforms;
+        };
+
     public:
         GltfModelBuilder(AZStd::unique_ptr<GltfMaterialBuilder> materialBuilder);
 
         void Create(GenericIOManager& io, const AZStd::string& modelPath, const GltfModelBuilderOption& option, GltfLoadModel& result);
 
+        // Read the model and its external images and buffers concurrently, then decode and build it on worker threads.
+        // The builder must outlive the returned future. The result is empty if the model cannot be read
+        CesiumAsync::Future<std::optional<GltfLoadModel>> CreateAsync(
+            const CesiumAsync::AsyncSystem& asyncSystem,
+            GenericIOManager& io,
+            const AZStd::string& modelPath,
+            const GltfModelBuilderOption& option);
+
         void Create(const CesiumGltf::Model& model, const GltfModelBuilderOption& option, GltfLoadModel& result);
 
     private:
+        // Copy the parts of the model that meshes are built from. Images, textures and animations are left out
+        static CesiumGltf::Model CopyGeometry(const CesiumGltf::Model& model);
+
+        // ownedModel is the same model as model when the builder is allowed to free its buffers once they are read.
+        // Materials are built from materialModel, which only differs from model when model is a copy of its geometry
+        void LoadModel(
+            const CesiumGltf::Model& model,
+            const CesiumGltf::Model& materialModel,
+            const GltfModelBuilderOption& option,
+            CesiumGltf::Model* ownedModel,
+            GltfLoadModel& result);
+
         void LoadScene(
-            const CesiumGltf::Model& model, const CesiumGltf::Scene& scene, const GltfModelBuilderOption& option, GltfLoadModel& result);
+            const CesiumGltf::Model& model,
+            const CesiumGltf::Scene& scene,
+            const glm::dmat4& worldTransform,
+            AZStd::vector<MeshInstance>& meshInstances);
 
         void LoadNode(
-            const CesiumGltf::Model& model, const CesiumGltf::Node& node, const glm::dmat4& parentTransform, GltfLoadModel& loadModel);
-
-        void LoadMesh(const CesiumGltf::Model& model, std::size_t meshIndex, const glm::dmat4& transform, GltfLoadModel& loadModel);
+            const CesiumGltf::Model& model,
+            const CesiumGltf::Node& node,
+            const glm::dmat4& parentTransform,
+            AZStd::vector<MeshInstance>& meshInstances);
+
+        void LoadMesh(
+            const CesiumGltf::Model& model,
+            const CesiumGltf::Model& materialModel,
+            const GltfModelBuilderOption& option,
+            const MeshInstance& meshInstance,
+            GltfLoadMesh& gltfLoadMesh,
+            GltfLoadModel& loadModel);
+
+        void LoadMergedMeshes(
+            const CesiumGltf::Model& model,
+            const CesiumGltf::Model& materialModel,
+            const GltfModelBuilderOption& option,
+            const AZStd::vector<MeshInstance>& meshInstances,
+            GltfLoadModel& loadModel);
+
+        GltfLoadMaterial* LoadMaterial(const CesiumGltf::Model& model, std::int32_t materialIndex, GltfLoadModel& loadModel);
 
         void ResolveExternalImages(
             const AZStd::string& parentPath,
@@ -57,8 +131,27 @@ namespace Cesium
 
         void ResolveExternalBuffers(const AZStd::string& parentPath, CesiumGltf::Model& model, GenericIOManager& io);
 
+        static CesiumAsync::Future<std::vector<bool>> ResolveExternalResourcesAsync(
+            const CesiumAsync::AsyncSystem& asyncSystem,
+            const AZStd::string& parentPath,
+            const std::shared_ptr<CesiumGltf::Model>& model,
+            GenericIOManager& io);
+
+        static void FindBuffersLastUse(
+            const CesiumGltf::Model& model, const AZStd::vector<MeshInstance>& meshInstances, AZStd::vector<std::size_t>& buffersLastUse);
+
+        static bool ReadExternalImage(const std::vector<std::byte>& content, CesiumGltf::Image& image);
+
+        static void LoadGpuInstances(
+            const CesiumGltf::Model& model, const CesiumGltf::Node& node, AZStd::vector<glm::dmat4>& instanceTransforms);
+
+        static void AddMeshInstance(const MeshInstance& meshInstance, GltfLoadMesh& gltfLoadMesh);
+
         static bool IsIdentityMatrix(const std::vector<double>& matrix);
 
+        static constexpr char EXT_MESH_GPU_INSTANCING[] = "EXT_mesh_gpu_instancing";
+        static constexpr char KHR_TEXTURE_BASISU[] = "KHR_texture_basisu";
+
         static constexpr glm::dmat4 GLTF_TO_O3DE =
             glm::dmat4(1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, -1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0);
 
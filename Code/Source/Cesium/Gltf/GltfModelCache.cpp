@@ -0,0 +1,160 @@
+#include "Cesium/Gltf/GltfModelCache.h"
+#include "Cesium/Gltf/GltfBakedModelAsset.h"
+#include "Cesium/Gltf/GltfModelBuilder.h"
+#include "Cesium/Gltf/GltfPBRMaterialBuilder.h"
+#include "Cesium/Gltf/GltfLoadContext.h"
+#include <AzCore/Asset/AssetManager.h>
+#include <AzCore/Asset/AssetManagerBus.h>
+
+namespace Cesium
+{
+    GltfModelCache::Entry::Entry()
+        : m_model{}
+        , m_pendingLoad{}
+        , m_loadId{ 0 }
+    {
+    }
+
+    GltfModelCache::GltfModelCache(const std::shared_ptr<CesiumAsync::ITaskProcessor>& taskProcessor)
+        : m_asyncSystem{ taskProcessor }
+        , m_lastLoadId{ 0 }
+    {
+    }
+
+    CesiumAsync::SharedFuture<std::shared_ptr<const GltfLoadModel>> GltfModelCache::Load(
+        GenericIOManager& io, const AZStd::string& filePath, std::uint32_t generatedLodCount)
+    {
+        // the options change the built assets, so they are part of the key
+        AZStd::string key = AZStd::string::format("%u:%s", generatedLodCount, filePath.c_str());
+        auto entryIt = m_entries.find(key);
+        if (entryIt != m_entries.end())
+        {
+            if (entryIt->second.m_pendingLoad)
+            {
+                return *entryIt->second.m_pendingLoad;
+            }
+
+            if (std::shared_ptr<const GltfLoadModel> model = entryIt->second.m_model.lock())
+            {
+                return m_asyncSystem.createResolvedFuture(std::move(model)).share();
+            }
+        }
+
+        // products are baked with the default options
+        AZ::Data::AssetId bakedModelAssetId = generatedLodCount == 0 ? FindBakedModel(filePath) : AZ::Data::AssetId{};
+        GltfModelBuilderOption option{ glm::dmat4(1.0) };
+        option.m_primitiveBuilderOption.m_generatedLodCount = generatedLodCount;
+        std::shared_ptr<GltfModelBuilder> builder;
+        if (!bakedModelAssetId.IsValid())
+        {
+            builder = std::make_shared<GltfModelBuilder>(AZStd::make_unique<GltfPBRMaterialBuilder>());
+        }
+
+        // The entry is claimed by this load before the continuation is attached, since the continuation may complete before the
+        // pending future is stored. The continuation only updates the entry if it still belongs to this load
+        std::uint64_t loadId = ++m_lastLoadId;
+        Entry& newEntry = m_entries[key];
+        newEntry.m_model.reset();
+        newEntry.m_pendingLoad.reset();
+        newEntry.m_loadId = loadId;
+
+        CesiumAsync::Future<std::optional<GltfLoadModel>> modelFuture =
+            builder ? builder->CreateAsync(m_asyncSystem, io, filePath, option) : LoadBakedModelAsync(bakedModelAssetId);
+        CesiumAsync::SharedFuture<std::shared_ptr<const GltfLoadModel>> load =
+            std::move(modelFuture)
+                .thenInMainThread(
+                    [this, builder, key, loadId](std::optional<GltfLoadModel>&& loadModel)
+                    {
+                        std::shared_ptr<const GltfLoadModel> model;
+                        if (loadModel)
+                        {
+                            model = std::make_shared<const GltfLoadModel>(std::move(*loadModel));
+                        }
+
+                        auto loadEntryIt = m_entries.find(key);
+                        if (loadEntryIt == m_entries.end() || loadEntryIt->second.m_loadId != loadId)
+                        {
+                            return model;
+                        }
+
+                        // the pending load holds a strong reference to the model, so only the weak one is kept from now on.
+                        // Failed loads are not cached, so that they are retried
+                        if (model)
+                        {
+                            Entry& entry = loadEntryIt->second;
+                            entry.m_model = model;
+                            entry.m_pendingLoad.reset();
+                            entry.m_loadId = 0;
+                        }
+                        else
+                        {
+                            m_entries.erase(loadEntryIt);
+                        }
+
+                        return model;
+                    })
+                .share();
+
+        // the load is only pending if its continuation hasn't completed yet
+        auto pendingEntryIt = m_entries.find(key);
+        if (pendingEntryIt != m_entries.end() && pendingEntryIt->second.m_loadId == loadId)
+        {
+            pendingEntryIt->second.m_pendingLoad = load;
+        }
+
+        return load;
+    }
+
+    CesiumAsync::Future<std::optional<GltfLoadModel>> GltfModelCache::LoadBakedModelAsync(const AZ::Data::AssetId& bakedModelAssetId)
+    {
+        AZ::Data::Asset<GltfBakedModelAsset> bakedModel =
+            AZ::Data::AssetManager::Instance().GetAsset<GltfBakedModelAsset>(bakedModelAssetId, AZ::Data::AssetLoadBehavior::PreLoad);
+        return m_asyncSystem.runInWorkerThread(
+            [bakedModel]() mutable -> std::optional<GltfLoadModel>
+            {
+                // the model, material and image assets are preloaded, so they are ready as soon as the baked model is
+                bakedModel.BlockUntilLoadComplete();
+                if (!bakedModel.IsReady())
+                {
+                    AZ_Warning("GltfModelCache", false, "Failed to load the baked glTF model %s", bakedModel.GetHint().c_str());
+                    return std::nullopt;
+                }
+
+                GltfLoadModel loadModel;
+                bakedModel->CreateLoadModel(loadModel);
+                return loadModel;
+            });
+    }
+
+    AZ::Data::AssetId GltfModelCache::FindBakedModel(const AZStd::string& filePath)
+    {
+        // only paths relative to the asset folders match a product. Other paths are converted at runtime
+        AZStd::string productPath = GltfBakedModelAsset::GetProductPath(filePath);
+        AZ::Data::AssetId assetId;
+        AZ::Data::AssetCatalogRequestBus::BroadcastResult(
+            assetId,
+            &AZ::Data::AssetCatalogRequestBus::Events::GetAssetIdByPath,
+            productPath.c_str(),
+            azrtti_typeid<GltfBakedModelAsset>(),
+            false);
+        return assetId;
+    }
+
+    void GltfModelCache::DispatchMainThreadTasks()
+    {
+        m_asyncSystem.dispatchMainThreadTasks();
+
+        // drop the entries of the models that are no longer displayed by any entity
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            if (!it->second.m_pendingLoad && it->second.m_model.expired())
+            {
+                it = m_entries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+} // namespace Cesium
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/string/string.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/ITaskProcessor.h>
+#include <CesiumAsync/Future.h>
+#include <CesiumAsync/SharedFuture.h>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace Cesium
+{
+    class GenericIOManager;
+    struct GltfLoadModel;
+
+    // Models built from the same file with the same options are shared between the entities that display them. The cache only
+    // holds weak references, so a model is released once the last entity using it drops its pointer. Must be used on the main thread
+    class GltfModelCache final
+    {
+        struct Entry
+        {
+            Entry();
+
+            std::weak_ptr<const GltfLoadModel> m_model;
+            std::optional<CesiumAsync::SharedFuture<std::shared_ptr<const GltfLoadModel>>> m_pendingLoad;
+
+            // identifies the load that is still running for the entry, or 0 once it completed
+            std::uint64_t m_loadId;
+        };
+
+    public:
+        GltfModelCache(const std::shared_ptr<CesiumAsync::ITaskProcessor>& taskProcessor);
+
+        // Return the model that is already loaded or being loaded, or start loading it. The result is null if the model cannot be read.
+        // Files that the Asset Processor baked are loaded from their products, unless LODs need to be generated.
+        // Continuations on the main thread run when DispatchMainThreadTasks is called
+        CesiumAsync::SharedFuture<std::shared_ptr<const GltfLoadModel>> Load(
+            GenericIOManager& io, const AZStd::string& filePath, std::uint32_t generatedLodCount);
+
+        void DispatchMainThreadTasks();
+
+    private:
+        CesiumAsync::Future<std::optional<GltfLoadModel>> LoadBakedModelAsync(const AZ::Data::AssetId& bakedModelAssetId);
+
+        static AZ::Data::AssetId FindBakedModel(const AZStd::string& filePath);
+
+        CesiumAsync::AsyncSystem m_asyncSystem;
+        AZStd::unordered_map<AZStd::string, Entry> m_entries;
+        std::uint64_t m_lastLoadId;
+    };
+} // namespace Cesium
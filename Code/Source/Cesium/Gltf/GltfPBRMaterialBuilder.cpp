@@ -1,11 +1,12 @@
 #include "Cesium/Gltf/GltfPBRMaterialBuilder.h"
+#include "Cesium/Gltf/StreamingImageBuilder.h"
+#include "Cesium/Gltf/Ktx2Reader.h"
 #include "Cesium/Systems/CesiumSystem.h"
 #include "Cesium/Systems/CriticalAssetManager.h"
 #include <Atom/RPI.Reflect/Material/MaterialAssetCreator.h>
 #include <Atom/RPI.Reflect/Material/MaterialAsset.h>
+#include <Atom/RPI.Reflect/Material/MaterialPropertiesLayout.h>
 #include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
-#include <Atom/RPI.Reflect/Image/StreamingImageAssetCreator.h>
-#include <Atom/RPI.Reflect/Image/ImageMipChainAssetCreator.h>
 
 // Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
 // This only happens with unity build
@@ -21,11 +22,66 @@
 
 namespace Cesium
 {
+    namespace
+    {
+        // Atom has no 3-channel 8-bit format, so RGB images are uploaded with an opaque alpha
+        AZStd::vector<std::byte> ExpandRgbToRgba(const CesiumGltf::ImageCesium& imageData)
+        {
+            std::size_t pixelCount = imageData.pixelData.size() / 3;
+            AZStd::vector<std::byte> pixels(pixelCount * 4);
+            const std::byte* source = imageData.pixelData.data();
+            std::byte* destination = pixels.data();
+            for (std::size_t i = 0; i < pixelCount; ++i, source += 3, destination += 4)
+            {
+                destination[0] = source[0];
+                destination[1] = source[1];
+                destination[2] = source[2];
+                destination[3] = static_cast<std::byte>(255);
+            }
+
+            return pixels;
+        }
+
+        // Whether a format that KTX2 images are uploaded in stores the blue channel, where glTF puts metallic
+        bool HasBlueChannel(AZ::RHI::Format format)
+        {
+            switch (format)
+            {
+            case AZ::RHI::Format::R8_UNORM:
+            case AZ::RHI::Format::BC4_UNORM:
+            case AZ::RHI::Format::BC5_UNORM:
+            case AZ::RHI::Format::EAC_R11_UNORM:
+            case AZ::RHI::Format::EAC_RG11_UNORM:
+                return false;
+            default:
+                return true;
+            }
+        }
+    } // namespace
+
+    GltfPBRMaterialBuilder::GltfPBRMaterialBuilder(TextureCompressionQuality textureCompression)
+        : m_textureCompression{ textureCompression }
+    {
+    }
+
     const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& GltfPBRMaterialBuilder::GetDefaultMaterialType() const
     {
         return CesiumInterface::Get()->GetCriticalAssetManager().m_standardPbrMaterialType;
     }
 
+    void GltfPBRMaterialBuilder::PackMetallicRoughness(
+        const AZStd::span<const std::byte>& source, std::uint32_t channelCount, AZStd::span<std::byte> destination)
+    {
+        // roughness (G) and metallic (B) go to the red and green channels. Bytes are copied one by one, so that the layout doesn't
+        // depend on the endianness of the host
+        const std::byte* pixel = source.data();
+        for (std::size_t i = 0; i < destination.size(); i += 2, pixel += channelCount)
+        {
+            destination[i + PACKED_ROUGHNESS_CHANNEL] = pixel[1];
+            destination[i + PACKED_METALLIC_CHANNEL] = pixel[2];
+        }
+    }
+
     void GltfPBRMaterialBuilder::OverrideMaterialType(const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& materialType)
     {
         m_overrideMaterialTypeAsset = materialType;
@@ -48,11 +104,16 @@ namespace Cesium
             materialTypeAsset = GetDefaultMaterialType();
         }
 
-        AZ::Data::AssetId materialAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
+        AZ::Data::AssetId materialAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId();
         AZ::RPI::MaterialAssetCreator materialCreator;
         materialCreator.Begin(materialAssetId, materialTypeAsset, true);
 
-        ConfigurePbrMetallicRoughness(model, material, textureCache, materialCreator);
+        // material types that can select the channel of the metallic and roughness maps sample them from the same image
+        bool packMetallicRoughness =
+            materialTypeAsset->GetMaterialPropertiesLayout()->FindPropertyIndex(AZ::Name("metallic.textureMapChannel")).IsValid() &&
+            materialTypeAsset->GetMaterialPropertiesLayout()->FindPropertyIndex(AZ::Name("roughness.textureMapChannel")).IsValid();
+
+        ConfigurePbrMetallicRoughness(model, material, packMetallicRoughness, textureCache, materialCreator);
         ConfigureOcclusion(model, material, textureCache, materialCreator);
         ConfigureEmissive(model, material, textureCache, materialCreator);
         ConfigureOpacity(material, materialCreator);
@@ -68,6 +129,7 @@ namespace Cesium
     void GltfPBRMaterialBuilder::ConfigurePbrMetallicRoughness(
         const CesiumGltf::Model& model,
         const CesiumGltf::Material& material,
+        bool packMetallicRoughness,
         TextureCache& textureCache,
         AZ::RPI::MaterialAssetCreator& materialCreator)
     {
@@ -124,10 +186,14 @@ namespace Cesium
         const std::optional<CesiumGltf::TextureInfo>& metallicRoughnessTexture = pbrMetallicRoughness->metallicRoughnessTexture;
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> metallicImage;
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> roughnessImage;
+        std::uint32_t metallicChannel = PACKED_METALLIC_CHANNEL;
+        std::uint32_t roughnessChannel = PACKED_ROUGHNESS_CHANNEL;
         std::int64_t metallicRoughnessTexCoord = -1;
         if (metallicRoughnessTexture)
         {
-            GetOrCreateMetallicRoughnessImage(model, *metallicRoughnessTexture, metallicImage, roughnessImage, textureCache);
+            GetOrCreateMetallicRoughnessImage(
+                model, *metallicRoughnessTexture, packMetallicRoughness, metallicImage, roughnessImage, metallicChannel, roughnessChannel,
+                textureCache);
             metallicRoughnessTexCoord = metallicRoughnessTexture->texCoord;
         }
 
@@ -136,6 +202,10 @@ namespace Cesium
             materialCreator.SetPropertyValue(AZ::Name("metallic.useTexture"), true);
             materialCreator.SetPropertyValue(AZ::Name("metallic.textureMapUv"), static_cast<std::uint32_t>(metallicRoughnessTexCoord));
             materialCreator.SetPropertyValue(AZ::Name("metallic.textureMap"), metallicImage);
+            if (packMetallicRoughness)
+            {
+                materialCreator.SetPropertyValue(AZ::Name("metallic.textureMapChannel"), metallicChannel);
+            }
         }
         else
         {
@@ -147,6 +217,10 @@ namespace Cesium
             materialCreator.SetPropertyValue(AZ::Name("roughness.useTexture"), true);
             materialCreator.SetPropertyValue(AZ::Name("roughness.textureMapUv"), static_cast<std::uint32_t>(metallicRoughnessTexCoord));
             materialCreator.SetPropertyValue(AZ::Name("roughness.textureMap"), roughnessImage);
+            if (packMetallicRoughness)
+            {
+                materialCreator.SetPropertyValue(AZ::Name("roughness.textureMapChannel"), roughnessChannel);
+            }
         }
         else
         {
@@ -256,6 +330,12 @@ namespace Cesium
             return {};
         }
 
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> ktx2Image = GetOrCreateKtx2Image(model, *texture, textureCache);
+        if (ktx2Image)
+        {
+            return ktx2Image;
+        }
+
         const CesiumGltf::Image* image = model.getSafe<CesiumGltf::Image>(&model.images, texture->source);
         if (!image || image->cesium.pixelData.empty())
         {
@@ -280,7 +360,7 @@ namespace Cesium
         const CesiumGltf::ImageCesium& imageData = image->cesium;
         std::uint32_t width = static_cast<std::uint32_t>(imageData.width);
         std::uint32_t height = static_cast<std::uint32_t>(imageData.height);
-        if (imageData.bytesPerChannel != 1 || imageData.channels < 1)
+        if (imageData.bytesPerChannel != 1 || imageData.channels < 1 || imageData.channels > 4)
         {
             return {};
         }
@@ -290,20 +370,21 @@ namespace Cesium
             return {};
         }
 
-        // Do the fast path. Copy the whole data over
-        if (imageData.channels == 1)
+        // Occlusion is the red channel. Images of one or two channels are sampled as they are, but RGB and RGBA images, which are
+        // usually packed with metallic and roughness, are reduced to their red channel so that they take a byte per pixel
+        if (imageData.channels <= 2)
         {
-            newImage = Create2DImage(imageData.pixelData.data(), imageData.pixelData.size(), width, height, AZ::RHI::Format::R8_UNORM);
+            AZ::RHI::Format format = imageData.channels == 1 ? AZ::RHI::Format::R8_UNORM : AZ::RHI::Format::R8G8_UNORM;
+            newImage = Create2DImage(imageData.pixelData.data(), imageData.pixelData.size(), width, height, format);
         }
         else
         {
-            // Just copy the red channel
-            std::size_t j = 0;
-            AZStd::vector<std::byte> pixels(width * height);
-            for (std::size_t i = 0; i < imageData.pixelData.size(); i += imageData.channels * imageData.bytesPerChannel)
+            std::size_t pixelCount = std::size_t{ width } * height;
+            AZStd::vector<std::byte> pixels(pixelCount);
+            const std::byte* source = imageData.pixelData.data();
+            for (std::size_t i = 0; i < pixelCount; ++i, source += imageData.channels)
             {
-                pixels[j] = imageData.pixelData[i];
-                ++j;
+                pixels[i] = source[0];
             }
 
             newImage = Create2DImage(pixels.data(), pixels.size(), width, height, AZ::RHI::Format::R8_UNORM);
@@ -322,6 +403,12 @@ namespace Cesium
             return {};
         }
 
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> ktx2Image = GetOrCreateKtx2Image(model, *texture, textureCache);
+        if (ktx2Image)
+        {
+            return ktx2Image;
+        }
+
         const CesiumGltf::Image* image = model.getSafe<CesiumGltf::Image>(&model.images, texture->source);
         if (!image || image->cesium.pixelData.empty())
         {
@@ -358,15 +445,7 @@ namespace Cesium
 
         if (imageData.channels == 3)
         {
-            AZStd::vector<std::byte> pixels(width * height * 4);
-            for (std::size_t i = 0; i < imageData.pixelData.size(); i += 3)
-            {
-                pixels[i] = imageData.pixelData[i];
-                pixels[i + 1] = imageData.pixelData[i + 1];
-                pixels[i + 2] = imageData.pixelData[i + 2];
-                pixels[i + 3] = static_cast<std::byte>(255);
-            }
-
+            AZStd::vector<std::byte> pixels = ExpandRgbToRgba(imageData);
             newImage = Create2DImage(pixels.data(), pixels.size(), width, height, AZ::RHI::Format::R8G8B8A8_UNORM_SRGB);
         }
         else
@@ -382,19 +461,37 @@ namespace Cesium
     void GltfPBRMaterialBuilder::GetOrCreateMetallicRoughnessImage(
         const CesiumGltf::Model& model,
         const CesiumGltf::TextureInfo& textureInfo,
+        bool packMetallicRoughness,
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset>& metallic,
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset>& roughness,
+        std::uint32_t& metallicChannel,
+        std::uint32_t& roughnessChannel,
         TextureCache& textureCache)
     {
-        static const std::int32_t roughnessTextureSubIdx = 0;
-        static const std::int32_t metallicTextureSubIdx = 1;
-
         const CesiumGltf::Texture* texture = model.getSafe<CesiumGltf::Texture>(&model.textures, textureInfo.index);
         if (!texture)
         {
             return;
         }
 
+        // KTX2 images are uploaded as they are, so both maps sample their glTF channel of the same image. That needs a material type
+        // that selects the channel, and a format that has the blue channel
+        if (packMetallicRoughness)
+        {
+            AZ::Data::Asset<AZ::RPI::StreamingImageAsset> ktx2Image = GetOrCreateKtx2Image(model, *texture, textureCache);
+            if (ktx2Image && HasBlueChannel(ktx2Image->GetImageDescriptor().m_format))
+            {
+                metallic = ktx2Image;
+                roughness = ktx2Image;
+                metallicChannel = GLTF_METALLIC_CHANNEL;
+                roughnessChannel = GLTF_ROUGHNESS_CHANNEL;
+                return;
+            }
+        }
+
+        metallicChannel = PACKED_METALLIC_CHANNEL;
+        roughnessChannel = PACKED_ROUGHNESS_CHANNEL;
+
         const CesiumGltf::Image* image = model.getSafe<CesiumGltf::Image>(&model.images, texture->source);
         if (!image || image->cesium.pixelData.empty())
         {
@@ -407,15 +504,29 @@ namespace Cesium
         }
 
         // Lookup cache
+        TextureId packedImageIdx = AZStd::string::format("MetallicRoughness_%d", texture->source);
         TextureId roughnessImageIdx = AZStd::string::format("Roughness_%d", texture->source);
         TextureId metallicImageIdx = AZStd::string::format("Metallic_%d", texture->source);
-        auto cachedRoughness = textureCache.find(roughnessImageIdx);
-        auto cachedMetallic = textureCache.find(metallicImageIdx);
-        if (cachedRoughness != textureCache.end() && cachedMetallic != textureCache.end())
+        if (packMetallicRoughness)
         {
-            roughness = cachedRoughness->second.m_imageAsset;
-            metallic = cachedMetallic->second.m_imageAsset;
-            return;
+            auto cachedPacked = textureCache.find(packedImageIdx);
+            if (cachedPacked != textureCache.end())
+            {
+                metallic = cachedPacked->second.m_imageAsset;
+                roughness = cachedPacked->second.m_imageAsset;
+                return;
+            }
+        }
+        else
+        {
+            auto cachedRoughness = textureCache.find(roughnessImageIdx);
+            auto cachedMetallic = textureCache.find(metallicImageIdx);
+            if (cachedRoughness != textureCache.end() && cachedMetallic != textureCache.end())
+            {
+                roughness = cachedRoughness->second.m_imageAsset;
+                metallic = cachedMetallic->second.m_imageAsset;
+                return;
+            }
         }
 
         // Create new assets if caches are not found
@@ -432,14 +543,28 @@ namespace Cesium
             return;
         }
 
-        std::size_t j = 0;
-        AZStd::vector<std::byte> metallicPixels(width * height);
-        AZStd::vector<std::byte> roughnessPixels(width * height);
-        for (std::size_t i = 0; i < imageData.pixelData.size(); i += imageData.channels * imageData.bytesPerChannel)
+        std::size_t pixelCount = std::size_t{ width } * height;
+        const std::byte* source = imageData.pixelData.data();
+        if (packMetallicRoughness)
+        {
+            AZStd::vector<std::byte> pixels(pixelCount * 2);
+            PackMetallicRoughness(
+                AZStd::span<const std::byte>(imageData.pixelData.data(), imageData.pixelData.size()),
+                static_cast<std::uint32_t>(imageData.channels), AZStd::span<std::byte>(pixels.data(), pixels.size()));
+
+            auto packedCache = textureCache.insert(
+                { packedImageIdx, Create2DImage(pixels.data(), pixels.size(), width, height, AZ::RHI::Format::R8G8_UNORM) });
+            metallic = packedCache.first->second.m_imageAsset;
+            roughness = packedCache.first->second.m_imageAsset;
+            return;
+        }
+
+        AZStd::vector<std::byte> metallicPixels(pixelCount);
+        AZStd::vector<std::byte> roughnessPixels(pixelCount);
+        for (std::size_t i = 0; i < pixelCount; ++i, source += imageData.channels)
         {
-            roughnessPixels[j] = imageData.pixelData[i + 1];
-            metallicPixels[j] = imageData.pixelData[i + 2];
-            ++j;
+            roughnessPixels[i] = source[1];
+            metallicPixels[i] = source[2];
         }
 
         auto metallicCache = textureCache.insert(
@@ -450,38 +575,59 @@ namespace Cesium
         roughness = roughnessCache.first->second.m_imageAsset;
     }
 
+    AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GltfPBRMaterialBuilder::GetOrCreateKtx2Image(
+        const CesiumGltf::Model& model, const CesiumGltf::Texture& texture, TextureCache& textureCache)
+    {
+        const CesiumUtility::JsonValue* extension = texture.getGenericExtension(TEXTURE_BASISU_EXTENSION);
+        if (!extension)
+        {
+            return {};
+        }
+
+        const CesiumUtility::JsonValue* sourceValue = extension->getValuePtrForKey("source");
+        std::int32_t source = sourceValue ? sourceValue->getSafeNumber<std::int32_t>().value_or(-1) : -1;
+        const CesiumGltf::Image* image = model.getSafe<CesiumGltf::Image>(&model.images, source);
+        if (!image)
+        {
+            return {};
+        }
+
+        // Lookup cache
+        TextureId imageSourceIdx = AZStd::string::format("Ktx2_%d", source);
+        auto cachedAsset = textureCache.find(imageSourceIdx);
+        if (cachedAsset != textureCache.end())
+        {
+            return cachedAsset->second.m_imageAsset;
+        }
+
+        // The glTF reader doesn't decode KTX2 images, so their levels are read from the buffer view they are embedded in and
+        // uploaded as they are
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> newImage;
+        const CesiumGltf::BufferView* bufferView = model.getSafe<CesiumGltf::BufferView>(&model.bufferViews, image->bufferView);
+        const CesiumGltf::Buffer* buffer = bufferView ? model.getSafe<CesiumGltf::Buffer>(&model.buffers, bufferView->buffer) : nullptr;
+        if (buffer && bufferView->byteOffset >= 0 && bufferView->byteLength >= 0 &&
+            bufferView->byteOffset + bufferView->byteLength <= static_cast<std::int64_t>(buffer->cesium.data.size()))
+        {
+            AZStd::span<const std::byte> data(
+                buffer->cesium.data.data() + bufferView->byteOffset, static_cast<std::size_t>(bufferView->byteLength));
+            Ktx2Image ktx2Image;
+            if (Ktx2Reader::Read(data, ktx2Image) && StreamingImageBuilder::IsFormatSupported(ktx2Image.m_format))
+            {
+                newImage = StreamingImageBuilder::CreateFromMips(
+                    ktx2Image.m_mips, ktx2Image.m_width, ktx2Image.m_height, ktx2Image.m_format);
+            }
+        }
+
+        // images that can't be used are cached too, so that the texture falls back to its regular source without reading them again
+        auto cache = textureCache.insert({ imageSourceIdx, std::move(newImage) });
+        return cache.first->second.m_imageAsset;
+    }
+
     AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GltfPBRMaterialBuilder::Create2DImage(
         const std::byte* pixelData, std::size_t bytesPerImage, std::uint32_t width, std::uint32_t height, AZ::RHI::Format format)
     {
-        // image has 4 channels, so we just copy the data over
-        AZ::RHI::ImageDescriptor imageDesc;
-        imageDesc.m_bindFlags = AZ::RHI::ImageBindFlags::ShaderRead;
-        imageDesc.m_dimension = AZ::RHI::ImageDimension::Image2D;
-        imageDesc.m_size = AZ::RHI::Size(width, height, 1);
-        imageDesc.m_format = format;
-
-        AZ::RHI::ImageSubresourceLayout imageSubresourceLayout = AZ::RHI::GetImageSubresourceLayout(imageDesc, AZ::RHI::ImageSubresource{});
-
-        // Create mip chain
-        AZ::Data::AssetId imageMipChainAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
-        AZ::RPI::ImageMipChainAssetCreator mipChainCreator;
-        mipChainCreator.Begin(imageMipChainAssetId, 1, 1);
-        mipChainCreator.BeginMip(imageSubresourceLayout);
-        mipChainCreator.AddSubImage(pixelData, bytesPerImage);
-        mipChainCreator.EndMip();
-        AZ::Data::Asset<AZ::RPI::ImageMipChainAsset> mipChainAsset;
-        mipChainCreator.End(mipChainAsset);
-
-        // Create streaming image
-        AZ::Data::AssetId imageAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
-        AZ::RPI::StreamingImageAssetCreator imageCreator;
-        imageCreator.Begin(imageAssetId);
-        imageCreator.SetImageDescriptor(imageDesc);
-        imageCreator.AddMipChainAsset(*mipChainAsset);
-        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset;
-        imageCreator.End(imageAsset);
-
-        return imageAsset;
+        return StreamingImageBuilder::Create(
+            AZStd::span<const std::byte>(pixelData, bytesPerImage), width, height, format, m_textureCompression);
     }
 } // namespace Cesium
 
@@ -2,15 +2,20 @@
 
 #include "Cesium/Gltf/GltfMaterialBuilder.h"
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/TextureBlockCompressor.h"
 #include <Atom/RPI.Reflect/Material/MaterialTypeAsset.h>
 #include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/containers/span.h>
 #include <AzCore/std/containers/unordered_map.h>
+#include <cstddef>
+#include <cstdint>
 
 namespace CesiumGltf
 {
     struct Model;
     struct Material;
     struct TextureInfo;
+    struct Texture;
 } // namespace CesiumGltf
 
 namespace AZ
@@ -30,6 +35,8 @@ namespace Cesium
         using TextureCache = AZStd::unordered_map<TextureId, GltfLoadTexture>;
 
     public:
+        explicit GltfPBRMaterialBuilder(TextureCompressionQuality textureCompression = TextureCompressionQuality::None);
+
         const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& GetDefaultMaterialType() const override;
 
         void OverrideMaterialType(const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& materialType) override;
@@ -40,10 +47,16 @@ namespace Cesium
             AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache,
             GltfLoadMaterial& result) override;
 
+        // Pack the roughness (G) and metallic (B) channels of an 8-bit image of 3 or 4 channels into an RG8 image, which the material
+        // samples by channel. destination holds 2 bytes per pixel
+        static void PackMetallicRoughness(
+            const AZStd::span<const std::byte>& source, std::uint32_t channelCount, AZStd::span<std::byte> destination);
+
     private:
         void ConfigurePbrMetallicRoughness(
             const CesiumGltf::Model& model,
             const CesiumGltf::Material& material,
+            bool packMetallicRoughness,
             TextureCache& textureCache,
             AZ::RPI::MaterialAssetCreator& materialCreator);
 
@@ -67,18 +80,34 @@ namespace Cesium
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GetOrCreateRGBAImage(
             const CesiumGltf::Model& model, const CesiumGltf::TextureInfo& textureInfo, TextureCache& textureCache);
 
+        // Metallic and roughness are either sampled from channels of a single image, which is the KTX2 image of the texture or an RG8
+        // image they are packed in, or split into an image each. The channels are only set for a single image
         void GetOrCreateMetallicRoughnessImage(
             const CesiumGltf::Model& model,
             const CesiumGltf::TextureInfo& textureInfo,
+            bool packMetallicRoughness,
             AZ::Data::Asset<AZ::RPI::StreamingImageAsset>& metallic,
             AZ::Data::Asset<AZ::RPI::StreamingImageAsset>& roughness,
+            std::uint32_t& metallicChannel,
+            std::uint32_t& roughnessChannel,
             TextureCache& textureCache);
 
+        // Image of the KHR_texture_basisu extension of the texture, when it is a KTX2 image that the GPU can sample as is
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GetOrCreateKtx2Image(
+            const CesiumGltf::Model& model, const CesiumGltf::Texture& texture, TextureCache& textureCache);
+
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> Create2DImage(
             const std::byte* pixelData, std::size_t bytesPerImage, std::uint32_t width, std::uint32_t height, AZ::RHI::Format format);
 
         AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_overrideMaterialTypeAsset;
+        TextureCompressionQuality m_textureCompression;
 
         static constexpr const char* const MATERIALS_UNLIT_EXTENSION = "KHR_materials_unlit";
+        static constexpr const char* const TEXTURE_BASISU_EXTENSION = "KHR_texture_basisu";
+
+        static constexpr std::uint32_t PACKED_ROUGHNESS_CHANNEL = 0;
+        static constexpr std::uint32_t PACKED_METALLIC_CHANNEL = 1;
+        static constexpr std::uint32_t GLTF_ROUGHNESS_CHANNEL = 1;
+        static constexpr std::uint32_t GLTF_METALLIC_CHANNEL = 2;
     };
 } // namespace Cesium
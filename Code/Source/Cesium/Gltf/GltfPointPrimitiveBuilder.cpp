@@ -0,0 +1,459 @@
+#include "Cesium/Gltf/GltfPointPrimitiveBuilder.h"
+#include "Cesium/Gltf/GltfAccessorGather.h"
+#include "Cesium/Systems/CesiumSystem.h"
+#include "Cesium/Systems/CriticalAssetManager.h"
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAsset.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAssetCreator.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAssetCreator.h>
+#include <Atom/RPI.Reflect/Model/ModelAssetCreator.h>
+#include <Atom/RPI.Reflect/Material/MaterialAssetCreator.h>
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/span.h>
+
+// Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
+// This only happens with unity build
+#include <AzCore/PlatformDef.h>
+#ifdef AZ_COMPILER_MSVC
+#pragma push_macro("OPAQUE")
+#undef OPAQUE
+#endif
+
+#include <CesiumGltf/Model.h>
+#include <CesiumGltf/MeshPrimitive.h>
+#include <CesiumGltf/AccessorView.h>
+
+#ifdef AZ_COMPILER_MSVC
+#pragma pop_macro("OPAQUE")
+#endif
+
+#include <cmath>
+#include <limits>
+
+namespace Cesium
+{
+    static_assert(sizeof(GltfPointPrimitiveBuilder::PointRecord) == 16, "PointRecord must match the records read by the shader");
+
+    GltfPointPrimitiveBuilderOption::GltfPointPrimitiveBuilderOption()
+        : m_pointSize{ 0.1f }
+        , m_attenuation{ true }
+        , m_spacingScale{ 1.0f }
+        , m_maximumPointSize{ 5.0f }
+    {
+    }
+
+    GltfPointPrimitiveBuilder::GltfPointPrimitiveBuilder()
+        : GltfPointPrimitiveBuilder(GltfPointPrimitiveBuilderOption{})
+    {
+    }
+
+    GltfPointPrimitiveBuilder::GltfPointPrimitiveBuilder(const GltfPointPrimitiveBuilderOption& option)
+        : m_option{ option }
+        , m_positionAccessor{ nullptr }
+        , m_colorAccessor{ nullptr }
+        , m_intensityAccessor{ nullptr }
+        , m_classificationAccessor{ nullptr }
+        , m_pointCount{ 0 }
+        , m_minimum{ 0.0f }
+        , m_extent{ 0.0f }
+        , m_indexFormat{ AZ::RHI::Format::R16_UINT }
+    {
+    }
+
+    void GltfPointPrimitiveBuilder::Create(
+        const CesiumGltf::Model& model,
+        const CesiumGltf::MeshPrimitive& primitive,
+        AZStd::vector<GltfLoadMaterial>& materials,
+        GltfLoadPrimitive& result)
+    {
+        Reset();
+
+        auto positionAttribute = primitive.attributes.find("POSITION");
+        if (positionAttribute == primitive.attributes.end())
+        {
+            return;
+        }
+
+        m_positionAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, positionAttribute->second);
+        if (!m_positionAccessor || m_positionAccessor->type != CesiumGltf::AccessorSpec::Type::VEC3 || m_positionAccessor->count <= 0)
+        {
+            return;
+        }
+
+        // points are white until their colors are written
+        m_pointCount = static_cast<std::size_t>(m_positionAccessor->count);
+        m_records.resize(m_pointCount, PointRecord{ glm::u16vec3{ 0 }, 0, glm::u8vec4{ 255 }, 0 });
+        DetermineOptionalAttributes(model, primitive);
+        if (!CreatePositionsAttribute(model))
+        {
+            return;
+        }
+
+        CreateColorsAttribute(model);
+        CreateIntensitiesAttribute(model);
+        CreateClassificationsAttribute(model);
+        if (m_pointCount <= MAX_POINTS_PER_CHUNK)
+        {
+            CreateIndices<std::uint16_t>();
+        }
+        else
+        {
+            CreateIndices<std::uint32_t>();
+        }
+
+        AZ::RPI::ModelAssetCreator modelCreator;
+        modelCreator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId());
+        modelCreator.AddLodAsset(CreateLodAsset(CreateIndexBufferAsset()));
+
+        AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset;
+        modelCreator.End(modelAsset);
+
+        result.m_modelAsset = std::move(modelAsset);
+        result.m_materialId = static_cast<MaterialId>(materials.size());
+        GltfLoadMaterial& material = materials.emplace_back(CreateMaterial());
+        material.m_shaderBuffers.emplace_back(AZ::Name("m_points"), CreateRecordsBufferAsset());
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelLodAsset> GltfPointPrimitiveBuilder::CreateLodAsset(
+        const AZ::Data::Asset<AZ::RPI::BufferAsset>& indexBufferAsset)
+    {
+        AZ::RPI::ModelLodAssetCreator lodCreator;
+        lodCreator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId());
+        lodCreator.AddLodStreamBuffer(indexBufferAsset);
+
+        // every chunk is a mesh of the LOD that draws its range of the indices. The meshes have no vertex streams, since the shader
+        // reads the records of the points from the material
+        for (std::size_t chunk = 0; chunk < m_chunkAabbs.size(); ++chunk)
+        {
+            std::size_t firstPoint = chunk * MAX_POINTS_PER_CHUNK;
+            std::size_t pointCount = AZStd::min(MAX_POINTS_PER_CHUNK, m_pointCount - firstPoint);
+            AZ::RHI::BufferViewDescriptor indicesBufferView = AZ::RHI::BufferViewDescriptor::CreateTyped(
+                static_cast<std::uint32_t>(firstPoint * VERTICES_PER_POINT), static_cast<std::uint32_t>(pointCount * VERTICES_PER_POINT),
+                m_indexFormat);
+
+            lodCreator.BeginMesh();
+            lodCreator.SetMeshIndexBuffer(AZ::RPI::BufferAssetView(indexBufferAsset, indicesBufferView));
+            lodCreator.SetMeshAabb(AZ::Aabb(m_chunkAabbs[chunk]));
+            lodCreator.EndMesh();
+        }
+
+        AZ::Data::Asset<AZ::RPI::ModelLodAsset> lodAsset;
+        lodCreator.End(lodAsset);
+        return lodAsset;
+    }
+
+    void GltfPointPrimitiveBuilder::DetermineOptionalAttributes(const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive)
+    {
+        auto findAccessor = [&](const std::string& name) -> const CesiumGltf::Accessor*
+        {
+            auto attribute = primitive.attributes.find(name);
+            if (attribute == primitive.attributes.end())
+            {
+                return nullptr;
+            }
+
+            const CesiumGltf::Accessor* accessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, attribute->second);
+            if (!accessor || accessor->count != m_positionAccessor->count)
+            {
+                return nullptr;
+            }
+
+            return accessor;
+        };
+
+        // colors are always converted to RGBA8. glTF only allows float and normalized unsigned colors
+        const CesiumGltf::Accessor* colorAccessor = findAccessor("COLOR_0");
+        if (colorAccessor &&
+            (colorAccessor->type == CesiumGltf::AccessorSpec::Type::VEC3 || colorAccessor->type == CesiumGltf::AccessorSpec::Type::VEC4) &&
+            (colorAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::FLOAT ||
+             colorAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE ||
+             colorAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT))
+        {
+            m_colorAccessor = colorAccessor;
+        }
+
+        // intensities are stored as 16-bit unorm
+        const CesiumGltf::Accessor* intensityAccessor = findAccessor("_INTENSITY");
+        if (intensityAccessor && intensityAccessor->type == CesiumGltf::AccessorSpec::Type::SCALAR &&
+            (intensityAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE ||
+             intensityAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT ||
+             intensityAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::FLOAT))
+        {
+            m_intensityAccessor = intensityAccessor;
+        }
+
+        // classifications are class ids, so only unsigned integers are kept
+        const CesiumGltf::Accessor* classificationAccessor = findAccessor("_CLASSIFICATION");
+        if (classificationAccessor && classificationAccessor->type == CesiumGltf::AccessorSpec::Type::SCALAR &&
+            (classificationAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE ||
+             classificationAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT))
+        {
+            m_classificationAccessor = classificationAccessor;
+        }
+    }
+
+    bool GltfPointPrimitiveBuilder::CreatePositionsAttribute(const CesiumGltf::Model& model)
+    {
+        // Positions that are already quantized by KHR_mesh_quantization are dequantized by the node transform. They are quantized
+        // again in the bounding box of the primitive, which is as precise for 8 and 16-bit sources
+        AZStd::vector<glm::vec3> positions;
+        if (!GltfAccessorGather::GatherPositions(model, *m_positionAccessor, positions))
+        {
+            return false;
+        }
+
+        glm::vec3 minimum{ std::numeric_limits<float>::max() };
+        glm::vec3 maximum{ std::numeric_limits<float>::lowest() };
+        for (const glm::vec3& position : positions)
+        {
+            minimum = glm::min(minimum, position);
+            maximum = glm::max(maximum, position);
+        }
+
+        m_minimum = minimum;
+        m_extent = maximum - minimum;
+        glm::vec3 quantizationScale{ 0.0f };
+        for (glm::length_t axis = 0; axis < 3; ++axis)
+        {
+            if (m_extent[axis] > 0.0f)
+            {
+                quantizationScale[axis] = 1.0f / m_extent[axis];
+            }
+        }
+
+        // the triangle of a point extends up to its diameter around the point
+        float maximumDiameter = m_option.m_attenuation ? m_option.m_maximumPointSize : m_option.m_pointSize;
+        AZ::Vector3 diameter{ maximumDiameter };
+
+        m_chunkAabbs.resize((m_pointCount + MAX_POINTS_PER_CHUNK - 1) / MAX_POINTS_PER_CHUNK, AZ::Aabb::CreateNull());
+        for (std::size_t i = 0; i < m_pointCount; ++i)
+        {
+            const glm::vec3& position = positions[i];
+            glm::vec3 normalizedPosition = (position - m_minimum) * quantizationScale;
+            m_records[i].m_position = glm::u16vec3{ GltfAccessorGather::ToUnorm<std::uint16_t>(normalizedPosition.x),
+                                                    GltfAccessorGather::ToUnorm<std::uint16_t>(normalizedPosition.y),
+                                                    GltfAccessorGather::ToUnorm<std::uint16_t>(normalizedPosition.z) };
+
+            AZ::Vector3 point{ position.x, position.y, position.z };
+            m_chunkAabbs[i / MAX_POINTS_PER_CHUNK].AddAabb(AZ::Aabb::CreateFromMinMax(point - diameter, point + diameter));
+        }
+
+        return true;
+    }
+
+    void GltfPointPrimitiveBuilder::CreateColorsAttribute(const CesiumGltf::Model& model)
+    {
+        AZStd::vector<glm::u8vec4> colors;
+        if (!m_colorAccessor || !GltfAccessorGather::GatherColors(model, *m_colorAccessor, colors) || colors.size() != m_pointCount)
+        {
+            return;
+        }
+
+        for (std::size_t i = 0; i < m_pointCount; ++i)
+        {
+            m_records[i].m_color = colors[i];
+        }
+    }
+
+    void GltfPointPrimitiveBuilder::CreateIntensitiesAttribute(const CesiumGltf::Model& model)
+    {
+        if (!m_intensityAccessor)
+        {
+            return;
+        }
+
+        // 8-bit intensities are widened so that 255 stays the maximum intensity
+        switch (m_intensityAccessor->componentType)
+        {
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
+            CopyScalarAttribute<std::uint8_t>(
+                model, *m_intensityAccessor,
+                [](PointRecord& record, std::uint8_t value)
+                {
+                    record.m_intensity = static_cast<std::uint16_t>(value * 257);
+                });
+            break;
+        case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
+            CopyScalarAttribute<std::uint16_t>(
+                model, *m_intensityAccessor,
+                [](PointRecord& record, std::uint16_t value)
+                {
+                    record.m_intensity = value;
+                });
+            break;
+        case CesiumGltf::AccessorSpec::ComponentType::FLOAT:
+            CopyScalarAttribute<float>(
+                model, *m_intensityAccessor,
+                [](PointRecord& record, float value)
+                {
+                    record.m_intensity = GltfAccessorGather::ToUnorm<std::uint16_t>(value);
+                });
+            break;
+        default:
+            break;
+        }
+    }
+
+    void GltfPointPrimitiveBuilder::CreateClassificationsAttribute(const CesiumGltf::Model& model)
+    {
+        if (!m_classificationAccessor)
+        {
+            return;
+        }
+
+        auto setClassification = [](PointRecord& record, auto value)
+        {
+            record.m_classification = static_cast<std::uint32_t>(value);
+        };
+
+        if (m_classificationAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE)
+        {
+            CopyScalarAttribute<std::uint8_t>(model, *m_classificationAccessor, setClassification);
+        }
+        else if (m_classificationAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT)
+        {
+            CopyScalarAttribute<std::uint16_t>(model, *m_classificationAccessor, setClassification);
+        }
+    }
+
+    template<typename SourceType, typename SetValue>
+    void GltfPointPrimitiveBuilder::CopyScalarAttribute(
+        const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, SetValue&& setValue)
+    {
+        // the records keep their default value if the accessor cannot be read
+        CesiumGltf::AccessorView<SourceType> values{ model, accessor };
+        if (values.status() != CesiumGltf::AccessorViewStatus::Valid)
+        {
+            return;
+        }
+
+        for (std::size_t i = 0; i < m_pointCount; ++i)
+        {
+            setValue(m_records[i], values[static_cast<std::int64_t>(i)]);
+        }
+    }
+
+    template<typename IndexType>
+    void GltfPointPrimitiveBuilder::CreateIndices()
+    {
+        m_indexFormat = sizeof(IndexType) == sizeof(std::uint16_t) ? AZ::RHI::Format::R16_UINT : AZ::RHI::Format::R32_UINT;
+        m_indices.resize(m_pointCount * VERTICES_PER_POINT * sizeof(IndexType));
+
+        AZStd::span<IndexType> indices(reinterpret_cast<IndexType*>(m_indices.data()), m_pointCount * VERTICES_PER_POINT);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            indices[i] = static_cast<IndexType>(i);
+        }
+    }
+
+    AZ::Data::Asset<AZ::RPI::BufferAsset> GltfPointPrimitiveBuilder::CreateRecordsBufferAsset() const
+    {
+        AZ::RHI::BufferViewDescriptor bufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateStructured(
+            0, static_cast<std::uint32_t>(m_records.size()), static_cast<std::uint32_t>(sizeof(PointRecord)));
+
+        AZ::RHI::BufferDescriptor bufferDescriptor;
+        bufferDescriptor.m_bindFlags = AZ::RHI::BufferBindFlags::ShaderRead;
+        bufferDescriptor.m_byteCount = m_records.size() * sizeof(PointRecord);
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> bufferAsset;
+        AZ::RPI::BufferAssetCreator creator;
+        creator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId());
+        creator.SetBuffer(m_records.data(), bufferDescriptor.m_byteCount, bufferDescriptor);
+        creator.SetBufferViewDescriptor(bufferViewDescriptor);
+        creator.SetUseCommonPool(AZ::RPI::CommonBufferPoolType::ReadOnly);
+        creator.End(bufferAsset);
+        return bufferAsset;
+    }
+
+    AZ::Data::Asset<AZ::RPI::BufferAsset> GltfPointPrimitiveBuilder::CreateIndexBufferAsset() const
+    {
+        AZ::RHI::BufferViewDescriptor bufferViewDescriptor =
+            AZ::RHI::BufferViewDescriptor::CreateTyped(0, static_cast<std::uint32_t>(m_indices.size()), AZ::RHI::Format::R8_UINT);
+
+        AZ::RHI::BufferDescriptor bufferDescriptor;
+        bufferDescriptor.m_bindFlags = AZ::RHI::BufferBindFlags::InputAssembly | AZ::RHI::BufferBindFlags::ShaderRead;
+        bufferDescriptor.m_byteCount = m_indices.size();
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> bufferAsset;
+        AZ::RPI::BufferAssetCreator creator;
+        creator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId());
+        creator.SetBuffer(m_indices.data(), bufferDescriptor.m_byteCount, bufferDescriptor);
+        creator.SetBufferViewDescriptor(bufferViewDescriptor);
+        creator.SetUseCommonPool(AZ::RPI::CommonBufferPoolType::StaticInputAssembly);
+        creator.End(bufferAsset);
+        return bufferAsset;
+    }
+
+    GltfLoadMaterial GltfPointPrimitiveBuilder::CreateMaterial() const
+    {
+        AZ::RPI::MaterialAssetCreator materialCreator;
+        materialCreator.Begin(
+            CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId(),
+            CesiumInterface::Get()->GetCriticalAssetManager().m_pointCloudMaterialType, true);
+        materialCreator.SetPropertyValue(AZ::Name("pointCloud.positionOffset"), AZ::Vector3(m_minimum.x, m_minimum.y, m_minimum.z));
+        materialCreator.SetPropertyValue(AZ::Name("pointCloud.positionScale"), AZ::Vector3(m_extent.x, m_extent.y, m_extent.z));
+        materialCreator.SetPropertyValue(AZ::Name("pointCloud.pointSize"), m_option.m_pointSize);
+        materialCreator.SetPropertyValue(AZ::Name("pointCloud.attenuation"), m_option.m_attenuation);
+        materialCreator.SetPropertyValue(AZ::Name("pointCloud.pointSpacing"), EstimatePointSpacing(m_extent, m_pointCount));
+        materialCreator.SetPropertyValue(AZ::Name("pointCloud.spacingScale"), m_option.m_spacingScale);
+        materialCreator.SetPropertyValue(AZ::Name("pointCloud.maximumPointSize"), m_option.m_maximumPointSize);
+
+        // display the richest stream that the points have
+        std::uint32_t colorMode = 0;
+        if (!m_colorAccessor && m_intensityAccessor)
+        {
+            colorMode = 1;
+        }
+        else if (!m_colorAccessor && m_classificationAccessor)
+        {
+            colorMode = 2;
+        }
+
+        materialCreator.SetPropertyValue(AZ::Name("pointCloud.colorMode"), colorMode);
+
+        AZ::Data::Asset<AZ::RPI::MaterialAsset> materialAsset;
+        materialCreator.End(materialAsset);
+        return GltfLoadMaterial(std::move(materialAsset), false);
+    }
+
+    void GltfPointPrimitiveBuilder::Reset()
+    {
+        m_positionAccessor = nullptr;
+        m_colorAccessor = nullptr;
+        m_intensityAccessor = nullptr;
+        m_classificationAccessor = nullptr;
+        m_pointCount = 0;
+        m_minimum = glm::vec3{ 0.0f };
+        m_extent = glm::vec3{ 0.0f };
+        m_chunkAabbs.clear();
+        m_indexFormat = AZ::RHI::Format::R16_UINT;
+        m_records.clear();
+        m_indices.clear();
+    }
+
+    float GltfPointPrimitiveBuilder::EstimatePointSpacing(const glm::vec3& extent, std::size_t pointCount)
+    {
+        // The points are assumed to be evenly spread in their bounding box. Scans are often flat, so the axes that are much
+        // thinner than the others are left out, otherwise the spacing of a flat scan would be close to 0
+        float largestExtent = AZStd::max(extent.x, AZStd::max(extent.y, extent.z));
+        if (largestExtent <= 0.0f || pointCount == 0)
+        {
+            return 0.0f;
+        }
+
+        float volume = 1.0f;
+        float dimensionCount = 0.0f;
+        for (glm::length_t axis = 0; axis < 3; ++axis)
+        {
+            if (extent[axis] > 0.01f * largestExtent)
+            {
+                volume *= extent[axis];
+                dimensionCount += 1.0f;
+            }
+        }
+
+        return std::pow(volume / static_cast<float>(pointCount), 1.0f / dimensionCount);
+    }
+} // namespace Cesium
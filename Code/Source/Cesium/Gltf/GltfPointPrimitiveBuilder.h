@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Cesium/Gltf/GltfLoadContext.h"
+#include <Atom/RHI.Reflect/Format.h>
+#include <AzCore/Math/Aabb.h>
+#include <AzCore/std/containers/vector.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumGltf
+{
+    struct Model;
+    struct Accessor;
+    struct MeshPrimitive;
+} // namespace CesiumGltf
+
+namespace AZ
+{
+    namespace RPI
+    {
+        class ModelLodAsset;
+        class BufferAsset;
+    } // namespace RPI
+
+    namespace Data
+    {
+        template<typename T>
+        class Asset;
+    }
+} // namespace AZ
+
+namespace Cesium
+{
+    struct GltfPointPrimitiveBuilderOption final
+    {
+        GltfPointPrimitiveBuilderOption();
+
+        // Diameter of the points in meters when attenuation is disabled
+        float m_pointSize;
+
+        // Size the points from the average spacing between them, so that the points of coarse tiles cover the same surface
+        // as the points of their children
+        bool m_attenuation;
+        float m_spacingScale;
+        float m_maximumPointSize;
+    };
+
+    // Build POINTS primitives. Every point is stored once, as a record of a structured buffer that the shader reads. Atom only draws
+    // indexed triangle lists, so every point is drawn as three vertices: the vertex id divided by 3 is the point, and its remainder
+    // is the corner of the camera facing triangle. Positions are quantized to 16 bits in the bounding box of the primitive, colors
+    // are RGBA8 and intensities are 16-bit unorm
+    class GltfPointPrimitiveBuilder final
+    {
+    public:
+        // Layout of the records, which has to match PointRecord in GltfPointCloud_Common.azsli
+        struct PointRecord final
+        {
+            glm::u16vec3 m_position;
+            std::uint16_t m_intensity;
+            glm::u8vec4 m_color;
+            std::uint32_t m_classification;
+        };
+
+        GltfPointPrimitiveBuilder();
+
+        GltfPointPrimitiveBuilder(const GltfPointPrimitiveBuilderOption& option);
+
+        // The dequantization, the spacing and the records of the points are bound to the material, so the primitive gets its own
+        // material, which is appended to materials
+        void Create(
+            const CesiumGltf::Model& model,
+            const CesiumGltf::MeshPrimitive& primitive,
+            AZStd::vector<GltfLoadMaterial>& materials,
+            GltfLoadPrimitive& result);
+
+    private:
+        AZ::Data::Asset<AZ::RPI::ModelLodAsset> CreateLodAsset(const AZ::Data::Asset<AZ::RPI::BufferAsset>& indexBufferAsset);
+
+        void DetermineOptionalAttributes(const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive);
+
+        bool CreatePositionsAttribute(const CesiumGltf::Model& model);
+
+        void CreateColorsAttribute(const CesiumGltf::Model& model);
+
+        void CreateIntensitiesAttribute(const CesiumGltf::Model& model);
+
+        void CreateClassificationsAttribute(const CesiumGltf::Model& model);
+
+        template<typename SourceType, typename SetValue>
+        void CopyScalarAttribute(const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, SetValue&& setValue);
+
+        template<typename IndexType>
+        void CreateIndices();
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> CreateRecordsBufferAsset() const;
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> CreateIndexBufferAsset() const;
+
+        GltfLoadMaterial CreateMaterial() const;
+
+        void Reset();
+
+        static float EstimatePointSpacing(const glm::vec3& extent, std::size_t pointCount);
+
+        static constexpr std::size_t VERTICES_PER_POINT = 3;
+
+        // Points are drawn in chunks that are culled with their own bounds. A primitive that fits in one chunk has 16-bit indices
+        static constexpr std::size_t MAX_POINTS_PER_CHUNK = 65535 / VERTICES_PER_POINT;
+
+        GltfPointPrimitiveBuilderOption m_option;
+        const CesiumGltf::Accessor* m_positionAccessor;
+        const CesiumGltf::Accessor* m_colorAccessor;
+        const CesiumGltf::Accessor* m_intensityAccessor;
+        const CesiumGltf::Accessor* m_classificationAccessor;
+        std::size_t m_pointCount;
+        glm::vec3 m_minimum;
+        glm::vec3 m_extent;
+        AZStd::vector<AZ::Aabb> m_chunkAabbs;
+
+        // The indices are the vertex ids, since the draws of the chunks all start at the first vertex. The capacity of the records
+        // and the indices is kept between primitives of the same model
+        AZ::RHI::Format m_indexFormat;
+        AZStd::vector<PointRecord> m_records;
+        AZStd::vector<std::byte> m_indices;
+    };
+} // namespace Cesium
@@ -1,5 +1,11 @@
 #include "Cesium/Gltf/GltfPrimitiveBuilder.h"
 #include "Cesium/Gltf/BitangentAndTangentGenerator.h"
+#include "Cesium/Gltf/GeometryHeap.h"
+#include "Cesium/Gltf/GltfPrimitiveCache.h"
+#include "Cesium/Gltf/IndexBufferOptimizer.h"
+#include "Cesium/Gltf/MeshPartitioner.h"
+#include "Cesium/Gltf/MeshSimplifier.h"
+#include "Cesium/Gltf/TriangleBvh.h"
 #include "Cesium/Systems/CesiumSystem.h"
 #include "Cesium/Systems/CriticalAssetManager.h"
 #include "Cesium/Math/MathHelper.h"
@@ -10,7 +16,12 @@
 #include <Atom/RPI.Reflect/Model/ModelLodAssetCreator.h>
 #include <Atom/RPI.Reflect/Model/ModelAssetCreator.h>
 #include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/Math/Crc.h>
 #include <AzCore/std/limits.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+#include <AzCore/Utils/TypeHash.h>
+#include <AzFramework/Physics/SystemBus.h>
 
 // Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
 // This only happens with unity build
@@ -32,9 +43,110 @@
 #include <cassert>
 #include <cstdint>
 #include <numeric>
+#include <type_traits>
 
 namespace Cesium
 {
+    namespace
+    {
+        // Hash of the content of a primitive, along with a CRC of the same bytes computed with an unrelated algorithm. Both are kept
+        // in the cache key, so that a collision of one of them alone doesn't match two different primitives
+        class PrimitiveHasher final
+        {
+        public:
+            void AddBytes(const void* data, std::size_t size)
+            {
+                m_hash = AZ::TypeHash64(reinterpret_cast<const std::uint8_t*>(data), size, m_hash);
+                m_checksum.Add(data, size);
+            }
+
+            template<typename ValueType>
+            void AddValue(const ValueType& value)
+            {
+                static_assert(std::is_trivially_copyable_v<ValueType>, "Only the bytes of the value are hashed");
+                AddBytes(&value, sizeof(value));
+            }
+
+            void AddString(AZStd::string_view value)
+            {
+                AddValue(value.size());
+                AddBytes(value.data(), value.size());
+            }
+
+            void Finish(GltfPrimitiveCacheKey& key) const
+            {
+                key.m_hash = static_cast<std::uint64_t>(m_hash);
+                key.m_checksum = static_cast<std::uint32_t>(m_checksum);
+            }
+
+        private:
+            AZ::HashValue64 m_hash{ 0 };
+            AZ::Crc32 m_checksum;
+        };
+
+        // Hash the description and the elements of an accessor, and record its description in the key. Return false if the content
+        // cannot be read directly, which is the case of sparse accessors
+        bool HashAccessor(
+            const CesiumGltf::Model& model,
+            std::int32_t accessorIndex,
+            PrimitiveHasher& hasher,
+            AZStd::vector<GltfPrimitiveCacheAccessor>& accessors)
+        {
+            const CesiumGltf::Accessor* accessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, accessorIndex);
+            if (!accessor)
+            {
+                hasher.AddValue(std::int32_t{ -1 });
+                accessors.emplace_back();
+                return true;
+            }
+
+            const CesiumGltf::BufferView* bufferView = model.getSafe<CesiumGltf::BufferView>(&model.bufferViews, accessor->bufferView);
+            const CesiumGltf::Buffer* buffer = bufferView ? model.getSafe<CesiumGltf::Buffer>(&model.buffers, bufferView->buffer) : nullptr;
+            if (accessor->sparse || !buffer || accessor->count < 0)
+            {
+                return false;
+            }
+
+            std::int64_t elementSize = accessor->computeBytesPerVertex();
+            std::int64_t byteStride = accessor->computeByteStride(model);
+            std::int64_t byteOffset = bufferView->byteOffset + accessor->byteOffset;
+            std::int64_t byteLength = accessor->count > 0 ? (accessor->count - 1) * byteStride + elementSize : 0;
+            const std::vector<std::byte>& data = buffer->cesium.data;
+            if (elementSize <= 0 || byteStride < elementSize || byteOffset < 0 ||
+                byteOffset + byteLength > static_cast<std::int64_t>(data.size()))
+            {
+                return false;
+            }
+
+            GltfPrimitiveCacheAccessor& description = accessors.emplace_back();
+            description.m_count = accessor->count;
+            description.m_componentType = accessor->componentType;
+            description.m_componentCount = accessor->computeNumberOfComponents();
+            description.m_normalized = accessor->normalized;
+            description.m_byteSize = accessor->count * elementSize;
+
+            hasher.AddValue(accessor->componentType);
+            hasher.AddString(AZStd::string_view(accessor->type.data(), accessor->type.size()));
+            hasher.AddValue(accessor->normalized);
+            hasher.AddValue(accessor->count);
+
+            // interleaved elements are hashed one by one, so the other attributes of the buffer view don't change the hash
+            const std::byte* elements = data.data() + byteOffset;
+            if (byteStride == elementSize)
+            {
+                hasher.AddBytes(elements, static_cast<std::size_t>(byteLength));
+                return true;
+            }
+
+            for (std::int64_t i = 0; i < accessor->count; ++i)
+            {
+                hasher.AddBytes(elements + i * byteStride, static_cast<std::size_t>(elementSize));
+            }
+
+            return true;
+        }
+    } // namespace
+
     struct GltfTrianglePrimitiveBuilder::CommonAccessorViews final
     {
         CommonAccessorViews(const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive)
@@ -80,6 +192,46 @@ namespace Cesium
         CesiumGltf::AccessorView<glm::vec4> m_tangents;
     };
 
+    struct GltfTrianglePrimitiveBuilder::PartLoadContext final
+    {
+        PartLoadContext(const CesiumGltf::Model& model, const PrimitivePart& part)
+            : m_primitive{ part.m_primitive }
+            , m_accessorViews{ model, *part.m_primitive }
+            , m_transform{ part.m_transform }
+            , m_bakeTransform{ part.m_transform != glm::dmat4(1.0) }
+            , m_context{}
+            , m_indices{}
+            , m_vertexRemap{}
+            , m_customAccessors{}
+            , m_firstVertex{ 0 }
+            , m_vertexCount{ 0 }
+            , m_firstIndex{ 0 }
+        {
+            m_uvAccessors.fill(nullptr);
+            m_uvFormats.fill(AZ::RHI::Format::Unknown);
+        }
+
+        const CesiumGltf::MeshPrimitive* m_primitive;
+        CommonAccessorViews m_accessorViews;
+        glm::dmat4 m_transform;
+        bool m_bakeTransform;
+        LoadContext m_context;
+        AZStd::vector<std::uint32_t> m_indices;
+
+        // new location of each vertex of the accessors when vertices are reordered. It is empty if they keep their order
+        AZStd::vector<std::uint32_t> m_vertexRemap;
+        AZStd::array<const CesiumGltf::Accessor*, 2> m_uvAccessors;
+        AZStd::array<AZ::RHI::Format, 2> m_uvFormats;
+
+        // one accessor per custom attribute of the builder. It is null if the part doesn't have the attribute
+        AZStd::vector<const CesiumGltf::Accessor*> m_customAccessors;
+
+        // range of the part in the vertex streams and the index stream
+        std::size_t m_firstVertex;
+        std::size_t m_vertexCount;
+        std::size_t m_firstIndex;
+    };
+
     GltfTrianglePrimitiveBuilder::LoadContext::LoadContext()
         : m_generateFlatNormal{ false }
         , m_generateTangent{ false }
@@ -87,17 +239,47 @@ namespace Cesium
     {
     }
 
-    GltfTrianglePrimitiveBuilder::VertexRawBuffer::VertexRawBuffer()
-        : m_buffer{}
-        , m_format{ AZ::RHI::Format::Unknown }
-        , m_elementCount{ 0 }
+    GltfTrianglePrimitiveBuilder::VertexAttributeLayout::VertexAttributeLayout()
+        : m_format{ AZ::RHI::Format::Unknown }
+        , m_bufferView{}
     {
     }
 
-    GltfTrianglePrimitiveBuilder::VertexCustomAttribute::VertexCustomAttribute(
-        const GltfShaderVertexAttribute& shaderAttribute, VertexRawBuffer&& buffer)
+    GltfTrianglePrimitiveBuilder::VertexCustomAttribute::VertexCustomAttribute(const GltfShaderVertexAttribute& shaderAttribute)
         : m_shaderAttribute{ shaderAttribute }
-        , m_buffer{ std::move(buffer) }
+        , m_layout{}
+    {
+        m_layout.m_format = shaderAttribute.m_format;
+    }
+
+    GltfTrianglePrimitiveBuilder::PrimitivePart::PrimitivePart(const CesiumGltf::MeshPrimitive& primitive, const glm::dmat4& transform)
+        : m_primitive{ &primitive }
+        , m_transform{ transform }
+    {
+    }
+
+    GltfTrianglePrimitiveBuilderOption::GltfTrianglePrimitiveBuilderOption()
+        : m_optimizeVertexOrder{ false }
+        , m_generatedLodCount{ 0 }
+        , m_clusterTriangleCount{ 0 }
+        , m_buildRaycastBvh{ false }
+        , m_buildCollisionMesh{ false }
+        , m_collisionSimplificationError{ 0.005f }
+        , m_geometryHeap{ nullptr }
+        , m_primitiveCache{ nullptr }
+    {
+    }
+
+    GltfTrianglePrimitiveBuilder::GltfTrianglePrimitiveBuilder()
+        : GltfTrianglePrimitiveBuilder(GltfTrianglePrimitiveBuilderOption{})
+    {
+    }
+
+    GltfTrianglePrimitiveBuilder::GltfTrianglePrimitiveBuilder(const GltfTrianglePrimitiveBuilderOption& option)
+        : m_option{ option }
+        , m_vertexCount{ 0 }
+        , m_indexCount{ 0 }
+        , m_needTangents{ false }
     {
     }
 
@@ -106,283 +288,813 @@ namespace Cesium
         const CesiumGltf::MeshPrimitive& primitive,
         const GltfLoadMaterial& material,
         GltfLoadPrimitive& result)
+    {
+        AZStd::vector<PrimitivePart> parts;
+        parts.emplace_back(primitive, glm::dmat4(1.0));
+        Create(model, parts, material, result);
+    }
+
+    void GltfTrianglePrimitiveBuilder::Create(
+        const CesiumGltf::Model& model,
+        const AZStd::vector<PrimitivePart>& parts,
+        const GltfLoadMaterial& material,
+        GltfLoadPrimitive& result)
     {
         Reset();
+        m_needTangents = material.m_needTangents;
 
-        // Construct common accessor views. This is needed to begin determine loading context
-        CommonAccessorViews commonAccessorViews{ model, primitive };
-        if (commonAccessorViews.m_positions.status() != CesiumGltf::AccessorViewStatus::Valid)
+        // primitives that repeat across tiles reuse the model built for the first of them
+        GltfPrimitiveCacheKey cacheKey;
+        bool isCacheable = m_option.m_primitiveCache && ComputeCacheKey(model, parts, material, cacheKey);
+        if (isCacheable)
         {
-            return;
+            if (AZStd::shared_ptr<const GltfSharedPrimitive> sharedPrimitive = m_option.m_primitiveCache->Find(cacheKey))
+            {
+                result.m_modelAsset = sharedPrimitive->m_modelAsset;
+                result.m_clusterModelAssets = sharedPrimitive->m_clusterModelAssets;
+                result.m_materialId = parts.front().m_primitive->material;
+                result.m_raycastBvh = sharedPrimitive->m_raycastBvh;
+                result.m_collisionMesh = sharedPrimitive->m_collisionMesh;
+                result.m_geometryAllocation = sharedPrimitive->m_geometryAllocation;
+                result.m_sharedPrimitive = AZStd::move(sharedPrimitive);
+                return;
+            }
         }
 
-        if (commonAccessorViews.m_positions.size() == 0)
+        // Construct accessor views and indices of each part. This is needed to determine the loading context of the part.
+        // Parts that cannot be loaded are skipped
+        AZStd::vector<PartLoadContext> partContexts;
+        partContexts.reserve(parts.size());
+        for (const PrimitivePart& part : parts)
         {
-            return;
+            PartLoadContext& partContext = partContexts.emplace_back(model, part);
+            if (!PreparePart(model, material, partContext))
+            {
+                partContexts.pop_back();
+                continue;
+            }
+
+            partContext.m_firstVertex = m_vertexCount;
+            partContext.m_firstIndex = m_indexCount;
+            m_vertexCount += partContext.m_vertexCount;
+            m_indexCount += partContext.m_indices.size();
         }
 
-        // construct bounding volume
-        auto positionAccessor = commonAccessorViews.m_positionAccessor;
-        AZ::Aabb aabb = AZ::Aabb::CreateNull();
-        if (positionAccessor->min.size() == 3 && positionAccessor->max.size() == 3)
+        if (partContexts.empty())
         {
-            aabb = AZ::Aabb::CreateFromMinMaxValues(
-                static_cast<float>(positionAccessor->min[0]), static_cast<float>(positionAccessor->min[1]),
-                static_cast<float>(positionAccessor->min[2]), static_cast<float>(positionAccessor->max[0]),
-                static_cast<float>(positionAccessor->max[1]), static_cast<float>(positionAccessor->max[2]));
+            return;
         }
-        else
+
+        // Determine which optional attributes will be loaded, so that the final layout of the buffer is known before anything is
+        // written. Each attribute is then written straight into its region of the buffer without intermediate copies
+        DetermineUVsAttributes(model, partContexts);
+        DetermineCustomAttributes(model, material, partContexts);
+        CreateBufferLayout();
+
+        // Create attributes of each part. The order call of the functions is important
+        for (const PartLoadContext& partContext : partContexts)
         {
-            aabb = CreateAabbFromPositions(commonAccessorViews.m_positions);
+            CreatePositionsAttribute(partContext);
+            CreateNormalsAttribute(partContext);
+            CreateUVsAttributes(model, partContext);
+            if (m_needTangents)
+            {
+                CreateTangentsAndBitangentsAttributes(partContext);
+            }
+
+            CreateCustomAttributes(model, partContext);
+            CreateIndicesAttribute(partContext);
         }
 
-        // set indices
-        if (!CreateIndices(commonAccessorViews, model, primitive))
+        // construct bounding volume
+        AZ::Aabb aabb = CreateAabb(partContexts);
+
+        // the triangles are reordered by cluster before anything else reads the indices
+        AZStd::vector<AZ::RHI::BufferViewDescriptor> clusterIndicesBufferViews;
+        AZStd::vector<AZ::Aabb> clusterAabbs;
+        if (m_option.m_clusterTriangleCount > 0 && m_option.m_generatedLodCount == 0)
         {
-            return;
+            CreateClusters(clusterIndicesBufferViews, clusterAabbs);
         }
 
-        // We should expect indices size is a multiple of 3
-        if (m_indices.size() % 3 != 0)
+        // simplified index buffers are appended to the buffer, so every LOD shares the vertices of the full detail mesh
+        AZStd::vector<AZ::RHI::BufferViewDescriptor> lodIndicesBufferViews;
+        lodIndicesBufferViews.emplace_back(m_indicesBufferView);
+        CreateLodIndices(lodIndicesBufferViews);
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> bufferAsset;
+        if (m_option.m_geometryHeap)
         {
-            return;
+            m_geometryAllocation = m_option.m_geometryHeap->Allocate(m_buffer);
+            bufferAsset = m_geometryAllocation->GetBufferAsset();
+        }
+        else
+        {
+            bufferAsset = CreateBufferAsset(m_buffer);
         }
 
-        // determine loading context
-        DetermineLoadContext(commonAccessorViews, material);
-
-        // Create attributes. The order call of the functions is important
-        CreatePositionsAttribute(commonAccessorViews);
-        CreateNormalsAttribute(commonAccessorViews);
-        CreateUVsAttributes(commonAccessorViews, model, primitive);
-        CreateTangentsAndBitangentsAttributes(commonAccessorViews);
-        CreateCustomAttributes(model, primitive, material);
+        // create model asset
+        AZ::Data::AssetId modelAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId();
 
-        // after retrieving all the attributes, we reindex the indices if it's un-indexed mesh
-        if (m_context.m_generateUnIndexedMesh)
+        AZ::RPI::ModelAssetCreator modelCreator;
+        modelCreator.Begin(modelAssetId);
+        for (const AZ::RHI::BufferViewDescriptor& indicesBufferView : lodIndicesBufferViews)
         {
-            std::iota(m_indices.begin(), m_indices.end(), 0);
+            modelCreator.AddLodAsset(CreateLodAsset(bufferAsset, indicesBufferView, aabb));
         }
 
-        // calculate buffer view descriptor for each attribute and total buffer size to store all of them
-        // in a single buffer
-        auto positionBufferViewDescriptor =
-            AZ::RHI::BufferViewDescriptor::CreateTyped(0, static_cast<std::uint32_t>(m_positions.size()), AZ::RHI::Format::R32G32B32_FLOAT);
-        std::size_t totalBufferSize = m_positions.size() * sizeof(glm::vec3);
-
-        std::size_t normalByteOffset = MathHelper::Align(totalBufferSize, sizeof(glm::vec3));
-        auto normalBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
-            static_cast<std::uint32_t>(normalByteOffset / sizeof(glm::vec3)), static_cast<std::uint32_t>(m_normals.size()),
-            AZ::RHI::Format::R32G32B32_FLOAT);
-        totalBufferSize = normalByteOffset + m_normals.size() * sizeof(glm::vec3);
+        AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset;
+        modelCreator.End(modelAsset);
 
-        std::size_t bitangentByteOffset = MathHelper::Align(totalBufferSize, sizeof(glm::vec3));
-        auto bitangentBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
-            static_cast<std::uint32_t>(bitangentByteOffset / sizeof(glm::vec3)), static_cast<std::uint32_t>(m_bitangents.size()),
-            AZ::RHI::Format::R32G32B32_FLOAT);
-        totalBufferSize = bitangentByteOffset + m_bitangents.size() * sizeof(glm::vec3);
+        result.m_modelAsset = std::move(modelAsset);
 
-        std::size_t tangentByteOffset = MathHelper::Align(totalBufferSize, sizeof(glm::vec4));
-        auto tangentBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
-            static_cast<std::uint32_t>(tangentByteOffset / sizeof(glm::vec4)), static_cast<std::uint32_t>(m_tangents.size()),
-            AZ::RHI::Format::R32G32B32A32_FLOAT);
-        totalBufferSize = tangentByteOffset + m_tangents.size() * sizeof(glm::vec4);
+        // every cluster is a model of its own, because the renderer culls models, not the meshes inside them
+        result.m_clusterModelAssets.reserve(clusterIndicesBufferViews.size());
+        for (std::size_t i = 0; i < clusterIndicesBufferViews.size(); ++i)
+        {
+            AZ::RPI::ModelAssetCreator clusterCreator;
+            clusterCreator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId());
+            clusterCreator.AddLodAsset(CreateLodAsset(bufferAsset, clusterIndicesBufferViews[i], clusterAabbs[i]));
+            clusterCreator.End(result.m_clusterModelAssets.emplace_back());
+        }
 
-        AZStd::array<AZ::RHI::BufferViewDescriptor, 2> uvBufferViewDescriptors;
-        for (std::size_t i = 0; i < uvBufferViewDescriptors.size(); ++i)
+        result.m_materialId = partContexts.front().m_primitive->material;
+        result.m_geometryAllocation = m_geometryAllocation;
+        if (m_option.m_buildRaycastBvh)
         {
-            if (!m_uvs[i].m_buffer.empty())
-            {
-                std::size_t formatSize = AZ::RHI::GetFormatSize(m_uvs[i].m_format);
-                std::size_t offset = MathHelper::Align(totalBufferSize, formatSize);
-                uvBufferViewDescriptors[i] = AZ::RHI::BufferViewDescriptor::CreateTyped(
-                    static_cast<std::uint32_t>(offset / formatSize), static_cast<std::uint32_t>(m_uvs[i].m_elementCount),
-                    m_uvs[i].m_format);
-                totalBufferSize = offset + m_uvs[i].m_buffer.size();
-            }
-            else
-            {
-                // since this UVs buffer is empty, we just assign its region to tangent buffer as dummy buffer since we don't
-                // care about its value anyway and tangent offset is also a multiple of R32G32_FLOAT size
-                std::size_t formatSize = AZ::RHI::GetFormatSize(AZ::RHI::Format::R32G32_FLOAT);
-                std::size_t offset = tangentByteOffset;
-                uvBufferViewDescriptors[i] = AZ::RHI::BufferViewDescriptor::CreateTyped(
-                    static_cast<std::uint32_t>(offset / formatSize), static_cast<std::uint32_t>(m_tangents.size()),
-                    AZ::RHI::Format::R32G32_FLOAT);
-            }
+            result.m_raycastBvh = CreateRaycastBvh();
         }
 
-        AZStd::vector<AZ::RHI::BufferViewDescriptor> customAttribBufferViewDescriptors;
-        if (!m_customAttributes.empty())
+        if (m_option.m_buildCollisionMesh)
         {
-            customAttribBufferViewDescriptors.reserve(m_customAttributes.size());
-            for (const auto& customAttribute : m_customAttributes)
-            {
-                std::size_t formatSize = AZ::RHI::GetFormatSize(customAttribute.m_buffer.m_format);
-                std::size_t offset = MathHelper::Align(totalBufferSize, formatSize);
-                customAttribBufferViewDescriptors.emplace_back(AZ::RHI::BufferViewDescriptor::CreateTyped(
-                    static_cast<std::uint32_t>(offset / formatSize), static_cast<std::uint32_t>(customAttribute.m_buffer.m_elementCount),
-                    customAttribute.m_buffer.m_format));
-                totalBufferSize = offset + customAttribute.m_buffer.m_buffer.size();
-            }
+            result.m_collisionMesh = CreateCollisionMesh();
         }
 
-        std::size_t offset = MathHelper::Align(totalBufferSize, sizeof(std::uint32_t));
-        auto indicesBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
-            static_cast<std::uint32_t>(offset / sizeof(std::uint32_t)), static_cast<std::uint32_t>(m_indices.size()),
-            AZ::RHI::Format::R32_UINT);
-        totalBufferSize = offset + m_indices.size() * sizeof(std::uint32_t);
+        if (isCacheable)
+        {
+            AZStd::shared_ptr<GltfSharedPrimitive> sharedPrimitive = AZStd::make_shared<GltfSharedPrimitive>();
+            sharedPrimitive->m_modelAsset = result.m_modelAsset;
+            sharedPrimitive->m_clusterModelAssets = result.m_clusterModelAssets;
+            sharedPrimitive->m_raycastBvh = result.m_raycastBvh;
+            sharedPrimitive->m_collisionMesh = result.m_collisionMesh;
+            sharedPrimitive->m_geometryAllocation = result.m_geometryAllocation;
+            sharedPrimitive->m_key = AZStd::move(cacheKey);
+            sharedPrimitive->m_bufferSize = m_buffer.size();
+            m_option.m_primitiveCache->Add(sharedPrimitive);
+            result.m_sharedPrimitive = AZStd::move(sharedPrimitive);
+        }
+    }
 
-        // populate the raw buffer with attributes data
-        AZStd::vector<std::byte> buffer;
-        buffer.resize_no_construct(totalBufferSize);
-        CopySubregionBuffer(buffer, m_indices.data(), indicesBufferViewDescriptor);
-        CopySubregionBuffer(buffer, m_positions.data(), positionBufferViewDescriptor);
-        CopySubregionBuffer(buffer, m_normals.data(), normalBufferViewDescriptor);
-        CopySubregionBuffer(buffer, m_bitangents.data(), bitangentBufferViewDescriptor);
-        CopySubregionBuffer(buffer, m_tangents.data(), tangentBufferViewDescriptor);
+    bool GltfTrianglePrimitiveBuilder::ComputeCacheKey(
+        const CesiumGltf::Model& model,
+        const AZStd::vector<PrimitivePart>& parts,
+        const GltfLoadMaterial& material,
+        GltfPrimitiveCacheKey& key) const
+    {
+        // only what changes the built geometry is hashed. The material itself is bound to the mesh when it is acquired
+        PrimitiveHasher hasher;
+        hasher.AddValue(m_option.m_optimizeVertexOrder);
+        hasher.AddValue(m_option.m_generatedLodCount);
+        hasher.AddValue(m_option.m_clusterTriangleCount);
+        hasher.AddValue(m_option.m_buildRaycastBvh);
+        hasher.AddValue(m_option.m_buildCollisionMesh);
+        hasher.AddValue(m_option.m_collisionSimplificationError);
+        hasher.AddValue(material.m_needTangents);
+        for (const auto& [name, customAttribute] : material.m_customVertexAttributes)
+        {
+            hasher.AddString(name);
+            hasher.AddString(customAttribute.m_shaderSemantic.m_name.GetStringView());
+            hasher.AddValue(customAttribute.m_shaderSemantic.m_index);
+            hasher.AddString(customAttribute.m_shaderAttributeName.GetStringView());
+            hasher.AddValue(customAttribute.m_format);
+        }
 
-        for (std::size_t i = 0; i < m_uvs.size(); ++i)
+        key.m_accessors.clear();
+        for (const PrimitivePart& part : parts)
         {
-            if (!m_uvs[i].m_buffer.empty())
+            hasher.AddValue(part.m_primitive->mode);
+            hasher.AddValue(part.m_transform);
+            for (const auto& [name, accessorIndex] : part.m_primitive->attributes)
             {
-                CopySubregionBuffer(buffer, m_uvs[i].m_buffer.data(), uvBufferViewDescriptors[i]);
+                hasher.AddString(AZStd::string_view(name.data(), name.size()));
+                if (!HashAccessor(model, accessorIndex, hasher, key.m_accessors))
+                {
+                    return false;
+                }
             }
-        }
 
-        for (std::size_t i = 0; i < m_customAttributes.size(); ++i)
-        {
-            if (!m_customAttributes[i].m_buffer.m_buffer.empty())
+            if (!HashAccessor(model, part.m_primitive->indices, hasher, key.m_accessors))
             {
-                CopySubregionBuffer(buffer, m_customAttributes[i].m_buffer.m_buffer.data(), customAttribBufferViewDescriptors[i]);
+                return false;
             }
         }
 
-        AZ::Data::Asset<AZ::RPI::BufferAsset> bufferAsset = CreateBufferAsset(buffer);
+        hasher.Finish(key);
+        return true;
+    }
 
-        // create LOD asset
-        AZ::Data::AssetId lodAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
+    AZ::Data::Asset<AZ::RPI::ModelLodAsset> GltfTrianglePrimitiveBuilder::CreateLodAsset(
+        const AZ::Data::Asset<AZ::RPI::BufferAsset>& bufferAsset,
+        const AZ::RHI::BufferViewDescriptor& indicesBufferView,
+        const AZ::Aabb& aabb)
+    {
+        AZ::Data::AssetId lodAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId();
         AZ::RPI::ModelLodAssetCreator lodCreator;
         lodCreator.Begin(lodAssetId);
         lodCreator.AddLodStreamBuffer(bufferAsset);
+        if (m_constantStreams.m_bufferAsset)
+        {
+            lodCreator.AddLodStreamBuffer(m_constantStreams.m_bufferAsset);
+        }
 
         // create mesh
         lodCreator.BeginMesh();
-        lodCreator.SetMeshIndexBuffer(AZ::RPI::BufferAssetView(bufferAsset, indicesBufferViewDescriptor));
-        lodCreator.AddMeshStreamBuffer(
-            AZ::RHI::ShaderSemantic("POSITION"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, positionBufferViewDescriptor));
-        lodCreator.AddMeshStreamBuffer(
-            AZ::RHI::ShaderSemantic("NORMAL"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, normalBufferViewDescriptor));
+        lodCreator.SetMeshIndexBuffer(AZ::RPI::BufferAssetView(bufferAsset, GetBlockBufferView(indicesBufferView)));
         lodCreator.AddMeshStreamBuffer(
-            AZ::RHI::ShaderSemantic("BITANGENT"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, bitangentBufferViewDescriptor));
+            AZ::RHI::ShaderSemantic("POSITION"), AZ::Name(),
+            AZ::RPI::BufferAssetView(bufferAsset, GetBlockBufferView(m_positionsBufferView)));
         lodCreator.AddMeshStreamBuffer(
-            AZ::RHI::ShaderSemantic("TANGENT"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, tangentBufferViewDescriptor));
+            AZ::RHI::ShaderSemantic("NORMAL"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, GetBlockBufferView(m_normalsBufferView)));
 
-        for (std::size_t i = 0; i < uvBufferViewDescriptors.size(); ++i)
+        // the shader always requires tangent space and UVs, so the streams that have no data are bound to the shared constant buffer
+        if (m_needTangents)
+        {
+            lodCreator.AddMeshStreamBuffer(
+                AZ::RHI::ShaderSemantic("BITANGENT"), AZ::Name(),
+                AZ::RPI::BufferAssetView(bufferAsset, GetBlockBufferView(m_bitangentsBufferView)));
+            lodCreator.AddMeshStreamBuffer(
+                AZ::RHI::ShaderSemantic("TANGENT"), AZ::Name(),
+                AZ::RPI::BufferAssetView(bufferAsset, GetBlockBufferView(m_tangentsBufferView)));
+        }
+        else
         {
             lodCreator.AddMeshStreamBuffer(
-                AZ::RHI::ShaderSemantic("UV", i), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, uvBufferViewDescriptors[i]));
+                AZ::RHI::ShaderSemantic("BITANGENT"), AZ::Name(),
+                AZ::RPI::BufferAssetView(m_constantStreams.m_bufferAsset, m_bitangentsBufferView));
+            lodCreator.AddMeshStreamBuffer(
+                AZ::RHI::ShaderSemantic("TANGENT"), AZ::Name(),
+                AZ::RPI::BufferAssetView(m_constantStreams.m_bufferAsset, m_tangentsBufferView));
+        }
+
+        for (std::size_t i = 0; i < m_uvs.size(); ++i)
+        {
+            AZ::RPI::BufferAssetView uvBufferAssetView = m_uvs[i].m_format != AZ::RHI::Format::Unknown
+                ? AZ::RPI::BufferAssetView(bufferAsset, GetBlockBufferView(m_uvs[i].m_bufferView))
+                : AZ::RPI::BufferAssetView(m_constantStreams.m_bufferAsset, m_uvs[i].m_bufferView);
+            lodCreator.AddMeshStreamBuffer(AZ::RHI::ShaderSemantic("UV", i), AZ::Name(), uvBufferAssetView);
         }
 
         for (std::size_t i = 0; i < m_customAttributes.size(); ++i)
         {
             lodCreator.AddMeshStreamBuffer(
                 m_customAttributes[i].m_shaderAttribute.m_shaderSemantic, m_customAttributes[i].m_shaderAttribute.m_shaderAttributeName,
-                AZ::RPI::BufferAssetView(bufferAsset, customAttribBufferViewDescriptors[i]));
+                AZ::RPI::BufferAssetView(bufferAsset, GetBlockBufferView(m_customAttributes[i].m_layout.m_bufferView)));
         }
 
-        lodCreator.SetMeshAabb(std::move(aabb));
+        lodCreator.SetMeshAabb(AZ::Aabb(aabb));
         lodCreator.EndMesh();
 
         AZ::Data::Asset<AZ::RPI::ModelLodAsset> lodAsset;
         lodCreator.End(lodAsset);
+        return lodAsset;
+    }
 
-        // create model asset
-        AZ::Data::AssetId modelAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
+    AZ::RHI::BufferViewDescriptor GltfTrianglePrimitiveBuilder::GetBlockBufferView(const AZ::RHI::BufferViewDescriptor& bufferView) const
+    {
+        if (m_geometryAllocation)
+        {
+            return m_geometryAllocation->GetBlockBufferView(bufferView);
+        }
 
-        AZ::RPI::ModelAssetCreator modelCreator;
-        modelCreator.Begin(modelAssetId);
-        modelCreator.AddLodAsset(std::move(lodAsset));
+        return bufferView;
+    }
 
-        AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset;
-        modelCreator.End(modelAsset);
+    AZStd::shared_ptr<const TriangleBvh> GltfTrianglePrimitiveBuilder::CreateRaycastBvh()
+    {
+        // the hierarchy is built from the final positions and indices, so it matches the full detail mesh exactly
+        AZStd::shared_ptr<TriangleBvh> bvh = AZStd::make_shared<TriangleBvh>();
+        bvh->Build(GetBufferRegion<glm::vec3>(m_positionsBufferView), GetBufferRegion<std::uint32_t>(m_indicesBufferView));
+        if (bvh->IsEmpty())
+        {
+            return nullptr;
+        }
 
-        result.m_modelAsset = std::move(modelAsset);
-        result.m_materialId = primitive.material;
+        return bvh;
+    }
+
+    AZStd::shared_ptr<const GltfCollisionMesh> GltfTrianglePrimitiveBuilder::CreateCollisionMesh()
+    {
+        auto physicsSystem = AZ::Interface<Physics::SystemRequests>::Get();
+        if (!physicsSystem || m_indexCount == 0)
+        {
+            return nullptr;
+        }
+
+        // Physics doesn't need the detail that is only visible up close, so indexed meshes are simplified before they are cooked.
+        // Un-indexed meshes don't share vertices between triangles, so they have no edge to collapse
+        AZStd::span<const std::uint32_t> indices = GetBufferRegion<std::uint32_t>(m_indicesBufferView);
+        AZStd::span<const glm::vec3> positions = GetBufferRegion<glm::vec3>(m_positionsBufferView);
+        AZStd::vector<std::uint32_t> simplifiedIndices;
+        if (m_option.m_collisionSimplificationError > 0.0f && m_vertexCount < m_indexCount)
+        {
+            MeshSimplifier::Simplify(simplifiedIndices, indices, positions, 0, m_option.m_collisionSimplificationError);
+            if (!simplifiedIndices.empty())
+            {
+                indices = AZStd::span<const std::uint32_t>{ simplifiedIndices.data(), simplifiedIndices.size() };
+            }
+        }
+
+        // only keep the vertices that the remaining triangles use
+        AZStd::shared_ptr<GltfCollisionMesh> collisionMesh = AZStd::make_shared<GltfCollisionMesh>();
+        AZStd::vector<std::uint32_t> remap(positions.size(), AZStd::numeric_limits<std::uint32_t>::max());
+        AZStd::vector<AZ::Vector3> vertices;
+        AZStd::vector<AZ::u32> collisionIndices;
+        collisionIndices.reserve(indices.size());
+        glm::vec3 minimum{ AZStd::numeric_limits<float>::max() };
+        glm::vec3 maximum{ AZStd::numeric_limits<float>::lowest() };
+        for (std::uint32_t index : indices)
+        {
+            // the indices are validated when the primitive is loaded, but a bad index here would write past the remap table
+            if (index >= positions.size())
+            {
+                return nullptr;
+            }
+
+            if (remap[index] == AZStd::numeric_limits<std::uint32_t>::max())
+            {
+                const glm::vec3& position = positions[index];
+                remap[index] = static_cast<std::uint32_t>(vertices.size());
+                vertices.emplace_back(position.x, position.y, position.z);
+                minimum = glm::min(minimum, position);
+                maximum = glm::max(maximum, position);
+            }
+
+            collisionIndices.emplace_back(remap[index]);
+        }
+
+        bool cooked = physicsSystem->CookTriangleMeshToMemory(
+            vertices.data(), static_cast<AZ::u32>(vertices.size()), collisionIndices.data(), static_cast<AZ::u32>(collisionIndices.size()),
+            collisionMesh->m_cookedData);
+        if (!cooked || collisionMesh->m_cookedData.empty())
+        {
+            return nullptr;
+        }
+
+        collisionMesh->m_minimum = minimum;
+        collisionMesh->m_maximum = maximum;
+        return collisionMesh;
+    }
+
+    void GltfTrianglePrimitiveBuilder::CreateLodIndices(AZStd::vector<AZ::RHI::BufferViewDescriptor>& lodIndicesBufferViews)
+    {
+        // un-indexed meshes don't share vertices between triangles, so there is no edge to collapse
+        std::uint32_t lodCount = AZStd::min(m_option.m_generatedLodCount, MAX_GENERATED_LOD_COUNT);
+        if (lodCount == 0 || m_vertexCount >= m_indexCount)
+        {
+            return;
+        }
+
+        // Each LOD halves the triangles of the full detail mesh and doubles the error allowed, relative to the size of the mesh.
+        // LODs are simplified from the full detail mesh, so that their error doesn't accumulate
+        AZStd::span<const std::uint32_t> indices = GetBufferRegion<std::uint32_t>(m_indicesBufferView);
+        AZStd::span<const glm::vec3> positions = GetBufferRegion<glm::vec3>(m_positionsBufferView);
+        AZStd::vector<AZStd::vector<std::uint32_t>> lodIndices;
+        std::size_t previousIndexCount = indices.size();
+        float targetError = LOD_TARGET_ERROR;
+        for (std::uint32_t lod = 1; lod <= lodCount; ++lod)
+        {
+            std::size_t targetIndexCount = (indices.size() >> lod) / 3 * 3;
+            AZStd::vector<std::uint32_t> simplifiedIndices;
+            MeshSimplifier::Simplify(simplifiedIndices, indices, positions, targetIndexCount, targetError);
+
+            // stop once the error bound doesn't allow the mesh to get noticeably lighter
+            if (static_cast<float>(simplifiedIndices.size()) > static_cast<float>(previousIndexCount) * LOD_MIN_REDUCTION)
+            {
+                break;
+            }
+
+            if (m_option.m_optimizeVertexOrder)
+            {
+                AZStd::vector<std::uint32_t> clusterOffsets;
+                IndexBufferOptimizer::OptimizeVertexCache(
+                    AZStd::span<std::uint32_t>{ simplifiedIndices.data(), simplifiedIndices.size() }, m_vertexCount, clusterOffsets);
+            }
+
+            previousIndexCount = simplifiedIndices.size();
+            lodIndices.emplace_back(std::move(simplifiedIndices));
+            targetError *= 2.0f;
+        }
+
+        std::size_t totalBufferSize = m_buffer.size();
+        for (const AZStd::vector<std::uint32_t>& simplifiedIndices : lodIndices)
+        {
+            lodIndicesBufferViews.emplace_back(AppendBufferView(totalBufferSize, simplifiedIndices.size(), AZ::RHI::Format::R32_UINT));
+        }
+
+        m_buffer.resize(totalBufferSize);
+        for (std::size_t i = 0; i < lodIndices.size(); ++i)
+        {
+            AZStd::span<std::uint32_t> region = GetBufferRegion<std::uint32_t>(lodIndicesBufferViews[i + 1]);
+            AZStd::copy(lodIndices[i].begin(), lodIndices[i].end(), region.begin());
+        }
+    }
+
+    void GltfTrianglePrimitiveBuilder::CreateClusters(
+        AZStd::vector<AZ::RHI::BufferViewDescriptor>& clusterIndicesBufferViews, AZStd::vector<AZ::Aabb>& clusterAabbs)
+    {
+        // a primitive that fits in two clusters gains too little culling for the extra draw call
+        std::size_t triangleCount = m_indexCount / 3;
+        if (triangleCount <= static_cast<std::size_t>(m_option.m_clusterTriangleCount) * 2)
+        {
+            return;
+        }
+
+        AZStd::span<std::uint32_t> indices = GetBufferRegion<std::uint32_t>(m_indicesBufferView);
+        AZStd::span<const glm::vec3> positions = GetBufferRegion<glm::vec3>(m_positionsBufferView);
+        AZStd::vector<std::uint32_t> clusterOffsets;
+        MeshPartitioner::Partition(indices, positions, m_option.m_clusterTriangleCount, clusterOffsets);
+
+        // out of range triangles are removed by PreparePart, so a single cluster only means there was nothing to split
+        if (clusterOffsets.size() <= 2)
+        {
+            return;
+        }
+
+        std::size_t clusterCount = clusterOffsets.size() - 1;
+        clusterIndicesBufferViews.reserve(clusterCount);
+        clusterAabbs.reserve(clusterCount);
+        for (std::size_t i = 0; i < clusterCount; ++i)
+        {
+            std::uint32_t firstIndex = clusterOffsets[i] * 3;
+            std::uint32_t indexCount = (clusterOffsets[i + 1] - clusterOffsets[i]) * 3;
+            clusterIndicesBufferViews.emplace_back(AZ::RHI::BufferViewDescriptor::CreateTyped(
+                m_indicesBufferView.m_elementOffset + firstIndex, indexCount, AZ::RHI::Format::R32_UINT));
+
+            AZ::Aabb& clusterAabb = clusterAabbs.emplace_back(AZ::Aabb::CreateNull());
+            for (std::uint32_t index = firstIndex; index < firstIndex + indexCount; ++index)
+            {
+                const glm::vec3& position = positions[indices[index]];
+                clusterAabb.AddPoint(AZ::Vector3(position.x, position.y, position.z));
+            }
+        }
+    }
+
+    bool GltfTrianglePrimitiveBuilder::PreparePart(const CesiumGltf::Model& model, const GltfLoadMaterial& material, PartLoadContext& part)
+    {
+        const CommonAccessorViews& accessorViews = part.m_accessorViews;
+        if (accessorViews.m_positions.status() != CesiumGltf::AccessorViewStatus::Valid)
+        {
+            return false;
+        }
+
+        if (accessorViews.m_positions.size() == 0)
+        {
+            return false;
+        }
+
+        // set indices
+        if (!CreateIndices(model, part))
+        {
+            return false;
+        }
+
+        // We should expect indices size is a multiple of 3
+        if (part.m_indices.size() % 3 != 0)
+        {
+            return false;
+        }
+
+        // Every consumer of the indices, from the vertex gather to the collision mesh, reads positions through them, so triangles
+        // that refer to a vertex past the end of the accessor are dropped here once
+        RemoveOutOfRangeTriangles(part.m_indices, static_cast<std::size_t>(accessorViews.m_positions.size()));
+        if (part.m_indices.empty())
+        {
+            return false;
+        }
+
+        // a mirroring transform flips the winding of the triangles after baking, so we flip them back to keep the front faces
+        if (part.m_bakeTransform && glm::determinant(part.m_transform) < 0.0)
+        {
+            for (std::size_t i = 0; i < part.m_indices.size(); i += 3)
+            {
+                AZStd::swap(part.m_indices[i + 1], part.m_indices[i + 2]);
+            }
+        }
+
+        // determine loading context
+        DetermineLoadContext(part, material);
+
+        // un-indexed primitives don't reuse vertices, so only indexed ones benefit from the vertex cache
+        if (m_option.m_optimizeVertexOrder && !part.m_context.m_generateUnIndexedMesh)
+        {
+            OptimizeVertexOrder(part);
+        }
+
+        part.m_vertexCount =
+            part.m_context.m_generateUnIndexedMesh ? part.m_indices.size() : static_cast<std::size_t>(accessorViews.m_positions.size());
+
+        return true;
     }
 
-    void GltfTrianglePrimitiveBuilder::DetermineLoadContext(const CommonAccessorViews& accessorViews, const GltfLoadMaterial& material)
+    void GltfTrianglePrimitiveBuilder::DetermineLoadContext(PartLoadContext& part, const GltfLoadMaterial& material)
     {
+        const CommonAccessorViews& accessorViews = part.m_accessorViews;
+        LoadContext& context = part.m_context;
+
         // check if we should generate normal
         bool isNormalAccessorValid = accessorViews.m_normals.status() == CesiumGltf::AccessorViewStatus::Valid;
         bool hasEnoughNormalVertices = accessorViews.m_normals.size() == accessorViews.m_positions.size();
-        m_context.m_generateFlatNormal = !isNormalAccessorValid || !hasEnoughNormalVertices;
+        context.m_generateFlatNormal = !isNormalAccessorValid || !hasEnoughNormalVertices;
 
         // check if we should generate tangent
         if (material.m_needTangents)
         {
             bool isTangentAccessorValid = accessorViews.m_tangents.status() == CesiumGltf::AccessorViewStatus::Valid;
             bool hasEnoughTangentVertices = accessorViews.m_tangents.size() == accessorViews.m_positions.size();
-            m_context.m_generateTangent = !isTangentAccessorValid || !hasEnoughTangentVertices;
+            context.m_generateTangent = !isTangentAccessorValid || !hasEnoughTangentVertices;
         }
         else
         {
-            m_context.m_generateTangent = false;
+            context.m_generateTangent = false;
         }
 
         // check if we should generate unindexed mesh
-        m_context.m_generateUnIndexedMesh = m_context.m_generateFlatNormal || m_context.m_generateTangent;
+        context.m_generateUnIndexedMesh = context.m_generateFlatNormal || context.m_generateTangent;
     }
 
-    template<typename AccessorType>
-    void GltfTrianglePrimitiveBuilder::CopyAccessorToBuffer(
-        const CesiumGltf::AccessorView<AccessorType>& attributeAccessorView, AZStd::vector<AccessorType>& attributes)
+    void GltfTrianglePrimitiveBuilder::RemoveOutOfRangeTriangles(AZStd::vector<std::uint32_t>& indices, std::size_t vertexCount)
     {
-        if (m_context.m_generateUnIndexedMesh)
+        std::size_t triangleCount = 0;
+        for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
         {
-            // mesh has indices
-            attributes.resize(m_indices.size());
-            for (std::size_t i = 0; i < m_indices.size(); ++i)
+            if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount)
             {
-                std::int64_t index = static_cast<std::int64_t>(m_indices[i]);
-                attributes[static_cast<std::size_t>(i)] = attributeAccessorView[index];
+                continue;
             }
+
+            indices[triangleCount * 3] = indices[i];
+            indices[triangleCount * 3 + 1] = indices[i + 1];
+            indices[triangleCount * 3 + 2] = indices[i + 2];
+            ++triangleCount;
+        }
+
+        indices.resize(triangleCount * 3);
+    }
+
+    void GltfTrianglePrimitiveBuilder::OptimizeVertexOrder(PartLoadContext& part)
+    {
+        // out of range triangles are already removed, so every index refers to an existing vertex
+        const CesiumGltf::AccessorView<glm::vec3>& positionAccessorView = part.m_accessorViews.m_positions;
+        std::size_t vertexCount = static_cast<std::size_t>(positionAccessorView.size());
+        AZStd::vector<glm::vec3> positions(vertexCount);
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            positions[i] = positionAccessorView[static_cast<std::int64_t>(i)];
+        }
+
+        AZStd::span<std::uint32_t> indices{ part.m_indices.data(), part.m_indices.size() };
+        AZStd::vector<std::uint32_t> clusterOffsets;
+        IndexBufferOptimizer::OptimizeVertexCache(indices, vertexCount, clusterOffsets);
+        IndexBufferOptimizer::OptimizeOverdraw(indices, AZStd::span<const glm::vec3>{ positions.data(), positions.size() }, clusterOffsets);
+        IndexBufferOptimizer::OptimizeVertexFetch(indices, vertexCount, part.m_vertexRemap);
+    }
+
+    void GltfTrianglePrimitiveBuilder::DetermineUVsAttributes(const CesiumGltf::Model& model, AZStd::vector<PartLoadContext>& parts)
+    {
+        for (PartLoadContext& part : parts)
+        {
+            for (std::size_t i = 0; i < m_uvs.size(); ++i)
+            {
+                auto uvAttribute = part.m_primitive->attributes.find("TEXCOORD_" + std::to_string(i));
+                if (uvAttribute == part.m_primitive->attributes.end())
+                {
+                    continue;
+                }
+
+                const CesiumGltf::Accessor* uvAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, uvAttribute->second);
+                if (!uvAccessor || uvAccessor->type != CesiumGltf::AccessorSpec::Type::VEC2)
+                {
+                    continue;
+                }
+
+                // UVs share the index buffer with positions, so they must have one element per position
+                std::int64_t positionCount = part.m_accessorViews.m_positions.size();
+                bool isValid = false;
+                AZ::RHI::Format format = AZ::RHI::Format::Unknown;
+                if (uvAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::FLOAT)
+                {
+                    CesiumGltf::AccessorView<glm::vec2> view{ model, *uvAccessor };
+                    isValid = view.status() == CesiumGltf::AccessorViewStatus::Valid && view.size() == positionCount;
+                    format = AZ::RHI::Format::R32G32_FLOAT;
+                }
+                else if (uvAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE)
+                {
+                    CesiumGltf::AccessorView<glm::u8vec2> view{ model, *uvAccessor };
+                    isValid = view.status() == CesiumGltf::AccessorViewStatus::Valid && view.size() == positionCount;
+                    format = AZ::RHI::Format::R8G8_UNORM;
+                }
+                else if (uvAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT)
+                {
+                    CesiumGltf::AccessorView<glm::u16vec2> view{ model, *uvAccessor };
+                    isValid = view.status() == CesiumGltf::AccessorViewStatus::Valid && view.size() == positionCount;
+                    format = AZ::RHI::Format::R16G16_UNORM;
+                }
+
+                if (!isValid)
+                {
+                    continue;
+                }
+
+                part.m_uvAccessors[i] = uvAccessor;
+                part.m_uvFormats[i] = format;
+            }
+        }
+
+        // All parts write to the same UV stream, so the stream takes the format of the first part that has it. Parts that don't
+        // have the UV or store it in a different format are zero-filled
+        for (std::size_t i = 0; i < m_uvs.size(); ++i)
+        {
+            for (PartLoadContext& part : parts)
+            {
+                if (!part.m_uvAccessors[i])
+                {
+                    continue;
+                }
+
+                if (m_uvs[i].m_format == AZ::RHI::Format::Unknown)
+                {
+                    m_uvs[i].m_format = part.m_uvFormats[i];
+                }
+                else if (m_uvs[i].m_format != part.m_uvFormats[i])
+                {
+                    part.m_uvAccessors[i] = nullptr;
+                }
+            }
+        }
+    }
+
+    void GltfTrianglePrimitiveBuilder::DetermineCustomAttributes(
+        const CesiumGltf::Model& model, const GltfLoadMaterial& material, AZStd::vector<PartLoadContext>& parts)
+    {
+        m_customAttributes.reserve(material.m_customVertexAttributes.size());
+        for (const auto& customAttribute : material.m_customVertexAttributes)
+        {
+            bool hasAccessor = false;
+            for (PartLoadContext& part : parts)
+            {
+                const CesiumGltf::Accessor* accessor = nullptr;
+                auto accessorIt = part.m_primitive->attributes.find(customAttribute.first.c_str());
+                if (accessorIt != part.m_primitive->attributes.end())
+                {
+                    accessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, accessorIt->second);
+                }
+
+                // the attribute shares the index buffer with positions, so it must have one element per position
+                if (accessor &&
+                    (!DoesRHIVertexFormatSupported(*accessor, customAttribute.second.m_format) ||
+                     accessor->count != part.m_accessorViews.m_positions.size()))
+                {
+                    accessor = nullptr;
+                }
+
+                part.m_customAccessors.emplace_back(accessor);
+                hasAccessor = hasAccessor || accessor != nullptr;
+            }
+
+            if (!hasAccessor)
+            {
+                for (PartLoadContext& part : parts)
+                {
+                    part.m_customAccessors.pop_back();
+                }
+
+                continue;
+            }
+
+            m_customAttributes.emplace_back(customAttribute.second);
+        }
+    }
+
+    void GltfTrianglePrimitiveBuilder::CreateBufferLayout()
+    {
+        // calculate buffer view descriptor for each attribute and total buffer size to store all of them in a single buffer
+        std::size_t totalBufferSize = 0;
+        m_positionsBufferView = AppendBufferView(totalBufferSize, m_vertexCount, AZ::RHI::Format::R32G32B32_FLOAT);
+        m_normalsBufferView = AppendBufferView(totalBufferSize, m_vertexCount, AZ::RHI::Format::R32G32B32_FLOAT);
+
+        // streams that the material doesn't use are read from the shared constant buffer instead of being stored per vertex
+        bool hasMissingUVs = AZStd::any_of(
+            m_uvs.begin(), m_uvs.end(),
+            [](const VertexAttributeLayout& uv)
+            {
+                return uv.m_format == AZ::RHI::Format::Unknown;
+            });
+        if (!m_needTangents || hasMissingUVs)
+        {
+            m_constantStreams = CesiumInterface::Get()->GetCriticalAssetManager().GetConstantVertexStreams(m_vertexCount);
+        }
+
+        if (m_needTangents)
+        {
+            m_bitangentsBufferView = AppendBufferView(totalBufferSize, m_vertexCount, AZ::RHI::Format::R32G32B32_FLOAT);
+            m_tangentsBufferView = AppendBufferView(totalBufferSize, m_vertexCount, AZ::RHI::Format::R32G32B32A32_FLOAT);
         }
         else
         {
-            attributes.resize(static_cast<std::size_t>(attributeAccessorView.size()));
-            for (std::int64_t i = 0; i < attributeAccessorView.size(); ++i)
+            m_bitangentsBufferView = m_constantStreams.m_bitangents;
+            m_tangentsBufferView = m_constantStreams.m_tangents;
+        }
+
+        for (std::size_t i = 0; i < m_uvs.size(); ++i)
+        {
+            if (m_uvs[i].m_format != AZ::RHI::Format::Unknown)
+            {
+                m_uvs[i].m_bufferView = AppendBufferView(totalBufferSize, m_vertexCount, m_uvs[i].m_format);
+            }
+            else
             {
-                attributes[static_cast<std::size_t>(i)] = attributeAccessorView[i];
+                m_uvs[i].m_bufferView = m_constantStreams.m_uvs;
             }
         }
+
+        for (auto& customAttribute : m_customAttributes)
+        {
+            customAttribute.m_layout.m_bufferView = AppendBufferView(totalBufferSize, m_vertexCount, customAttribute.m_layout.m_format);
+        }
+
+        m_indicesBufferView = AppendBufferView(totalBufferSize, m_indexCount, AZ::RHI::Format::R32_UINT);
+
+        // every byte of the buffer is overwritten by the attributes or the indices, except the alignment padding
+        m_buffer.resize_no_construct(totalBufferSize);
     }
 
     template<typename AccessorType>
     void GltfTrianglePrimitiveBuilder::CopyAccessorToBuffer(
-        const CesiumGltf::AccessorView<AccessorType>& accessorView, AZStd::vector<std::byte>& buffer)
+        const PartLoadContext& part,
+        const CesiumGltf::AccessorView<AccessorType>& accessorView,
+        const AZ::RHI::BufferViewDescriptor& bufferView)
     {
-        if (m_context.m_generateUnIndexedMesh)
+        AZStd::span<AccessorType> values = GetPartBufferRegion<AccessorType>(part, bufferView);
+        if (part.m_context.m_generateUnIndexedMesh)
         {
-            buffer.resize(m_indices.size() * sizeof(AccessorType));
-            AccessorType* value = reinterpret_cast<AccessorType*>(buffer.data());
-            for (std::size_t i = 0; i < m_indices.size(); ++i)
+            assert(values.size() == part.m_indices.size());
+            for (std::size_t i = 0; i < part.m_indices.size(); ++i)
+            {
+                std::int64_t index = static_cast<std::int64_t>(part.m_indices[i]);
+                values[i] = accessorView[index];
+            }
+        }
+        else if (!part.m_vertexRemap.empty())
+        {
+            assert(values.size() == part.m_vertexRemap.size());
+            for (std::int64_t i = 0; i < accessorView.size(); ++i)
             {
-                std::int64_t index = static_cast<std::int64_t>(m_indices[i]);
-                value[i] = accessorView[index];
+                values[part.m_vertexRemap[static_cast<std::size_t>(i)]] = accessorView[i];
             }
         }
         else
         {
-            buffer.resize(static_cast<std::size_t>(accessorView.size()) * sizeof(AccessorType));
-            AccessorType* value = reinterpret_cast<AccessorType*>(buffer.data());
+            assert(values.size() == static_cast<std::size_t>(accessorView.size()));
             for (std::int64_t i = 0; i < accessorView.size(); ++i)
             {
-                value[i] = accessorView[i];
+                values[static_cast<std::size_t>(i)] = accessorView[i];
             }
         }
     }
 
+    template<typename ElementType>
+    AZStd::span<ElementType> GltfTrianglePrimitiveBuilder::GetBufferRegion(const AZ::RHI::BufferViewDescriptor& bufferView)
+    {
+        assert(bufferView.m_elementSize == sizeof(ElementType));
+        std::size_t offset = static_cast<std::size_t>(bufferView.m_elementOffset) * bufferView.m_elementSize;
+        return AZStd::span<ElementType>(reinterpret_cast<ElementType*>(m_buffer.data() + offset), bufferView.m_elementCount);
+    }
+
+    template<typename ElementType>
+    AZStd::span<ElementType> GltfTrianglePrimitiveBuilder::GetPartBufferRegion(
+        const PartLoadContext& part, const AZ::RHI::BufferViewDescriptor& bufferView)
+    {
+        AZStd::span<ElementType> region = GetBufferRegion<ElementType>(bufferView);
+        assert(part.m_firstVertex + part.m_vertexCount <= region.size());
+        return AZStd::span<ElementType>(region.data() + part.m_firstVertex, part.m_vertexCount);
+    }
+
+    void GltfTrianglePrimitiveBuilder::ZeroPartBufferRegion(const PartLoadContext& part, const AZ::RHI::BufferViewDescriptor& bufferView)
+    {
+        std::size_t offset = (static_cast<std::size_t>(bufferView.m_elementOffset) + part.m_firstVertex) * bufferView.m_elementSize;
+        memset(m_buffer.data() + offset, 0, part.m_vertexCount * bufferView.m_elementSize);
+    }
+
+    AZ::RHI::BufferViewDescriptor GltfTrianglePrimitiveBuilder::AppendBufferView(
+        std::size_t& totalBufferSize, std::size_t elementCount, AZ::RHI::Format format)
+    {
+        std::size_t formatSize = AZ::RHI::GetFormatSize(format);
+        std::size_t offset = MathHelper::AlignToMultiple(totalBufferSize, formatSize);
+        totalBufferSize = offset + elementCount * formatSize;
+        return AZ::RHI::BufferViewDescriptor::CreateTyped(
+            static_cast<std::uint32_t>(offset / formatSize), static_cast<std::uint32_t>(elementCount), format);
+    }
+
     AZ::Data::Asset<AZ::RPI::BufferAsset> GltfTrianglePrimitiveBuilder::CreateBufferAsset(const AZStd::vector<std::byte>& buffer)
     {
         AZ::RHI::BufferViewDescriptor bufferViewDescriptor;
@@ -395,7 +1107,7 @@ namespace Cesium
         bufferDescriptor.m_bindFlags = AZ::RHI::BufferBindFlags::InputAssembly | AZ::RHI::BufferBindFlags::ShaderRead;
         bufferDescriptor.m_byteCount = bufferViewDescriptor.m_elementCount * bufferViewDescriptor.m_elementSize;
 
-        AZ::Data::AssetId bufferAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
+        AZ::Data::AssetId bufferAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId();
 
         AZ::RPI::BufferAssetCreator creator;
         creator.Begin(bufferAssetId);
@@ -409,14 +1121,14 @@ namespace Cesium
         return bufferAsset;
     }
 
-    bool GltfTrianglePrimitiveBuilder::CreateIndices(
-        const CommonAccessorViews& accessorViews, const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive)
+    bool GltfTrianglePrimitiveBuilder::CreateIndices(const CesiumGltf::Model& model, PartLoadContext& part)
     {
+        const CesiumGltf::MeshPrimitive& primitive = *part.m_primitive;
         const CesiumGltf::Accessor* indicesAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, primitive.indices);
         if (!indicesAccessor)
         {
-            m_indices.resize(static_cast<std::size_t>(accessorViews.m_positions.size()));
-            std::iota(m_indices.begin(), m_indices.end(), 0);
+            part.m_indices.resize(static_cast<std::size_t>(part.m_accessorViews.m_positions.size()));
+            std::iota(part.m_indices.begin(), part.m_indices.end(), 0);
             return true;
         }
 
@@ -429,31 +1141,32 @@ namespace Cesium
         if (indicesAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE)
         {
             CesiumGltf::AccessorView<std::uint8_t> view{ model, *indicesAccessor };
-            return CreateIndices(primitive, view);
+            return CreateIndices(part, view);
         }
         else if (indicesAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT)
         {
             CesiumGltf::AccessorView<std::uint16_t> view{ model, *indicesAccessor };
-            return CreateIndices(primitive, view);
+            return CreateIndices(part, view);
         }
         else if (indicesAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_INT)
         {
             CesiumGltf::AccessorView<std::uint32_t> view{ model, *indicesAccessor };
-            return CreateIndices(primitive, view);
+            return CreateIndices(part, view);
         }
 
         return false;
     }
 
     template<typename IndexType>
-    bool GltfTrianglePrimitiveBuilder::CreateIndices(
-        const CesiumGltf::MeshPrimitive& primitive, const CesiumGltf::AccessorView<IndexType>& indicesAccessorView)
+    bool GltfTrianglePrimitiveBuilder::CreateIndices(PartLoadContext& part, const CesiumGltf::AccessorView<IndexType>& indicesAccessorView)
     {
         if (indicesAccessorView.status() != CesiumGltf::AccessorViewStatus::Valid)
         {
             return false;
         }
 
+        const CesiumGltf::MeshPrimitive& primitive = *part.m_primitive;
+        AZStd::vector<std::uint32_t>& indices = part.m_indices;
         if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::TRIANGLES)
         {
             if (indicesAccessorView.size() % 3 != 0)
@@ -461,10 +1174,10 @@ namespace Cesium
                 return false;
             }
 
-            m_indices.resize(static_cast<std::size_t>(indicesAccessorView.size()));
+            indices.resize(static_cast<std::size_t>(indicesAccessorView.size()));
             for (std::int64_t i = 0; i < indicesAccessorView.size(); ++i)
             {
-                m_indices[static_cast<std::size_t>(i)] = static_cast<std::uint32_t>(indicesAccessorView[i]);
+                indices[static_cast<std::size_t>(i)] = static_cast<std::uint32_t>(indicesAccessorView[i]);
             }
 
             return true;
@@ -477,20 +1190,20 @@ namespace Cesium
                 return false;
             }
 
-            m_indices.reserve(static_cast<std::size_t>(indicesAccessorView.size() - 2) * 3);
+            indices.reserve(static_cast<std::size_t>(indicesAccessorView.size() - 2) * 3);
             for (std::int64_t i = 0; i < indicesAccessorView.size() - 2; ++i)
             {
                 if (i % 2)
                 {
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i]));
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 2]));
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 1]));
+                    indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i]));
+                    indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 2]));
+                    indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 1]));
                 }
                 else
                 {
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i]));
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 1]));
-                    m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 2]));
+                    indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i]));
+                    indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 1]));
+                    indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 2]));
                 }
             }
 
@@ -504,12 +1217,12 @@ namespace Cesium
                 return false;
             }
 
-            m_indices.reserve(static_cast<std::size_t>(indicesAccessorView.size() - 2) * 3);
+            indices.reserve(static_cast<std::size_t>(indicesAccessorView.size() - 2) * 3);
             for (std::int64_t i = 0; i < indicesAccessorView.size() - 2; ++i)
             {
-                m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[0]));
-                m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 1]));
-                m_indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 2]));
+                indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[0]));
+                indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 1]));
+                indices.emplace_back(static_cast<std::uint32_t>(indicesAccessorView[i + 2]));
             }
 
             return true;
@@ -518,135 +1231,137 @@ namespace Cesium
         return false;
     }
 
-    void GltfTrianglePrimitiveBuilder::CreatePositionsAttribute(const CommonAccessorViews& commonAccessorViews)
+    void GltfTrianglePrimitiveBuilder::CreateIndicesAttribute(const PartLoadContext& part)
+    {
+        AZStd::span<std::uint32_t> indices = GetBufferRegion<std::uint32_t>(m_indicesBufferView);
+        assert(part.m_firstIndex + part.m_indices.size() <= indices.size());
+        std::uint32_t* partIndices = indices.data() + part.m_firstIndex;
+        std::uint32_t firstVertex = static_cast<std::uint32_t>(part.m_firstVertex);
+        if (part.m_context.m_generateUnIndexedMesh)
+        {
+            // attributes are already un-indexed at this point, so we just reindex them sequentially
+            std::iota(partIndices, partIndices + part.m_indices.size(), firstVertex);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < part.m_indices.size(); ++i)
+            {
+                partIndices[i] = part.m_indices[i] + firstVertex;
+            }
+        }
+    }
+
+    void GltfTrianglePrimitiveBuilder::CreatePositionsAttribute(const PartLoadContext& part)
     {
-        assert(commonAccessorViews.m_positions.status() == CesiumGltf::AccessorViewStatus::Valid);
-        assert(commonAccessorViews.m_positions.size() > 0);
-        CopyAccessorToBuffer(commonAccessorViews.m_positions, m_positions);
+        assert(part.m_accessorViews.m_positions.status() == CesiumGltf::AccessorViewStatus::Valid);
+        assert(part.m_accessorViews.m_positions.size() > 0);
+        CopyAccessorToBuffer(part, part.m_accessorViews.m_positions, m_positionsBufferView);
+
+        if (part.m_bakeTransform)
+        {
+            for (glm::vec3& position : GetPartBufferRegion<glm::vec3>(part, m_positionsBufferView))
+            {
+                position = glm::vec3(part.m_transform * glm::dvec4(position, 1.0));
+            }
+        }
     }
 
-    void GltfTrianglePrimitiveBuilder::CreateNormalsAttribute(const CommonAccessorViews& commonAccessorViews)
+    void GltfTrianglePrimitiveBuilder::CreateNormalsAttribute(const PartLoadContext& part)
     {
-        if (m_context.m_generateFlatNormal)
+        if (part.m_context.m_generateFlatNormal)
         {
-            // if we are at this point, positions is already un-indexed
-            assert(m_context.m_generateUnIndexedMesh);
-            assert(m_positions.size() > 0);
-            assert(m_positions.size() % 3 == 0);
-            CreateFlatNormal();
+            // if we are at this point, positions is already un-indexed and transformed
+            assert(part.m_context.m_generateUnIndexedMesh);
+            assert(part.m_vertexCount > 0);
+            assert(part.m_vertexCount % 3 == 0);
+            CreateFlatNormal(part);
         }
         else
         {
-            assert(commonAccessorViews.m_normals.status() == CesiumGltf::AccessorViewStatus::Valid);
-            assert(commonAccessorViews.m_normals.size() > 0);
-            assert(commonAccessorViews.m_normals.size() == commonAccessorViews.m_positions.size());
-            CopyAccessorToBuffer(commonAccessorViews.m_normals, m_normals);
+            const CommonAccessorViews& accessorViews = part.m_accessorViews;
+            assert(accessorViews.m_normals.status() == CesiumGltf::AccessorViewStatus::Valid);
+            assert(accessorViews.m_normals.size() > 0);
+            assert(accessorViews.m_normals.size() == accessorViews.m_positions.size());
+            CopyAccessorToBuffer(part, accessorViews.m_normals, m_normalsBufferView);
+
+            if (part.m_bakeTransform)
+            {
+                glm::dmat3 normalMatrix = glm::transpose(glm::inverse(glm::dmat3(part.m_transform)));
+                for (glm::vec3& normal : GetPartBufferRegion<glm::vec3>(part, m_normalsBufferView))
+                {
+                    normal = glm::vec3(glm::normalize(normalMatrix * glm::dvec3(normal)));
+                }
+            }
         }
     }
 
-    void GltfTrianglePrimitiveBuilder::CreateUVsAttributes(
-        const CommonAccessorViews& commonAccessorViews, const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive)
+    void GltfTrianglePrimitiveBuilder::CreateUVsAttributes(const CesiumGltf::Model& model, const PartLoadContext& part)
     {
         for (std::size_t i = 0; i < m_uvs.size(); ++i)
         {
-            auto uvAttribute = primitive.attributes.find("TEXCOORD_" + std::to_string(i));
-            if (uvAttribute == primitive.attributes.end())
+            const VertexAttributeLayout& uv = m_uvs[i];
+            if (uv.m_format == AZ::RHI::Format::Unknown)
             {
                 continue;
             }
 
-            const CesiumGltf::Accessor* uvAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, uvAttribute->second);
-            if (uvAccessor->type != CesiumGltf::AccessorSpec::Type::VEC2)
+            const CesiumGltf::Accessor* uvAccessor = part.m_uvAccessors[i];
+            if (!uvAccessor)
             {
+                ZeroPartBufferRegion(part, uv.m_bufferView);
                 continue;
             }
 
-            if (uvAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::FLOAT)
+            if (uv.m_format == AZ::RHI::Format::R32G32_FLOAT)
             {
-                CesiumGltf::AccessorView<glm::vec2> view{ model, *uvAccessor };
-                if (view.status() != CesiumGltf::AccessorViewStatus::Valid)
-                {
-                    continue;
-                }
-
-                if (view.size() != commonAccessorViews.m_positions.size())
-                {
-                    continue;
-                }
-
-                CopyAccessorToBuffer(view, m_uvs[i].m_buffer);
-                m_uvs[i].m_elementCount = m_uvs[i].m_buffer.size() / (sizeof(float) * 2);
-                m_uvs[i].m_format = AZ::RHI::Format::R32G32_FLOAT;
+                CopyAccessorToBuffer(part, CesiumGltf::AccessorView<glm::vec2>{ model, *uvAccessor }, uv.m_bufferView);
             }
-            else if (uvAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE)
+            else if (uv.m_format == AZ::RHI::Format::R8G8_UNORM)
             {
-                CesiumGltf::AccessorView<glm::u8vec2> view{ model, *uvAccessor };
-                if (view.status() != CesiumGltf::AccessorViewStatus::Valid)
-                {
-                    continue;
-                }
-
-                if (view.size() != commonAccessorViews.m_positions.size())
-                {
-                    continue;
-                }
-
-                CopyAccessorToBuffer(view, m_uvs[i].m_buffer);
-                m_uvs[i].m_elementCount = m_uvs[i].m_buffer.size() / (sizeof(std::uint8_t) * 2);
-                m_uvs[i].m_format = AZ::RHI::Format::R8G8_UNORM;
+                CopyAccessorToBuffer(part, CesiumGltf::AccessorView<glm::u8vec2>{ model, *uvAccessor }, uv.m_bufferView);
             }
-            else if (uvAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT)
+            else if (uv.m_format == AZ::RHI::Format::R16G16_UNORM)
             {
-                CesiumGltf::AccessorView<glm::u16vec2> view{ model, *uvAccessor };
-                if (view.status() != CesiumGltf::AccessorViewStatus::Valid)
-                {
-                    continue;
-                }
-
-                if (view.size() != commonAccessorViews.m_positions.size())
-                {
-                    continue;
-                }
-
-                CopyAccessorToBuffer(view, m_uvs[i].m_buffer);
-                m_uvs[i].m_elementCount = m_uvs[i].m_buffer.size() / (sizeof(std::uint16_t) * 2);
-                m_uvs[i].m_format = AZ::RHI::Format::R16G16_UNORM;
+                CopyAccessorToBuffer(part, CesiumGltf::AccessorView<glm::u16vec2>{ model, *uvAccessor }, uv.m_bufferView);
             }
         }
     }
 
-    void GltfTrianglePrimitiveBuilder::CreateTangentsAndBitangentsAttributes(const CommonAccessorViews& commonAccessorViews)
+    void GltfTrianglePrimitiveBuilder::CreateTangentsAndBitangentsAttributes(const PartLoadContext& part)
     {
-        if (m_context.m_generateTangent)
+        AZStd::span<glm::vec3> positions = GetPartBufferRegion<glm::vec3>(part, m_positionsBufferView);
+        AZStd::span<glm::vec3> normals = GetPartBufferRegion<glm::vec3>(part, m_normalsBufferView);
+        AZStd::span<glm::vec4> tangents = GetPartBufferRegion<glm::vec4>(part, m_tangentsBufferView);
+        AZStd::span<glm::vec3> bitangents = GetPartBufferRegion<glm::vec3>(part, m_bitangentsBufferView);
+
+        if (part.m_context.m_generateTangent)
         {
             // positions, normals, and uvs should be unindexed at this point
-            assert(m_context.m_generateUnIndexedMesh);
-            assert(m_positions.size() == m_normals.size());
-            assert(m_positions.size() > 0);
-            assert(m_positions.size() % 3 == 0);
-            assert(m_normals.size() > 0);
-            assert(m_normals.size() % 3 == 0);
+            assert(part.m_context.m_generateUnIndexedMesh);
+            assert(positions.size() == normals.size());
+            assert(positions.size() > 0);
+            assert(positions.size() % 3 == 0);
 
             // Try to generate tangents and bitangents
             bool success = false;
             for (std::size_t i = 0; i < m_uvs.size(); ++i)
             {
-                if (!m_uvs[i].m_buffer.empty())
+                if (part.m_uvAccessors[i])
                 {
                     if (m_uvs[i].m_format == AZ::RHI::Format::R32G32_FLOAT)
                     {
-                        AZStd::span<glm::vec2> uvs(reinterpret_cast<glm::vec2*>(m_uvs[i].m_buffer.data()), m_uvs[i].m_elementCount);
-                        success = BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
+                        AZStd::span<glm::vec2> uvs = GetPartBufferRegion<glm::vec2>(part, m_uvs[i].m_bufferView);
+                        success = BitangentAndTangentGenerator::Generate(positions, normals, uvs, tangents, bitangents);
                     }
                     else if (m_uvs[i].m_format == AZ::RHI::Format::R8G8_UNORM)
                     {
-                        AZStd::span<glm::u8vec2> uvs(reinterpret_cast<glm::u8vec2*>(m_uvs[i].m_buffer.data()), m_uvs[i].m_elementCount);
-                        success = BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
+                        AZStd::span<glm::u8vec2> uvs = GetPartBufferRegion<glm::u8vec2>(part, m_uvs[i].m_bufferView);
+                        success = BitangentAndTangentGenerator::Generate(positions, normals, uvs, tangents, bitangents);
                     }
                     else if (m_uvs[i].m_format == AZ::RHI::Format::R16G16_UNORM)
                     {
-                        AZStd::span<glm::u16vec2> uvs(reinterpret_cast<glm::u16vec2*>(m_uvs[i].m_buffer.data()), m_uvs[i].m_elementCount);
-                        success = BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
+                        AZStd::span<glm::u16vec2> uvs = GetPartBufferRegion<glm::u16vec2>(part, m_uvs[i].m_bufferView);
+                        success = BitangentAndTangentGenerator::Generate(positions, normals, uvs, tangents, bitangents);
                     }
                     else
                     {
@@ -664,78 +1379,79 @@ namespace Cesium
             // if we still cannot generate MikkTSpace, then we generate dummy
             if (!success)
             {
-                m_tangents.resize(m_positions.size(), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
-                m_bitangents.resize(m_positions.size(), glm::vec3(0.0f, 1.0f, 0.0f));
+                AZStd::fill(tangents.begin(), tangents.end(), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+                AZStd::fill(bitangents.begin(), bitangents.end(), glm::vec3(0.0f, 1.0f, 0.0f));
             }
 
             return;
         }
 
         // check if tangents accessor is valid. If it is, we just copy to the buffer
-        const CesiumGltf::AccessorView<glm::vec4>& tangents = commonAccessorViews.m_tangents;
-        if ((tangents.status() == CesiumGltf::AccessorViewStatus::Valid) && (tangents.size() > 0) &&
-            (tangents.size() == commonAccessorViews.m_positions.size()))
+        const CesiumGltf::AccessorView<glm::vec4>& tangentAccessorView = part.m_accessorViews.m_tangents;
+        if ((tangentAccessorView.status() == CesiumGltf::AccessorViewStatus::Valid) && (tangentAccessorView.size() > 0) &&
+            (tangentAccessorView.size() == part.m_accessorViews.m_positions.size()))
         {
-            // copy tangents to vector
-            CopyAccessorToBuffer(commonAccessorViews.m_tangents, m_tangents);
+            // copy tangents to the buffer
+            CopyAccessorToBuffer(part, tangentAccessorView, m_tangentsBufferView);
+
+            // a mirroring transform flips the handedness of the tangent space
+            if (part.m_bakeTransform)
+            {
+                glm::dmat3 tangentMatrix = glm::dmat3(part.m_transform);
+                float handedness = glm::determinant(tangentMatrix) < 0.0 ? -1.0f : 1.0f;
+                for (glm::vec4& tangent : tangents)
+                {
+                    glm::dvec3 direction = glm::normalize(tangentMatrix * glm::dvec3(tangent));
+                    tangent = glm::vec4(glm::vec3(direction), tangent.w * handedness);
+                }
+            }
 
             // create bitangents
-            m_bitangents.resize(m_tangents.size(), glm::vec3(0.0f));
-            for (std::size_t i = 0; i < m_tangents.size(); ++i)
+            for (std::size_t i = 0; i < tangents.size(); ++i)
             {
-                m_bitangents[i] = glm::cross(m_normals[i], glm::vec3(m_tangents[i])) * m_tangents[i].w;
+                bitangents[i] = glm::cross(normals[i], glm::vec3(tangents[i])) * tangents[i].w;
             }
 
             return;
         }
 
         // generate dummy if accessor is not valid
-        m_tangents.resize(m_positions.size(), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
-        m_bitangents.resize(m_positions.size(), glm::vec3(0.0f, 1.0f, 0.0f));
+        AZStd::fill(tangents.begin(), tangents.end(), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+        AZStd::fill(bitangents.begin(), bitangents.end(), glm::vec3(0.0f, 1.0f, 0.0f));
     }
 
-    void GltfTrianglePrimitiveBuilder::CreateCustomAttributes(
-        const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, const GltfLoadMaterial& material)
+    void GltfTrianglePrimitiveBuilder::CreateCustomAttributes(const CesiumGltf::Model& model, const PartLoadContext& part)
     {
-        m_customAttributes.reserve(material.m_customVertexAttributes.size());
-        for (const auto& customAttribute : material.m_customVertexAttributes)
+        assert(part.m_customAccessors.size() == m_customAttributes.size());
+        for (std::size_t i = 0; i < m_customAttributes.size(); ++i)
         {
-            auto accessorIt = primitive.attributes.find(customAttribute.first.c_str());
-            if (accessorIt == primitive.attributes.end())
-            {
-                continue;
-            }
-
-            const CesiumGltf::Accessor* accessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, accessorIt->second);
+            const VertexAttributeLayout& layout = m_customAttributes[i].m_layout;
+            const CesiumGltf::Accessor* accessor = part.m_customAccessors[i];
             if (!accessor)
             {
-                continue;
-            }
-
-            if (!DoesRHIVertexFormatSupported(*accessor, customAttribute.second.m_format))
-            {
+                ZeroPartBufferRegion(part, layout.m_bufferView);
                 continue;
             }
 
             switch (accessor->componentType)
             {
             case CesiumGltf::AccessorSpec::ComponentType::BYTE:
-                CreateCustomAttribute<std::int8_t>(model, *accessor, customAttribute.second);
+                CreateCustomAttribute<std::int8_t>(model, part, *accessor, layout);
                 break;
             case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE:
-                CreateCustomAttribute<std::uint8_t>(model, *accessor, customAttribute.second);
+                CreateCustomAttribute<std::uint8_t>(model, part, *accessor, layout);
                 break;
             case CesiumGltf::AccessorSpec::ComponentType::SHORT:
-                CreateCustomAttribute<std::int16_t>(model, *accessor, customAttribute.second);
+                CreateCustomAttribute<std::int16_t>(model, part, *accessor, layout);
                 break;
             case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT:
-                CreateCustomAttribute<std::uint16_t>(model, *accessor, customAttribute.second);
+                CreateCustomAttribute<std::uint16_t>(model, part, *accessor, layout);
                 break;
             case CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_INT:
-                CreateCustomAttribute<std::uint32_t>(model, *accessor, customAttribute.second);
+                CreateCustomAttribute<std::uint32_t>(model, part, *accessor, layout);
                 break;
             case CesiumGltf::AccessorSpec::ComponentType::FLOAT:
-                CreateCustomAttribute<float>(model, *accessor, customAttribute.second);
+                CreateCustomAttribute<float>(model, part, *accessor, layout);
                 break;
             default:
                 break;
@@ -745,58 +1461,42 @@ namespace Cesium
 
     template<typename ComponentType>
     void GltfTrianglePrimitiveBuilder::CreateCustomAttribute(
-        const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, const GltfShaderVertexAttribute& customShaderAttribute)
+        const CesiumGltf::Model& model,
+        const PartLoadContext& part,
+        const CesiumGltf::Accessor& accessor,
+        const VertexAttributeLayout& layout)
     {
         if (accessor.type == CesiumGltf::AccessorSpec::Type::SCALAR)
         {
             CesiumGltf::AccessorView<ComponentType> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
-            vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
-            vertexBuffer.m_format = customShaderAttribute.m_format;
-            CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
-
-            m_customAttributes.emplace_back(customShaderAttribute, std::move(vertexBuffer));
+            CopyAccessorToBuffer(part, accessorView, layout.m_bufferView);
         }
         else if (accessor.type == CesiumGltf::AccessorSpec::Type::VEC2)
         {
             CesiumGltf::AccessorView<glm::vec<2, ComponentType, glm::defaultp>> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
-            vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
-            vertexBuffer.m_format = customShaderAttribute.m_format;
-            CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
-
-            m_customAttributes.emplace_back(customShaderAttribute, std::move(vertexBuffer));
+            CopyAccessorToBuffer(part, accessorView, layout.m_bufferView);
         }
         else if (accessor.type == CesiumGltf::AccessorSpec::Type::VEC3)
         {
             CesiumGltf::AccessorView<glm::vec<3, ComponentType, glm::defaultp>> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
-            vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
-            vertexBuffer.m_format = customShaderAttribute.m_format;
-            CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
-
-            m_customAttributes.emplace_back(customShaderAttribute, std::move(vertexBuffer));
+            CopyAccessorToBuffer(part, accessorView, layout.m_bufferView);
         }
         else if (accessor.type == CesiumGltf::AccessorSpec::Type::VEC4)
         {
             CesiumGltf::AccessorView<glm::vec<4, ComponentType, glm::defaultp>> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
-            vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
-            vertexBuffer.m_format = customShaderAttribute.m_format;
-            CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
-
-            m_customAttributes.emplace_back(customShaderAttribute, std::move(vertexBuffer));
+            CopyAccessorToBuffer(part, accessorView, layout.m_bufferView);
         }
     }
 
-    void GltfTrianglePrimitiveBuilder::CreateFlatNormal()
+    void GltfTrianglePrimitiveBuilder::CreateFlatNormal(const PartLoadContext& part)
     {
-        m_normals.resize(m_positions.size());
-        for (std::size_t i = 0; i < m_positions.size(); i += 3)
+        AZStd::span<glm::vec3> positions = GetPartBufferRegion<glm::vec3>(part, m_positionsBufferView);
+        AZStd::span<glm::vec3> normals = GetPartBufferRegion<glm::vec3>(part, m_normalsBufferView);
+        for (std::size_t i = 0; i < positions.size(); i += 3)
         {
-            const glm::vec3& p0 = m_positions[i];
-            const glm::vec3& p1 = m_positions[i + 1];
-            const glm::vec3& p2 = m_positions[i + 2];
+            const glm::vec3& p0 = positions[i];
+            const glm::vec3& p1 = positions[i + 1];
+            const glm::vec3& p2 = positions[i + 2];
             glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
             if (CesiumUtility::Math::equalsEpsilon(glm::dot(normal, normal), 0.0, CesiumUtility::Math::EPSILON5))
             {
@@ -807,36 +1507,58 @@ namespace Cesium
                 normal = glm::normalize(normal);
             }
 
-            m_normals[i] = normal;
-            m_normals[i + 1] = normal;
-            m_normals[i + 2] = normal;
+            normals[i] = normal;
+            normals[i + 1] = normal;
+            normals[i + 2] = normal;
         }
     }
 
-    void GltfTrianglePrimitiveBuilder::CopySubregionBuffer(
-        AZStd::vector<std::byte>& buffer, const void* src, const AZ::RHI::BufferViewDescriptor& descriptor)
+    AZ::Aabb GltfTrianglePrimitiveBuilder::CreateAabb(const AZStd::vector<PartLoadContext>& parts)
     {
-        std::size_t offset = descriptor.m_elementOffset * descriptor.m_elementSize;
-        std::size_t totalBytes = descriptor.m_elementCount * descriptor.m_elementSize;
-        memcpy(buffer.data() + offset, src, totalBytes);
+        // the accessor bounds can only be used when the vertices are not transformed
+        if (parts.size() == 1 && !parts.front().m_bakeTransform)
+        {
+            const CommonAccessorViews& accessorViews = parts.front().m_accessorViews;
+            const CesiumGltf::Accessor* positionAccessor = accessorViews.m_positionAccessor;
+            if (positionAccessor->min.size() == 3 && positionAccessor->max.size() == 3)
+            {
+                return AZ::Aabb::CreateFromMinMaxValues(
+                    static_cast<float>(positionAccessor->min[0]), static_cast<float>(positionAccessor->min[1]),
+                    static_cast<float>(positionAccessor->min[2]), static_cast<float>(positionAccessor->max[0]),
+                    static_cast<float>(positionAccessor->max[1]), static_cast<float>(positionAccessor->max[2]));
+            }
+
+            return CreateAabbFromPositions(accessorViews.m_positions);
+        }
+
+        AZ::Aabb aabb = AZ::Aabb::CreateNull();
+        for (const glm::vec3& position : GetBufferRegion<glm::vec3>(m_positionsBufferView))
+        {
+            aabb.AddPoint(AZ::Vector3(position.x, position.y, position.z));
+        }
+
+        return aabb;
     }
 
     void GltfTrianglePrimitiveBuilder::Reset()
     {
-        m_context = LoadContext{};
-        m_indices.clear();
-        m_positions.clear();
-        m_normals.clear();
-        m_tangents.clear();
-        m_bitangents.clear();
+        m_vertexCount = 0;
+        m_indexCount = 0;
+        m_needTangents = false;
+        m_indicesBufferView = AZ::RHI::BufferViewDescriptor{};
+        m_positionsBufferView = AZ::RHI::BufferViewDescriptor{};
+        m_normalsBufferView = AZ::RHI::BufferViewDescriptor{};
+        m_tangentsBufferView = AZ::RHI::BufferViewDescriptor{};
+        m_bitangentsBufferView = AZ::RHI::BufferViewDescriptor{};
         for (std::size_t i = 0; i < m_uvs.size(); ++i)
         {
-            m_uvs[i].m_buffer.clear();
-            m_uvs[i].m_elementCount = 0;
-            m_uvs[i].m_format = AZ::RHI::Format::Unknown;
+            m_uvs[i] = VertexAttributeLayout{};
         }
 
         m_customAttributes.clear();
+        m_constantStreams = ConstantVertexStreams{};
+        m_buffer.clear();
+        m_geometryAllocation = nullptr;
     }
 
     AZ::Aabb GltfTrianglePrimitiveBuilder::CreateAabbFromPositions(const CesiumGltf::AccessorView<glm::vec3>& positionAccessorView)
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Systems/CriticalAssetManager.h"
 #include <Atom/RHI.Reflect/Format.h>
+#include <Atom/RHI.Reflect/BufferViewDescriptor.h>
 #include <AzCore/std/containers/vector.h>
 #include <AzCore/std/containers/array.h>
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
 #include <glm/glm.hpp>
 
 namespace CesiumGltf
@@ -23,6 +27,7 @@ namespace AZ
     namespace RPI
     {
         class ModelAsset;
+        class ModelLodAsset;
         class BufferAsset;
     } // namespace RPI
 
@@ -35,10 +40,49 @@ namespace AZ
 
 namespace Cesium
 {
+    class GeometryHeap;
+
+    class GltfPrimitiveCache;
+
+    struct GltfPrimitiveCacheKey;
+
+    struct GltfTrianglePrimitiveBuilderOption final
+    {
+        GltfTrianglePrimitiveBuilderOption();
+
+        // Reorder triangles and vertices of indexed primitives for the post-transform vertex cache, overdraw and vertex fetch
+        bool m_optimizeVertexOrder;
+
+        // Number of simplified LODs generated in addition to the full detail mesh, so that Atom can switch to them with distance
+        std::uint32_t m_generatedLodCount;
+
+        // Split primitives that have more triangles than this into spatially compact clusters, each drawn as its own model with tight
+        // bounds, so that the renderer culls the clusters that are off-screen instead of drawing the whole primitive. Clusters share
+        // the vertex buffer of the primitive. Zero disables the split. Primitives are not split when LODs are generated
+        std::uint32_t m_clusterTriangleCount;
+
+        // Build a bounding volume hierarchy of the triangles, so that the primitive can be ray casted on the CPU
+        bool m_buildRaycastBvh;
+
+        // Cook a simplified triangle mesh of the primitive for physics. The simplification error is relative to the extent of the
+        // primitive, and zero keeps every triangle
+        bool m_buildCollisionMesh;
+        float m_collisionSimplificationError;
+
+        // Heap that the vertex and index buffer of the primitive is sub-allocated from. Each primitive gets its own buffer when it is null
+        AZStd::shared_ptr<GeometryHeap> m_geometryHeap;
+
+        // Primitives whose source accessors, material layout and options are identical to an already built primitive reuse its model
+        // instead of building a new one. Every primitive is built when it is null
+        AZStd::shared_ptr<GltfPrimitiveCache> m_primitiveCache;
+    };
+
     class GltfTrianglePrimitiveBuilder final
     {
         struct CommonAccessorViews;
 
+        struct PartLoadContext;
+
         struct LoadContext final
         {
             LoadContext();
@@ -48,81 +92,165 @@ namespace Cesium
             bool m_generateUnIndexedMesh;
         };
 
-        struct VertexRawBuffer final
+        struct VertexAttributeLayout final
         {
-            VertexRawBuffer();
+            VertexAttributeLayout();
 
-            AZStd::vector<std::byte> m_buffer;
             AZ::RHI::Format m_format;
-            std::size_t m_elementCount;
+            AZ::RHI::BufferViewDescriptor m_bufferView;
         };
 
         struct VertexCustomAttribute final
         {
-            VertexCustomAttribute(const GltfShaderVertexAttribute& shaderAttribute, VertexRawBuffer&& buffer);
+            VertexCustomAttribute(const GltfShaderVertexAttribute& shaderAttribute);
 
             GltfShaderVertexAttribute m_shaderAttribute;
-            VertexRawBuffer m_buffer;
+            VertexAttributeLayout m_layout;
         };
 
     public:
+        // A primitive to be concatenated into a merged primitive. The transform is baked into the vertices of the primitive
+        struct PrimitivePart final
+        {
+            PrimitivePart(const CesiumGltf::MeshPrimitive& primitive, const glm::dmat4& transform);
+
+            const CesiumGltf::MeshPrimitive* m_primitive;
+            glm::dmat4 m_transform;
+        };
+
+        GltfTrianglePrimitiveBuilder();
+
+        GltfTrianglePrimitiveBuilder(const GltfTrianglePrimitiveBuilderOption& option);
+
         void Create(
             const CesiumGltf::Model& model,
             const CesiumGltf::MeshPrimitive& primitive,
             const GltfLoadMaterial& material,
             GltfLoadPrimitive& result);
 
+        // Concatenate primitives that share the same material into a single primitive. Vertices of each part are transformed by
+        // its transform, and indices are rebased, so the result can be drawn in one draw call
+        void Create(
+            const CesiumGltf::Model& model,
+            const AZStd::vector<PrimitivePart>& parts,
+            const GltfLoadMaterial& material,
+            GltfLoadPrimitive& result);
+
     private:
-        void DetermineLoadContext(const CommonAccessorViews& accessorViews, const GltfLoadMaterial& material);
+        AZ::Data::Asset<AZ::RPI::ModelLodAsset> CreateLodAsset(
+            const AZ::Data::Asset<AZ::RPI::BufferAsset>& bufferAsset,
+            const AZ::RHI::BufferViewDescriptor& indicesBufferView,
+            const AZ::Aabb& aabb);
+
+        void CreateLodIndices(AZStd::vector<AZ::RHI::BufferViewDescriptor>& lodIndicesBufferViews);
+
+        void CreateClusters(AZStd::vector<AZ::RHI::BufferViewDescriptor>& clusterIndicesBufferViews, AZStd::vector<AZ::Aabb>& clusterAabbs);
+
+        bool ComputeCacheKey(
+            const CesiumGltf::Model& model,
+            const AZStd::vector<PrimitivePart>& parts,
+            const GltfLoadMaterial& material,
+            GltfPrimitiveCacheKey& key) const;
+
+        AZ::RHI::BufferViewDescriptor GetBlockBufferView(const AZ::RHI::BufferViewDescriptor& bufferView) const;
+
+        AZStd::shared_ptr<const TriangleBvh> CreateRaycastBvh();
+
+        AZStd::shared_ptr<const GltfCollisionMesh> CreateCollisionMesh();
+
+        bool PreparePart(const CesiumGltf::Model& model, const GltfLoadMaterial& material, PartLoadContext& part);
+
+        void DetermineLoadContext(PartLoadContext& part, const GltfLoadMaterial& material);
+
+        void OptimizeVertexOrder(PartLoadContext& part);
+
+        static void RemoveOutOfRangeTriangles(AZStd::vector<std::uint32_t>& indices, std::size_t vertexCount);
+
+        void DetermineUVsAttributes(const CesiumGltf::Model& model, AZStd::vector<PartLoadContext>& parts);
+
+        void DetermineCustomAttributes(
+            const CesiumGltf::Model& model, const GltfLoadMaterial& material, AZStd::vector<PartLoadContext>& parts);
+
+        void CreateBufferLayout();
 
         template<typename AccessorType>
         void CopyAccessorToBuffer(
-            const CesiumGltf::AccessorView<AccessorType>& attributeAccessorView, AZStd::vector<AccessorType>& attributes);
+            const PartLoadContext& part,
+            const CesiumGltf::AccessorView<AccessorType>& accessorView,
+            const AZ::RHI::BufferViewDescriptor& bufferView);
 
-        template<typename AccessorType>
-        void CopyAccessorToBuffer(const CesiumGltf::AccessorView<AccessorType>& accessorView, AZStd::vector<std::byte>& buffer);
+        template<typename ElementType>
+        AZStd::span<ElementType> GetBufferRegion(const AZ::RHI::BufferViewDescriptor& bufferView);
+
+        template<typename ElementType>
+        AZStd::span<ElementType> GetPartBufferRegion(const PartLoadContext& part, const AZ::RHI::BufferViewDescriptor& bufferView);
 
-        bool CreateIndices(
-            const CommonAccessorViews& accessorViews, const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive);
+        void ZeroPartBufferRegion(const PartLoadContext& part, const AZ::RHI::BufferViewDescriptor& bufferView);
+
+        bool CreateIndices(const CesiumGltf::Model& model, PartLoadContext& part);
 
         template<typename IndexType>
-        bool CreateIndices(const CesiumGltf::MeshPrimitive& primitive, const CesiumGltf::AccessorView<IndexType>& indicesAccessorView);
+        bool CreateIndices(PartLoadContext& part, const CesiumGltf::AccessorView<IndexType>& indicesAccessorView);
+
+        void CreateIndicesAttribute(const PartLoadContext& part);
 
-        void CreatePositionsAttribute(const CommonAccessorViews& commonAccessorViews);
+        void CreatePositionsAttribute(const PartLoadContext& part);
 
-        void CreateNormalsAttribute(const CommonAccessorViews& commonAccessorViews);
+        void CreateNormalsAttribute(const PartLoadContext& part);
 
-        void CreateUVsAttributes(
-            const CommonAccessorViews& commonAccessorViews, const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive);
+        void CreateUVsAttributes(const CesiumGltf::Model& model, const PartLoadContext& part);
 
-        void CreateTangentsAndBitangentsAttributes(const CommonAccessorViews& commonAccessorViews);
+        void CreateTangentsAndBitangentsAttributes(const PartLoadContext& part);
 
-        void CreateCustomAttributes(
-            const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, const GltfLoadMaterial& material);
+        void CreateCustomAttributes(const CesiumGltf::Model& model, const PartLoadContext& part);
 
         template<typename ComponentType>
         void CreateCustomAttribute(
-            const CesiumGltf::Model& model, const CesiumGltf::Accessor& accessor, const GltfShaderVertexAttribute& customShaderAttribute);
+            const CesiumGltf::Model& model,
+            const PartLoadContext& part,
+            const CesiumGltf::Accessor& accessor,
+            const VertexAttributeLayout& layout);
 
-        void CreateFlatNormal();
+        void CreateFlatNormal(const PartLoadContext& part);
 
-        void CopySubregionBuffer(AZStd::vector<std::byte>& buffer, const void* src, const AZ::RHI::BufferViewDescriptor& descriptor);
+        AZ::Aabb CreateAabb(const AZStd::vector<PartLoadContext>& parts);
 
         void Reset();
 
+        static AZ::RHI::BufferViewDescriptor AppendBufferView(
+            std::size_t& totalBufferSize, std::size_t elementCount, AZ::RHI::Format format);
+
         static AZ::Data::Asset<AZ::RPI::BufferAsset> CreateBufferAsset(const AZStd::vector<std::byte>& buffer);
 
         static AZ::Aabb CreateAabbFromPositions(const CesiumGltf::AccessorView<glm::vec3>& positionAccessorView);
 
         static bool DoesRHIVertexFormatSupported(const CesiumGltf::Accessor& accessor, AZ::RHI::Format format);
 
-        LoadContext m_context;
-        AZStd::vector<std::uint32_t> m_indices;
-        AZStd::vector<glm::vec3> m_positions;
-        AZStd::vector<glm::vec3> m_normals;
-        AZStd::vector<glm::vec4> m_tangents;
-        AZStd::vector<glm::vec3> m_bitangents;
-        AZStd::array<VertexRawBuffer, 2> m_uvs;
+        static constexpr std::uint32_t MAX_GENERATED_LOD_COUNT = 4;
+        static constexpr float LOD_TARGET_ERROR = 0.01f;
+        static constexpr float LOD_MIN_REDUCTION = 0.9f;
+
+        GltfTrianglePrimitiveBuilderOption m_option;
+        std::size_t m_vertexCount;
+        std::size_t m_indexCount;
+
+        // Tangents and bitangents are only stored when the material needs them. Otherwise they, and the UV sets that the
+        // primitive doesn't have, are bound to the constant streams
+        bool m_needTangents;
+        ConstantVertexStreams m_constantStreams;
+        AZ::RHI::BufferViewDescriptor m_indicesBufferView;
+        AZ::RHI::BufferViewDescriptor m_positionsBufferView;
+        AZ::RHI::BufferViewDescriptor m_normalsBufferView;
+        AZ::RHI::BufferViewDescriptor m_tangentsBufferView;
+        AZ::RHI::BufferViewDescriptor m_bitangentsBufferView;
+        AZStd::array<VertexAttributeLayout, 2> m_uvs;
         AZStd::vector<VertexCustomAttribute> m_customAttributes;
+
+        // Final vertex and index buffer of the primitive. Every attribute is written straight into its region, and the capacity is
+        // kept between primitives so that a single builder can load a whole model without reallocating
+        AZStd::vector<std::byte> m_buffer;
+
+        // range of the geometry heap that the buffer is copied to, when the primitive is sub-allocated
+        AZStd::shared_ptr<const GeometryHeapAllocation> m_geometryAllocation;
     };
 } // namespace Cesium
@@ -0,0 +1,114 @@
+#include "Cesium/Gltf/GltfPrimitiveCache.h"
+
+namespace Cesium
+{
+    GltfPrimitiveCacheAccessor::GltfPrimitiveCacheAccessor()
+        : m_count{ 0 }
+        , m_componentType{ 0 }
+        , m_componentCount{ 0 }
+        , m_normalized{ false }
+        , m_byteSize{ 0 }
+    {
+    }
+
+    bool GltfPrimitiveCacheAccessor::operator==(const GltfPrimitiveCacheAccessor& other) const
+    {
+        return m_count == other.m_count && m_componentType == other.m_componentType && m_componentCount == other.m_componentCount &&
+            m_normalized == other.m_normalized && m_byteSize == other.m_byteSize;
+    }
+
+    GltfPrimitiveCacheKey::GltfPrimitiveCacheKey()
+        : m_hash{ 0 }
+        , m_checksum{ 0 }
+    {
+    }
+
+    bool GltfPrimitiveCacheKey::operator==(const GltfPrimitiveCacheKey& other) const
+    {
+        return m_hash == other.m_hash && m_checksum == other.m_checksum && m_accessors == other.m_accessors;
+    }
+
+    GltfSharedPrimitive::GltfSharedPrimitive()
+        : m_bufferSize{ 0 }
+    {
+    }
+
+    GltfPrimitiveCacheStatistics::GltfPrimitiveCacheStatistics()
+        : m_entryCount{ 0 }
+        , m_hitCount{ 0 }
+        , m_missCount{ 0 }
+        , m_savedBytes{ 0 }
+    {
+    }
+
+    GltfPrimitiveCache::GltfPrimitiveCache()
+        : m_addCountSinceCleanup{ 0 }
+        , m_hitCount{ 0 }
+        , m_missCount{ 0 }
+        , m_savedBytes{ 0 }
+    {
+    }
+
+    AZStd::shared_ptr<const GltfSharedPrimitive> GltfPrimitiveCache::Find(const GltfPrimitiveCacheKey& key)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        auto it = m_primitives.find(key.m_hash);
+        AZStd::shared_ptr<const GltfSharedPrimitive> primitive = it != m_primitives.end() ? it->second.lock() : nullptr;
+        if (!primitive || !(primitive->m_key == key))
+        {
+            ++m_missCount;
+            return nullptr;
+        }
+
+        ++m_hitCount;
+        m_savedBytes += primitive->m_bufferSize;
+        return primitive;
+    }
+
+    void GltfPrimitiveCache::Add(const AZStd::shared_ptr<const GltfSharedPrimitive>& primitive)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+
+        // two threads may build the same primitive at once, or two primitives may have the same hash. The last one replaces the
+        // other, which stays valid for its own models
+        m_primitives.insert_or_assign(primitive->m_key.m_hash, AZStd::weak_ptr<const GltfSharedPrimitive>(primitive));
+        if (++m_addCountSinceCleanup >= CLEANUP_INTERVAL)
+        {
+            RemoveReleasedPrimitives();
+            m_addCountSinceCleanup = 0;
+        }
+    }
+
+    GltfPrimitiveCacheStatistics GltfPrimitiveCache::GetStatistics() const
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        GltfPrimitiveCacheStatistics statistics;
+        statistics.m_hitCount = m_hitCount;
+        statistics.m_missCount = m_missCount;
+        statistics.m_savedBytes = m_savedBytes;
+        for (const auto& primitive : m_primitives)
+        {
+            if (!primitive.second.expired())
+            {
+                ++statistics.m_entryCount;
+            }
+        }
+
+        return statistics;
+    }
+
+    void GltfPrimitiveCache::RemoveReleasedPrimitives()
+    {
+        for (auto it = m_primitives.begin(); it != m_primitives.end();)
+        {
+            if (it->second.expired())
+            {
+                it = m_primitives.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+} // namespace Cesium
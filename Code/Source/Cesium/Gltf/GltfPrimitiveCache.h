@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzCore/std/smart_ptr/weak_ptr.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    class TriangleBvh;
+
+    class GeometryHeapAllocation;
+
+    struct GltfCollisionMesh;
+
+    // Description of a source accessor of a primitive, compared along with the hashes of the key
+    struct GltfPrimitiveCacheAccessor final
+    {
+        GltfPrimitiveCacheAccessor();
+
+        bool operator==(const GltfPrimitiveCacheAccessor& other) const;
+
+        std::int64_t m_count;
+        std::int32_t m_componentType;
+        std::int64_t m_componentCount;
+        bool m_normalized;
+        std::int64_t m_byteSize;
+    };
+
+    // Source of a triangle primitive. The hash selects the cache entry, while the CRC of the same content and the description of
+    // the accessors are compared on every hit, so that two different primitives whose hashes collide are never mixed up
+    struct GltfPrimitiveCacheKey final
+    {
+        GltfPrimitiveCacheKey();
+
+        bool operator==(const GltfPrimitiveCacheKey& other) const;
+
+        std::uint64_t m_hash;
+        std::uint32_t m_checksum;
+        AZStd::vector<GltfPrimitiveCacheAccessor> m_accessors;
+    };
+
+    // Geometry built for a triangle primitive, which the identical primitives of other tiles reuse instead of building their own
+    struct GltfSharedPrimitive final
+    {
+        GltfSharedPrimitive();
+
+        GltfPrimitiveCacheKey m_key;
+
+        AZ::Data::Asset<AZ::RPI::ModelAsset> m_modelAsset;
+        AZStd::vector<AZ::Data::Asset<AZ::RPI::ModelAsset>> m_clusterModelAssets;
+        AZStd::shared_ptr<const TriangleBvh> m_raycastBvh;
+        AZStd::shared_ptr<const GltfCollisionMesh> m_collisionMesh;
+        AZStd::shared_ptr<const GeometryHeapAllocation> m_geometryAllocation;
+
+        // size of the vertex and index buffer, which every reuse of the primitive saves
+        std::size_t m_bufferSize;
+    };
+
+    struct GltfPrimitiveCacheStatistics final
+    {
+        GltfPrimitiveCacheStatistics();
+
+        std::size_t m_entryCount;
+        std::uint64_t m_hitCount;
+        std::uint64_t m_missCount;
+        std::uint64_t m_savedBytes;
+    };
+
+    // Primitives built by GltfTrianglePrimitiveBuilder, by the hash of their source accessors, material layout and build options.
+    // The cache only holds weak references, so a primitive is released once the last model using it is. Thread safe
+    class GltfPrimitiveCache final
+    {
+    public:
+        GltfPrimitiveCache();
+
+        // Return the primitive built for the key, or null if there is none, it has been released or its key only has the same hash
+        AZStd::shared_ptr<const GltfSharedPrimitive> Find(const GltfPrimitiveCacheKey& key);
+
+        // Add a primitive under its key
+        void Add(const AZStd::shared_ptr<const GltfSharedPrimitive>& primitive);
+
+        GltfPrimitiveCacheStatistics GetStatistics() const;
+
+    private:
+        void RemoveReleasedPrimitives();
+
+        // released primitives are only removed once this many primitives have been added since the last cleanup
+        static constexpr std::size_t CLEANUP_INTERVAL = 256;
+
+        mutable AZStd::mutex m_mutex;
+        AZStd::unordered_map<std::uint64_t, AZStd::weak_ptr<const GltfSharedPrimitive>> m_primitives;
+        std::size_t m_addCountSinceCleanup;
+        std::uint64_t m_hitCount;
+        std::uint64_t m_missCount;
+        std::uint64_t m_savedBytes;
+    };
+} // namespace Cesium
@@ -0,0 +1,292 @@
+#include "Cesium/Gltf/IndexBufferOptimizer.h"
+#include <AzCore/std/sort.h>
+#include <cassert>
+#include <limits>
+
+namespace Cesium
+{
+    void IndexBufferOptimizer::OptimizeVertexCache(
+        AZStd::span<std::uint32_t> indices, std::size_t vertexCount, AZStd::vector<std::uint32_t>& clusterOffsets)
+    {
+        clusterOffsets.clear();
+        std::size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0 || vertexCount == 0)
+        {
+            return;
+        }
+
+        // count the triangles that are not emitted yet for each vertex
+        AZStd::vector<std::uint32_t> liveTriangles(vertexCount, 0);
+        for (std::size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            assert(indices[i] < vertexCount);
+            ++liveTriangles[indices[i]];
+        }
+
+        // build vertex to triangles adjacency. The offsets are moved forward while filling the triangles of each vertex,
+        // so they are shifted back by one vertex afterward
+        AZStd::vector<std::uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (std::size_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + liveTriangles[vertex];
+        }
+
+        AZStd::vector<std::uint32_t> adjacency(triangleCount * 3);
+        for (std::size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            adjacency[adjacencyOffsets[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+
+        for (std::size_t vertex = vertexCount; vertex > 0; --vertex)
+        {
+            adjacencyOffsets[vertex] = adjacencyOffsets[vertex - 1];
+        }
+
+        adjacencyOffsets[0] = 0;
+
+        // Tipsify. Triangles are emitted in fans around a vertex, then the next fanning vertex is picked among the vertices of the fan
+        // that are still in the cache. When there is none, we go back to the most recent vertex that still has triangles
+        AZStd::vector<std::uint32_t> cacheTimeStamps(vertexCount, 0);
+        AZStd::vector<std::uint8_t> emittedTriangles(triangleCount, 0);
+        AZStd::vector<std::uint32_t> deadEndStack;
+        AZStd::vector<std::uint32_t> candidates;
+        AZStd::vector<std::uint32_t> output;
+        deadEndStack.reserve(triangleCount * 3);
+        output.reserve(triangleCount * 3);
+
+        std::uint32_t timeStamp = static_cast<std::uint32_t>(VERTEX_CACHE_SIZE) + 1;
+        std::size_t inputCursor = 0;
+        std::int64_t fanningVertex = indices[0];
+        bool isClusterStart = true;
+        while (fanningVertex >= 0)
+        {
+            if (isClusterStart)
+            {
+                clusterOffsets.emplace_back(static_cast<std::uint32_t>(output.size() / 3));
+                isClusterStart = false;
+            }
+
+            candidates.clear();
+            for (std::uint32_t i = adjacencyOffsets[fanningVertex]; i < adjacencyOffsets[fanningVertex + 1]; ++i)
+            {
+                std::uint32_t triangle = adjacency[i];
+                if (emittedTriangles[triangle])
+                {
+                    continue;
+                }
+
+                for (std::size_t corner = 0; corner < 3; ++corner)
+                {
+                    std::uint32_t vertex = indices[triangle * 3 + corner];
+                    output.emplace_back(vertex);
+                    deadEndStack.emplace_back(vertex);
+                    candidates.emplace_back(vertex);
+                    --liveTriangles[vertex];
+                    if (timeStamp - cacheTimeStamps[vertex] > VERTEX_CACHE_SIZE)
+                    {
+                        cacheTimeStamps[vertex] = timeStamp++;
+                    }
+                }
+
+                emittedTriangles[triangle] = 1;
+            }
+
+            // pick the candidate that has been in the cache the longest but will still be there after its remaining triangles are emitted
+            std::int64_t nextVertex = -1;
+            std::int64_t bestPriority = -1;
+            for (std::uint32_t vertex : candidates)
+            {
+                if (liveTriangles[vertex] == 0)
+                {
+                    continue;
+                }
+
+                std::int64_t priority = 0;
+                std::int64_t age = static_cast<std::int64_t>(timeStamp - cacheTimeStamps[vertex]);
+                if (age + 2 * static_cast<std::int64_t>(liveTriangles[vertex]) <= static_cast<std::int64_t>(VERTEX_CACHE_SIZE))
+                {
+                    priority = age;
+                }
+
+                if (priority > bestPriority)
+                {
+                    bestPriority = priority;
+                    nextVertex = vertex;
+                }
+            }
+
+            if (nextVertex >= 0)
+            {
+                fanningVertex = nextVertex;
+                continue;
+            }
+
+            // dead end. Resume from the most recently emitted vertex that still has triangles
+            while (!deadEndStack.empty())
+            {
+                std::uint32_t vertex = deadEndStack.back();
+                deadEndStack.pop_back();
+                if (liveTriangles[vertex] > 0)
+                {
+                    nextVertex = vertex;
+                    break;
+                }
+            }
+
+            // otherwise resume from the next vertex in input order
+            if (nextVertex < 0)
+            {
+                while (inputCursor < triangleCount * 3 && liveTriangles[indices[inputCursor]] == 0)
+                {
+                    ++inputCursor;
+                }
+
+                if (inputCursor < triangleCount * 3)
+                {
+                    nextVertex = indices[inputCursor];
+                }
+            }
+
+            // a new cluster starts when the fan cannot reuse the cache anymore
+            if (nextVertex >= 0 && timeStamp - cacheTimeStamps[nextVertex] > VERTEX_CACHE_SIZE)
+            {
+                isClusterStart = true;
+            }
+
+            fanningVertex = nextVertex;
+        }
+
+        assert(output.size() == triangleCount * 3);
+        AZStd::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    void IndexBufferOptimizer::OptimizeOverdraw(
+        AZStd::span<std::uint32_t> indices, const AZStd::span<const glm::vec3>& positions, const AZStd::vector<std::uint32_t>& clusterOffsets)
+    {
+        std::size_t triangleCount = indices.size() / 3;
+        if (clusterOffsets.size() <= 1 || triangleCount == 0)
+        {
+            return;
+        }
+
+        glm::dvec3 meshCenter{ 0.0 };
+        for (std::size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            assert(indices[i] < positions.size());
+            meshCenter += glm::dvec3(positions[indices[i]]);
+        }
+
+        meshCenter /= static_cast<double>(triangleCount * 3);
+
+        // Sort clusters by how much they face away from the center of the mesh. For a convex mesh, those clusters are in front
+        // of the others from any point of view where they are visible
+        struct ClusterSortKey
+        {
+            double m_key;
+            std::uint32_t m_cluster;
+        };
+
+        AZStd::vector<ClusterSortKey> sortKeys(clusterOffsets.size());
+        for (std::size_t cluster = 0; cluster < clusterOffsets.size(); ++cluster)
+        {
+            std::size_t begin = clusterOffsets[cluster];
+            std::size_t end = cluster + 1 < clusterOffsets.size() ? clusterOffsets[cluster + 1] : triangleCount;
+            glm::dvec3 clusterCenter{ 0.0 };
+            glm::dvec3 clusterNormal{ 0.0 };
+            double clusterArea = 0.0;
+            for (std::size_t triangle = begin; triangle < end; ++triangle)
+            {
+                glm::dvec3 p0 = positions[indices[triangle * 3]];
+                glm::dvec3 p1 = positions[indices[triangle * 3 + 1]];
+                glm::dvec3 p2 = positions[indices[triangle * 3 + 2]];
+                glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+                double area = glm::length(normal);
+                clusterCenter += (p0 + p1 + p2) * (area / 3.0);
+                clusterNormal += normal;
+                clusterArea += area;
+            }
+
+            double key = 0.0;
+            double normalLength = glm::length(clusterNormal);
+            if (clusterArea > 0.0 && normalLength > 0.0)
+            {
+                key = glm::dot(clusterCenter / clusterArea - meshCenter, clusterNormal / normalLength);
+            }
+
+            sortKeys[cluster] = ClusterSortKey{ key, static_cast<std::uint32_t>(cluster) };
+        }
+
+        AZStd::sort(
+            sortKeys.begin(), sortKeys.end(),
+            [](const ClusterSortKey& lhs, const ClusterSortKey& rhs)
+            {
+                return lhs.m_key > rhs.m_key || (lhs.m_key == rhs.m_key && lhs.m_cluster < rhs.m_cluster);
+            });
+
+        AZStd::vector<std::uint32_t> output;
+        output.reserve(triangleCount * 3);
+        for (const ClusterSortKey& sortKey : sortKeys)
+        {
+            std::size_t begin = clusterOffsets[sortKey.m_cluster];
+            std::size_t end = sortKey.m_cluster + 1 < clusterOffsets.size() ? clusterOffsets[sortKey.m_cluster + 1] : triangleCount;
+            output.insert(output.end(), indices.begin() + begin * 3, indices.begin() + end * 3);
+        }
+
+        AZStd::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    void IndexBufferOptimizer::OptimizeVertexFetch(
+        AZStd::span<std::uint32_t> indices, std::size_t vertexCount, AZStd::vector<std::uint32_t>& vertexRemap)
+    {
+        static constexpr std::uint32_t UNUSED_VERTEX = std::numeric_limits<std::uint32_t>::max();
+
+        vertexRemap.clear();
+        vertexRemap.resize(vertexCount, UNUSED_VERTEX);
+        std::uint32_t nextVertex = 0;
+        for (std::uint32_t& index : indices)
+        {
+            assert(index < vertexCount);
+            if (vertexRemap[index] == UNUSED_VERTEX)
+            {
+                vertexRemap[index] = nextVertex++;
+            }
+
+            index = vertexRemap[index];
+        }
+
+        for (std::uint32_t& remap : vertexRemap)
+        {
+            if (remap == UNUSED_VERTEX)
+            {
+                remap = nextVertex++;
+            }
+        }
+    }
+
+    float IndexBufferOptimizer::CalculateACMR(
+        const AZStd::span<const std::uint32_t>& indices, std::size_t vertexCount, std::size_t cacheSize)
+    {
+        std::size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0)
+        {
+            return 0.0f;
+        }
+
+        // a vertex is in the FIFO cache if it was inserted during the last cacheSize misses
+        AZStd::vector<std::size_t> cacheTimeStamps(vertexCount, 0);
+        std::size_t timeStamp = cacheSize + 1;
+        std::size_t misses = 0;
+        for (std::size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            std::uint32_t index = indices[i];
+            assert(index < vertexCount);
+            if (timeStamp - cacheTimeStamps[index] > cacheSize)
+            {
+                cacheTimeStamps[index] = timeStamp++;
+                ++misses;
+            }
+        }
+
+        return static_cast<float>(misses) / static_cast<float>(triangleCount);
+    }
+} // namespace Cesium
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace Cesium
+{
+    struct IndexBufferOptimizer
+    {
+    public:
+        // Reorder triangles so that vertices are reused while they are still in the post-transform vertex cache (Tipsify).
+        // The first triangle of each cluster found along the way is written to clusterOffsets, so that overdraw optimization
+        // can reorder the clusters without losing the cache locality inside them
+        static void OptimizeVertexCache(
+            AZStd::span<std::uint32_t> indices, std::size_t vertexCount, AZStd::vector<std::uint32_t>& clusterOffsets);
+
+        // Reorder the clusters produced by OptimizeVertexCache so that triangles facing away from the center of the mesh are drawn
+        // first, which lets the depth test reject more of the triangles behind them
+        static void OptimizeOverdraw(
+            AZStd::span<std::uint32_t> indices,
+            const AZStd::span<const glm::vec3>& positions,
+            const AZStd::vector<std::uint32_t>& clusterOffsets);
+
+        // Renumber vertices in the order they are first referenced by the indices. vertexRemap maps the old vertex to the new one.
+        // Vertices that are not referenced are moved to the end
+        static void OptimizeVertexFetch(
+            AZStd::span<std::uint32_t> indices, std::size_t vertexCount, AZStd::vector<std::uint32_t>& vertexRemap);
+
+        // Average number of vertices transformed per triangle with a FIFO vertex cache. Lower is better, with 0.5 being the best
+        // possible for a regular grid and 3.0 being the worst
+        static float CalculateACMR(const AZStd::span<const std::uint32_t>& indices, std::size_t vertexCount, std::size_t cacheSize);
+
+        static constexpr std::size_t VERTEX_CACHE_SIZE = 16;
+    };
+} // namespace Cesium
@@ -0,0 +1,139 @@
+#include "Cesium/Gltf/Ktx2Reader.h"
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/utils.h>
+#include <cstring>
+
+namespace Cesium
+{
+    namespace
+    {
+        constexpr std::uint8_t KTX2_IDENTIFIER[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+        template<typename T>
+        T ReadLittleEndian(const AZStd::span<const std::byte>& data, std::size_t offset)
+        {
+            T value = 0;
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                value |= static_cast<T>(static_cast<std::uint8_t>(data[offset + i])) << (8 * i);
+            }
+
+            return value;
+        }
+    } // namespace
+
+    Ktx2Image::Ktx2Image()
+        : m_format{ AZ::RHI::Format::Unknown }
+        , m_width{ 0 }
+        , m_height{ 0 }
+    {
+    }
+
+    bool Ktx2Reader::IsKtx2(const AZStd::span<const std::byte>& data)
+    {
+        return data.size() >= sizeof(KTX2_IDENTIFIER) && std::memcmp(data.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) == 0;
+    }
+
+    bool Ktx2Reader::Read(const AZStd::span<const std::byte>& data, Ktx2Image& image)
+    {
+        if (!IsKtx2(data) || data.size() < HEADER_SIZE)
+        {
+            return false;
+        }
+
+        std::uint32_t vkFormat = ReadLittleEndian<std::uint32_t>(data, 12);
+        std::uint32_t width = ReadLittleEndian<std::uint32_t>(data, 20);
+        std::uint32_t height = ReadLittleEndian<std::uint32_t>(data, 24);
+        std::uint32_t depth = ReadLittleEndian<std::uint32_t>(data, 28);
+        std::uint32_t layerCount = ReadLittleEndian<std::uint32_t>(data, 32);
+        std::uint32_t faceCount = ReadLittleEndian<std::uint32_t>(data, 36);
+        std::uint32_t levelCount = AZStd::max(ReadLittleEndian<std::uint32_t>(data, 40), 1u);
+        std::uint32_t supercompressionScheme = ReadLittleEndian<std::uint32_t>(data, 44);
+
+        // a format of 0 is a Basis Universal payload, which the GPU can't sample as is
+        const FormatInfo* formatInfo = FindFormat(vkFormat);
+        if (!formatInfo || supercompressionScheme != 0)
+        {
+            return false;
+        }
+
+        if (width == 0 || height == 0 || depth > 1 || layerCount > 1 || faceCount != 1 || levelCount > 32)
+        {
+            return false;
+        }
+
+        if (data.size() < HEADER_SIZE + std::size_t{ levelCount } * LEVEL_INDEX_ENTRY_SIZE)
+        {
+            return false;
+        }
+
+        // the level index is ordered from the most detailed level, even though the levels themselves are stored from the smallest
+        AZStd::vector<AZStd::span<const std::byte>> mips;
+        mips.reserve(levelCount);
+        for (std::uint32_t level = 0; level < levelCount; ++level)
+        {
+            std::uint32_t mipWidth = AZStd::max(width >> level, 1u);
+            std::uint32_t mipHeight = AZStd::max(height >> level, 1u);
+            std::uint64_t blockCountX = (mipWidth + formatInfo->m_blockSize - 1) / formatInfo->m_blockSize;
+            std::uint64_t blockCountY = (mipHeight + formatInfo->m_blockSize - 1) / formatInfo->m_blockSize;
+            std::uint64_t expectedLength = blockCountX * blockCountY * formatInfo->m_bytesPerBlock;
+
+            std::size_t entry = HEADER_SIZE + std::size_t{ level } * LEVEL_INDEX_ENTRY_SIZE;
+            std::uint64_t byteOffset = ReadLittleEndian<std::uint64_t>(data, entry);
+            std::uint64_t byteLength = ReadLittleEndian<std::uint64_t>(data, entry + 8);
+            if (byteLength != expectedLength || byteOffset > data.size() || byteLength > data.size() - byteOffset)
+            {
+                return false;
+            }
+
+            mips.emplace_back(data.data() + byteOffset, static_cast<std::size_t>(byteLength));
+        }
+
+        image.m_format = formatInfo->m_format;
+        image.m_width = width;
+        image.m_height = height;
+        image.m_mips = AZStd::move(mips);
+        return true;
+    }
+
+    const Ktx2Reader::FormatInfo* Ktx2Reader::FindFormat(std::uint32_t vkFormat)
+    {
+        // VkFormat values of the formats Atom samples directly. BC1 RGB is read as BC1 with an opaque alpha, and ETC2 RGB as the
+        // ETC1 subset of it
+        static constexpr FormatInfo formats[] = {
+            { 9, AZ::RHI::Format::R8_UNORM, 1, 1 },
+            { 37, AZ::RHI::Format::R8G8B8A8_UNORM, 1, 4 },
+            { 43, AZ::RHI::Format::R8G8B8A8_UNORM_SRGB, 1, 4 },
+            { 131, AZ::RHI::Format::BC1_UNORM, 4, 8 },
+            { 132, AZ::RHI::Format::BC1_UNORM_SRGB, 4, 8 },
+            { 133, AZ::RHI::Format::BC1_UNORM, 4, 8 },
+            { 134, AZ::RHI::Format::BC1_UNORM_SRGB, 4, 8 },
+            { 137, AZ::RHI::Format::BC3_UNORM, 4, 16 },
+            { 138, AZ::RHI::Format::BC3_UNORM_SRGB, 4, 16 },
+            { 139, AZ::RHI::Format::BC4_UNORM, 4, 8 },
+            { 141, AZ::RHI::Format::BC5_UNORM, 4, 16 },
+            { 145, AZ::RHI::Format::BC7_UNORM, 4, 16 },
+            { 146, AZ::RHI::Format::BC7_UNORM_SRGB, 4, 16 },
+            { 147, AZ::RHI::Format::ETC2_UNORM, 4, 8 },
+            { 148, AZ::RHI::Format::ETC2_UNORM_SRGB, 4, 8 },
+            { 149, AZ::RHI::Format::ETC2A1_UNORM, 4, 8 },
+            { 150, AZ::RHI::Format::ETC2A1_UNORM_SRGB, 4, 8 },
+            { 151, AZ::RHI::Format::ETC2A_UNORM, 4, 16 },
+            { 152, AZ::RHI::Format::ETC2A_UNORM_SRGB, 4, 16 },
+            { 153, AZ::RHI::Format::EAC_R11_UNORM, 4, 8 },
+            { 155, AZ::RHI::Format::EAC_RG11_UNORM, 4, 16 },
+            { 157, AZ::RHI::Format::ASTC_4x4_UNORM, 4, 16 },
+            { 158, AZ::RHI::Format::ASTC_4x4_UNORM_SRGB, 4, 16 },
+        };
+
+        for (const FormatInfo& format : formats)
+        {
+            if (format.m_vkFormat == vkFormat)
+            {
+                return &format;
+            }
+        }
+
+        return nullptr;
+    }
+} // namespace Cesium
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Atom/RHI.Reflect/Format.h>
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Levels of a KTX2 image, starting from the most detailed one. They point into the data the image is read from
+    struct Ktx2Image final
+    {
+        Ktx2Image();
+
+        AZ::RHI::Format m_format;
+        std::uint32_t m_width;
+        std::uint32_t m_height;
+        AZStd::vector<AZStd::span<const std::byte>> m_mips;
+    };
+
+    // Reader of the KTX2 container used by KHR_texture_basisu. Only 2D images whose levels are stored without supercompression in a
+    // format that the GPU samples directly are read. Basis Universal payloads are rejected, because they need to be transcoded first
+    struct Ktx2Reader
+    {
+    public:
+        static bool IsKtx2(const AZStd::span<const std::byte>& data);
+
+        static bool Read(const AZStd::span<const std::byte>& data, Ktx2Image& image);
+
+    private:
+        struct FormatInfo
+        {
+            std::uint32_t m_vkFormat;
+            AZ::RHI::Format m_format;
+            std::uint32_t m_blockSize;
+            std::uint32_t m_bytesPerBlock;
+        };
+
+        static const FormatInfo* FindFormat(std::uint32_t vkFormat);
+
+        static constexpr std::size_t HEADER_SIZE = 80;
+        static constexpr std::size_t LEVEL_INDEX_ENTRY_SIZE = 24;
+    };
+} // namespace Cesium
@@ -0,0 +1,99 @@
+#include "Cesium/Gltf/MeshPartitioner.h"
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/sort.h>
+#include <AzCore/std/utils.h>
+#include <algorithm>
+#include <limits>
+
+namespace Cesium
+{
+    void MeshPartitioner::Partition(
+        AZStd::span<std::uint32_t> indices,
+        const AZStd::span<const glm::vec3>& positions,
+        std::size_t maxTriangleCount,
+        AZStd::vector<std::uint32_t>& clusterOffsets)
+    {
+        std::uint32_t triangleCount = static_cast<std::uint32_t>(indices.size() / 3);
+        clusterOffsets.clear();
+        if (triangleCount == 0)
+        {
+            clusterOffsets.emplace_back(0);
+            return;
+        }
+
+        // a triangle that refers to a missing vertex has no centroid, so the mesh is left as a single cluster in its original order
+        std::size_t vertexCount = positions.size();
+        if (AZStd::any_of(
+                indices.begin(), indices.begin() + triangleCount * 3,
+                [vertexCount](std::uint32_t index)
+                {
+                    return index >= vertexCount;
+                }))
+        {
+            clusterOffsets.emplace_back(0);
+            clusterOffsets.emplace_back(triangleCount);
+            return;
+        }
+
+        maxTriangleCount = AZStd::max(maxTriangleCount, std::size_t{ 1 });
+        AZStd::vector<glm::vec3> centroids(triangleCount);
+        AZStd::vector<std::uint32_t> triangles(triangleCount);
+        for (std::uint32_t i = 0; i < triangleCount; ++i)
+        {
+            const glm::vec3& v0 = positions[indices[i * 3]];
+            const glm::vec3& v1 = positions[indices[i * 3 + 1]];
+            const glm::vec3& v2 = positions[indices[i * 3 + 2]];
+            centroids[i] = (v0 + v1 + v2) / 3.0f;
+            triangles[i] = i;
+        }
+
+        // split depth first, so that clusters next to each other in the buffer are next to each other in space
+        AZStd::vector<AZStd::pair<std::uint32_t, std::uint32_t>> ranges;
+        ranges.emplace_back(0, triangleCount);
+        while (!ranges.empty())
+        {
+            auto [begin, end] = ranges.back();
+            ranges.pop_back();
+            if (end - begin <= maxTriangleCount)
+            {
+                // restore the original order of the triangles inside the cluster
+                AZStd::sort(triangles.begin() + begin, triangles.begin() + end);
+                clusterOffsets.emplace_back(begin);
+                continue;
+            }
+
+            glm::vec3 minimum{ std::numeric_limits<float>::max() };
+            glm::vec3 maximum{ std::numeric_limits<float>::lowest() };
+            for (std::uint32_t i = begin; i < end; ++i)
+            {
+                minimum = glm::min(minimum, centroids[triangles[i]]);
+                maximum = glm::max(maximum, centroids[triangles[i]]);
+            }
+
+            glm::vec3 extent = maximum - minimum;
+            glm::length_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+            std::uint32_t middle = begin + (end - begin) / 2;
+            std::nth_element(
+                triangles.begin() + begin, triangles.begin() + middle, triangles.begin() + end,
+                [&centroids, axis](std::uint32_t lhs, std::uint32_t rhs)
+                {
+                    return centroids[lhs][axis] < centroids[rhs][axis];
+                });
+
+            // the first half is pushed last, so it is split first
+            ranges.emplace_back(middle, end);
+            ranges.emplace_back(begin, middle);
+        }
+
+        clusterOffsets.emplace_back(triangleCount);
+
+        AZStd::vector<std::uint32_t> sourceIndices(indices.begin(), indices.begin() + triangleCount * 3);
+        for (std::uint32_t i = 0; i < triangleCount; ++i)
+        {
+            std::uint32_t triangle = triangles[i];
+            indices[i * 3] = sourceIndices[triangle * 3];
+            indices[i * 3 + 1] = sourceIndices[triangle * 3 + 1];
+            indices[i * 3 + 2] = sourceIndices[triangle * 3 + 2];
+        }
+    }
+} // namespace Cesium
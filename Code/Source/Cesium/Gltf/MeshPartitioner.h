@@ -0,0 +1,23 @@
+#pragma once
+
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace Cesium
+{
+    struct MeshPartitioner
+    {
+    public:
+        // Reorder triangles into spatially compact clusters of at most maxTriangleCount triangles, by splitting the triangles at the
+        // median of their centroids along the longest axis until each half is small enough. Triangles keep their relative order inside
+        // a cluster, so the vertex cache order is preserved. The first triangle of each cluster is written to clusterOffsets, followed
+        // by the total triangle count. A mesh with an index past the end of positions is kept as a single cluster
+        static void Partition(
+            AZStd::span<std::uint32_t> indices,
+            const AZStd::span<const glm::vec3>& positions,
+            std::size_t maxTriangleCount,
+            AZStd::vector<std::uint32_t>& clusterOffsets);
+    };
+} // namespace Cesium
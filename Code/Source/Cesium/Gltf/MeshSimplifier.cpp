@@ -0,0 +1,410 @@
+#include "Cesium/Gltf/MeshSimplifier.h"
+#include <AzCore/std/sort.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace Cesium
+{
+    MeshSimplifier::Quadric::Quadric()
+        : m_a00{ 0.0 }
+        , m_a11{ 0.0 }
+        , m_a22{ 0.0 }
+        , m_a01{ 0.0 }
+        , m_a02{ 0.0 }
+        , m_a12{ 0.0 }
+        , m_b0{ 0.0 }
+        , m_b1{ 0.0 }
+        , m_b2{ 0.0 }
+        , m_c{ 0.0 }
+        , m_weight{ 0.0 }
+    {
+    }
+
+    MeshSimplifier::Quadric::Quadric(const glm::dvec3& normal, double distance, double weight)
+        : m_a00{ weight * normal.x * normal.x }
+        , m_a11{ weight * normal.y * normal.y }
+        , m_a22{ weight * normal.z * normal.z }
+        , m_a01{ weight * normal.x * normal.y }
+        , m_a02{ weight * normal.x * normal.z }
+        , m_a12{ weight * normal.y * normal.z }
+        , m_b0{ weight * normal.x * distance }
+        , m_b1{ weight * normal.y * distance }
+        , m_b2{ weight * normal.z * distance }
+        , m_c{ weight * distance * distance }
+        , m_weight{ weight }
+    {
+    }
+
+    MeshSimplifier::Quadric& MeshSimplifier::Quadric::operator+=(const Quadric& rhs)
+    {
+        m_a00 += rhs.m_a00;
+        m_a11 += rhs.m_a11;
+        m_a22 += rhs.m_a22;
+        m_a01 += rhs.m_a01;
+        m_a02 += rhs.m_a02;
+        m_a12 += rhs.m_a12;
+        m_b0 += rhs.m_b0;
+        m_b1 += rhs.m_b1;
+        m_b2 += rhs.m_b2;
+        m_c += rhs.m_c;
+        m_weight += rhs.m_weight;
+        return *this;
+    }
+
+    double MeshSimplifier::Quadric::Evaluate(const glm::dvec3& p) const
+    {
+        // weighted average of the squared distances from p to the planes accumulated in the quadric
+        if (m_weight == 0.0)
+        {
+            return 0.0;
+        }
+
+        double error = m_a00 * p.x * p.x + m_a11 * p.y * p.y + m_a22 * p.z * p.z;
+        error += 2.0 * (m_a01 * p.x * p.y + m_a02 * p.x * p.z + m_a12 * p.y * p.z);
+        error += 2.0 * (m_b0 * p.x + m_b1 * p.y + m_b2 * p.z);
+        error += m_c;
+        return std::fabs(error) / m_weight;
+    }
+
+    float MeshSimplifier::Simplify(
+        AZStd::vector<std::uint32_t>& destination,
+        const AZStd::span<const std::uint32_t>& indices,
+        const AZStd::span<const glm::vec3>& positions,
+        std::size_t targetIndexCount,
+        float targetError)
+    {
+        destination.assign(indices.begin(), indices.end());
+        if (indices.size() % 3 != 0 || indices.size() <= targetIndexCount)
+        {
+            return 0.0f;
+        }
+
+        for (std::uint32_t index : indices)
+        {
+            if (index >= positions.size())
+            {
+                return 0.0f;
+            }
+        }
+
+        // vertices that only differ by their attributes are welded, so that the topology of the surface is known
+        AZStd::vector<std::uint32_t> canonicalVertices;
+        std::size_t canonicalVertexCount = CreateCanonicalVertices(positions, canonicalVertices);
+
+        AZStd::vector<std::uint8_t> lockedVertices;
+        LockBorderAndSeamVertices(indices, canonicalVertices, canonicalVertexCount, lockedVertices);
+
+        // the error limit is relative to the extent of the mesh, so that it doesn't depend on its scale
+        glm::dvec3 minPosition{ std::numeric_limits<double>::max() };
+        glm::dvec3 maxPosition{ std::numeric_limits<double>::lowest() };
+        for (std::uint32_t index : indices)
+        {
+            minPosition = glm::min(minPosition, glm::dvec3(positions[index]));
+            maxPosition = glm::max(maxPosition, glm::dvec3(positions[index]));
+        }
+
+        glm::dvec3 size = maxPosition - minPosition;
+        double extent = std::max(std::max(size.x, size.y), size.z);
+        if (extent <= 0.0)
+        {
+            return 0.0f;
+        }
+
+        double errorLimit = static_cast<double>(targetError) * extent;
+        errorLimit *= errorLimit;
+
+        // accumulate the planes of the triangles around each vertex, weighted by their area
+        AZStd::vector<Quadric> quadrics(canonicalVertexCount);
+        for (std::size_t i = 0; i < indices.size(); i += 3)
+        {
+            glm::dvec3 p0{ positions[indices[i]] };
+            glm::dvec3 p1{ positions[indices[i + 1]] };
+            glm::dvec3 p2{ positions[indices[i + 2]] };
+            glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+            double area = glm::length(normal);
+            if (area == 0.0)
+            {
+                continue;
+            }
+
+            normal /= area;
+            Quadric quadric{ normal, -glm::dot(normal, p0), area };
+            quadrics[canonicalVertices[indices[i]]] += quadric;
+            quadrics[canonicalVertices[indices[i + 1]]] += quadric;
+            quadrics[canonicalVertices[indices[i + 2]]] += quadric;
+        }
+
+        AZStd::vector<std::uint32_t> vertexRemap(positions.size());
+        for (std::size_t i = 0; i < vertexRemap.size(); ++i)
+        {
+            vertexRemap[i] = static_cast<std::uint32_t>(i);
+        }
+
+        AZStd::vector<std::uint32_t> adjacencyOffsets;
+        AZStd::vector<std::uint32_t> adjacency;
+        AZStd::vector<Collapse> collapses;
+        AZStd::vector<std::uint8_t> collapsedVertices;
+        double maxError = 0.0;
+        while (destination.size() > targetIndexCount)
+        {
+            // triangles around each canonical vertex
+            adjacencyOffsets.assign(canonicalVertexCount + 1, 0);
+            for (std::uint32_t index : destination)
+            {
+                ++adjacencyOffsets[canonicalVertices[index] + 1];
+            }
+
+            for (std::size_t i = 0; i < canonicalVertexCount; ++i)
+            {
+                adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+            }
+
+            adjacency.resize(destination.size());
+            {
+                AZStd::vector<std::uint32_t> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+                for (std::size_t i = 0; i < destination.size(); ++i)
+                {
+                    adjacency[fillOffsets[canonicalVertices[destination[i]]]++] = static_cast<std::uint32_t>(i / 3);
+                }
+            }
+
+            // every half-edge is a candidate to collapse its start vertex into its end vertex
+            collapses.clear();
+            for (std::size_t i = 0; i < destination.size(); i += 3)
+            {
+                for (std::size_t corner = 0; corner < 3; ++corner)
+                {
+                    std::uint32_t v0 = destination[i + corner];
+                    std::uint32_t v1 = destination[i + (corner + 1) % 3];
+                    for (std::size_t direction = 0; direction < 2; ++direction)
+                    {
+                        std::uint32_t from = direction == 0 ? v0 : v1;
+                        std::uint32_t to = direction == 0 ? v1 : v0;
+                        std::uint32_t canonicalFrom = canonicalVertices[from];
+                        std::uint32_t canonicalTo = canonicalVertices[to];
+                        if (canonicalFrom == canonicalTo || lockedVertices[canonicalFrom])
+                        {
+                            continue;
+                        }
+
+                        Quadric quadric = quadrics[canonicalFrom];
+                        quadric += quadrics[canonicalTo];
+                        double error = quadric.Evaluate(glm::dvec3(positions[to]));
+                        if (error <= errorLimit)
+                        {
+                            collapses.push_back(Collapse{ from, to, error });
+                        }
+                    }
+                }
+            }
+
+            AZStd::sort(
+                collapses.begin(), collapses.end(),
+                [](const Collapse& lhs, const Collapse& rhs)
+                {
+                    return lhs.m_error < rhs.m_error;
+                });
+
+            // Collapse the cheapest edges first. The neighborhood of a collapsed vertex is left alone for the rest of the pass, so that
+            // the flip test of each collapse stays valid. Each collapse of an interior vertex removes two triangles
+            std::size_t trianglesToRemove = (destination.size() - targetIndexCount + 2) / 3;
+            std::size_t removedTriangles = 0;
+            std::size_t collapseCount = 0;
+            collapsedVertices.assign(canonicalVertexCount, 0);
+            for (const Collapse& collapse : collapses)
+            {
+                std::uint32_t canonicalFrom = canonicalVertices[collapse.m_from];
+                std::uint32_t canonicalTo = canonicalVertices[collapse.m_to];
+                if (collapsedVertices[canonicalFrom] || collapsedVertices[canonicalTo])
+                {
+                    continue;
+                }
+
+                AZStd::span<const std::uint32_t> triangles{ adjacency.data() + adjacencyOffsets[canonicalFrom],
+                                                            adjacencyOffsets[canonicalFrom + 1] - adjacencyOffsets[canonicalFrom] };
+                if (HasTriangleFlip(destination, canonicalVertices, positions, triangles, collapse))
+                {
+                    continue;
+                }
+
+                vertexRemap[collapse.m_from] = collapse.m_to;
+                quadrics[canonicalTo] += quadrics[canonicalFrom];
+                maxError = std::max(maxError, collapse.m_error);
+                for (std::uint32_t triangle : triangles)
+                {
+                    for (std::size_t corner = 0; corner < 3; ++corner)
+                    {
+                        collapsedVertices[canonicalVertices[destination[triangle * 3 + corner]]] = 1;
+                    }
+                }
+
+                ++collapseCount;
+                removedTriangles += 2;
+                if (removedTriangles >= trianglesToRemove)
+                {
+                    break;
+                }
+            }
+
+            if (collapseCount == 0)
+            {
+                break;
+            }
+
+            // apply the collapses and remove the triangles that became degenerate
+            std::size_t writeOffset = 0;
+            for (std::size_t i = 0; i < destination.size(); i += 3)
+            {
+                std::uint32_t v0 = vertexRemap[destination[i]];
+                std::uint32_t v1 = vertexRemap[destination[i + 1]];
+                std::uint32_t v2 = vertexRemap[destination[i + 2]];
+                std::uint32_t c0 = canonicalVertices[v0];
+                std::uint32_t c1 = canonicalVertices[v1];
+                std::uint32_t c2 = canonicalVertices[v2];
+                if (c0 == c1 || c1 == c2 || c0 == c2)
+                {
+                    continue;
+                }
+
+                destination[writeOffset++] = v0;
+                destination[writeOffset++] = v1;
+                destination[writeOffset++] = v2;
+            }
+
+            destination.resize(writeOffset);
+        }
+
+        return static_cast<float>(std::sqrt(maxError) / extent);
+    }
+
+    std::size_t MeshSimplifier::CreateCanonicalVertices(
+        const AZStd::span<const glm::vec3>& positions, AZStd::vector<std::uint32_t>& canonicalVertices)
+    {
+        AZStd::vector<std::uint32_t> sortedVertices(positions.size());
+        for (std::size_t i = 0; i < sortedVertices.size(); ++i)
+        {
+            sortedVertices[i] = static_cast<std::uint32_t>(i);
+        }
+
+        auto isLess = [&positions](std::uint32_t lhs, std::uint32_t rhs)
+        {
+            const glm::vec3& p0 = positions[lhs];
+            const glm::vec3& p1 = positions[rhs];
+            return p0.x < p1.x || (p0.x == p1.x && (p0.y < p1.y || (p0.y == p1.y && p0.z < p1.z)));
+        };
+
+        AZStd::sort(sortedVertices.begin(), sortedVertices.end(), isLess);
+
+        canonicalVertices.resize(positions.size());
+        std::size_t canonicalVertexCount = 0;
+        for (std::size_t i = 0; i < sortedVertices.size(); ++i)
+        {
+            if (i > 0 && isLess(sortedVertices[i - 1], sortedVertices[i]))
+            {
+                ++canonicalVertexCount;
+            }
+
+            canonicalVertices[sortedVertices[i]] = static_cast<std::uint32_t>(canonicalVertexCount);
+        }
+
+        return sortedVertices.empty() ? 0 : canonicalVertexCount + 1;
+    }
+
+    void MeshSimplifier::LockBorderAndSeamVertices(
+        const AZStd::span<const std::uint32_t>& indices,
+        const AZStd::vector<std::uint32_t>& canonicalVertices,
+        std::size_t canonicalVertexCount,
+        AZStd::vector<std::uint8_t>& lockedVertices)
+    {
+        static constexpr std::uint32_t NO_VERTEX = std::numeric_limits<std::uint32_t>::max();
+
+        // a vertex is on a seam when triangles refer to it through more than one vertex of the buffer
+        lockedVertices.assign(canonicalVertexCount, 0);
+        AZStd::vector<std::uint32_t> firstVertices(canonicalVertexCount, NO_VERTEX);
+        for (std::uint32_t index : indices)
+        {
+            std::uint32_t canonicalVertex = canonicalVertices[index];
+            if (firstVertices[canonicalVertex] == NO_VERTEX)
+            {
+                firstVertices[canonicalVertex] = index;
+            }
+            else if (firstVertices[canonicalVertex] != index)
+            {
+                lockedVertices[canonicalVertex] = 1;
+            }
+        }
+
+        // an edge is on a border when it is used by a single triangle. Edges used by more than two triangles are locked as well
+        AZStd::vector<std::uint64_t> edges;
+        edges.reserve(indices.size());
+        for (std::size_t i = 0; i < indices.size(); i += 3)
+        {
+            for (std::size_t corner = 0; corner < 3; ++corner)
+            {
+                std::uint64_t c0 = canonicalVertices[indices[i + corner]];
+                std::uint64_t c1 = canonicalVertices[indices[i + (corner + 1) % 3]];
+                edges.push_back(c0 < c1 ? (c0 << 32) | c1 : (c1 << 32) | c0);
+            }
+        }
+
+        AZStd::sort(edges.begin(), edges.end());
+        for (std::size_t i = 0; i < edges.size();)
+        {
+            std::size_t end = i + 1;
+            while (end < edges.size() && edges[end] == edges[i])
+            {
+                ++end;
+            }
+
+            if (end - i != 2)
+            {
+                lockedVertices[static_cast<std::size_t>(edges[i] >> 32)] = 1;
+                lockedVertices[static_cast<std::size_t>(edges[i] & 0xFFFFFFFF)] = 1;
+            }
+
+            i = end;
+        }
+    }
+
+    bool MeshSimplifier::HasTriangleFlip(
+        const AZStd::vector<std::uint32_t>& indices,
+        const AZStd::vector<std::uint32_t>& canonicalVertices,
+        const AZStd::span<const glm::vec3>& positions,
+        const AZStd::span<const std::uint32_t>& triangles,
+        const Collapse& collapse)
+    {
+        std::uint32_t canonicalFrom = canonicalVertices[collapse.m_from];
+        std::uint32_t canonicalTo = canonicalVertices[collapse.m_to];
+        for (std::uint32_t triangle : triangles)
+        {
+            glm::dvec3 before[3];
+            glm::dvec3 after[3];
+            bool isCollapsed = false;
+            for (std::size_t corner = 0; corner < 3; ++corner)
+            {
+                std::uint32_t vertex = indices[triangle * 3 + corner];
+                std::uint32_t canonicalVertex = canonicalVertices[vertex];
+                isCollapsed = isCollapsed || canonicalVertex == canonicalTo;
+                before[corner] = glm::dvec3(positions[vertex]);
+                after[corner] = canonicalVertex == canonicalFrom ? glm::dvec3(positions[collapse.m_to]) : before[corner];
+            }
+
+            // triangles that share the collapsed edge disappear
+            if (isCollapsed)
+            {
+                continue;
+            }
+
+            glm::dvec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+            glm::dvec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+            if (glm::dot(normalBefore, normalBefore) > 0.0 && glm::dot(normalBefore, normalAfter) <= 0.0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+} // namespace Cesium
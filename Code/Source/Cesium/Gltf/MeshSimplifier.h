@@ -0,0 +1,64 @@
+#pragma once
+
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace Cesium
+{
+    struct MeshSimplifier
+    {
+    public:
+        // Collapse edges of a triangle list until it has at most targetIndexCount indices, or until the next collapse would move the
+        // surface further than targetError, relative to the extent of the mesh. Vertices are only collapsed into their neighbors,
+        // so the simplified indices still refer to the same vertex buffer. Vertices on borders and attribute seams are kept in place.
+        // Return the relative error of the simplified mesh
+        static float Simplify(
+            AZStd::vector<std::uint32_t>& destination,
+            const AZStd::span<const std::uint32_t>& indices,
+            const AZStd::span<const glm::vec3>& positions,
+            std::size_t targetIndexCount,
+            float targetError);
+
+    private:
+        struct Quadric
+        {
+            Quadric();
+
+            Quadric(const glm::dvec3& normal, double distance, double weight);
+
+            Quadric& operator+=(const Quadric& rhs);
+
+            double Evaluate(const glm::dvec3& position) const;
+
+            double m_a00, m_a11, m_a22, m_a01, m_a02, m_a12;
+            double m_b0, m_b1, m_b2;
+            double m_c;
+            double m_weight;
+        };
+
+        struct Collapse
+        {
+            std::uint32_t m_from;
+            std::uint32_t m_to;
+            double m_error;
+        };
+
+        static std::size_t CreateCanonicalVertices(
+            const AZStd::span<const glm::vec3>& positions, AZStd::vector<std::uint32_t>& canonicalVertices);
+
+        static void LockBorderAndSeamVertices(
+            const AZStd::span<const std::uint32_t>& indices,
+            const AZStd::vector<std::uint32_t>& canonicalVertices,
+            std::size_t canonicalVertexCount,
+            AZStd::vector<std::uint8_t>& lockedVertices);
+
+        static bool HasTriangleFlip(
+            const AZStd::vector<std::uint32_t>& indices,
+            const AZStd::vector<std::uint32_t>& canonicalVertices,
+            const AZStd::span<const glm::vec3>& positions,
+            const AZStd::span<const std::uint32_t>& triangles,
+            const Collapse& collapse);
+    };
+} // namespace Cesium
@@ -0,0 +1,654 @@
+#include "Cesium/Gltf/MeshoptDecoder.h"
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/vector.h>
+
+// Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
+// This only happens with unity build
+#include <AzCore/PlatformDef.h>
+#ifdef AZ_COMPILER_MSVC
+#pragma push_macro("OPAQUE")
+#undef OPAQUE
+#endif
+
+#include <CesiumGltf/Model.h>
+#include <CesiumGltf/Buffer.h>
+#include <CesiumGltf/BufferView.h>
+#include <CesiumUtility/JsonValue.h>
+
+#ifdef AZ_COMPILER_MSVC
+#pragma pop_macro("OPAQUE")
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace Cesium
+{
+    namespace
+    {
+        std::uint8_t UnZigZag8(std::uint8_t value)
+        {
+            return static_cast<std::uint8_t>(-(value & 1) ^ (value >> 1));
+        }
+
+        std::uint32_t UnZigZag32(std::uint32_t value)
+        {
+            return (0u - (value & 1)) ^ (value >> 1);
+        }
+
+        template<typename T>
+        T Load(const std::byte* data)
+        {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        template<typename T>
+        void Store(std::byte* data, T value)
+        {
+            std::memcpy(data, &value, sizeof(T));
+        }
+
+        template<typename T>
+        T RoundToInteger(float value)
+        {
+            return static_cast<T>(static_cast<int>(value + (value >= 0.0f ? 0.5f : -0.5f)));
+        }
+
+        template<typename T>
+        void DecodeOctahedral(AZStd::span<std::byte> data, std::size_t count)
+        {
+            // x and y are the octahedral coordinates, and z stores the value of 1.0 at the same precision
+            const float maxValue = static_cast<float>((1 << (sizeof(T) * 8 - 1)) - 1);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                std::byte* element = data.data() + i * 4 * sizeof(T);
+                float x = static_cast<float>(Load<T>(element));
+                float y = static_cast<float>(Load<T>(element + sizeof(T)));
+                float z = static_cast<float>(Load<T>(element + 2 * sizeof(T))) - std::fabs(x) - std::fabs(y);
+
+                // unfold the lower hemisphere
+                float t = z >= 0.0f ? 0.0f : z;
+                x += x >= 0.0f ? t : -t;
+                y += y >= 0.0f ? t : -t;
+
+                float length = std::sqrt(x * x + y * y + z * z);
+                float scale = maxValue / length;
+                Store<T>(element, RoundToInteger<T>(x * scale));
+                Store<T>(element + sizeof(T), RoundToInteger<T>(y * scale));
+                Store<T>(element + 2 * sizeof(T), RoundToInteger<T>(z * scale));
+            }
+        }
+    } // namespace
+
+    bool MeshoptDecoder::HasCompressedBufferViews(const CesiumGltf::Model& model)
+    {
+        return std::any_of(
+            model.bufferViews.begin(), model.bufferViews.end(),
+            [](const CesiumGltf::BufferView& bufferView)
+            {
+                return bufferView.getGenericExtension(EXT_MESHOPT_COMPRESSION) != nullptr;
+            });
+    }
+
+    void MeshoptDecoder::DecodeBufferViews(CesiumGltf::Model& model)
+    {
+        for (std::size_t i = 0; i < model.bufferViews.size(); ++i)
+        {
+            CesiumGltf::BufferView& bufferView = model.bufferViews[i];
+            if (!bufferView.getGenericExtension(EXT_MESHOPT_COMPRESSION))
+            {
+                continue;
+            }
+
+            if (DecodeBufferView(model, i))
+            {
+                bufferView.extensions.erase(EXT_MESHOPT_COMPRESSION);
+            }
+        }
+    }
+
+    bool MeshoptDecoder::DecodeBufferView(CesiumGltf::Model& model, std::size_t bufferViewIndex)
+    {
+        CesiumGltf::BufferView& bufferView = model.bufferViews[bufferViewIndex];
+        const CesiumUtility::JsonValue* extension = bufferView.getGenericExtension(EXT_MESHOPT_COMPRESSION);
+        auto getInteger = [extension](const char* key, std::int64_t defaultValue) -> std::int64_t
+        {
+            const CesiumUtility::JsonValue* value = extension->getValuePtrForKey(key);
+            return value ? value->getSafeNumber<std::int64_t>().value_or(-1) : defaultValue;
+        };
+
+        auto getString = [extension](const char* key, const char* defaultValue) -> std::string
+        {
+            const CesiumUtility::JsonValue* value = extension->getValuePtrForKey(key);
+            return value && value->isString() ? value->getString() : std::string(defaultValue);
+        };
+
+        std::int64_t sourceBufferIndex = getInteger("buffer", -1);
+        std::int64_t sourceOffset = getInteger("byteOffset", 0);
+        std::int64_t sourceLength = getInteger("byteLength", -1);
+        std::int64_t byteStride = getInteger("byteStride", -1);
+        std::int64_t count = getInteger("count", -1);
+        std::string mode = getString("mode", "");
+        std::string filter = getString("filter", "NONE");
+        if (sourceBufferIndex < 0 || static_cast<std::size_t>(sourceBufferIndex) >= model.buffers.size() || sourceOffset < 0 ||
+            sourceLength < 0 || byteStride <= 0 || count < 0)
+        {
+            return false;
+        }
+
+        if (bufferView.buffer < 0 || static_cast<std::size_t>(bufferView.buffer) >= model.buffers.size() || bufferView.byteOffset < 0)
+        {
+            return false;
+        }
+
+        std::size_t decodedSize = static_cast<std::size_t>(count) * static_cast<std::size_t>(byteStride);
+        if (decodedSize > static_cast<std::size_t>(bufferView.byteLength))
+        {
+            return false;
+        }
+
+        // the buffer that the buffer view refers to usually has no data, since it is only a fallback for loaders that don't
+        // support the extension. Allocate it before taking any view into the buffers, since the source may be the same buffer
+        CesiumGltf::Buffer& destinationBuffer = model.buffers[static_cast<std::size_t>(bufferView.buffer)];
+        std::size_t destinationOffset = static_cast<std::size_t>(bufferView.byteOffset);
+        if (destinationBuffer.cesium.data.size() < destinationOffset + decodedSize)
+        {
+            std::size_t fallbackSize = static_cast<std::size_t>(std::max<std::int64_t>(destinationBuffer.byteLength, 0));
+            destinationBuffer.cesium.data.resize(std::max(destinationOffset + decodedSize, fallbackSize));
+        }
+
+        const CesiumGltf::Buffer& sourceBuffer = model.buffers[static_cast<std::size_t>(sourceBufferIndex)];
+        if (static_cast<std::size_t>(sourceOffset + sourceLength) > sourceBuffer.cesium.data.size())
+        {
+            return false;
+        }
+
+        AZStd::span<const std::byte> source{ sourceBuffer.cesium.data.data() + sourceOffset, static_cast<std::size_t>(sourceLength) };
+        AZStd::span<std::byte> destination{ destinationBuffer.cesium.data.data() + destinationOffset, decodedSize };
+
+        // decode into a temporary buffer when the compressed data lives in the same buffer, so that it is not overwritten while decoding
+        AZStd::vector<std::byte> decodedData;
+        if (&sourceBuffer == &destinationBuffer)
+        {
+            decodedData.resize(decodedSize);
+            destination = AZStd::span<std::byte>{ decodedData.data(), decodedData.size() };
+        }
+
+        std::size_t elementCount = static_cast<std::size_t>(count);
+        std::size_t elementSize = static_cast<std::size_t>(byteStride);
+        bool success = false;
+        if (mode == "ATTRIBUTES")
+        {
+            success = DecodeVertexBuffer(destination, elementCount, elementSize, source);
+            if (success && filter == "OCTAHEDRAL")
+            {
+                success = DecodeOctahedralFilter(destination, elementCount, elementSize);
+            }
+            else if (success && filter == "QUATERNION")
+            {
+                success = DecodeQuaternionFilter(destination, elementCount, elementSize);
+            }
+            else if (success && filter == "EXPONENTIAL")
+            {
+                success = DecodeExponentialFilter(destination, elementCount, elementSize);
+            }
+            else
+            {
+                success = success && filter == "NONE";
+            }
+        }
+        else if (mode == "TRIANGLES")
+        {
+            success = DecodeIndexBuffer(destination, elementCount, elementSize, source);
+        }
+        else if (mode == "INDICES")
+        {
+            success = DecodeIndexSequence(destination, elementCount, elementSize, source);
+        }
+
+        if (success && !decodedData.empty())
+        {
+            std::memcpy(destinationBuffer.cesium.data.data() + destinationOffset, decodedData.data(), decodedData.size());
+        }
+
+        return success;
+    }
+
+    bool MeshoptDecoder::DecodeVertexBuffer(
+        AZStd::span<std::byte> destination, std::size_t count, std::size_t byteStride, AZStd::span<const std::byte> source)
+    {
+        if (byteStride == 0 || byteStride > VERTEX_BLOCK_MAX_SIZE || byteStride % 4 != 0 || destination.size() < count * byteStride)
+        {
+            return false;
+        }
+
+        // header byte, then vertex blocks, then a tail that holds the vertex the deltas of the first block are based on
+        std::size_t tailSize = std::max(byteStride, TAIL_MAX_SIZE);
+        if (source.size() < 1 + tailSize)
+        {
+            return false;
+        }
+
+        std::uint8_t header = static_cast<std::uint8_t>(source[0]);
+        if ((header & 0xF0) != 0xA0 || (header & 0x0F) != 0)
+        {
+            return false;
+        }
+
+        std::uint8_t lastVertex[VERTEX_BLOCK_MAX_SIZE];
+        std::memcpy(lastVertex, source.data() + source.size() - byteStride, byteStride);
+
+        std::size_t blockSize = std::min((VERTEX_BLOCK_SIZE_BYTES / byteStride) & ~(BYTE_GROUP_SIZE - 1), VERTEX_BLOCK_MAX_SIZE);
+        std::size_t offset = 1;
+        std::size_t end = source.size() - tailSize;
+        std::uint8_t deltas[VERTEX_BLOCK_MAX_SIZE];
+        for (std::size_t firstVertex = 0; firstVertex < count; firstVertex += blockSize)
+        {
+            // each byte of the vertex is stored separately as deltas from the same byte of the previous vertex
+            std::size_t blockCount = std::min(blockSize, count - firstVertex);
+            std::size_t alignedBlockCount = (blockCount + BYTE_GROUP_SIZE - 1) & ~(BYTE_GROUP_SIZE - 1);
+            for (std::size_t k = 0; k < byteStride; ++k)
+            {
+                if (!DecodeBytes(source, offset, end, deltas, alignedBlockCount))
+                {
+                    return false;
+                }
+
+                std::uint8_t value = lastVertex[k];
+                std::byte* output = destination.data() + firstVertex * byteStride + k;
+                for (std::size_t i = 0; i < blockCount; ++i)
+                {
+                    value = static_cast<std::uint8_t>(value + UnZigZag8(deltas[i]));
+                    *output = static_cast<std::byte>(value);
+                    output += byteStride;
+                }
+
+                lastVertex[k] = value;
+            }
+        }
+
+        return offset == end;
+    }
+
+    bool MeshoptDecoder::DecodeIndexBuffer(
+        AZStd::span<std::byte> destination, std::size_t indexCount, std::size_t indexSize, AZStd::span<const std::byte> source)
+    {
+        if (indexCount % 3 != 0 || (indexSize != 2 && indexSize != 4) || destination.size() < indexCount * indexSize)
+        {
+            return false;
+        }
+
+        // header byte, one code per triangle, the data referred to by the codes, then a table of 16 auxiliary codes
+        std::size_t triangleCount = indexCount / 3;
+        if (source.size() < 1 + triangleCount + 16)
+        {
+            return false;
+        }
+
+        std::uint8_t header = static_cast<std::uint8_t>(source[0]);
+        if ((header & 0xF0) != 0xE0 || (header & 0x0F) > 1)
+        {
+            return false;
+        }
+
+        std::size_t codeOffset = 1;
+        std::size_t dataOffset = 1 + triangleCount;
+        std::size_t dataEnd = source.size() - 16;
+        const std::byte* codeAuxTable = source.data() + dataEnd;
+
+        // the last 16 edges and vertices are kept in FIFOs that the codes refer to
+        std::uint32_t edgeFifo[16][2];
+        std::uint32_t vertexFifo[16];
+        std::memset(edgeFifo, 0xFF, sizeof(edgeFifo));
+        std::memset(vertexFifo, 0xFF, sizeof(vertexFifo));
+        std::size_t edgeFifoOffset = 0;
+        std::size_t vertexFifoOffset = 0;
+        auto pushEdge = [&edgeFifo, &edgeFifoOffset](std::uint32_t a, std::uint32_t b)
+        {
+            edgeFifo[edgeFifoOffset][0] = a;
+            edgeFifo[edgeFifoOffset][1] = b;
+            edgeFifoOffset = (edgeFifoOffset + 1) & 15;
+        };
+
+        auto pushVertex = [&vertexFifo, &vertexFifoOffset](std::uint32_t vertex, bool advance = true)
+        {
+            vertexFifo[vertexFifoOffset] = vertex;
+            vertexFifoOffset = (vertexFifoOffset + (advance ? 1 : 0)) & 15;
+        };
+
+        auto decodeIndex = [&source, &dataOffset, dataEnd](std::uint32_t& last, std::uint32_t& index)
+        {
+            std::uint32_t value = 0;
+            if (!DecodeVByte(source, dataOffset, dataEnd, value))
+            {
+                return false;
+            }
+
+            last += UnZigZag32(value);
+            index = last;
+            return true;
+        };
+
+        // version 0 doesn't encode delta of -1 and 1 from the last free index
+        std::uint32_t maxEdgeFifoCode = (header & 0x0F) >= 1 ? 13 : 15;
+        std::uint32_t next = 0;
+        std::uint32_t last = 0;
+        for (std::size_t i = 0; i < indexCount; i += 3)
+        {
+            std::uint32_t a = 0;
+            std::uint32_t b = 0;
+            std::uint32_t c = 0;
+            std::uint8_t code = static_cast<std::uint8_t>(source[codeOffset++]);
+            if (code < 0xF0)
+            {
+                // the triangle reuses an edge from the FIFO
+                std::uint32_t fe = code >> 4;
+                a = edgeFifo[(edgeFifoOffset - 1 - fe) & 15][0];
+                b = edgeFifo[(edgeFifoOffset - 1 - fe) & 15][1];
+
+                std::uint32_t fec = code & 15;
+                if (fec < maxEdgeFifoCode)
+                {
+                    bool isNewVertex = fec == 0;
+                    c = isNewVertex ? next : vertexFifo[(vertexFifoOffset - 1 - fec) & 15];
+                    next += isNewVertex ? 1 : 0;
+                    pushVertex(c, isNewVertex);
+                }
+                else
+                {
+                    // 13 and 14 encode a delta of -1 and 1 from the last free index, and 15 encodes the free index explicitly
+                    if (fec != 15)
+                    {
+                        last += fec == 13 ? 0xFFFFFFFFu : 1u;
+                        c = last;
+                    }
+                    else if (!decodeIndex(last, c))
+                    {
+                        return false;
+                    }
+
+                    pushVertex(c);
+                }
+
+                pushEdge(c, b);
+                pushEdge(a, c);
+            }
+            else
+            {
+                // the triangle has no edge in the FIFO. The codes of its vertices are either in the table or in the data
+                bool isTableCode = code < 0xFE;
+                std::uint8_t codeAux = 0;
+                if (isTableCode)
+                {
+                    codeAux = static_cast<std::uint8_t>(codeAuxTable[code & 15]);
+                }
+                else
+                {
+                    if (dataOffset >= dataEnd)
+                    {
+                        return false;
+                    }
+
+                    codeAux = static_cast<std::uint8_t>(source[dataOffset++]);
+                }
+
+                std::uint32_t fea = isTableCode || code == 0xFE ? 0 : 15;
+                std::uint32_t feb = codeAux >> 4;
+                std::uint32_t fec = codeAux & 15;
+
+                // a zero code outside of the table resets the next vertex
+                if (!isTableCode && codeAux == 0)
+                {
+                    next = 0;
+                }
+
+                a = fea == 0 ? next++ : 0;
+                b = feb == 0 ? next++ : vertexFifo[(vertexFifoOffset - feb) & 15];
+                c = fec == 0 ? next++ : vertexFifo[(vertexFifoOffset - fec) & 15];
+                if (!isTableCode)
+                {
+                    if ((fea == 15 && !decodeIndex(last, a)) || (feb == 15 && !decodeIndex(last, b)) ||
+                        (fec == 15 && !decodeIndex(last, c)))
+                    {
+                        return false;
+                    }
+                }
+
+                pushVertex(a);
+                pushVertex(b, feb == 0 || (!isTableCode && feb == 15));
+                pushVertex(c, fec == 0 || (!isTableCode && fec == 15));
+                pushEdge(b, a);
+                pushEdge(c, b);
+                pushEdge(a, c);
+            }
+
+            WriteIndex(destination, i, indexSize, a);
+            WriteIndex(destination, i + 1, indexSize, b);
+            WriteIndex(destination, i + 2, indexSize, c);
+        }
+
+        return dataOffset == dataEnd;
+    }
+
+    bool MeshoptDecoder::DecodeIndexSequence(
+        AZStd::span<std::byte> destination, std::size_t indexCount, std::size_t indexSize, AZStd::span<const std::byte> source)
+    {
+        if ((indexSize != 2 && indexSize != 4) || destination.size() < indexCount * indexSize)
+        {
+            return false;
+        }
+
+        // header byte, one varint per index, then 4 bytes of padding
+        if (source.size() < 1 + indexCount + 4)
+        {
+            return false;
+        }
+
+        std::uint8_t header = static_cast<std::uint8_t>(source[0]);
+        if ((header & 0xF0) != 0xD0 || (header & 0x0F) > 1)
+        {
+            return false;
+        }
+
+        // each index is a delta from one of the two last indices, which is selected by the lowest bit
+        std::uint32_t last[2] = { 0, 0 };
+        std::size_t offset = 1;
+        std::size_t end = source.size() - 4;
+        for (std::size_t i = 0; i < indexCount; ++i)
+        {
+            std::uint32_t value = 0;
+            if (!DecodeVByte(source, offset, end, value))
+            {
+                return false;
+            }
+
+            std::uint32_t current = value & 1;
+            std::uint32_t index = last[current] + UnZigZag32(value >> 1);
+            last[current] = index;
+            WriteIndex(destination, i, indexSize, index);
+        }
+
+        return offset == end;
+    }
+
+    bool MeshoptDecoder::DecodeOctahedralFilter(AZStd::span<std::byte> data, std::size_t count, std::size_t byteStride)
+    {
+        if (data.size() < count * byteStride)
+        {
+            return false;
+        }
+
+        if (byteStride == 4)
+        {
+            DecodeOctahedral<std::int8_t>(data, count);
+            return true;
+        }
+
+        if (byteStride == 8)
+        {
+            DecodeOctahedral<std::int16_t>(data, count);
+            return true;
+        }
+
+        return false;
+    }
+
+    bool MeshoptDecoder::DecodeQuaternionFilter(AZStd::span<std::byte> data, std::size_t count, std::size_t byteStride)
+    {
+        if (byteStride != 8 || data.size() < count * byteStride)
+        {
+            return false;
+        }
+
+        // the three smallest components are stored, and the index of the largest one is in the 2 lowest bits of the last component
+        const float scale = 1.0f / std::sqrt(2.0f);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::byte* element = data.data() + i * 8;
+            std::int16_t last = Load<std::int16_t>(element + 6);
+            float componentScale = scale / static_cast<float>(last | 3);
+            float x = static_cast<float>(Load<std::int16_t>(element)) * componentScale;
+            float y = static_cast<float>(Load<std::int16_t>(element + 2)) * componentScale;
+            float z = static_cast<float>(Load<std::int16_t>(element + 4)) * componentScale;
+            float ww = 1.0f - x * x - y * y - z * z;
+            float w = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+
+            std::size_t largestComponent = static_cast<std::size_t>(last & 3);
+            Store<std::int16_t>(element + ((largestComponent + 1) & 3) * 2, RoundToInteger<std::int16_t>(x * 32767.0f));
+            Store<std::int16_t>(element + ((largestComponent + 2) & 3) * 2, RoundToInteger<std::int16_t>(y * 32767.0f));
+            Store<std::int16_t>(element + ((largestComponent + 3) & 3) * 2, RoundToInteger<std::int16_t>(z * 32767.0f));
+            Store<std::int16_t>(element + largestComponent * 2, RoundToInteger<std::int16_t>(w * 32767.0f));
+        }
+
+        return true;
+    }
+
+    bool MeshoptDecoder::DecodeExponentialFilter(AZStd::span<std::byte> data, std::size_t count, std::size_t byteStride)
+    {
+        if (byteStride % 4 != 0 || data.size() < count * byteStride)
+        {
+            return false;
+        }
+
+        // each component is a 24-bit signed mantissa and an 8-bit signed exponent
+        std::size_t componentCount = count * byteStride / 4;
+        for (std::size_t i = 0; i < componentCount; ++i)
+        {
+            std::byte* component = data.data() + i * 4;
+            std::uint32_t value = Load<std::uint32_t>(component);
+            std::int32_t mantissa = static_cast<std::int32_t>(value << 8) >> 8;
+            std::int32_t exponent = static_cast<std::int32_t>(value) >> 24;
+            Store<float>(component, std::ldexp(static_cast<float>(mantissa), exponent));
+        }
+
+        return true;
+    }
+
+    bool MeshoptDecoder::DecodeBytes(
+        AZStd::span<const std::byte> source, std::size_t& offset, std::size_t end, std::uint8_t* values, std::size_t count)
+    {
+        // values are split into groups of 16. Each group has a 2-bit header that selects how many bits each value takes.
+        // Values that don't fit are marked with the largest value of the group bits, and stored as a byte after the group
+        std::size_t groupCount = count / BYTE_GROUP_SIZE;
+        std::size_t headerSize = (groupCount + 3) / 4;
+        if (end - offset < headerSize)
+        {
+            return false;
+        }
+
+        const std::byte* headers = source.data() + offset;
+        offset += headerSize;
+        for (std::size_t group = 0; group < groupCount; ++group)
+        {
+            std::uint8_t* groupValues = values + group * BYTE_GROUP_SIZE;
+            std::uint32_t mode = (static_cast<std::uint8_t>(headers[group / 4]) >> ((group % 4) * 2)) & 3;
+            if (mode == 0)
+            {
+                std::memset(groupValues, 0, BYTE_GROUP_SIZE);
+                continue;
+            }
+
+            if (mode == 3)
+            {
+                if (end - offset < BYTE_GROUP_SIZE)
+                {
+                    return false;
+                }
+
+                std::memcpy(groupValues, source.data() + offset, BYTE_GROUP_SIZE);
+                offset += BYTE_GROUP_SIZE;
+                continue;
+            }
+
+            // mode 1 packs 2-bit values, mode 2 packs 4-bit values, with the first value in the highest bits of the first byte
+            std::uint32_t bits = mode == 1 ? 2 : 4;
+            std::size_t packedSize = BYTE_GROUP_SIZE * bits / 8;
+            if (end - offset < packedSize)
+            {
+                return false;
+            }
+
+            std::uint8_t sentinel = static_cast<std::uint8_t>((1u << bits) - 1);
+            std::size_t packedOffset = offset;
+            offset += packedSize;
+            std::uint32_t valuesPerByte = 8 / bits;
+            for (std::size_t i = 0; i < BYTE_GROUP_SIZE; ++i)
+            {
+                std::uint8_t packed = static_cast<std::uint8_t>(source[packedOffset + i / valuesPerByte]);
+                std::uint32_t shift = 8 - bits * (static_cast<std::uint32_t>(i % valuesPerByte) + 1);
+                std::uint8_t value = static_cast<std::uint8_t>((packed >> shift) & sentinel);
+                if (value == sentinel)
+                {
+                    if (offset >= end)
+                    {
+                        return false;
+                    }
+
+                    value = static_cast<std::uint8_t>(source[offset++]);
+                }
+
+                groupValues[i] = value;
+            }
+        }
+
+        return true;
+    }
+
+    bool MeshoptDecoder::DecodeVByte(AZStd::span<const std::byte> source, std::size_t& offset, std::size_t end, std::uint32_t& value)
+    {
+        // little endian base 128, at most 5 bytes for a 32-bit value
+        value = 0;
+        for (std::uint32_t shift = 0; shift < 35; shift += 7)
+        {
+            if (offset >= end)
+            {
+                return false;
+            }
+
+            std::uint8_t group = static_cast<std::uint8_t>(source[offset++]);
+            value |= static_cast<std::uint32_t>(group & 127) << shift;
+            if (group < 128)
+            {
+                return true;
+            }
+        }
+
+        return true;
+    }
+
+    void MeshoptDecoder::WriteIndex(AZStd::span<std::byte> destination, std::size_t index, std::size_t indexSize, std::uint32_t value)
+    {
+        if (indexSize == 2)
+        {
+            Store<std::uint16_t>(destination.data() + index * 2, static_cast<std::uint16_t>(value));
+        }
+        else
+        {
+            Store<std::uint32_t>(destination.data() + index * 4, value);
+        }
+    }
+} // namespace Cesium
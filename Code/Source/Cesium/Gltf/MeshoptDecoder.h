@@ -0,0 +1,61 @@
+#pragma once
+
+#include <AzCore/std/containers/span.h>
+#include <cstdint>
+#include <cstddef>
+
+namespace CesiumGltf
+{
+    struct Model;
+}
+
+namespace Cesium
+{
+    // Decoder for buffer views compressed with EXT_meshopt_compression. The bitstream is described in
+    // https://github.com/KhronosGroup/glTF/tree/main/extensions/2.0/Vendor/EXT_meshopt_compression
+    struct MeshoptDecoder
+    {
+    public:
+        static bool HasCompressedBufferViews(const CesiumGltf::Model& model);
+
+        // Decode every compressed buffer view into the buffer it refers to, which is usually the fallback buffer of the extension,
+        // and remove the extension from the buffer view afterward. Buffer views that fail to decode are left untouched
+        static void DecodeBufferViews(CesiumGltf::Model& model);
+
+        // ATTRIBUTES mode. byteStride must be a multiple of 4 and not larger than 256
+        static bool DecodeVertexBuffer(
+            AZStd::span<std::byte> destination, std::size_t count, std::size_t byteStride, AZStd::span<const std::byte> source);
+
+        // TRIANGLES mode. indexSize is either 2 or 4
+        static bool DecodeIndexBuffer(
+            AZStd::span<std::byte> destination, std::size_t indexCount, std::size_t indexSize, AZStd::span<const std::byte> source);
+
+        // INDICES mode. indexSize is either 2 or 4
+        static bool DecodeIndexSequence(
+            AZStd::span<std::byte> destination, std::size_t indexCount, std::size_t indexSize, AZStd::span<const std::byte> source);
+
+        // Filters are applied in place after the vertex buffer is decoded
+        static bool DecodeOctahedralFilter(AZStd::span<std::byte> data, std::size_t count, std::size_t byteStride);
+
+        static bool DecodeQuaternionFilter(AZStd::span<std::byte> data, std::size_t count, std::size_t byteStride);
+
+        static bool DecodeExponentialFilter(AZStd::span<std::byte> data, std::size_t count, std::size_t byteStride);
+
+        static constexpr const char* const EXT_MESHOPT_COMPRESSION = "EXT_meshopt_compression";
+
+    private:
+        static bool DecodeBufferView(CesiumGltf::Model& model, std::size_t bufferViewIndex);
+
+        static bool DecodeBytes(
+            AZStd::span<const std::byte> source, std::size_t& offset, std::size_t end, std::uint8_t* values, std::size_t count);
+
+        static bool DecodeVByte(AZStd::span<const std::byte> source, std::size_t& offset, std::size_t end, std::uint32_t& value);
+
+        static void WriteIndex(AZStd::span<std::byte> destination, std::size_t index, std::size_t indexSize, std::uint32_t value);
+
+        static constexpr std::size_t VERTEX_BLOCK_SIZE_BYTES = 8192;
+        static constexpr std::size_t VERTEX_BLOCK_MAX_SIZE = 256;
+        static constexpr std::size_t BYTE_GROUP_SIZE = 16;
+        static constexpr std::size_t TAIL_MAX_SIZE = 32;
+    };
+} // namespace Cesium
@@ -0,0 +1,369 @@
+#include "Cesium/Gltf/StreamingImageBuilder.h"
+#include "Cesium/Systems/CesiumSystem.h"
+#include "Cesium/Systems/CriticalAssetManager.h"
+#include <Atom/RHI/Device.h>
+#include <Atom/RHI/RHISystemInterface.h>
+#include <Atom/RPI.Reflect/Image/ImageMipChainAssetCreator.h>
+#include <Atom/RPI.Reflect/Image/StreamingImageAssetCreator.h>
+#include <AzCore/Math/Simd.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/vector.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Cesium
+{
+    namespace
+    {
+        // Conversions of 8-bit sRGB codes to linear values and back
+        struct SrgbTables final
+        {
+            SrgbTables()
+            {
+                for (std::uint32_t i = 0; i < 256; ++i)
+                {
+                    m_toLinear[i] = ToLinear(static_cast<float>(i) / 255.0f);
+                    m_roundingThresholds[i] = ToLinear((static_cast<float>(i) + 0.5f) / 255.0f);
+                }
+
+                for (std::uint32_t i = 0; i < ENCODE_TABLE_SIZE; ++i)
+                {
+                    float srgb = ToSrgb(static_cast<float>(i) / static_cast<float>(ENCODE_TABLE_SIZE - 1));
+                    m_toSrgb[i] = static_cast<std::uint8_t>(std::lround(srgb * 255.0f));
+                }
+            }
+
+            std::uint8_t Encode(float linear) const
+            {
+                linear = AZStd::clamp(linear, 0.0f, 1.0f);
+                std::uint32_t code = m_toSrgb[static_cast<std::uint32_t>(linear * static_cast<float>(ENCODE_TABLE_SIZE - 1) + 0.5f)];
+
+                // the table is coarse near black, so the code is corrected to the nearest one in sRGB space
+                while (code < 255 && linear > m_roundingThresholds[code])
+                {
+                    ++code;
+                }
+
+                while (code > 0 && linear < m_roundingThresholds[code - 1])
+                {
+                    --code;
+                }
+
+                return static_cast<std::uint8_t>(code);
+            }
+
+            static float ToLinear(float srgb)
+            {
+                return srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+            }
+
+            static float ToSrgb(float linear)
+            {
+                return linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+            }
+
+            static constexpr std::uint32_t ENCODE_TABLE_SIZE = 4096;
+
+            float m_toLinear[256];
+            float m_roundingThresholds[256];
+            std::uint8_t m_toSrgb[ENCODE_TABLE_SIZE];
+        };
+
+        const SrgbTables& GetSrgbTables()
+        {
+            static const SrgbTables tables;
+            return tables;
+        }
+
+        bool HasTranslucentPixels(const AZStd::span<const std::byte>& pixels)
+        {
+            for (std::size_t i = 3; i < pixels.size(); i += 4)
+            {
+                if (pixels[i] != std::byte{ 255 })
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    } // namespace
+
+    std::uint32_t StreamingImageBuilder::GetMipLevelCount(std::uint32_t width, std::uint32_t height)
+    {
+        std::uint32_t mipLevelCount = 1;
+        std::uint32_t size = AZStd::max(width, height);
+        while (size > 1)
+        {
+            size /= 2;
+            ++mipLevelCount;
+        }
+
+        return mipLevelCount;
+    }
+
+    void StreamingImageBuilder::Downsample(
+        const AZStd::span<const std::byte>& source,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channelCount,
+        bool isSrgb,
+        AZStd::span<std::byte> destination)
+    {
+        AZ_Assert(channelCount >= 1 && channelCount <= 4, "Only images of 1 to 4 channels are downsampled");
+        AZ_Assert(source.size() >= std::size_t{ width } * height * channelCount, "The source is smaller than the image");
+        AZ_Assert(
+            destination.size() >= std::size_t{ AZStd::max(width / 2, 1u) } * AZStd::max(height / 2, 1u) * channelCount,
+            "The destination is smaller than the downsampled image");
+        if (isSrgb)
+        {
+            DownsampleSrgb(source, width, height, channelCount, destination);
+        }
+        else
+        {
+            DownsampleLinear(source, width, height, channelCount, destination);
+        }
+    }
+
+    AZ::Data::Asset<AZ::RPI::StreamingImageAsset> StreamingImageBuilder::Create(
+        const AZStd::span<const std::byte>& pixels,
+        std::uint32_t width,
+        std::uint32_t height,
+        AZ::RHI::Format format,
+        TextureCompressionQuality compression)
+    {
+        std::uint32_t channelCount = 0;
+        bool isSrgb = false;
+        switch (format)
+        {
+        case AZ::RHI::Format::R8_UNORM:
+            channelCount = 1;
+            break;
+        case AZ::RHI::Format::R8G8_UNORM:
+            channelCount = 2;
+            break;
+        case AZ::RHI::Format::R8G8B8A8_UNORM:
+            channelCount = 4;
+            break;
+        case AZ::RHI::Format::R8G8B8A8_UNORM_SRGB:
+            channelCount = 4;
+            isSrgb = true;
+            break;
+        default:
+            break;
+        }
+
+        std::uint32_t mipLevelCount = channelCount > 0 ? GetMipLevelCount(width, height) : 1;
+
+        // the most detailed mip of a block compressed image is made of whole blocks
+        AZ::RHI::Format compressedFormat = AZ::RHI::Format::Unknown;
+        if (compression != TextureCompressionQuality::None && channelCount > 0 && width % 4 == 0 && height % 4 == 0)
+        {
+            compressedFormat = TextureBlockCompressor::GetCompressedFormat(format, channelCount == 4 && HasTranslucentPixels(pixels));
+
+            // the platform has BC formats, but the device may still not sample them, in which case the image stays uncompressed
+            if (compressedFormat != AZ::RHI::Format::Unknown && !IsFormatSupported(compressedFormat))
+            {
+                compressedFormat = AZ::RHI::Format::Unknown;
+            }
+        }
+
+        // each mip is downsampled from the previous one
+        AZStd::vector<AZStd::vector<std::byte>> mips(mipLevelCount);
+        AZStd::span<const std::byte> mipPixels = pixels;
+        for (std::uint32_t level = 1; level < mipLevelCount; ++level)
+        {
+            std::uint32_t mipWidth = AZStd::max(width >> (level - 1), 1u);
+            std::uint32_t mipHeight = AZStd::max(height >> (level - 1), 1u);
+            AZStd::vector<std::byte>& mip = mips[level];
+            mip.resize(std::size_t{ AZStd::max(mipWidth / 2, 1u) } * AZStd::max(mipHeight / 2, 1u) * channelCount);
+            Downsample(mipPixels, mipWidth, mipHeight, channelCount, isSrgb, mip);
+            mipPixels = mip;
+        }
+
+        // mips are compressed once they are all downsampled, since each of them is downsampled from the uncompressed previous one
+        if (compressedFormat != AZ::RHI::Format::Unknown)
+        {
+            AZStd::vector<AZStd::vector<std::byte>> compressedMips(mipLevelCount);
+            for (std::uint32_t level = 0; level < mipLevelCount; ++level)
+            {
+                std::uint32_t mipWidth = AZStd::max(width >> level, 1u);
+                std::uint32_t mipHeight = AZStd::max(height >> level, 1u);
+                AZStd::vector<std::byte>& compressedMip = compressedMips[level];
+                compressedMip.resize(TextureBlockCompressor::GetCompressedSize(mipWidth, mipHeight, compressedFormat));
+                TextureBlockCompressor::Compress(
+                    level == 0 ? pixels : AZStd::span<const std::byte>(mips[level]), mipWidth, mipHeight, compressedFormat, compression,
+                    compressedMip);
+            }
+
+            mips = AZStd::move(compressedMips);
+        }
+
+        AZStd::vector<AZStd::span<const std::byte>> mipData(mipLevelCount);
+        for (std::uint32_t level = 0; level < mipLevelCount; ++level)
+        {
+            mipData[level] = mips[level].empty() ? pixels : AZStd::span<const std::byte>(mips[level]);
+        }
+
+        return CreateFromMips(mipData, width, height, compressedFormat != AZ::RHI::Format::Unknown ? compressedFormat : format);
+    }
+
+    AZ::Data::Asset<AZ::RPI::StreamingImageAsset> StreamingImageBuilder::CreateFromMips(
+        const AZStd::vector<AZStd::span<const std::byte>>& mips, std::uint32_t width, std::uint32_t height, AZ::RHI::Format format)
+    {
+        std::uint32_t mipLevelCount = static_cast<std::uint32_t>(mips.size());
+
+        AZ::RHI::ImageDescriptor imageDesc;
+        imageDesc.m_bindFlags = AZ::RHI::ImageBindFlags::ShaderRead;
+        imageDesc.m_dimension = AZ::RHI::ImageDimension::Image2D;
+        imageDesc.m_size = AZ::RHI::Size(width, height, 1);
+        imageDesc.m_format = format;
+        imageDesc.m_mipLevels = static_cast<std::uint16_t>(mipLevelCount);
+
+        AZ::RPI::StreamingImageAssetCreator imageCreator;
+        imageCreator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId());
+        imageCreator.SetImageDescriptor(imageDesc);
+
+        // mip chains are added from the most detailed one, and the last one is the tail
+        std::uint32_t level = 0;
+        while (level < mipLevelCount)
+        {
+            std::uint32_t mipChainLevelCount = 1;
+            if (AZStd::max(width >> level, height >> level) <= STREAMING_MIP_SIZE)
+            {
+                mipChainLevelCount = mipLevelCount - level;
+            }
+
+            AZ::RPI::ImageMipChainAssetCreator mipChainCreator;
+            mipChainCreator.Begin(
+                CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId(), static_cast<std::uint16_t>(mipChainLevelCount), 1);
+            for (std::uint32_t mipChainLevel = level; mipChainLevel < level + mipChainLevelCount; ++mipChainLevel)
+            {
+                const AZStd::span<const std::byte>& data = mips[mipChainLevel];
+                mipChainCreator.BeginMip(AZ::RHI::GetImageSubresourceLayout(
+                    imageDesc, AZ::RHI::ImageSubresource{ static_cast<std::uint16_t>(mipChainLevel), 0 }));
+                mipChainCreator.AddSubImage(data.data(), data.size());
+                mipChainCreator.EndMip();
+            }
+
+            AZ::Data::Asset<AZ::RPI::ImageMipChainAsset> mipChainAsset;
+            mipChainCreator.End(mipChainAsset);
+            imageCreator.AddMipChainAsset(*mipChainAsset);
+            level += mipChainLevelCount;
+        }
+
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset;
+        imageCreator.End(imageAsset);
+        return imageAsset;
+    }
+
+    bool StreamingImageBuilder::IsFormatSupported(AZ::RHI::Format format)
+    {
+        AZ::RHI::RHISystemInterface* rhiSystem = AZ::RHI::RHISystemInterface::Get();
+        AZ::RHI::Device* device = rhiSystem ? rhiSystem->GetDevice() : nullptr;
+        if (!device)
+        {
+            return true;
+        }
+
+        return AZ::RHI::CheckBitsAll(device->GetFormatCapabilities(format), AZ::RHI::FormatCapabilities::Sample);
+    }
+
+    void StreamingImageBuilder::DownsampleLinear(
+        const AZStd::span<const std::byte>& source,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channelCount,
+        AZStd::span<std::byte> destination)
+    {
+        std::uint32_t destinationWidth = AZStd::max(width / 2, 1u);
+        std::uint32_t destinationHeight = AZStd::max(height / 2, 1u);
+        std::size_t rowSize = std::size_t{ width } * channelCount;
+        const std::uint8_t* pixels = reinterpret_cast<const std::uint8_t*>(source.data());
+        std::uint8_t* output = reinterpret_cast<std::uint8_t*>(destination.data());
+        for (std::uint32_t y = 0; y < destinationHeight; ++y)
+        {
+            const std::uint8_t* row0 = pixels + AZStd::min(y * 2, height - 1) * rowSize;
+            const std::uint8_t* row1 = pixels + AZStd::min(y * 2 + 1, height - 1) * rowSize;
+            for (std::uint32_t x = 0; x < destinationWidth; ++x)
+            {
+                std::size_t x0 = std::size_t{ AZStd::min(x * 2, width - 1) } * channelCount;
+                std::size_t x1 = std::size_t{ AZStd::min(x * 2 + 1, width - 1) } * channelCount;
+                for (std::uint32_t channel = 0; channel < channelCount; ++channel)
+                {
+                    std::uint32_t sum = row0[x0 + channel] + row0[x1 + channel] + row1[x0 + channel] + row1[x1 + channel];
+                    *output++ = static_cast<std::uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+    }
+
+    void StreamingImageBuilder::DownsampleSrgb(
+        const AZStd::span<const std::byte>& source,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channelCount,
+        AZStd::span<std::byte> destination)
+    {
+        const SrgbTables& tables = GetSrgbTables();
+        std::uint32_t destinationWidth = AZStd::max(width / 2, 1u);
+        std::uint32_t destinationHeight = AZStd::max(height / 2, 1u);
+        std::size_t rowSize = std::size_t{ width } * channelCount;
+        const std::uint8_t* pixels = reinterpret_cast<const std::uint8_t*>(source.data());
+        std::uint8_t* output = reinterpret_cast<std::uint8_t*>(destination.data());
+
+        // the two source rows of a destination row are converted to linear and summed once, then pairs of pixels are averaged
+        AZStd::vector<float> rowSum(rowSize);
+        for (std::uint32_t y = 0; y < destinationHeight; ++y)
+        {
+            const std::uint8_t* row0 = pixels + AZStd::min(y * 2, height - 1) * rowSize;
+            const std::uint8_t* row1 = pixels + AZStd::min(y * 2 + 1, height - 1) * rowSize;
+            for (std::size_t i = 0; i < rowSize; i += channelCount)
+            {
+                for (std::uint32_t channel = 0; channel < channelCount; ++channel)
+                {
+                    if (channel == 3)
+                    {
+                        rowSum[i + channel] = static_cast<float>(row0[i + channel] + row1[i + channel]) / 255.0f;
+                    }
+                    else
+                    {
+                        rowSum[i + channel] = tables.m_toLinear[row0[i + channel]] + tables.m_toLinear[row1[i + channel]];
+                    }
+                }
+            }
+
+            for (std::uint32_t x = 0; x < destinationWidth; ++x)
+            {
+                std::size_t x0 = std::size_t{ AZStd::min(x * 2, width - 1) } * channelCount;
+                std::size_t x1 = std::size_t{ AZStd::min(x * 2 + 1, width - 1) } * channelCount;
+                float average[4];
+                if (channelCount == 4)
+                {
+                    AZ::Simd::Vec4::FloatType sum =
+                        AZ::Simd::Vec4::Add(AZ::Simd::Vec4::LoadUnaligned(&rowSum[x0]), AZ::Simd::Vec4::LoadUnaligned(&rowSum[x1]));
+                    AZ::Simd::Vec4::StoreUnaligned(average, AZ::Simd::Vec4::Mul(sum, AZ::Simd::Vec4::Splat(0.25f)));
+                }
+                else
+                {
+                    for (std::uint32_t channel = 0; channel < channelCount; ++channel)
+                    {
+                        average[channel] = (rowSum[x0 + channel] + rowSum[x1 + channel]) * 0.25f;
+                    }
+                }
+
+                for (std::uint32_t channel = 0; channel < channelCount; ++channel)
+                {
+                    if (channel == 3)
+                    {
+                        *output++ = static_cast<std::uint8_t>(std::lround(AZStd::clamp(average[channel], 0.0f, 1.0f) * 255.0f));
+                    }
+                    else
+                    {
+                        *output++ = tables.Encode(average[channel]);
+                    }
+                }
+            }
+        }
+    }
+} // namespace Cesium
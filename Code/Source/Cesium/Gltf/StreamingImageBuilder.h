@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Cesium/Gltf/TextureBlockCompressor.h"
+#include <Atom/RHI.Reflect/Format.h>
+#include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Create the streaming images of glTF textures and raster overlays on the load threads, along with their full mip chain
+    struct StreamingImageBuilder
+    {
+    public:
+        // Number of mips down to 1x1
+        static std::uint32_t GetMipLevelCount(std::uint32_t width, std::uint32_t height);
+
+        // Downsample an 8-bit image by half with a 2x2 box filter. The last row and column are repeated for odd sizes. Color channels
+        // of sRGB images are averaged in linear space, and the fourth channel is treated as linear alpha. destination holds
+        // max(width / 2, 1) * max(height / 2, 1) pixels
+        static void Downsample(
+            const AZStd::span<const std::byte>& source,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channelCount,
+            bool isSrgb,
+            AZStd::span<std::byte> destination);
+
+        // Create a 2D image from its most detailed mip. Mips are generated for R8_UNORM, R8G8_UNORM, R8G8B8A8_UNORM and
+        // R8G8B8A8_UNORM_SRGB images.
+        // The mips larger than STREAMING_MIP_SIZE get a mip chain asset each, so that they can be evicted, while the smaller ones
+        // share the tail mip chain that stays resident. With compression, every mip is block compressed when the size of the image
+        // is a multiple of the block size and the device can sample the compressed format (see IsFormatSupported)
+        static AZ::Data::Asset<AZ::RPI::StreamingImageAsset> Create(
+            const AZStd::span<const std::byte>& pixels,
+            std::uint32_t width,
+            std::uint32_t height,
+            AZ::RHI::Format format,
+            TextureCompressionQuality compression = TextureCompressionQuality::None);
+
+        // Create a 2D image from mips that are already encoded in its format, starting from the most detailed one. The chain may stop
+        // before 1x1
+        static AZ::Data::Asset<AZ::RPI::StreamingImageAsset> CreateFromMips(
+            const AZStd::vector<AZStd::span<const std::byte>>& mips, std::uint32_t width, std::uint32_t height, AZ::RHI::Format format);
+
+        // Whether the RHI of the running device can sample a format. Every format is accepted when there is no device, like in the
+        // Asset Processor
+        static bool IsFormatSupported(AZ::RHI::Format format);
+
+        static constexpr std::uint32_t STREAMING_MIP_SIZE = 256;
+
+    private:
+        static void DownsampleLinear(
+            const AZStd::span<const std::byte>& source,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channelCount,
+            AZStd::span<std::byte> destination);
+
+        static void DownsampleSrgb(
+            const AZStd::span<const std::byte>& source,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channelCount,
+            AZStd::span<std::byte> destination);
+    };
+} // namespace Cesium
@@ -0,0 +1,410 @@
+#include "Cesium/Gltf/TextureBlockCompressor.h"
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/utils.h>
+#include <cmath>
+#include <limits>
+
+namespace Cesium
+{
+    namespace
+    {
+        // weight of the first endpoint for each index of a 4 color block
+        constexpr float COLOR_WEIGHTS[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+        std::uint16_t PackRgb565(const float (&color)[3])
+        {
+            std::uint32_t r = static_cast<std::uint32_t>(AZStd::clamp(color[0] * 31.0f / 255.0f + 0.5f, 0.0f, 31.0f));
+            std::uint32_t g = static_cast<std::uint32_t>(AZStd::clamp(color[1] * 63.0f / 255.0f + 0.5f, 0.0f, 63.0f));
+            std::uint32_t b = static_cast<std::uint32_t>(AZStd::clamp(color[2] * 31.0f / 255.0f + 0.5f, 0.0f, 31.0f));
+            return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        void UnpackRgb565(std::uint16_t packed, std::int32_t (&color)[3])
+        {
+            std::int32_t r = (packed >> 11) & 31;
+            std::int32_t g = (packed >> 5) & 63;
+            std::int32_t b = packed & 31;
+            color[0] = (r << 3) | (r >> 2);
+            color[1] = (g << 2) | (g >> 4);
+            color[2] = (b << 3) | (b >> 2);
+        }
+
+        // Solve the endpoints that minimize the squared error of the colors for the given indices
+        bool FitEndpoints(
+            const std::uint8_t (&pixels)[16][4], const std::uint8_t (&indices)[16], float (&endpoint0)[3], float (&endpoint1)[3])
+        {
+            float aa = 0.0f;
+            float ab = 0.0f;
+            float bb = 0.0f;
+            float ax[3] = { 0.0f, 0.0f, 0.0f };
+            float bx[3] = { 0.0f, 0.0f, 0.0f };
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+                float a = COLOR_WEIGHTS[indices[i]];
+                float b = 1.0f - a;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (std::size_t channel = 0; channel < 3; ++channel)
+                {
+                    ax[channel] += a * pixels[i][channel];
+                    bx[channel] += b * pixels[i][channel];
+                }
+            }
+
+            float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) < 1e-6f)
+            {
+                return false;
+            }
+
+            for (std::size_t channel = 0; channel < 3; ++channel)
+            {
+                endpoint0[channel] = (ax[channel] * bb - bx[channel] * ab) / determinant;
+                endpoint1[channel] = (bx[channel] * aa - ax[channel] * ab) / determinant;
+            }
+
+            return true;
+        }
+    } // namespace
+
+    AZ::RHI::Format TextureBlockCompressor::GetCompressedFormat(AZ::RHI::Format format, bool hasAlpha)
+    {
+#if defined(AZ_PLATFORM_ANDROID) || defined(AZ_PLATFORM_IOS)
+        // mobile GPUs sample ASTC and ETC2 rather than BC formats, and there is no encoder for those yet
+        AZ_UNUSED(format);
+        AZ_UNUSED(hasAlpha);
+        return AZ::RHI::Format::Unknown;
+#else
+        switch (format)
+        {
+        case AZ::RHI::Format::R8_UNORM:
+            return AZ::RHI::Format::BC4_UNORM;
+        case AZ::RHI::Format::R8G8_UNORM:
+            return AZ::RHI::Format::BC5_UNORM;
+        case AZ::RHI::Format::R8G8B8A8_UNORM:
+            return hasAlpha ? AZ::RHI::Format::BC3_UNORM : AZ::RHI::Format::BC1_UNORM;
+        case AZ::RHI::Format::R8G8B8A8_UNORM_SRGB:
+            return hasAlpha ? AZ::RHI::Format::BC3_UNORM_SRGB : AZ::RHI::Format::BC1_UNORM_SRGB;
+        default:
+            return AZ::RHI::Format::Unknown;
+        }
+#endif
+    }
+
+    std::size_t TextureBlockCompressor::GetCompressedSize(std::uint32_t width, std::uint32_t height, AZ::RHI::Format compressedFormat)
+    {
+        std::size_t blockCount = std::size_t{ (width + 3) / 4 } * ((height + 3) / 4);
+        bool isBC3 = compressedFormat == AZ::RHI::Format::BC3_UNORM || compressedFormat == AZ::RHI::Format::BC3_UNORM_SRGB;
+        bool isBC5 = compressedFormat == AZ::RHI::Format::BC5_UNORM;
+        return blockCount * (isBC3 || isBC5 ? 16 : 8);
+    }
+
+    void TextureBlockCompressor::Compress(
+        const AZStd::span<const std::byte>& source,
+        std::uint32_t width,
+        std::uint32_t height,
+        AZ::RHI::Format compressedFormat,
+        TextureCompressionQuality quality,
+        AZStd::span<std::byte> destination)
+    {
+        bool isBC3 = compressedFormat == AZ::RHI::Format::BC3_UNORM || compressedFormat == AZ::RHI::Format::BC3_UNORM_SRGB;
+        bool isBC4 = compressedFormat == AZ::RHI::Format::BC4_UNORM;
+        bool isBC5 = compressedFormat == AZ::RHI::Format::BC5_UNORM;
+        std::uint32_t channelCount = isBC4 ? 1 : (isBC5 ? 2 : 4);
+        AZ_Assert(source.size() >= std::size_t{ width } * height * channelCount, "The source is smaller than the image");
+        AZ_Assert(destination.size() >= GetCompressedSize(width, height, compressedFormat), "The destination is smaller than the blocks");
+
+        const std::uint8_t* pixels = reinterpret_cast<const std::uint8_t*>(source.data());
+        std::uint8_t* block = reinterpret_cast<std::uint8_t*>(destination.data());
+        for (std::uint32_t blockY = 0; blockY < height; blockY += 4)
+        {
+            for (std::uint32_t blockX = 0; blockX < width; blockX += 4)
+            {
+                std::uint8_t blockPixels[16][4];
+                std::uint8_t blockValues[16];
+                for (std::uint32_t i = 0; i < 16; ++i)
+                {
+                    std::uint32_t x = AZStd::min(blockX + (i & 3), width - 1);
+                    std::uint32_t y = AZStd::min(blockY + (i >> 2), height - 1);
+                    const std::uint8_t* pixel = pixels + (std::size_t{ y } * width + x) * channelCount;
+                    for (std::uint32_t channel = 0; channel < channelCount; ++channel)
+                    {
+                        blockPixels[i][channel] = pixel[channel];
+                    }
+
+                    blockValues[i] = pixel[channelCount - 1];
+                }
+
+                if (isBC4)
+                {
+                    CompressSingleChannelBlock(blockValues, block);
+                    block += 8;
+                }
+                else if (isBC5)
+                {
+                    // two BC4 blocks, red first
+                    std::uint8_t redValues[16];
+                    for (std::uint32_t i = 0; i < 16; ++i)
+                    {
+                        redValues[i] = blockPixels[i][0];
+                    }
+
+                    CompressSingleChannelBlock(redValues, block);
+                    CompressSingleChannelBlock(blockValues, block + 8);
+                    block += 16;
+                }
+                else if (isBC3)
+                {
+                    CompressSingleChannelBlock(blockValues, block);
+                    CompressColorBlock(blockPixels, quality, block + 8);
+                    block += 16;
+                }
+                else
+                {
+                    CompressColorBlock(blockPixels, quality, block);
+                    block += 8;
+                }
+            }
+        }
+    }
+
+    void TextureBlockCompressor::CompressColorBlock(
+        const std::uint8_t (&pixels)[16][4], TextureCompressionQuality quality, std::uint8_t* block)
+    {
+        float minimum[3] = { 255.0f, 255.0f, 255.0f };
+        float maximum[3] = { 0.0f, 0.0f, 0.0f };
+        float mean[3] = { 0.0f, 0.0f, 0.0f };
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            for (std::size_t channel = 0; channel < 3; ++channel)
+            {
+                float value = pixels[i][channel];
+                minimum[channel] = AZStd::min(minimum[channel], value);
+                maximum[channel] = AZStd::max(maximum[channel], value);
+                mean[channel] += value / 16.0f;
+            }
+        }
+
+        float covariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            float r = pixels[i][0] - mean[0];
+            float g = pixels[i][1] - mean[1];
+            float b = pixels[i][2] - mean[2];
+            covariance[0] += r * r;
+            covariance[1] += r * g;
+            covariance[2] += r * b;
+            covariance[3] += g * g;
+            covariance[4] += g * b;
+            covariance[5] += b * b;
+        }
+
+        float endpoint0[3];
+        float endpoint1[3];
+        if (quality == TextureCompressionQuality::High)
+        {
+            // power iterations find the principal axis, starting from the diagonal of the bounding box
+            float axis[3] = { maximum[0] - minimum[0], maximum[1] - minimum[1], maximum[2] - minimum[2] };
+            for (std::size_t iteration = 0; iteration < 8; ++iteration)
+            {
+                float r = axis[0] * covariance[0] + axis[1] * covariance[1] + axis[2] * covariance[2];
+                float g = axis[0] * covariance[1] + axis[1] * covariance[3] + axis[2] * covariance[4];
+                float b = axis[0] * covariance[2] + axis[1] * covariance[4] + axis[2] * covariance[5];
+                float length = AZStd::max(AZStd::max(std::abs(r), std::abs(g)), std::abs(b));
+                if (length < 1e-6f)
+                {
+                    break;
+                }
+
+                axis[0] = r / length;
+                axis[1] = g / length;
+                axis[2] = b / length;
+            }
+
+            // the endpoints are the colors at both ends of the axis
+            float minimumProjection = std::numeric_limits<float>::max();
+            float maximumProjection = std::numeric_limits<float>::lowest();
+            std::size_t minimumPixel = 0;
+            std::size_t maximumPixel = 0;
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+                float projection = pixels[i][0] * axis[0] + pixels[i][1] * axis[1] + pixels[i][2] * axis[2];
+                if (projection < minimumProjection)
+                {
+                    minimumProjection = projection;
+                    minimumPixel = i;
+                }
+
+                if (projection > maximumProjection)
+                {
+                    maximumProjection = projection;
+                    maximumPixel = i;
+                }
+            }
+
+            for (std::size_t channel = 0; channel < 3; ++channel)
+            {
+                endpoint0[channel] = pixels[maximumPixel][channel];
+                endpoint1[channel] = pixels[minimumPixel][channel];
+            }
+        }
+        else
+        {
+            // corners of the bounding box, inset so that the palette covers the colors better. The diagonal follows the sign of the
+            // covariance of each channel with the one of the largest range
+            std::size_t mainChannel = 0;
+            for (std::size_t channel = 1; channel < 3; ++channel)
+            {
+                if (maximum[channel] - minimum[channel] > maximum[mainChannel] - minimum[mainChannel])
+                {
+                    mainChannel = channel;
+                }
+            }
+
+            constexpr std::size_t covarianceIndices[3][3] = { { 0, 1, 2 }, { 1, 3, 4 }, { 2, 4, 5 } };
+            for (std::size_t channel = 0; channel < 3; ++channel)
+            {
+                float inset = (maximum[channel] - minimum[channel]) / 16.0f;
+                endpoint0[channel] = maximum[channel] - inset;
+                endpoint1[channel] = minimum[channel] + inset;
+                if (covariance[covarianceIndices[mainChannel][channel]] < 0.0f)
+                {
+                    AZStd::swap(endpoint0[channel], endpoint1[channel]);
+                }
+            }
+        }
+
+        std::uint16_t color0 = PackRgb565(endpoint0);
+        std::uint16_t color1 = PackRgb565(endpoint1);
+        std::uint8_t indices[16];
+        std::uint32_t error = SelectColorIndices(pixels, color0, color1, indices);
+        if (quality == TextureCompressionQuality::High)
+        {
+            for (std::size_t iteration = 0; iteration < 2 && error > 0; ++iteration)
+            {
+                if (!FitEndpoints(pixels, indices, endpoint0, endpoint1))
+                {
+                    break;
+                }
+
+                std::uint16_t refinedColor0 = PackRgb565(endpoint0);
+                std::uint16_t refinedColor1 = PackRgb565(endpoint1);
+                std::uint8_t refinedIndices[16];
+                std::uint32_t refinedError = SelectColorIndices(pixels, refinedColor0, refinedColor1, refinedIndices);
+                if (refinedError >= error)
+                {
+                    break;
+                }
+
+                color0 = refinedColor0;
+                color1 = refinedColor1;
+                error = refinedError;
+                AZStd::copy(refinedIndices, refinedIndices + 16, indices);
+            }
+        }
+
+        // the first color is the largest, otherwise the block is decoded with 3 colors and black
+        if (color0 < color1)
+        {
+            AZStd::swap(color0, color1);
+            for (std::uint8_t& index : indices)
+            {
+                index ^= 1;
+            }
+        }
+
+        std::uint32_t packedIndices = 0;
+        for (std::uint32_t i = 0; i < 16; ++i)
+        {
+            packedIndices |= static_cast<std::uint32_t>(color0 == color1 ? 0 : indices[i]) << (i * 2);
+        }
+
+        block[0] = static_cast<std::uint8_t>(color0 & 0xFF);
+        block[1] = static_cast<std::uint8_t>(color0 >> 8);
+        block[2] = static_cast<std::uint8_t>(color1 & 0xFF);
+        block[3] = static_cast<std::uint8_t>(color1 >> 8);
+        for (std::uint32_t i = 0; i < 4; ++i)
+        {
+            block[4 + i] = static_cast<std::uint8_t>(packedIndices >> (i * 8));
+        }
+    }
+
+    void TextureBlockCompressor::CompressSingleChannelBlock(const std::uint8_t (&values)[16], std::uint8_t* block)
+    {
+        std::uint8_t minimum = *AZStd::min_element(values, values + 16);
+        std::uint8_t maximum = *AZStd::max_element(values, values + 16);
+
+        // with the largest value first, the block interpolates 6 values between the endpoints
+        std::int32_t palette[8];
+        palette[0] = maximum;
+        palette[1] = minimum;
+        for (std::int32_t i = 2; i < 8; ++i)
+        {
+            palette[i] = ((8 - i) * maximum + (i - 1) * minimum + 3) / 7;
+        }
+
+        std::uint64_t packedIndices = 0;
+        if (maximum != minimum)
+        {
+            for (std::uint32_t i = 0; i < 16; ++i)
+            {
+                std::uint64_t bestIndex = 0;
+                std::int32_t bestError = std::numeric_limits<std::int32_t>::max();
+                for (std::uint32_t index = 0; index < 8; ++index)
+                {
+                    std::int32_t error = std::abs(palette[index] - values[i]);
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestIndex = index;
+                    }
+                }
+
+                packedIndices |= bestIndex << (i * 3);
+            }
+        }
+
+        block[0] = maximum;
+        block[1] = minimum;
+        for (std::uint32_t i = 0; i < 6; ++i)
+        {
+            block[2 + i] = static_cast<std::uint8_t>(packedIndices >> (i * 8));
+        }
+    }
+
+    std::uint32_t TextureBlockCompressor::SelectColorIndices(
+        const std::uint8_t (&pixels)[16][4], std::uint16_t color0, std::uint16_t color1, std::uint8_t (&indices)[16])
+    {
+        std::int32_t palette[4][3];
+        UnpackRgb565(color0, palette[0]);
+        UnpackRgb565(color1, palette[1]);
+        for (std::size_t channel = 0; channel < 3; ++channel)
+        {
+            palette[2][channel] = (2 * palette[0][channel] + palette[1][channel]) / 3;
+            palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel]) / 3;
+        }
+
+        std::uint32_t totalError = 0;
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            std::uint32_t bestError = std::numeric_limits<std::uint32_t>::max();
+            for (std::uint8_t index = 0; index < 4; ++index)
+            {
+                std::int32_t r = palette[index][0] - pixels[i][0];
+                std::int32_t g = palette[index][1] - pixels[i][1];
+                std::int32_t b = palette[index][2] - pixels[i][2];
+                std::uint32_t error = static_cast<std::uint32_t>(r * r + g * g + b * b);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    indices[i] = index;
+                }
+            }
+
+            totalError += bestError;
+        }
+
+        return totalError;
+    }
+} // namespace Cesium
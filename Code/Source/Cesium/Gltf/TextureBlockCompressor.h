@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Atom/RHI.Reflect/Format.h>
+#include <AzCore/std/containers/span.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    enum class TextureCompressionQuality
+    {
+        None,
+
+        // Endpoints are the corners of the color bounding box
+        Fast,
+
+        // Endpoints are fitted along the principal axis of the colors, then refined by least squares
+        High
+    };
+
+    // Block compression of 8-bit images on the load threads. RGBA images are compressed to BC1 when they are opaque or BC3 otherwise,
+    // single channel images to BC4 and two channel images to BC5
+    struct TextureBlockCompressor
+    {
+    public:
+        // Return the block compressed format of an uncompressed format, or Unknown when the format or the platform is not supported
+        static AZ::RHI::Format GetCompressedFormat(AZ::RHI::Format format, bool hasAlpha);
+
+        static std::size_t GetCompressedSize(std::uint32_t width, std::uint32_t height, AZ::RHI::Format compressedFormat);
+
+        // Compress an image of 4 channels for BC1 and BC3, 1 channel for BC4 or 2 channels for BC5. Partial blocks at the right and
+        // bottom edges repeat the last column and row. destination holds GetCompressedSize bytes
+        static void Compress(
+            const AZStd::span<const std::byte>& source,
+            std::uint32_t width,
+            std::uint32_t height,
+            AZ::RHI::Format compressedFormat,
+            TextureCompressionQuality quality,
+            AZStd::span<std::byte> destination);
+
+    private:
+        static void CompressColorBlock(const std::uint8_t (&pixels)[16][4], TextureCompressionQuality quality, std::uint8_t* block);
+
+        static void CompressSingleChannelBlock(const std::uint8_t (&values)[16], std::uint8_t* block);
+
+        static std::uint32_t SelectColorIndices(
+            const std::uint8_t (&pixels)[16][4], std::uint16_t color0, std::uint16_t color1, std::uint8_t (&indices)[16]);
+    };
+} // namespace Cesium
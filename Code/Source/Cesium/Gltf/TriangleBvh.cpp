@@ -0,0 +1,434 @@
+#include "Cesium/Gltf/TriangleBvh.h"
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/algorithm.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace Cesium
+{
+    namespace
+    {
+        float GetSurfaceArea(const glm::vec3& minimum, const glm::vec3& maximum)
+        {
+            glm::vec3 extent = glm::max(maximum - minimum, glm::vec3(0.0f));
+            return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+        }
+    } // namespace
+
+    TriangleBvhHit::TriangleBvhHit()
+        : m_distance{ 0.0f }
+        , m_normal{ 0.0f, 0.0f, 1.0f }
+    {
+    }
+
+    TriangleBvh::TriangleBvh()
+        : m_minimum{ 0.0f }
+        , m_maximum{ 0.0f }
+        , m_quantizationScale{ 0.0f }
+        , m_dequantizationScale{ 0.0f }
+    {
+    }
+
+    void TriangleBvh::Build(const AZStd::span<const glm::vec3>& positions, const AZStd::span<const std::uint32_t>& indices)
+    {
+        m_nodes.clear();
+        m_triangles.clear();
+        m_positions.assign(positions.begin(), positions.end());
+
+        AZStd::vector<BuildTriangle> triangles;
+        triangles.reserve(indices.size() / 3);
+        glm::vec3 minimum{ std::numeric_limits<float>::max() };
+        glm::vec3 maximum{ std::numeric_limits<float>::lowest() };
+        for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            if (indices[i] >= positions.size() || indices[i + 1] >= positions.size() || indices[i + 2] >= positions.size())
+            {
+                continue;
+            }
+
+            const glm::vec3& v0 = positions[indices[i]];
+            const glm::vec3& v1 = positions[indices[i + 1]];
+            const glm::vec3& v2 = positions[indices[i + 2]];
+            BuildTriangle& triangle = triangles.emplace_back();
+            triangle.m_min = glm::min(v0, glm::min(v1, v2));
+            triangle.m_max = glm::max(v0, glm::max(v1, v2));
+            triangle.m_centroid = (triangle.m_min + triangle.m_max) * 0.5f;
+            triangle.m_triangle = static_cast<std::uint32_t>(i / 3);
+            minimum = glm::min(minimum, triangle.m_min);
+            maximum = glm::max(maximum, triangle.m_max);
+        }
+
+        if (triangles.empty())
+        {
+            m_positions.clear();
+            return;
+        }
+
+        m_minimum = minimum;
+        m_maximum = maximum;
+        glm::vec3 extent = maximum - minimum;
+        for (glm::length_t axis = 0; axis < 3; ++axis)
+        {
+            m_quantizationScale[axis] = extent[axis] > 0.0f ? 65535.0f / extent[axis] : 0.0f;
+            m_dequantizationScale[axis] = extent[axis] / 65535.0f;
+        }
+
+        // Nodes are created depth first, so the first child of a node always follows it and only the second child needs to be stored.
+        // Tasks of second children remember their parent to patch its link once the node is created
+        struct BuildTask
+        {
+            std::size_t m_begin;
+            std::size_t m_end;
+            std::size_t m_depth;
+            std::uint32_t m_parent;
+        };
+
+        constexpr std::uint32_t NO_PARENT = std::numeric_limits<std::uint32_t>::max();
+        AZStd::vector<BuildTask> tasks;
+        tasks.push_back(BuildTask{ 0, triangles.size(), 0, NO_PARENT });
+        m_nodes.reserve(2 * triangles.size() / MAX_LEAF_TRIANGLES + 1);
+        while (!tasks.empty())
+        {
+            BuildTask task = tasks.back();
+            tasks.pop_back();
+
+            std::uint32_t nodeIndex = static_cast<std::uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+            if (task.m_parent != NO_PARENT)
+            {
+                m_nodes[task.m_parent].m_data = nodeIndex << LEAF_COUNT_BITS;
+            }
+
+            glm::vec3 nodeMinimum{ std::numeric_limits<float>::max() };
+            glm::vec3 nodeMaximum{ std::numeric_limits<float>::lowest() };
+            for (std::size_t i = task.m_begin; i < task.m_end; ++i)
+            {
+                nodeMinimum = glm::min(nodeMinimum, triangles[i].m_min);
+                nodeMaximum = glm::max(nodeMaximum, triangles[i].m_max);
+            }
+
+            SetNodeBounds(m_nodes[nodeIndex], nodeMinimum, nodeMaximum);
+
+            std::size_t count = task.m_end - task.m_begin;
+            if (count <= MAX_LEAF_TRIANGLES)
+            {
+                m_nodes[nodeIndex].m_data = (static_cast<std::uint32_t>(m_triangles.size()) << LEAF_COUNT_BITS) |
+                    static_cast<std::uint32_t>(count);
+                for (std::size_t i = task.m_begin; i < task.m_end; ++i)
+                {
+                    std::size_t triangle = triangles[i].m_triangle;
+                    m_triangles.emplace_back(indices[triangle * 3], indices[triangle * 3 + 1], indices[triangle * 3 + 2]);
+                }
+
+                continue;
+            }
+
+            std::size_t middle = Partition(triangles, task.m_begin, task.m_end, task.m_depth < MAX_SAH_DEPTH);
+            tasks.push_back(BuildTask{ middle, task.m_end, task.m_depth + 1, nodeIndex });
+            tasks.push_back(BuildTask{ task.m_begin, middle, task.m_depth + 1, NO_PARENT });
+        }
+    }
+
+    bool TriangleBvh::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, TriangleBvhHit& hit) const
+    {
+        if (m_nodes.empty())
+        {
+            return false;
+        }
+
+        // zero components are nudged, so that the slab test never multiplies zero by infinity
+        glm::vec3 inverseDirection;
+        for (glm::length_t axis = 0; axis < 3; ++axis)
+        {
+            float component = direction[axis];
+            if (std::abs(component) < std::numeric_limits<float>::min())
+            {
+                component = std::copysign(std::numeric_limits<float>::min(), component);
+            }
+
+            inverseDirection[axis] = 1.0f / component;
+        }
+
+        struct StackEntry
+        {
+            std::uint32_t m_node;
+            float m_entry;
+        };
+
+        AZStd::array<StackEntry, TRAVERSAL_STACK_SIZE> stack;
+        std::size_t stackSize = 0;
+        float closest = maxDistance;
+        bool found = false;
+
+        float rootEntry = 0.0f;
+        if (!IntersectNode(m_nodes.front(), origin, inverseDirection, closest, rootEntry))
+        {
+            return false;
+        }
+
+        std::uint32_t nodeIndex = 0;
+        while (true)
+        {
+            const Node& node = m_nodes[nodeIndex];
+            std::uint32_t triangleCount = node.m_data & LEAF_COUNT_MASK;
+            if (triangleCount != 0)
+            {
+                std::uint32_t firstTriangle = node.m_data >> LEAF_COUNT_BITS;
+                for (std::uint32_t i = firstTriangle; i < firstTriangle + triangleCount; ++i)
+                {
+                    // Moller-Trumbore intersection, accepting both sides of the triangle
+                    const glm::u32vec3& triangle = m_triangles[i];
+                    const glm::vec3& v0 = m_positions[triangle.x];
+                    glm::vec3 edge1 = m_positions[triangle.y] - v0;
+                    glm::vec3 edge2 = m_positions[triangle.z] - v0;
+                    glm::vec3 p = glm::cross(direction, edge2);
+                    float determinant = glm::dot(edge1, p);
+                    if (std::abs(determinant) < std::numeric_limits<float>::min())
+                    {
+                        continue;
+                    }
+
+                    float inverseDeterminant = 1.0f / determinant;
+                    glm::vec3 s = origin - v0;
+                    float u = glm::dot(s, p) * inverseDeterminant;
+                    if (u < 0.0f || u > 1.0f)
+                    {
+                        continue;
+                    }
+
+                    glm::vec3 q = glm::cross(s, edge1);
+                    float v = glm::dot(direction, q) * inverseDeterminant;
+                    if (v < 0.0f || u + v > 1.0f)
+                    {
+                        continue;
+                    }
+
+                    float distance = glm::dot(edge2, q) * inverseDeterminant;
+                    if (distance < 0.0f || distance > closest)
+                    {
+                        continue;
+                    }
+
+                    glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
+                    hit.m_distance = distance;
+                    hit.m_normal = glm::dot(normal, direction) > 0.0f ? -normal : normal;
+                    closest = distance;
+                    found = true;
+                }
+            }
+            else
+            {
+                // visit the nearest child first, so that the farther one can be culled by the closest hit
+                std::uint32_t first = nodeIndex + 1;
+                std::uint32_t second = node.m_data >> LEAF_COUNT_BITS;
+                float firstEntry = 0.0f;
+                float secondEntry = 0.0f;
+                bool hitFirst = IntersectNode(m_nodes[first], origin, inverseDirection, closest, firstEntry);
+                bool hitSecond = IntersectNode(m_nodes[second], origin, inverseDirection, closest, secondEntry);
+                if (hitFirst && hitSecond)
+                {
+                    if (secondEntry < firstEntry)
+                    {
+                        std::swap(first, second);
+                        std::swap(firstEntry, secondEntry);
+                    }
+
+                    assert(stackSize < stack.size());
+                    stack[stackSize++] = StackEntry{ second, secondEntry };
+                    nodeIndex = first;
+                    continue;
+                }
+
+                if (hitFirst || hitSecond)
+                {
+                    nodeIndex = hitFirst ? first : second;
+                    continue;
+                }
+            }
+
+            // skip the nodes that start behind the closest hit found since they were pushed
+            while (stackSize > 0 && stack[stackSize - 1].m_entry > closest)
+            {
+                --stackSize;
+            }
+
+            if (stackSize == 0)
+            {
+                break;
+            }
+
+            nodeIndex = stack[--stackSize].m_node;
+        }
+
+        return found;
+    }
+
+    bool TriangleBvh::IsEmpty() const
+    {
+        return m_nodes.empty();
+    }
+
+    std::size_t TriangleBvh::GetTriangleCount() const
+    {
+        return m_triangles.size();
+    }
+
+    std::size_t TriangleBvh::GetNodeCount() const
+    {
+        return m_nodes.size();
+    }
+
+    std::size_t TriangleBvh::GetMemoryUsage() const
+    {
+        return m_nodes.size() * sizeof(Node) + m_positions.size() * sizeof(glm::vec3) + m_triangles.size() * sizeof(glm::u32vec3);
+    }
+
+    const glm::vec3& TriangleBvh::GetMinimum() const
+    {
+        return m_minimum;
+    }
+
+    const glm::vec3& TriangleBvh::GetMaximum() const
+    {
+        return m_maximum;
+    }
+
+    std::size_t TriangleBvh::Partition(AZStd::vector<BuildTriangle>& triangles, std::size_t begin, std::size_t end, bool useSah) const
+    {
+        glm::vec3 centroidMinimum{ std::numeric_limits<float>::max() };
+        glm::vec3 centroidMaximum{ std::numeric_limits<float>::lowest() };
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            centroidMinimum = glm::min(centroidMinimum, triangles[i].m_centroid);
+            centroidMaximum = glm::max(centroidMaximum, triangles[i].m_centroid);
+        }
+
+        glm::vec3 centroidExtent = centroidMaximum - centroidMinimum;
+        if (useSah)
+        {
+            struct Bin
+            {
+                glm::vec3 m_min{ std::numeric_limits<float>::max() };
+                glm::vec3 m_max{ std::numeric_limits<float>::lowest() };
+                std::size_t m_count{ 0 };
+            };
+
+            auto getBin = [&](const BuildTriangle& triangle, glm::length_t axis)
+            {
+                float relative = (triangle.m_centroid[axis] - centroidMinimum[axis]) / centroidExtent[axis];
+                return AZStd::min(static_cast<std::size_t>(relative * static_cast<float>(SAH_BIN_COUNT)), SAH_BIN_COUNT - 1);
+            };
+
+            // the cost of a split is the surface area of each side weighted by its triangle count
+            float bestCost = std::numeric_limits<float>::max();
+            glm::length_t bestAxis = 0;
+            std::size_t bestSplit = 0;
+            for (glm::length_t axis = 0; axis < 3; ++axis)
+            {
+                if (centroidExtent[axis] <= 0.0f)
+                {
+                    continue;
+                }
+
+                AZStd::array<Bin, SAH_BIN_COUNT> bins;
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    Bin& bin = bins[getBin(triangles[i], axis)];
+                    bin.m_min = glm::min(bin.m_min, triangles[i].m_min);
+                    bin.m_max = glm::max(bin.m_max, triangles[i].m_max);
+                    ++bin.m_count;
+                }
+
+                AZStd::array<float, SAH_BIN_COUNT> rightCosts;
+                Bin right;
+                for (std::size_t split = SAH_BIN_COUNT - 1; split > 0; --split)
+                {
+                    right.m_min = glm::min(right.m_min, bins[split].m_min);
+                    right.m_max = glm::max(right.m_max, bins[split].m_max);
+                    right.m_count += bins[split].m_count;
+                    rightCosts[split] = GetSurfaceArea(right.m_min, right.m_max) * static_cast<float>(right.m_count);
+                }
+
+                Bin left;
+                for (std::size_t split = 1; split < SAH_BIN_COUNT; ++split)
+                {
+                    left.m_min = glm::min(left.m_min, bins[split - 1].m_min);
+                    left.m_max = glm::max(left.m_max, bins[split - 1].m_max);
+                    left.m_count += bins[split - 1].m_count;
+                    if (left.m_count == 0 || left.m_count == end - begin)
+                    {
+                        continue;
+                    }
+
+                    float cost = GetSurfaceArea(left.m_min, left.m_max) * static_cast<float>(left.m_count) + rightCosts[split];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = split;
+                    }
+                }
+            }
+
+            if (bestSplit != 0)
+            {
+                auto middle = std::partition(
+                    triangles.begin() + begin, triangles.begin() + end,
+                    [&](const BuildTriangle& triangle)
+                    {
+                        return getBin(triangle, bestAxis) < bestSplit;
+                    });
+                return static_cast<std::size_t>(middle - triangles.begin());
+            }
+        }
+
+        // split in the middle of the widest axis. Triangles with the same centroid still end up on both sides
+        glm::length_t axis = 0;
+        if (centroidExtent.y > centroidExtent[axis])
+        {
+            axis = 1;
+        }
+
+        if (centroidExtent.z > centroidExtent[axis])
+        {
+            axis = 2;
+        }
+
+        std::size_t middle = begin + (end - begin) / 2;
+        std::nth_element(
+            triangles.begin() + begin, triangles.begin() + middle, triangles.begin() + end,
+            [axis](const BuildTriangle& lhs, const BuildTriangle& rhs)
+            {
+                return lhs.m_centroid[axis] < rhs.m_centroid[axis];
+            });
+        return middle;
+    }
+
+    void TriangleBvh::SetNodeBounds(Node& node, const glm::vec3& minimum, const glm::vec3& maximum) const
+    {
+        // round outward, so that the quantized bounds always contain the triangles of the node
+        glm::vec3 quantizedMinimum = glm::floor((minimum - m_minimum) * m_quantizationScale);
+        glm::vec3 quantizedMaximum = glm::ceil((maximum - m_minimum) * m_quantizationScale);
+        node.m_min = glm::u16vec3(glm::clamp(quantizedMinimum, glm::vec3(0.0f), glm::vec3(65535.0f)));
+        node.m_max = glm::u16vec3(glm::clamp(quantizedMaximum, glm::vec3(0.0f), glm::vec3(65535.0f)));
+        node.m_data = 0;
+    }
+
+    bool TriangleBvh::IntersectNode(
+        const Node& node, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& entry) const
+    {
+        glm::vec3 minimum = m_minimum + glm::vec3(node.m_min) * m_dequantizationScale;
+        glm::vec3 maximum = m_minimum + glm::vec3(node.m_max) * m_dequantizationScale;
+        glm::vec3 t0 = (minimum - origin) * inverseDirection;
+        glm::vec3 t1 = (maximum - origin) * inverseDirection;
+        glm::vec3 tNear = glm::min(t0, t1);
+        glm::vec3 tFar = glm::max(t0, t1);
+        entry = AZStd::max(AZStd::max(tNear.x, tNear.y), AZStd::max(tNear.z, 0.0f));
+
+        // the exit is pushed out by a few ulps, so that rounding of the dequantization doesn't miss triangles on the bounds
+        float exit = AZStd::min(AZStd::min(tFar.x, tFar.y), AZStd::min(tFar.z, maxDistance)) * 1.0000004f;
+        return entry <= exit;
+    }
+} // namespace Cesium
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    struct TriangleBvhHit final
+    {
+        TriangleBvhHit();
+
+        // Distance along the ray in units of the ray direction, so that it stays the same when the ray is transformed
+        float m_distance;
+
+        // Unit geometric normal of the triangle that is hit, facing the origin of the ray
+        glm::vec3 m_normal;
+    };
+
+    // Bounding volume hierarchy of a triangle list for ray casts on the CPU. It is built with the binned surface area heuristic,
+    // and the bounds of the nodes are quantized to 16 bits relative to the bounds of the whole mesh, so that a node is 16 bytes
+    class TriangleBvh final
+    {
+        struct Node final
+        {
+            glm::u16vec3 m_min;
+            glm::u16vec3 m_max;
+
+            // Leaves store their first triangle above the 4 low bits, which hold their triangle count. Interior nodes store their
+            // second child above the 4 low bits, which are zero. The first child is always the next node
+            std::uint32_t m_data;
+        };
+
+        struct BuildTriangle final
+        {
+            glm::vec3 m_min;
+            glm::vec3 m_max;
+            glm::vec3 m_centroid;
+            std::uint32_t m_triangle;
+        };
+
+    public:
+        TriangleBvh();
+
+        // Build the hierarchy of a triangle list. Positions and indices are copied, so they don't need to outlive the hierarchy.
+        // Triangles with out of range indices are skipped
+        void Build(const AZStd::span<const glm::vec3>& positions, const AZStd::span<const std::uint32_t>& indices);
+
+        // Find the closest triangle hit by the ray within maxDistance. Both sides of the triangles are hit.
+        // The direction doesn't need to be normalized
+        bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, TriangleBvhHit& hit) const;
+
+        bool IsEmpty() const;
+
+        std::size_t GetTriangleCount() const;
+
+        std::size_t GetNodeCount() const;
+
+        std::size_t GetMemoryUsage() const;
+
+        const glm::vec3& GetMinimum() const;
+
+        const glm::vec3& GetMaximum() const;
+
+    private:
+        std::size_t Partition(AZStd::vector<BuildTriangle>& triangles, std::size_t begin, std::size_t end, bool useSah) const;
+
+        void SetNodeBounds(Node& node, const glm::vec3& minimum, const glm::vec3& maximum) const;
+
+        bool IntersectNode(const Node& node, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& entry)
+            const;
+
+        static constexpr std::uint32_t LEAF_COUNT_BITS = 4;
+        static constexpr std::uint32_t LEAF_COUNT_MASK = (1u << LEAF_COUNT_BITS) - 1;
+        static constexpr std::size_t MAX_LEAF_TRIANGLES = 4;
+        static constexpr std::size_t SAH_BIN_COUNT = 16;
+
+        // Below this depth, nodes are split in the middle instead of with the surface area heuristic, so that degenerate meshes
+        // cannot overflow the traversal stack
+        static constexpr std::size_t MAX_SAH_DEPTH = 64;
+        static constexpr std::size_t TRAVERSAL_STACK_SIZE = 128;
+
+        glm::vec3 m_minimum;
+        glm::vec3 m_maximum;
+        glm::vec3 m_quantizationScale;
+        glm::vec3 m_dequantizationScale;
+        AZStd::vector<Node> m_nodes;
+        AZStd::vector<glm::vec3> m_positions;
+
+        // indices of the triangles, in the order of the leaves
+        AZStd::vector<glm::u32vec3> m_triangles;
+    };
+} // namespace Cesium
@@ -3,6 +3,7 @@
 #include <CesiumUtility/Math.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <cmath>
 
 namespace Cesium
 {
@@ -78,6 +79,12 @@ namespace Cesium
         return true;
     }
 
+    bool MathHelper::IsInvertibleMatrix(const glm::dmat4& mat)
+    {
+        // a determinant that is zero or denormal makes the inverse overflow
+        return std::isnormal(glm::determinant(mat));
+    }
+
     glm::dvec3 MathHelper::CalculatePitchRollHead(const glm::dvec3& direction)
     {
         glm::dvec3 pitchRollHead{};
@@ -97,4 +104,10 @@ namespace Cesium
         assert(((0 != align) && !(align & (align - 1))) && "non-power of 2 alignment");
         return ((location + (align - 1)) & ~(align - 1));
     }
+
+    std::size_t MathHelper::AlignToMultiple(std::size_t location, std::size_t multiple)
+    {
+        assert(multiple != 0 && "alignment must not be zero");
+        return ((location + (multiple - 1)) / multiple) * multiple;
+    }
 } // namespace Cesium
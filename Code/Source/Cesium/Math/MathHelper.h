@@ -22,8 +22,13 @@ namespace Cesium
 
         static bool IsIdentityMatrix(const glm::dmat4& mat);
 
+        // A matrix that scales an axis to zero, as glTF does to hide a node, has no inverse
+        static bool IsInvertibleMatrix(const glm::dmat4& mat);
+
         static glm::dvec3 CalculatePitchRollHead(const glm::dvec3& direction);
 
         static std::size_t Align(std::size_t location, std::size_t align);
+
+        static std::size_t AlignToMultiple(std::size_t location, std::size_t multiple);
     };
 } // namespace Cesium
@@ -19,6 +19,9 @@ namespace Cesium
         // initialize task processor
         m_taskProcessor = std::make_shared<TaskProcessor>();
 
+        // initialize glTF model cache
+        m_gltfModelCache = AZStd::make_unique<GltfModelCache>(m_taskProcessor);
+
         // initialize credit system
         m_creditSystem = std::make_shared<Cesium3DTilesSelection::CreditSystem>();
 
@@ -73,4 +76,9 @@ namespace Cesium
     {
         return m_criticalAssetManager;
     }
+
+    GltfModelCache& CesiumSystem::GetGltfModelCache()
+    {
+        return *m_gltfModelCache;
+    }
 } // namespace Cesium
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Cesium/Systems/LocalFileManager.h"
 #include "Cesium/Systems/HttpManager.h"
 #include "Cesium/Systems/CriticalAssetManager.h"
+#include "Cesium/Gltf/GltfModelCache.h"
 #include <AzCore/JSON/rapidjson.h>
 #include <AzCore/Interface/Interface.h>
 #include <AzCore/RTTI/TypeInfo.h>
@@ -44,6 +45,8 @@ namespace Cesium
 
         const CriticalAssetManager& GetCriticalAssetManager() const;
 
+        GltfModelCache& GetGltfModelCache();
+
     private:
         AZStd::unique_ptr<HttpManager> m_httpManager;
         AZStd::unique_ptr<LocalFileManager> m_localFileManager;
@@ -53,6 +56,7 @@ namespace Cesium
         std::shared_ptr<spdlog::logger> m_logger;
         std::shared_ptr<Cesium3DTilesSelection::CreditSystem> m_creditSystem;
         CriticalAssetManager m_criticalAssetManager;
+        AZStd::unique_ptr<GltfModelCache> m_gltfModelCache;
     };
 } // namespace Cesium
 
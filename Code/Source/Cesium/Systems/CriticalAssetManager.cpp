@@ -1,9 +1,35 @@
 #include "Cesium/Systems/CriticalAssetManager.h"
+#include "Cesium/Math/MathHelper.h"
 #include <Atom/RPI.Reflect/Asset/AssetUtils.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAssetCreator.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/vector.h>
+#include <glm/glm.hpp>
+#include <cstring>
 
 namespace Cesium
 {
+    namespace
+    {
+        thread_local StableAssetIdScope* g_stableAssetIdScope = nullptr;
+    }
+
+    StableAssetIdScope::StableAssetIdScope(const AZ::Uuid& sourceUuid, AZ::u32 firstSubId)
+        : m_sourceUuid{ sourceUuid }
+        , m_nextSubId{ firstSubId }
+    {
+        AZ_Assert(g_stableAssetIdScope == nullptr, "Stable asset ID scopes cannot be nested");
+        g_stableAssetIdScope = this;
+    }
+
+    StableAssetIdScope::~StableAssetIdScope() noexcept
+    {
+        g_stableAssetIdScope = nullptr;
+    }
+
     CriticalAssetManager::CriticalAssetManager()
+        : m_transientAssetNamespace{ AZ::Uuid::CreateRandom() }
+        , m_nextTransientAssetId{ 0 }
     {
         AzFramework::AssetCatalogEventBus::Handler::BusConnect();
     }
@@ -12,18 +38,120 @@ namespace Cesium
     {
         m_standardPbrMaterialType.Release();
         m_rasterMaterialType.Release();
+        m_pointCloudMaterialType.Release();
+        m_lineMaterialType.Release();
+        m_constantVertexStreams.m_bufferAsset.Release();
     }
 
     void CriticalAssetManager::OnCatalogLoaded([[maybe_unused]] const char* catalogFile)
     {
         m_standardPbrMaterialType = AZ::RPI::AssetUtils::LoadCriticalAsset<AZ::RPI::MaterialTypeAsset>(STANDARD_PBR_MAT_TYPE);
         m_rasterMaterialType = AZ::RPI::AssetUtils::LoadCriticalAsset<AZ::RPI::MaterialTypeAsset>(RASTER_MAT_TYPE);
+        m_pointCloudMaterialType = AZ::RPI::AssetUtils::LoadCriticalAsset<AZ::RPI::MaterialTypeAsset>(POINT_CLOUD_MAT_TYPE);
+        m_lineMaterialType = AZ::RPI::AssetUtils::LoadCriticalAsset<AZ::RPI::MaterialTypeAsset>(LINE_MAT_TYPE);
         AzFramework::AssetCatalogEventBus::Handler::BusDisconnect();
     }
 
-    AZ::Data::AssetId CriticalAssetManager::GenerateRandomAssetId() const
+    AZ::Data::AssetId CriticalAssetManager::GenerateAssetId() const
+    {
+        if (g_stableAssetIdScope)
+        {
+            return AZ::Data::AssetId(g_stableAssetIdScope->m_sourceUuid, g_stableAssetIdScope->m_nextSubId++);
+        }
+
+        // the low bits of the counter are the sub ID, and the high bits are folded into the namespace, so IDs never repeat in a session
+        std::uint64_t id = m_nextTransientAssetId.fetch_add(1, std::memory_order_relaxed);
+        AZ::Uuid guid = m_transientAssetNamespace;
+        std::uint32_t highBits = static_cast<std::uint32_t>(id >> 32);
+        if (highBits != 0)
+        {
+            auto guidBytes = guid.begin();
+            for (std::size_t i = 0; i < sizeof(highBits); ++i)
+            {
+                guidBytes[i] ^= static_cast<std::uint8_t>(highBits >> (i * 8));
+            }
+        }
+
+        return AZ::Data::AssetId(guid, static_cast<AZ::u32>(id));
+    }
+
+    ConstantVertexStreams CriticalAssetManager::GetConstantVertexStreams(std::size_t vertexCount) const
+    {
+        if (g_stableAssetIdScope)
+        {
+            return GrowConstantVertexStreams(g_stableAssetIdScope->m_constantVertexStreams, vertexCount);
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_constantVertexStreamsMutex);
+        return GrowConstantVertexStreams(m_constantVertexStreams, vertexCount);
+    }
+
+    ConstantVertexStreams CriticalAssetManager::GrowConstantVertexStreams(
+        ConstantVertexStreams& cachedStreams, std::size_t vertexCount) const
+    {
+        std::size_t capacity = cachedStreams.m_tangents.m_elementCount;
+        if (!cachedStreams.m_bufferAsset || capacity < vertexCount)
+        {
+            // grow geometrically, so that large tiles don't recreate the buffer over and over. Meshes that use the previous
+            // buffer keep it alive through their own reference
+            capacity = AZStd::max(AZStd::max(vertexCount, capacity * 2), MIN_CONSTANT_VERTEX_STREAMS_CAPACITY);
+            cachedStreams = CreateConstantVertexStreams(capacity);
+        }
+
+        ConstantVertexStreams streams = cachedStreams;
+
+        // every stream of a mesh must have as many elements as the mesh has vertices
+        streams.m_tangents.m_elementCount = static_cast<std::uint32_t>(vertexCount);
+        streams.m_bitangents.m_elementCount = static_cast<std::uint32_t>(vertexCount);
+        streams.m_uvs.m_elementCount = static_cast<std::uint32_t>(vertexCount);
+        return streams;
+    }
+
+    ConstantVertexStreams CriticalAssetManager::CreateConstantVertexStreams(std::size_t capacity) const
     {
-        static std::atomic_uint32_t subId = 0;
-        return AZ::Data::AssetId(AZ::Uuid::CreateRandom(), subId.fetch_add(1, std::memory_order_relaxed));
+        auto appendBufferView = [capacity](std::size_t& totalBufferSize, AZ::RHI::Format format)
+        {
+            std::size_t formatSize = AZ::RHI::GetFormatSize(format);
+            std::size_t offset = MathHelper::AlignToMultiple(totalBufferSize, formatSize);
+            totalBufferSize = offset + capacity * formatSize;
+            return AZ::RHI::BufferViewDescriptor::CreateTyped(
+                static_cast<std::uint32_t>(offset / formatSize), static_cast<std::uint32_t>(capacity), format);
+        };
+
+        ConstantVertexStreams streams;
+        std::size_t totalBufferSize = 0;
+        streams.m_tangents = appendBufferView(totalBufferSize, AZ::RHI::Format::R32G32B32A32_FLOAT);
+        streams.m_bitangents = appendBufferView(totalBufferSize, AZ::RHI::Format::R32G32B32_FLOAT);
+        streams.m_uvs = appendBufferView(totalBufferSize, AZ::RHI::Format::R32G32_FLOAT);
+
+        // same values as the tangents and bitangents generated for primitives that have no tangent space
+        AZStd::vector<std::byte> buffer(totalBufferSize, std::byte{ 0 });
+        auto fill = [&buffer](const AZ::RHI::BufferViewDescriptor& bufferView, const auto& value)
+        {
+            std::byte* begin = buffer.data() + bufferView.m_elementOffset * bufferView.m_elementSize;
+            for (std::uint32_t i = 0; i < bufferView.m_elementCount; ++i)
+            {
+                std::memcpy(begin + i * sizeof(value), &value, sizeof(value));
+            }
+        };
+
+        fill(streams.m_tangents, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+        fill(streams.m_bitangents, glm::vec3(0.0f, 1.0f, 0.0f));
+
+        AZ::RHI::BufferViewDescriptor bufferViewDescriptor =
+            AZ::RHI::BufferViewDescriptor::CreateTyped(0, static_cast<std::uint32_t>(buffer.size()), AZ::RHI::Format::R8_UINT);
+
+        AZ::RHI::BufferDescriptor bufferDescriptor;
+        bufferDescriptor.m_bindFlags = AZ::RHI::BufferBindFlags::InputAssembly | AZ::RHI::BufferBindFlags::ShaderRead;
+        bufferDescriptor.m_byteCount = buffer.size();
+
+        AZ::RPI::BufferAssetCreator creator;
+        creator.Begin(GenerateAssetId());
+        creator.SetBuffer(buffer.data(), bufferDescriptor.m_byteCount, bufferDescriptor);
+        creator.SetBufferViewDescriptor(bufferViewDescriptor);
+        creator.SetUseCommonPool(AZ::RPI::CommonBufferPoolType::StaticInputAssembly);
+        creator.End(streams.m_bufferAsset);
+
+        return streams;
     }
 } // namespace Cesium
@@ -1,12 +1,48 @@
 #pragma once
 
 #include <Atom/RPI.Reflect/Material/MaterialTypeAsset.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
+#include <Atom/RHI.Reflect/BufferViewDescriptor.h>
 #include <AzFramework/Asset/AssetCatalogBus.h>
 #include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/parallel/mutex.h>
 #include <atomic>
 
 namespace Cesium
 {
+    // Vertex streams with the same value for every vertex. They are bound in place of the streams that the shader
+    // requires but the material doesn't use, so that meshes don't need to store per-vertex filler
+    struct ConstantVertexStreams final
+    {
+        AZ::Data::Asset<AZ::RPI::BufferAsset> m_bufferAsset;
+        AZ::RHI::BufferViewDescriptor m_tangents;
+        AZ::RHI::BufferViewDescriptor m_bitangents;
+        AZ::RHI::BufferViewDescriptor m_uvs;
+    };
+
+    // While a scope is alive, the asset IDs generated on its thread are derived from a source asset instead of being random, so that
+    // the products that the Asset Processor builds from the same source keep their IDs between builds. Scopes cannot be nested
+    class StableAssetIdScope final
+    {
+        friend class CriticalAssetManager;
+
+    public:
+        StableAssetIdScope(const AZ::Uuid& sourceUuid, AZ::u32 firstSubId);
+
+        StableAssetIdScope(const StableAssetIdScope&) = delete;
+
+        StableAssetIdScope& operator=(const StableAssetIdScope&) = delete;
+
+        ~StableAssetIdScope() noexcept;
+
+    private:
+        AZ::Uuid m_sourceUuid;
+        AZ::u32 m_nextSubId;
+
+        // the constant streams become products of the source too, so they aren't shared with the meshes built at runtime
+        ConstantVertexStreams m_constantVertexStreams;
+    };
+
     class CriticalAssetManager : public AzFramework::AssetCatalogEventBus::Handler
     {
     public:
@@ -16,13 +52,36 @@ namespace Cesium
 
         void OnCatalogLoaded(const char* catalogFile) override;
 
-        AZ::Data::AssetId GenerateRandomAssetId() const;
+        // IDs of the assets built at runtime, which are never saved nor registered to the asset catalog. They are a namespace picked
+        // once per session plus a counter, which is much cheaper than a random UUID per asset. Inside a StableAssetIdScope, IDs are
+        // derived from the source asset instead
+        AZ::Data::AssetId GenerateAssetId() const;
+
+        // Return constant streams that have at least vertexCount elements. The buffer is shared by every mesh and only
+        // recreated when a mesh needs more vertices than its capacity. Inside a StableAssetIdScope, it is only shared by the
+        // meshes built in the scope
+        ConstantVertexStreams GetConstantVertexStreams(std::size_t vertexCount) const;
 
         AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_standardPbrMaterialType;
         AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_rasterMaterialType;
+        AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_pointCloudMaterialType;
+        AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_lineMaterialType;
 
     private:
+        ConstantVertexStreams GrowConstantVertexStreams(ConstantVertexStreams& cachedStreams, std::size_t vertexCount) const;
+
+        ConstantVertexStreams CreateConstantVertexStreams(std::size_t capacity) const;
+
         static constexpr const char* const STANDARD_PBR_MAT_TYPE = "Materials/Types/StandardPBR.azmaterialtype";
         static constexpr const char* const RASTER_MAT_TYPE = "Materials/Types/GltfStandardPBR.azmaterialtype";
+        static constexpr const char* const POINT_CLOUD_MAT_TYPE = "Materials/Types/GltfPointCloud.azmaterialtype";
+        static constexpr const char* const LINE_MAT_TYPE = "Materials/Types/GltfLine.azmaterialtype";
+        static constexpr std::size_t MIN_CONSTANT_VERTEX_STREAMS_CAPACITY = 4096;
+
+        AZ::Uuid m_transientAssetNamespace;
+        mutable std::atomic_uint64_t m_nextTransientAssetId;
+
+        mutable AZStd::mutex m_constantVertexStreamsMutex;
+        mutable ConstantVertexStreams m_constantVertexStreams;
     };
 } // namespace Cesium
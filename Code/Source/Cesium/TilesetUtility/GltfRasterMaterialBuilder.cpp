@@ -5,7 +5,8 @@
 
 namespace Cesium
 {
-    GltfRasterMaterialBuilder::GltfRasterMaterialBuilder()
+    GltfRasterMaterialBuilder::GltfRasterMaterialBuilder(TextureCompressionQuality textureCompression)
+        : m_pbrMaterialBuilder{ textureCompression }
     {
         const auto& defaultMaterialType = CesiumInterface::Get()->GetCriticalAssetManager().m_rasterMaterialType;
         m_pbrMaterialBuilder.OverrideMaterialType(defaultMaterialType);
@@ -50,7 +51,7 @@ namespace Cesium
         AZStd::string prefix = AZStd::string::format("raster%d", rasterLayer);
 
         AZ::RPI::MaterialAssetCreator materialCreator;
-        materialCreator.Begin(AZ::Uuid::CreateRandom(), parent->GetMaterialTypeAsset(), true);
+        materialCreator.Begin(CesiumInterface::Get()->GetCriticalAssetManager().GenerateAssetId(), parent->GetMaterialTypeAsset(), true);
         materialCreator.SetPropertyValue(AZ::Name(prefix + ".textureMap"), raster);
         materialCreator.SetPropertyValue(AZ::Name(prefix + ".useTexture"), true);
         materialCreator.SetPropertyValue(AZ::Name(prefix + ".textureMapUv"), textureUv);
@@ -104,4 +105,10 @@ namespace Cesium
 
         return material->Compile();
     }
+
+    bool GltfRasterMaterialBuilder::HasRasterLayer(std::uint32_t rasterLayer, const AZ::Data::Instance<AZ::RPI::Material>& material)
+    {
+        AZStd::string prefix = AZStd::string::format("raster%d", rasterLayer);
+        return material->FindPropertyIndex(AZ::Name(prefix + ".textureMap")).IsValid();
+    }
 } // namespace Cesium
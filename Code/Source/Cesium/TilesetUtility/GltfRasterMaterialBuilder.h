@@ -14,7 +14,7 @@ namespace Cesium
     class GltfRasterMaterialBuilder final : public GltfMaterialBuilder
     {
     public:
-        GltfRasterMaterialBuilder();
+        explicit GltfRasterMaterialBuilder(TextureCompressionQuality textureCompression = TextureCompressionQuality::None);
 
         const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& GetDefaultMaterialType() const override;
 
@@ -42,6 +42,9 @@ namespace Cesium
 
         bool UnsetRasterForMaterial(std::uint32_t rasterLayer, AZ::Data::Instance<AZ::RPI::Material>& material);
 
+        // Point cloud and line materials don't have raster slots, so the raster overlay skips them
+        static bool HasRasterLayer(std::uint32_t rasterLayer, const AZ::Data::Instance<AZ::RPI::Material>& material);
+
         static constexpr std::uint32_t MAX_RASTER_LAYERS = 2;
 
     private:
@@ -2,12 +2,17 @@
 #include "Cesium/TilesetUtility/GltfRasterMaterialBuilder.h"
 #include "Cesium/Gltf/GltfModelBuilder.h"
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/GeometryHeap.h"
+#include "Cesium/Gltf/GltfPrimitiveCache.h"
+#include "Cesium/Gltf/StreamingImageBuilder.h"
 #include <Atom/Feature/Mesh/MeshFeatureProcessorInterface.h>
-#include <Atom/RPI.Reflect/Image/StreamingImageAssetCreator.h>
-#include <Atom/RPI.Reflect/Image/ImageMipChainAssetCreator.h>
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
 #include <AzCore/std/algorithm.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <limits>
 
 // Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
 // This only happens with unity build
@@ -28,9 +33,21 @@
 
 namespace Cesium
 {
-    RenderResourcesPreparer::RenderResourcesPreparer(AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor)
+    TileRaycastQuery::TileRaycastQuery()
+        : m_origin{ 0.0 }
+        , m_direction{ 0.0, 0.0, -1.0 }
+        , m_maxDistance{ std::numeric_limits<double>::max() }
+        , m_isHit{ false }
+    {
+    }
+
+    RenderResourcesPreparer::RenderResourcesPreparer(
+        AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor, const TilesetRenderConfiguration& renderConfiguration)
         : m_meshFeatureProcessor{ meshFeatureProcessor }
+        , m_renderConfiguration{ renderConfiguration }
         , m_transform{ 1.0 }
+        , m_geometryHeap{ AZStd::make_shared<GeometryHeap>(GeometryHeap::DEFAULT_BLOCK_SIZE) }
+        , m_primitiveCache{ AZStd::make_shared<GltfPrimitiveCache>() }
     {
         m_freeRasterLayers.reserve(GltfRasterMaterialBuilder::MAX_RASTER_LAYERS);
         for (std::uint32_t i = 0; i < GltfRasterMaterialBuilder::MAX_RASTER_LAYERS; ++i)
@@ -62,6 +79,8 @@ namespace Cesium
                 return !material->NeedsCompile() || material->Compile();
             });
         m_compileMaterialsQueue.erase(it, m_compileMaterialsQueue.end());
+
+        m_geometryHeap->NextFrame();
     }
 
     void RenderResourcesPreparer::SetTransform(const glm::dmat4& transform)
@@ -90,6 +109,173 @@ namespace Cesium
         }
     }
 
+    void RenderResourcesPreparer::SetSelected(void* renderResources, bool selected)
+    {
+        if (renderResources)
+        {
+            IntrusiveGltfModel* intrusiveModel = reinterpret_cast<IntrusiveGltfModel*>(renderResources);
+            intrusiveModel->m_isSelected = selected;
+        }
+    }
+
+    void RenderResourcesPreparer::SetCollisionFocusPoints(const AZStd::vector<glm::dvec3>& focusPoints)
+    {
+        m_collisionFocusPoints = focusPoints;
+    }
+
+    void RenderResourcesPreparer::UpdateCollision()
+    {
+        if (!m_renderConfiguration.m_enableCollision)
+        {
+            return;
+        }
+
+        // Only selected tiles get colliders, because their ancestors and descendants that are still loaded overlap them
+        double focusRadiusSquared = static_cast<double>(m_renderConfiguration.m_collisionFocusRadius);
+        focusRadiusSquared *= focusRadiusSquared;
+        std::uint32_t enabledCount = 0;
+        for (IntrusiveGltfModel& intrusiveModel : m_intrusiveModels)
+        {
+            GltfModel& model = intrusiveModel.m_model;
+            if (!model.HasCollision())
+            {
+                continue;
+            }
+
+            bool isInFocus = false;
+            if (intrusiveModel.m_isSelected)
+            {
+                for (const glm::dvec3& focusPoint : m_collisionFocusPoints)
+                {
+                    glm::dvec3 offset = glm::clamp(focusPoint, model.GetCollisionMinimum(), model.GetCollisionMaximum()) - focusPoint;
+                    if (glm::dot(offset, offset) <= focusRadiusSquared)
+                    {
+                        isInFocus = true;
+                        break;
+                    }
+                }
+            }
+
+            if (isInFocus == model.IsCollisionEnabled() || (isInFocus && enabledCount >= MAX_COLLISION_MODELS_ENABLED_PER_FRAME))
+            {
+                continue;
+            }
+
+            model.SetCollisionEnabled(isInFocus);
+            enabledCount += isInFocus ? 1 : 0;
+        }
+    }
+
+    bool RenderResourcesPreparer::Raycast(const glm::dvec3& origin, const glm::dvec3& direction, double maxDistance, GltfRaycastHit& hit)
+    {
+        // Hidden tiles are either ancestors replaced by their children or tiles outside of the view. Skipping them keeps the hit on
+        // the same level of detail that is rendered
+        bool found = false;
+        double closest = maxDistance;
+        for (const IntrusiveGltfModel& intrusiveModel : m_intrusiveModels)
+        {
+            if (intrusiveModel.m_model.IsVisible() && intrusiveModel.m_model.Raycast(origin, direction, closest, hit))
+            {
+                closest = hit.m_distance;
+                found = true;
+            }
+        }
+
+        return found;
+    }
+
+    void RenderResourcesPreparer::RaycastMostDetailed(AZStd::vector<TileRaycastQuery>& queries)
+    {
+        AZStd::vector<const IntrusiveGltfModel*> models;
+        for (const IntrusiveGltfModel& intrusiveModel : m_intrusiveModels)
+        {
+            if (intrusiveModel.m_model.CanRaycast())
+            {
+                models.emplace_back(&intrusiveModel);
+            }
+        }
+
+        // the first model that is hit is at the most detailed level
+        AZStd::sort(
+            models.begin(), models.end(),
+            [](const IntrusiveGltfModel* lhs, const IntrusiveGltfModel* rhs)
+            {
+                return lhs->m_geometricError < rhs->m_geometricError;
+            });
+
+        if (queries.size() <= RAYCAST_BATCH_SIZE)
+        {
+            RaycastMostDetailedBatch(models, queries.data(), queries.data() + queries.size());
+            return;
+        }
+
+        // the models are only read, so the batches can run on the job threads while the main thread waits
+        AZ::JobCompletion completion;
+        for (std::size_t begin = 0; begin < queries.size(); begin += RAYCAST_BATCH_SIZE)
+        {
+            TileRaycastQuery* batchBegin = queries.data() + begin;
+            TileRaycastQuery* batchEnd = queries.data() + AZStd::min(begin + RAYCAST_BATCH_SIZE, queries.size());
+            AZ::Job* job = AZ::CreateJobFunction(
+                [&models, batchBegin, batchEnd]()
+                {
+                    RaycastMostDetailedBatch(models, batchBegin, batchEnd);
+                },
+                true);
+            job->SetDependent(&completion);
+            job->Start();
+        }
+
+        completion.StartAndWaitForCompletion();
+    }
+
+    void RenderResourcesPreparer::RaycastMostDetailedBatch(
+        const AZStd::vector<const IntrusiveGltfModel*>& models, TileRaycastQuery* begin, TileRaycastQuery* end)
+    {
+        // bounds of the ray segments of the batch
+        glm::dvec3 batchMinimum{ std::numeric_limits<double>::max() };
+        glm::dvec3 batchMaximum{ std::numeric_limits<double>::lowest() };
+        for (TileRaycastQuery* query = begin; query != end; ++query)
+        {
+            glm::dvec3 rayEnd = query->m_origin + query->m_direction * query->m_maxDistance;
+            batchMinimum = glm::min(batchMinimum, glm::min(query->m_origin, rayEnd));
+            batchMaximum = glm::max(batchMaximum, glm::max(query->m_origin, rayEnd));
+        }
+
+        AZStd::vector<const IntrusiveGltfModel*> batchModels;
+        for (const IntrusiveGltfModel* intrusiveModel : models)
+        {
+            const GltfModel& model = intrusiveModel->m_model;
+            if (glm::all(glm::lessThanEqual(model.GetRaycastMinimum(), batchMaximum)) &&
+                glm::all(glm::greaterThanEqual(model.GetRaycastMaximum(), batchMinimum)))
+            {
+                batchModels.emplace_back(intrusiveModel);
+            }
+        }
+
+        for (TileRaycastQuery* query = begin; query != end; ++query)
+        {
+            // Sibling tiles share their geometric error and can both lie along the ray, so every tile of the most detailed level
+            // that is hit is tested, each one only for a hit closer than the previous ones
+            query->m_isHit = false;
+            double maxDistance = query->m_maxDistance;
+            double hitGeometricError = 0.0;
+            for (const IntrusiveGltfModel* intrusiveModel : batchModels)
+            {
+                if (query->m_isHit && intrusiveModel->m_geometricError > hitGeometricError)
+                {
+                    break;
+                }
+
+                if (intrusiveModel->m_model.Raycast(query->m_origin, query->m_direction, maxDistance, query->m_hit))
+                {
+                    query->m_isHit = true;
+                    maxDistance = query->m_hit.m_distance;
+                    hitGeometricError = intrusiveModel->m_geometricError;
+                }
+            }
+        }
+    }
+
     bool RenderResourcesPreparer::AddRasterLayer(const Cesium3DTilesSelection::RasterOverlay* rasterOverlay)
     {
         if (m_freeRasterLayers.empty())
@@ -128,22 +314,40 @@ namespace Cesium
             option.m_transform = glm::translate(transform, rtc.value());
         }
 
+        option.m_mergePrimitives = m_renderConfiguration.m_mergeMeshPrimitives;
+        option.m_primitiveBuilderOption.m_optimizeVertexOrder = m_renderConfiguration.m_optimizeMeshVertexOrder;
+        option.m_primitiveBuilderOption.m_clusterTriangleCount = m_renderConfiguration.m_meshClusterTriangleCount;
+        option.m_primitiveBuilderOption.m_buildRaycastBvh = m_renderConfiguration.m_enableRaycast;
+        option.m_primitiveBuilderOption.m_buildCollisionMesh = m_renderConfiguration.m_enableCollision;
+        option.m_primitiveBuilderOption.m_collisionSimplificationError = m_renderConfiguration.m_collisionSimplificationError;
+        option.m_primitiveBuilderOption.m_geometryHeap = m_geometryHeap;
+        option.m_primitiveBuilderOption.m_primitiveCache = m_primitiveCache;
+        option.m_pointPrimitiveBuilderOption.m_attenuation = m_renderConfiguration.m_pointCloudAttenuation;
+        option.m_pointPrimitiveBuilderOption.m_pointSize = m_renderConfiguration.m_pointCloudPointSize;
+        option.m_pointPrimitiveBuilderOption.m_spacingScale = m_renderConfiguration.m_pointCloudSpacingScale;
+        option.m_pointPrimitiveBuilderOption.m_maximumPointSize = m_renderConfiguration.m_pointCloudMaximumPointSize;
+        option.m_linePrimitiveBuilderOption.m_lineWidth = m_renderConfiguration.m_lineWidth;
+
         // build model
         AZStd::unique_ptr<GltfLoadModel> loadModel = AZStd::make_unique<GltfLoadModel>();
-        GltfModelBuilder builder(AZStd::make_unique<GltfRasterMaterialBuilder>());
+        GltfModelBuilder builder(AZStd::make_unique<GltfRasterMaterialBuilder>(GetTextureCompressionQuality()));
         builder.Create(model, option, *loadModel);
         return loadModel.release();
     }
 
-    void* RenderResourcesPreparer::prepareInMainThread([[maybe_unused]] Cesium3DTilesSelection::Tile& tile, void* pLoadThreadResult)
+    void* RenderResourcesPreparer::prepareInMainThread(Cesium3DTilesSelection::Tile& tile, void* pLoadThreadResult)
     {
         if (pLoadThreadResult)
         {
             // we destroy loadModel after main thread is done
             AZStd::unique_ptr<GltfLoadModel> loadModel{ reinterpret_cast<GltfLoadModel*>(pLoadThreadResult) };
+
+            // the meshes of the model read their vertices from the heap, so it has to be written before they are acquired
+            m_geometryHeap->Upload();
             auto handle = m_intrusiveModels.emplace(GltfModel(m_meshFeatureProcessor, *loadModel));
             IntrusiveGltfModel& intrusiveModel = *handle;
             intrusiveModel.m_self = std::move(handle);
+            intrusiveModel.m_geometricError = tile.getGeometricError();
             intrusiveModel.m_model.SetTransform(m_transform);
             intrusiveModel.m_model.SetVisible(false);
             return &intrusiveModel;
@@ -173,33 +377,10 @@ namespace Cesium
     {
         if (!image.pixelData.empty() && image.width != 0 && image.height != 0)
         {
-            // image has 4 channels, so we just copy the data over
-            AZ::RHI::ImageDescriptor imageDesc;
-            imageDesc.m_bindFlags = AZ::RHI::ImageBindFlags::ShaderRead;
-            imageDesc.m_dimension = AZ::RHI::ImageDimension::Image2D;
-            imageDesc.m_size = AZ::RHI::Size(image.width, image.height, 1);
-            imageDesc.m_format = AZ::RHI::Format::R8G8B8A8_UNORM_SRGB;
-
-            AZ::RHI::ImageSubresourceLayout imageSubresourceLayout =
-                AZ::RHI::GetImageSubresourceLayout(imageDesc, AZ::RHI::ImageSubresource{});
-
-            // Create mip chain
-            AZ::RPI::ImageMipChainAssetCreator mipChainCreator;
-            mipChainCreator.Begin(AZ::Uuid::CreateRandom(), 1, 1);
-            mipChainCreator.BeginMip(imageSubresourceLayout);
-            mipChainCreator.AddSubImage(image.pixelData.data(), image.pixelData.size());
-            mipChainCreator.EndMip();
-            AZ::Data::Asset<AZ::RPI::ImageMipChainAsset> mipChainAsset;
-            mipChainCreator.End(mipChainAsset);
-
-            // Create streaming image
-            AZ::RPI::StreamingImageAssetCreator imageCreator;
-            imageCreator.Begin(AZ::Uuid::CreateRandom());
-            imageCreator.SetImageDescriptor(imageDesc);
-            imageCreator.AddMipChainAsset(*mipChainAsset);
-
-            AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset;
-            imageCreator.End(imageAsset);
+            // image has 4 channels, so the mips are generated from it as is
+            AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset = StreamingImageBuilder::Create(
+                AZStd::span<const std::byte>(image.pixelData.data(), image.pixelData.size()), static_cast<std::uint32_t>(image.width),
+                static_cast<std::uint32_t>(image.height), AZ::RHI::Format::R8G8B8A8_UNORM_SRGB, GetTextureCompressionQuality());
 
             if (imageAsset)
             {
@@ -271,7 +452,7 @@ namespace Cesium
                 GltfModel& model = intrusiveGltfModel->m_model;
                 for (auto& material : model.GetMaterials())
                 {
-                    if (!material.m_material)
+                    if (!material.m_material || !GltfRasterMaterialBuilder::HasRasterLayer(layer, material.m_material))
                     {
                         continue;
                     }
@@ -297,6 +478,7 @@ namespace Cesium
                             layer, rasterOverlay->m_imageAsset, static_cast<std::uint32_t>(overlayTextureCoordinateID), uvTranslateScale,
                             material.m_material->GetAsset());
                         material.m_material = AZ::RPI::Material::FindOrCreate(materialAsset);
+                        material.BindShaderBuffers();
                     }
                 }
 
@@ -336,7 +518,7 @@ namespace Cesium
                 GltfModel& model = intrusiveGltfModel->m_model;
                 for (auto& material : model.GetMaterials())
                 {
-                    if (!material.m_material)
+                    if (!material.m_material || !GltfRasterMaterialBuilder::HasRasterLayer(layer, material.m_material))
                     {
                         continue;
                     }
@@ -379,4 +561,17 @@ namespace Cesium
         rtc.z = array[2].getDoubleOrDefault(0.0);
         return rtc;
     }
+
+    TextureCompressionQuality RenderResourcesPreparer::GetTextureCompressionQuality() const
+    {
+        switch (m_renderConfiguration.m_textureCompression)
+        {
+        case TilesetTextureCompression::Fast:
+            return TextureCompressionQuality::Fast;
+        case TilesetTextureCompression::HighQuality:
+            return TextureCompressionQuality::High;
+        default:
+            return TextureCompressionQuality::None;
+        }
+    }
 } // namespace Cesium
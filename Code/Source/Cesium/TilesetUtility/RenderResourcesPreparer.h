@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Cesium/Gltf/GltfModel.h"
+#include "Cesium/EBus/TilesetComponentBus.h"
+#include "Cesium/Gltf/TextureBlockCompressor.h"
 #include <Atom/RPI.Public/Material/Material.h>
 #include <Atom/RPI.Public/Image/StreamingImage.h>
 #include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
@@ -33,6 +35,10 @@ namespace Cesium3DTilesSelection
 
 namespace Cesium
 {
+    class GeometryHeap;
+
+    class GltfPrimitiveCache;
+
     struct RasterOverlay
     {
         AZ::Data::Instance<AZ::RPI::StreamingImage> m_image;
@@ -43,19 +49,39 @@ namespace Cesium
     {
         IntrusiveGltfModel(GltfModel&& model)
             : m_model{ std::move(model) }
+            , m_geometricError{ 0.0 }
+            , m_isSelected{ false }
         {
         }
 
         GltfModel m_model;
+
+        // geometric error of the tile that owns the model. The smaller it is, the more detailed the tile
+        double m_geometricError;
+
+        // whether the tile is part of the tiles selected for rendering by any view, including the views that are not displayed
+        bool m_isSelected;
         AZ::StableDynamicArrayHandle<IntrusiveGltfModel> m_self;
     };
 
+    struct TileRaycastQuery final
+    {
+        TileRaycastQuery();
+
+        glm::dvec3 m_origin;
+        glm::dvec3 m_direction;
+        double m_maxDistance;
+        bool m_isHit;
+        GltfRaycastHit m_hit;
+    };
+
     class RenderResourcesPreparer
         : public Cesium3DTilesSelection::IPrepareRendererResources
         , public AZ::TickBus::Handler
     {
     public:
-        RenderResourcesPreparer(AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor);
+        RenderResourcesPreparer(
+            AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor, const TilesetRenderConfiguration& renderConfiguration);
 
         ~RenderResourcesPreparer() noexcept;
 
@@ -67,6 +93,22 @@ namespace Cesium
 
         void SetVisible(void* renderResources, bool visible);
 
+        void SetSelected(void* renderResources, bool selected);
+
+        // Focus points of the colliders, in the same space as the transform of the preparer
+        void SetCollisionFocusPoints(const AZStd::vector<glm::dvec3>& focusPoints);
+
+        // Add colliders to the selected tiles around the focus points, and remove them from the other tiles
+        void UpdateCollision();
+
+        // Ray cast the tiles that are rendered in the current frame. The ray is in the same space as the transform of the preparer
+        bool Raycast(const glm::dvec3& origin, const glm::dvec3& direction, double maxDistance, GltfRaycastHit& hit);
+
+        // Ray cast every loaded tile, rendered or not, and keep the hit of the most detailed tile for each query. Queries that are
+        // next to each other in the vector should be close in space, because they are answered in parallel batches that only test
+        // the tiles overlapping the batch
+        void RaycastMostDetailed(AZStd::vector<TileRaycastQuery>& queries);
+
         bool AddRasterLayer(const Cesium3DTilesSelection::RasterOverlay* rasterOverlay);
 
         void RemoveRasterLayer(const Cesium3DTilesSelection::RasterOverlay* rasterOverlay);
@@ -103,11 +145,29 @@ namespace Cesium
     private:
         AZStd::optional<glm::dvec3> GetRTCFromGltf(const CesiumGltf::Model& model);
 
+        TextureCompressionQuality GetTextureCompressionQuality() const;
+
+        static void RaycastMostDetailedBatch(
+            const AZStd::vector<const IntrusiveGltfModel*>& models, TileRaycastQuery* begin, TileRaycastQuery* end);
+
+        static constexpr std::size_t RAYCAST_BATCH_SIZE = 64;
+
+        // Creating static bodies has a cost on the main thread, so it is spread over several frames
+        static constexpr std::uint32_t MAX_COLLISION_MODELS_ENABLED_PER_FRAME = 8;
+
         static constexpr char CESIUM_RTC_CENTER_EXTRA[] = "RTC_CENTER";
 
         AZ::Render::MeshFeatureProcessorInterface* m_meshFeatureProcessor;
+        TilesetRenderConfiguration m_renderConfiguration;
         AZ::StableDynamicArray<IntrusiveGltfModel> m_intrusiveModels;
         glm::dmat4 m_transform;
+        AZStd::vector<glm::dvec3> m_collisionFocusPoints;
+
+        // the vertices and indices of every tile are sub-allocated from the heap instead of getting a buffer per primitive
+        AZStd::shared_ptr<GeometryHeap> m_geometryHeap;
+
+        // tiles that repeat the same geometry, like the buildings of a city, share the models built for the first of them
+        AZStd::shared_ptr<GltfPrimitiveCache> m_primitiveCache;
 
         AZStd::vector<AZ::Data::Instance<AZ::RPI::Material>> m_compileMaterialsQueue;
         AZStd::map<const Cesium3DTilesSelection::RasterOverlay*, std::uint32_t> m_rasterOverlayLayers;
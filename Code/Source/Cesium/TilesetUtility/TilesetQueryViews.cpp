@@ -0,0 +1,75 @@
+#include "Cesium/TilesetUtility/TilesetQueryViews.h"
+#include <Cesium/Math/GeospatialHelper.h>
+#include <AzCore/std/algorithm.h>
+#include <glm/gtc/constants.hpp>
+#include <numeric>
+
+namespace Cesium
+{
+    AZStd::vector<std::uint32_t> TilesetQueryViews::SortAlongMortonCurve(const AZStd::vector<Cartographic>& positions)
+    {
+        auto spreadBits = [](std::uint64_t value)
+        {
+            value &= 0xFFFFFFFFull;
+            value = (value | (value << 16)) & 0x0000FFFF0000FFFFull;
+            value = (value | (value << 8)) & 0x00FF00FF00FF00FFull;
+            value = (value | (value << 4)) & 0x0F0F0F0F0F0F0F0Full;
+            value = (value | (value << 2)) & 0x3333333333333333ull;
+            value = (value | (value << 1)) & 0x5555555555555555ull;
+            return value;
+        };
+
+        // interleave the bits of the longitude and latitude quantized to 32 bits
+        AZStd::vector<std::uint64_t> codes(positions.size());
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            double u = glm::clamp((positions[i].m_longitude + glm::pi<double>()) / glm::two_pi<double>(), 0.0, 1.0);
+            double v = glm::clamp((positions[i].m_latitude + glm::half_pi<double>()) / glm::pi<double>(), 0.0, 1.0);
+            codes[i] = spreadBits(static_cast<std::uint64_t>(u * 4294967295.0)) |
+                (spreadBits(static_cast<std::uint64_t>(v * 4294967295.0)) << 1);
+        }
+
+        AZStd::vector<std::uint32_t> order(positions.size());
+        std::iota(order.begin(), order.end(), 0);
+        AZStd::sort(
+            order.begin(), order.end(),
+            [&codes](std::uint32_t lhs, std::uint32_t rhs)
+            {
+                return codes[lhs] < codes[rhs];
+            });
+        return order;
+    }
+
+    Cesium3DTilesSelection::ViewState TilesetQueryViews::CreateDownwardViewState(
+        const glm::dvec3& ecefPosition, const glm::dmat4& absToTileset)
+    {
+        glm::dmat4 enuToECEF = GeospatialHelper::EastNorthUpToECEF(ecefPosition);
+        glm::dvec3 position = absToTileset * glm::dvec4(ecefPosition, 1.0);
+        glm::dvec3 direction = glm::normalize(glm::dvec3(absToTileset * -enuToECEF[2]));
+        glm::dvec3 up = glm::normalize(glm::dvec3(absToTileset * enuToECEF[1]));
+        return Cesium3DTilesSelection::ViewState::create(
+            position, direction, up, glm::dvec2(DOWNWARD_VIEW_VIEWPORT_SIZE), DOWNWARD_VIEW_FOV, DOWNWARD_VIEW_FOV);
+    }
+
+    bool TilesetQueryViews::IsVisibleFromCameras(
+        const std::vector<Cesium3DTilesSelection::ViewState>& cameraViewStates,
+        bool hasQueryViews,
+        const Cesium3DTilesSelection::BoundingVolume& boundingVolume)
+    {
+        // without query views, every selected tile is selected by a camera
+        if (!hasQueryViews)
+        {
+            return true;
+        }
+
+        for (const Cesium3DTilesSelection::ViewState& viewState : cameraViewStates)
+        {
+            if (viewState.isBoundingVolumeVisible(boundingVolume))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+} // namespace Cesium
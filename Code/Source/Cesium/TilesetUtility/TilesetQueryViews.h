@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Cesium/Math/Cartographic.h>
+#include <AzCore/std/containers/vector.h>
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Cesium
+{
+    // Views that a tileset selects tiles for besides its cameras, so that the tiles under height requests and collision focus
+    // entities are loaded. The tiles that only these views select are loaded without being rendered
+    struct TilesetQueryViews final
+    {
+        // Indices of the positions in the order of the Morton curve of their longitude and latitude, so that positions close to each
+        // other are sampled together
+        static AZStd::vector<std::uint32_t> SortAlongMortonCurve(const AZStd::vector<Cartographic>& positions);
+
+        // View looking straight down at an ECEF position from above it, in the space of the tileset
+        static Cesium3DTilesSelection::ViewState CreateDownwardViewState(const glm::dvec3& ecefPosition, const glm::dmat4& absToTileset);
+
+        // Whether a selected tile is rendered. With query views, only the tiles that a camera sees are
+        static bool IsVisibleFromCameras(
+            const std::vector<Cesium3DTilesSelection::ViewState>& cameraViewStates,
+            bool hasQueryViews,
+            const Cesium3DTilesSelection::BoundingVolume& boundingVolume);
+
+        static constexpr double DOWNWARD_VIEW_FOV = 1.0471975511965976; // 60 degrees
+        static constexpr double DOWNWARD_VIEW_VIEWPORT_SIZE = 512.0;
+    };
+} // namespace Cesium
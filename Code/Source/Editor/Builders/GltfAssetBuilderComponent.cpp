@@ -0,0 +1,59 @@
+#include "Editor/Builders/GltfAssetBuilderComponent.h"
+#include <AssetBuilderSDK/AssetBuilderSDK.h>
+#include <AzCore/Serialization/EditContext.h>
+#include <AzCore/Serialization/SerializeContext.h>
+
+namespace Cesium
+{
+    void GltfAssetBuilderComponent::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<GltfAssetBuilderComponent, AZ::Component>()->Version(0)->Attribute(
+                AZ::Edit::Attributes::SystemComponentTags, AZStd::vector<AZ::Crc32>({ AssetBuilderSDK::ComponentTags::AssetBuilder }));
+        }
+    }
+
+    GltfAssetBuilderComponent::GltfAssetBuilderComponent()
+    {
+    }
+
+    void GltfAssetBuilderComponent::GetProvidedServices(AZ::ComponentDescriptor::DependencyArrayType& provided)
+    {
+        provided.push_back(AZ_CRC_CE("CesiumGltfBuilderService"));
+    }
+
+    void GltfAssetBuilderComponent::GetRequiredServices(AZ::ComponentDescriptor::DependencyArrayType& required)
+    {
+        required.push_back(AZ_CRC_CE("CesiumService"));
+    }
+
+    void GltfAssetBuilderComponent::Activate()
+    {
+        AssetBuilderSDK::AssetBuilderDesc builderDescriptor;
+        builderDescriptor.m_name = GltfAssetBuilderWorker::BUILDER_NAME;
+        builderDescriptor.m_patterns.emplace_back("*.gltf", AssetBuilderSDK::AssetBuilderPattern::PatternType::Wildcard);
+        builderDescriptor.m_patterns.emplace_back("*.glb", AssetBuilderSDK::AssetBuilderPattern::PatternType::Wildcard);
+        builderDescriptor.m_busId = azrtti_typeid<GltfAssetBuilderWorker>();
+        builderDescriptor.m_version = GltfAssetBuilderWorker::BUILDER_VERSION;
+        builderDescriptor.m_createJobFunction =
+            [this](const AssetBuilderSDK::CreateJobsRequest& request, AssetBuilderSDK::CreateJobsResponse& response)
+        {
+            m_worker.CreateJobs(request, response);
+        };
+        builderDescriptor.m_processJobFunction =
+            [this](const AssetBuilderSDK::ProcessJobRequest& request, AssetBuilderSDK::ProcessJobResponse& response)
+        {
+            m_worker.ProcessJob(request, response);
+        };
+
+        m_worker.BusConnect(builderDescriptor.m_busId);
+        AssetBuilderSDK::AssetBuilderBus::Broadcast(
+            &AssetBuilderSDK::AssetBuilderBus::Events::RegisterBuilderInformation, builderDescriptor);
+    }
+
+    void GltfAssetBuilderComponent::Deactivate()
+    {
+        m_worker.BusDisconnect();
+    }
+} // namespace Cesium
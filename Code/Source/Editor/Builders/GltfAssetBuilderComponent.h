@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Editor/Builders/GltfAssetBuilderWorker.h"
+#include <AzCore/Component/Component.h>
+
+namespace Cesium
+{
+    // Register the glTF builder with the Asset Processor. It is only activated in the asset builder application
+    class GltfAssetBuilderComponent final : public AZ::Component
+    {
+    public:
+        AZ_COMPONENT(GltfAssetBuilderComponent, "{3E8B1D54-A27C-4F69-8D03-B5C94E7A2F18}");
+
+        static void Reflect(AZ::ReflectContext* context);
+
+        GltfAssetBuilderComponent();
+
+    private:
+        static void GetProvidedServices(AZ::ComponentDescriptor::DependencyArrayType& provided);
+
+        static void GetRequiredServices(AZ::ComponentDescriptor::DependencyArrayType& required);
+
+        void Activate() override;
+
+        void Deactivate() override;
+
+        GltfAssetBuilderWorker m_worker;
+    };
+} // namespace Cesium
@@ -0,0 +1,316 @@
+#include "Editor/Builders/GltfAssetBuilderWorker.h"
+#include "Cesium/Gltf/GltfBakedModelAsset.h"
+#include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/GltfModelBuilder.h"
+#include "Cesium/Gltf/GltfPBRMaterialBuilder.h"
+#include "Cesium/Systems/CesiumSystem.h"
+#include "Cesium/Systems/CriticalAssetManager.h"
+#include "Cesium/Systems/GenericIOManager.h"
+#include <AssetBuilderSDK/SerializationDependencies.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
+#include <Atom/RPI.Reflect/Image/ImageMipChainAsset.h>
+#include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
+#include <Atom/RPI.Reflect/Material/MaterialAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAsset.h>
+#include <AzCore/StringFunc/StringFunc.h>
+#include <CesiumGltfReader/GltfReader.h>
+#include <glm/glm.hpp>
+
+namespace Cesium
+{
+    GltfAssetBuilderWorker::GltfAssetBuilderWorker()
+        : m_isShuttingDown{ false }
+    {
+    }
+
+    void GltfAssetBuilderWorker::CreateJobs(
+        const AssetBuilderSDK::CreateJobsRequest& request, AssetBuilderSDK::CreateJobsResponse& response) const
+    {
+        if (m_isShuttingDown)
+        {
+            response.m_result = AssetBuilderSDK::CreateJobsResultCode::ShuttingDown;
+            return;
+        }
+
+        for (const AssetBuilderSDK::PlatformInfo& platformInfo : request.m_enabledPlatforms)
+        {
+            AssetBuilderSDK::JobDescriptor jobDescriptor;
+            jobDescriptor.m_jobKey = JOB_KEY;
+            jobDescriptor.SetPlatformIdentifier(platformInfo.m_identifier.c_str());
+            for (const char* materialTypeSource : MATERIAL_TYPE_SOURCES)
+            {
+                jobDescriptor.m_jobDependencyList.emplace_back(
+                    MATERIAL_TYPE_JOB_KEY,
+                    platformInfo.m_identifier,
+                    AssetBuilderSDK::JobDependencyType::Order,
+                    AssetBuilderSDK::SourceFileDependency(materialTypeSource, AZ::Uuid::CreateNull()));
+            }
+
+            response.m_createJobOutputs.push_back(jobDescriptor);
+        }
+
+        AddExternalResourceDependencies(request, response);
+        response.m_result = AssetBuilderSDK::CreateJobsResultCode::Success;
+    }
+
+    void GltfAssetBuilderWorker::ProcessJob(
+        const AssetBuilderSDK::ProcessJobRequest& request, AssetBuilderSDK::ProcessJobResponse& response) const
+    {
+        AssetBuilderSDK::JobCancelListener jobCancelListener(request.m_jobId);
+        if (m_isShuttingDown || jobCancelListener.IsCancelled())
+        {
+            response.m_resultCode = AssetBuilderSDK::ProcessJobResult_Cancelled;
+            return;
+        }
+
+        CesiumSystem* cesiumSystem = CesiumInterface::Get();
+        if (!cesiumSystem || !cesiumSystem->GetCriticalAssetManager().m_standardPbrMaterialType.IsReady())
+        {
+            AZ_Error(
+                "GltfAssetBuilder", false, "The Cesium material types are not loaded, so %s cannot be baked", request.m_sourceFile.c_str());
+            response.m_resultCode = AssetBuilderSDK::ProcessJobResult_Failed;
+            return;
+        }
+
+        // The IDs of the generated assets follow the order in which they are created, and the synchronous build creates them
+        // in the same order every time
+        GltfLoadModel loadModel;
+        {
+            StableAssetIdScope assetIdScope(request.m_sourceFileUUID, FIRST_GENERATED_SUB_ID);
+            GltfModelBuilder builder(AZStd::make_unique<GltfPBRMaterialBuilder>());
+            GltfModelBuilderOption option{ glm::dmat4(1.0) };
+            builder.Create(cesiumSystem->GetIOManager(IOKind::LocalFile), request.m_fullPath, option, loadModel);
+        }
+
+        if (loadModel.m_meshes.empty())
+        {
+            AZ_Error("GltfAssetBuilder", false, "Failed to read the glTF file %s", request.m_fullPath.c_str());
+            response.m_resultCode = AssetBuilderSDK::ProcessJobResult_Failed;
+            return;
+        }
+
+        ProductContext context;
+        context.m_request = &request;
+        context.m_response = &response;
+        AZ::StringFunc::Path::GetFullFileName(request.m_sourceFile.c_str(), context.m_sourceName);
+
+        GltfBakedModelAsset bakedModel;
+        bakedModel.SetLoadModel(loadModel);
+        if (!OutputModels(loadModel, context) || !OutputMaterials(loadModel, context) ||
+            !OutputProduct(bakedModel, BAKED_MODEL_SUB_ID, GltfBakedModelAsset::EXTENSION, context))
+        {
+            response.m_resultCode = AssetBuilderSDK::ProcessJobResult_Failed;
+            return;
+        }
+
+        response.m_resultCode = AssetBuilderSDK::ProcessJobResult_Success;
+    }
+
+    void GltfAssetBuilderWorker::ShutDown()
+    {
+        m_isShuttingDown = true;
+    }
+
+    void GltfAssetBuilderWorker::AddExternalResourceDependencies(
+        const AssetBuilderSDK::CreateJobsRequest& request, AssetBuilderSDK::CreateJobsResponse& response)
+    {
+        CesiumSystem* cesiumSystem = CesiumInterface::Get();
+        if (!cesiumSystem)
+        {
+            return;
+        }
+
+        AZStd::string sourcePath;
+        AZ::StringFunc::Path::Join(request.m_watchFolder.c_str(), request.m_sourceFile.c_str(), sourcePath);
+        GenericIOManager& io = cesiumSystem->GetIOManager(IOKind::LocalFile);
+        IOContent content = io.GetFileContent({ "", sourcePath });
+        CesiumGltfReader::GltfReader reader;
+        CesiumGltfReader::GltfReaderResult load = reader.readModel(gsl::span<const std::byte>(content.data(), content.size()));
+        if (!load.model)
+        {
+            return;
+        }
+
+        // embedded data URIs are decoded and cleared by the reader, so the URIs that are left point to files next to the model
+        AZStd::string parentPath = io.GetParentPath(sourcePath);
+        auto addDependency = [&parentPath, &response](const std::optional<std::string>& uri)
+        {
+            if (!uri || uri->rfind("data:", 0) == 0)
+            {
+                return;
+            }
+
+            AZStd::string path;
+            AZ::StringFunc::Path::Join(parentPath.c_str(), uri->c_str(), path);
+            response.m_sourceFileDependencyList.emplace_back(path, AZ::Uuid::CreateNull());
+        };
+
+        for (const CesiumGltf::Buffer& buffer : load.model->buffers)
+        {
+            addDependency(buffer.uri);
+        }
+
+        for (const CesiumGltf::Image& image : load.model->images)
+        {
+            addDependency(image.uri);
+        }
+    }
+
+    bool GltfAssetBuilderWorker::OutputModels(const GltfLoadModel& loadModel, ProductContext& context)
+    {
+        auto outputBuffer = [&context](const AZ::Data::Asset<AZ::RPI::BufferAsset>& bufferAsset)
+        {
+            if (!bufferAsset.IsReady() || !IsNewProduct(bufferAsset.GetId(), context))
+            {
+                return true;
+            }
+
+            return OutputProduct(*bufferAsset.Get(), bufferAsset.GetId().m_subId, "azbuffer", context);
+        };
+
+        // the assets are written before the assets that reference them
+        for (const GltfLoadMesh& mesh : loadModel.m_meshes)
+        {
+            for (const GltfLoadPrimitive& primitive : mesh.m_primitives)
+            {
+                const AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset = primitive.m_modelAsset;
+                if (!modelAsset.IsReady() || !IsNewProduct(modelAsset.GetId(), context))
+                {
+                    continue;
+                }
+
+                for (const AZ::Data::Asset<AZ::RPI::ModelLodAsset>& lodAsset : modelAsset->GetLodAssets())
+                {
+                    if (!lodAsset.IsReady() || !IsNewProduct(lodAsset.GetId(), context))
+                    {
+                        continue;
+                    }
+
+                    for (const AZ::RPI::ModelLodAsset::Mesh& lodMesh : lodAsset->GetMeshes())
+                    {
+                        if (!outputBuffer(lodMesh.GetIndexBufferAssetView().GetBufferAsset()))
+                        {
+                            return false;
+                        }
+
+                        for (const AZ::RPI::ModelLodAsset::Mesh::StreamBufferInfo& streamBufferInfo : lodMesh.GetStreamBufferInfoList())
+                        {
+                            if (!outputBuffer(streamBufferInfo.m_bufferAssetView.GetBufferAsset()))
+                            {
+                                return false;
+                            }
+                        }
+                    }
+
+                    if (!OutputProduct(*lodAsset.Get(), lodAsset.GetId().m_subId, "azlod", context))
+                    {
+                        return false;
+                    }
+                }
+
+                if (!OutputProduct(*modelAsset.Get(), modelAsset.GetId().m_subId, "azmodel", context))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool GltfAssetBuilderWorker::OutputMaterials(const GltfLoadModel& loadModel, ProductContext& context)
+    {
+        for (const GltfLoadMaterial& material : loadModel.m_materials)
+        {
+            const AZ::Data::Asset<AZ::RPI::MaterialAsset>& materialAsset = material.m_materialAsset;
+            if (!materialAsset.IsReady() || !IsNewProduct(materialAsset.GetId(), context))
+            {
+                continue;
+            }
+
+            for (const GltfShaderBuffer& shaderBuffer : material.m_shaderBuffers)
+            {
+                const AZ::Data::Asset<AZ::RPI::BufferAsset>& bufferAsset = shaderBuffer.m_bufferAsset;
+                if (bufferAsset.IsReady() && IsNewProduct(bufferAsset.GetId(), context) &&
+                    !OutputProduct(*bufferAsset.Get(), bufferAsset.GetId().m_subId, "azbuffer", context))
+                {
+                    return false;
+                }
+            }
+
+            for (const AZ::RPI::MaterialPropertyValue& propertyValue : materialAsset->GetPropertyValues())
+            {
+                if (!propertyValue.Is<AZ::Data::Asset<AZ::RPI::ImageAsset>>())
+                {
+                    continue;
+                }
+
+                const AZ::Data::Asset<AZ::RPI::ImageAsset>& imageAsset = propertyValue.GetValue<AZ::Data::Asset<AZ::RPI::ImageAsset>>();
+                const AZ::RPI::StreamingImageAsset* streamingImage = azrtti_cast<const AZ::RPI::StreamingImageAsset*>(imageAsset.Get());
+                if (!streamingImage || !IsNewProduct(imageAsset.GetId(), context))
+                {
+                    continue;
+                }
+
+                // the tail mip chain is stored in the image itself, the others are separate products
+                for (std::size_t mipLevel = 0; mipLevel < streamingImage->GetImageDescriptor().m_mipLevels; ++mipLevel)
+                {
+                    const AZ::Data::Asset<AZ::RPI::ImageMipChainAsset>& mipChainAsset =
+                        streamingImage->GetMipChainAsset(streamingImage->GetMipChainIndex(mipLevel));
+                    if (!mipChainAsset.IsReady() || !IsNewProduct(mipChainAsset.GetId(), context))
+                    {
+                        continue;
+                    }
+
+                    if (!OutputProduct(*mipChainAsset.Get(), mipChainAsset.GetId().m_subId, "imagemipchain", context))
+                    {
+                        return false;
+                    }
+                }
+
+                if (!OutputProduct(*streamingImage, imageAsset.GetId().m_subId, "streamingimage", context))
+                {
+                    return false;
+                }
+            }
+
+            if (!OutputProduct(*materialAsset.Get(), materialAsset.GetId().m_subId, "azmaterial", context))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool GltfAssetBuilderWorker::IsNewProduct(const AZ::Data::AssetId& assetId, ProductContext& context)
+    {
+        return assetId.m_guid == context.m_request->m_sourceFileUUID && context.m_writtenAssets.insert(assetId).second;
+    }
+
+    template<typename AssetDataType>
+    bool GltfAssetBuilderWorker::OutputProduct(
+        const AssetDataType& assetData, AZ::u32 subId, const char* extension, ProductContext& context)
+    {
+        AZStd::string productFileName = AZStd::string::format("%s_%08x.%s", context.m_sourceName.c_str(), subId, extension);
+        if (subId == BAKED_MODEL_SUB_ID)
+        {
+            // the runtime finds the baked model from the path of its source
+            productFileName = GltfBakedModelAsset::GetProductPath(context.m_sourceName);
+        }
+
+        AZStd::string productPath;
+        AZ::StringFunc::Path::Join(context.m_request->m_tempDirPath.c_str(), productFileName.c_str(), productPath);
+
+        AssetBuilderSDK::JobProduct jobProduct;
+        if (!AssetBuilderSDK::OutputObject(&assetData, productPath, azrtti_typeid<AssetDataType>(), subId, jobProduct))
+        {
+            AZ_Error("GltfAssetBuilder", false, "Failed to write the product %s", productPath.c_str());
+            return false;
+        }
+
+        context.m_response->m_outputProducts.push_back(AZStd::move(jobProduct));
+        return true;
+    }
+} // namespace Cesium
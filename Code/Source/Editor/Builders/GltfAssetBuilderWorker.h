@@ -0,0 +1,69 @@
+#pragma once
+
+#include <AssetBuilderSDK/AssetBuilderBusses.h>
+#include <AssetBuilderSDK/AssetBuilderSDK.h>
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/string/string.h>
+#include <atomic>
+
+namespace Cesium
+{
+    struct GltfLoadModel;
+
+    // Bake glTF files into native Atom products: buffers, model LODs, models, images and materials, along with a
+    // GltfBakedModelAsset that lists them. Products get stable IDs derived from the source, so references to them survive rebuilds
+    class GltfAssetBuilderWorker final : public AssetBuilderSDK::AssetBuilderCommandBus::Handler
+    {
+    public:
+        AZ_RTTI(GltfAssetBuilderWorker, "{9A4C7E21-5D3B-4F86-B1E0-7C2A8D5F3E96}");
+
+        static constexpr const char* const BUILDER_NAME = "Cesium glTF Builder";
+        static constexpr const char* const JOB_KEY = "Cesium glTF";
+
+        // the products are rebuilt when the version changes
+        static constexpr int BUILDER_VERSION = 1;
+
+        GltfAssetBuilderWorker();
+
+        void CreateJobs(const AssetBuilderSDK::CreateJobsRequest& request, AssetBuilderSDK::CreateJobsResponse& response) const;
+
+        void ProcessJob(const AssetBuilderSDK::ProcessJobRequest& request, AssetBuilderSDK::ProcessJobResponse& response) const;
+
+        void ShutDown() override;
+
+    private:
+        struct ProductContext final
+        {
+            const AssetBuilderSDK::ProcessJobRequest* m_request;
+            AssetBuilderSDK::ProcessJobResponse* m_response;
+            AZStd::string m_sourceName;
+            AZStd::unordered_set<AZ::Data::AssetId> m_writtenAssets;
+        };
+
+        static void AddExternalResourceDependencies(
+            const AssetBuilderSDK::CreateJobsRequest& request, AssetBuilderSDK::CreateJobsResponse& response);
+
+        static bool OutputModels(const GltfLoadModel& loadModel, ProductContext& context);
+
+        static bool OutputMaterials(const GltfLoadModel& loadModel, ProductContext& context);
+
+        // Only the assets generated from the source are written, and each of them once
+        static bool IsNewProduct(const AZ::Data::AssetId& assetId, ProductContext& context);
+
+        template<typename AssetDataType>
+        static bool OutputProduct(const AssetDataType& assetData, AZ::u32 subId, const char* extension, ProductContext& context);
+
+        // Sub IDs of the products start with "CE", so that they don't collide with the products of other builders of glTF files
+        static constexpr AZ::u32 BAKED_MODEL_SUB_ID = 0x43450000;
+        static constexpr AZ::u32 FIRST_GENERATED_SUB_ID = BAKED_MODEL_SUB_ID + 1;
+
+        // the materials are created from these material types, so the types are built first
+        static constexpr const char* const MATERIAL_TYPE_JOB_KEY = "Atom Material Builder";
+        static constexpr const char* const MATERIAL_TYPE_SOURCES[] = { "Materials/Types/StandardPBR.materialtype",
+                                                                      "Materials/Types/GltfPointCloud.materialtype",
+                                                                      "Materials/Types/GltfLine.materialtype" };
+
+        std::atomic_bool m_isShuttingDown;
+    };
+} // namespace Cesium
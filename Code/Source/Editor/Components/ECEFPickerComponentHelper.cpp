@@ -14,6 +14,12 @@
 
 namespace Cesium
 {
+    namespace
+    {
+        // far enough to reach any tile of the globe from a camera in orbit, and small enough to be narrowed to a float
+        constexpr double CAMERA_RAYCAST_DISTANCE = 1.0e9;
+    } // namespace
+
     void ECEFPickerComponentHelper::DegreeCartographic::Reflect(AZ::ReflectContext* context)
     {
         if (AZ::SerializeContext* serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
@@ -67,6 +73,7 @@ namespace Cesium
                 ->Version(0)
                 ->Field("SampleOriginMethod", &ECEFPickerComponentHelper::m_samplePositionMethod)
                 ->Field("SampledEntityId", &ECEFPickerComponentHelper::m_sampledEntityId)
+                ->Field("RaycastTilesetEntityId", &ECEFPickerComponentHelper::m_raycastTilesetEntityId)
                 ->Field("PositionType", &ECEFPickerComponentHelper::m_positionType)
                 ->Field("Position", &ECEFPickerComponentHelper::m_position)
                 ->Field("Cartographic", &ECEFPickerComponentHelper::m_cartographic);
@@ -96,6 +103,7 @@ namespace Cesium
                     ->DataElement(AZ::Edit::UIHandlers::ComboBox, &ECEFPickerComponentHelper::m_samplePositionMethod, "Sample Method", "")
                     ->EnumAttribute(SamplePositionMethod::EntityCoordinate, "Entity ECEF Coordinate")
                     ->EnumAttribute(SamplePositionMethod::CameraPosition, "Camera ECEF Coordinate")
+                    ->EnumAttribute(SamplePositionMethod::CameraRaycast, "Tileset Under Camera")
                     ->Attribute(AZ::Edit::Attributes::ChangeNotify, AZ::Edit::PropertyRefreshLevels::EntireTree)
                     ->DataElement(
                         AZ::Edit::UIHandlers::Default, &ECEFPickerComponentHelper::m_sampledEntityId, "Sample Entity ECEF Coordinate", "")
@@ -104,7 +112,15 @@ namespace Cesium
                     ->UIElement(AZ::Edit::UIHandlers::Button, "Sample Camera ECEF Coordinate", "")
                     ->Attribute(AZ::Edit::Attributes::ButtonText, "Sample Camera ECEF Coordinate")
                     ->Attribute(AZ::Edit::Attributes::Visibility, &ECEFPickerComponentHelper::UseCameraPositionSampleMethod)
-                    ->Attribute(AZ::Edit::Attributes::ChangeNotify, &ECEFPickerComponentHelper::SamplePositionOfCamera);
+                    ->Attribute(AZ::Edit::Attributes::ChangeNotify, &ECEFPickerComponentHelper::SamplePositionOfCamera)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &ECEFPickerComponentHelper::m_raycastTilesetEntityId, "Raycast Tileset",
+                        "Tileset that is hit by the ray from the camera")
+                    ->Attribute(AZ::Edit::Attributes::Visibility, &ECEFPickerComponentHelper::UseCameraRaycastSampleMethod)
+                    ->UIElement(AZ::Edit::UIHandlers::Button, "Sample Tileset Under Camera", "")
+                    ->Attribute(AZ::Edit::Attributes::ButtonText, "Sample Tileset Under Camera")
+                    ->Attribute(AZ::Edit::Attributes::Visibility, &ECEFPickerComponentHelper::UseCameraRaycastSampleMethod)
+                    ->Attribute(AZ::Edit::Attributes::ChangeNotify, &ECEFPickerComponentHelper::SamplePositionOfCameraRaycast);
             }
         }
     }
@@ -137,6 +153,11 @@ namespace Cesium
         return m_samplePositionMethod == SamplePositionMethod::CameraPosition;
     }
 
+    bool ECEFPickerComponentHelper::UseCameraRaycastSampleMethod() const
+    {
+        return m_samplePositionMethod == SamplePositionMethod::CameraRaycast;
+    }
+
     bool ECEFPickerComponentHelper::UsePositionAsCartesian() const
     {
         return m_positionType == PositionType::Cartesian;
@@ -174,6 +195,34 @@ namespace Cesium
         return AZ::Edit::PropertyRefreshLevels::ValuesOnly;
     }
 
+    AZ::u32 ECEFPickerComponentHelper::SamplePositionOfCameraRaycast()
+    {
+        auto viewportContextManager = AZ::Interface<AZ::RPI::ViewportContextRequestsInterface>::Get();
+        auto defaultViewportContext = viewportContextManager->GetDefaultViewportContext();
+        if (defaultViewportContext)
+        {
+            // cast a ray along the view direction of the camera against the tiles that are currently rendered
+            glm::dmat4 relToAbsWorld{ 1.0 };
+            OriginShiftRequestBus::BroadcastResult(relToAbsWorld, &OriginShiftRequestBus::Events::GetRelToAbsWorld);
+            AZ::Transform cameraTransform = defaultViewportContext->GetCameraTransform();
+            AZ::Vector3 cameraPosition = cameraTransform.GetTranslation();
+            AZ::Vector3 cameraForward = cameraTransform.GetBasisY();
+            glm::dvec3 origin = relToAbsWorld * glm::dvec4(cameraPosition.GetX(), cameraPosition.GetY(), cameraPosition.GetZ(), 1.0);
+            glm::dvec3 direction = relToAbsWorld * glm::dvec4(cameraForward.GetX(), cameraForward.GetY(), cameraForward.GetZ(), 0.0);
+
+            TilesetRaycastResult result;
+            TilesetRequestBus::EventResult(
+                result, m_raycastTilesetEntityId, &TilesetRequestBus::Events::RaycastInECEF, origin, direction, CAMERA_RAYCAST_DISTANCE);
+            if (result.m_hit)
+            {
+                m_position = result.m_position;
+                OnPositionAsCartesianChanged();
+            }
+        }
+
+        return AZ::Edit::PropertyRefreshLevels::ValuesOnly;
+    }
+
     AZ::u32 ECEFPickerComponentHelper::OnPositionAsCartesianChanged()
     {
         auto maybeCartographic = GeospatialHelper::ECEFCartesianToCartographic(m_position);
@@ -22,7 +22,8 @@ namespace Cesium
         enum class SamplePositionMethod
         {
             EntityCoordinate,
-            CameraPosition
+            CameraPosition,
+            CameraRaycast
         };
 
         struct DegreeCartographic final
@@ -60,6 +61,8 @@ namespace Cesium
 
         AZ::u32 SamplePositionOfCamera();
 
+        AZ::u32 SamplePositionOfCameraRaycast();
+
         AZ::u32 OnPositionAsCartesianChanged();
 
         AZ::u32 OnPositionAsCartographicChanged();
@@ -68,6 +71,8 @@ namespace Cesium
 
         bool UseCameraPositionSampleMethod() const;
 
+        bool UseCameraRaycastSampleMethod() const;
+
         bool UsePositionAsCartesian() const;
 
         bool UsePositionAsCartographic() const;
@@ -75,6 +80,7 @@ namespace Cesium
         SamplePositionMethod m_samplePositionMethod;
         PositionType m_positionType;
         AZ::EntityId m_sampledEntityId;
+        AZ::EntityId m_raycastTilesetEntityId;
         glm::dvec3 m_position{ 0.0 };
         DegreeCartographic m_cartographic{ 0.0, 0.0, 0.0 };
     };
@@ -105,7 +105,58 @@ namespace Cesium
                     ->Attribute(AZ::Edit::Attributes::AutoExpand, true)
                     ->DataElement(
                         AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_generateMissingNormalAsSmooth,
-                        "Generate Missing Normal As Smooth", "");
+                        "Generate Missing Normal As Smooth", "")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_mergeMeshPrimitives, "Merge Mesh Primitives",
+                        "Merge primitives of a tile that share the same material to reduce draw calls")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_optimizeMeshVertexOrder,
+                        "Optimize Mesh Vertex Order", "Reorder triangles and vertices of tiles for the GPU vertex cache and overdraw")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_meshClusterTriangleCount,
+                        "Mesh Cluster Triangle Count",
+                        "Split primitives with more triangles than this into clusters that are culled on their own. Zero disables it")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0u)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::ComboBox, &TilesetRenderConfiguration::m_textureCompression, "Texture Compression",
+                        "Block compress the textures of tiles and raster overlays to reduce GPU memory. High quality is slower to encode")
+                    ->EnumAttribute(TilesetTextureCompression::None, "None")
+                    ->EnumAttribute(TilesetTextureCompression::Fast, "Fast")
+                    ->EnumAttribute(TilesetTextureCompression::HighQuality, "High Quality")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_pointCloudAttenuation, "Point Cloud Attenuation",
+                        "Size the points of point clouds from the spacing between them, so that coarse tiles don't show holes")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_pointCloudPointSize, "Point Cloud Point Size",
+                        "Diameter of the points in meters when attenuation is disabled")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_pointCloudSpacingScale,
+                        "Point Cloud Spacing Scale", "Scale applied to the spacing of the points when attenuation is enabled")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_pointCloudMaximumPointSize,
+                        "Point Cloud Maximum Point Size", "Maximum diameter of the points in meters when attenuation is enabled")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_lineWidth, "Line Width",
+                        "Width in meters of the lines of vector data in tiles")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_enableRaycast, "Enable Raycast",
+                        "Build a bounding volume hierarchy for each tile, so that the tileset can be ray casted for picking")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_enableCollision, "Enable Collision",
+                        "Cook a collision mesh for each tile, and add colliders to the tiles around the collision focus entities")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_collisionSimplificationError,
+                        "Collision Simplification Error", "Error allowed when simplifying collision meshes, relative to the size of a tile")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                    ->Attribute(AZ::Edit::Attributes::Max, 1.0f)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_collisionFocusRadius, "Collision Focus Radius",
+                        "Distance in meters from the collision focus entities within which tiles get colliders")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0f);
             }
         }
     }
@@ -8,6 +8,7 @@
 #include "Editor/Components/TilesetCreditEditorComponent.h"
 #include "Editor/Components/GeoreferenceAnchorEditorComponent.h"
 #include "Editor/Components/OriginShiftEditorComponent.h"
+#include "Editor/Builders/GltfAssetBuilderComponent.h"
 #include "Cesium/Modules/CesiumModuleInterface.h"
 
 namespace Cesium
@@ -30,7 +31,7 @@ namespace Cesium
                   OriginShiftEditorComponent::CreateDescriptor(), GeoreferenceAnchorEditorComponent::CreateDescriptor(),
                   TilesetEditorComponent::CreateDescriptor(), GeoReferenceCameraControllerEditor::CreateDescriptor(),
                   BingRasterOverlayEditorComponent::CreateDescriptor(), CesiumIonRasterOverlayEditorComponent::CreateDescriptor(),
-                  TMSRasterOverlayEditorComponent::CreateDescriptor() });
+                  TMSRasterOverlayEditorComponent::CreateDescriptor(), GltfAssetBuilderComponent::CreateDescriptor() });
         }
 
         /**
@@ -41,6 +42,7 @@ namespace Cesium
         {
             auto componentList = CesiumModuleInterface::GetRequiredSystemComponents();
             componentList.emplace_back(azrtti_typeid<CesiumSystemEditorComponent>());
+            componentList.emplace_back(azrtti_typeid<GltfAssetBuilderComponent>());
             return componentList;
         }
     };
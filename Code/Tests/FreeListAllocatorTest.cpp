@@ -0,0 +1,130 @@
+#include "Cesium/Gltf/FreeListAllocator.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/algorithm.h>
+
+class FreeListAllocatorTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(FreeListAllocatorTest, AllocationsAreAlignedAndFirstFit)
+{
+    Cesium::FreeListAllocator allocator(480, 48);
+
+    std::size_t first = 1;
+    std::size_t second = 1;
+    ASSERT_TRUE(allocator.Allocate(10, first));
+    ASSERT_TRUE(allocator.Allocate(50, second));
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(second, 48);
+    EXPECT_EQ(allocator.GetUsedSize(), 144);
+
+    // the freed range at the start is the first one large enough
+    allocator.Free(first, 10);
+    std::size_t third = 1;
+    ASSERT_TRUE(allocator.Allocate(48, third));
+    EXPECT_EQ(third, 0);
+}
+
+TEST_F(FreeListAllocatorTest, FreedRangesAreMergedWithTheirNeighbours)
+{
+    Cesium::FreeListAllocator allocator(480, 48);
+
+    std::size_t offsets[4];
+    for (std::size_t& offset : offsets)
+    {
+        ASSERT_TRUE(allocator.Allocate(96, offset));
+    }
+
+    // free the ranges out of order, so both the previous and the next ranges are merged
+    allocator.Free(offsets[0], 96);
+    allocator.Free(offsets[2], 96);
+    EXPECT_EQ(allocator.GetFreeRangeCount(), 3);
+    allocator.Free(offsets[1], 96);
+    EXPECT_EQ(allocator.GetFreeRangeCount(), 2);
+    EXPECT_EQ(allocator.GetLargestFreeRange(), 288);
+    allocator.Free(offsets[3], 96);
+
+    EXPECT_TRUE(allocator.IsEmpty());
+    EXPECT_EQ(allocator.GetFreeRangeCount(), 1);
+    EXPECT_EQ(allocator.GetLargestFreeRange(), 480);
+}
+
+TEST_F(FreeListAllocatorTest, AllocationFailsWhenNoRangeIsLargeEnough)
+{
+    Cesium::FreeListAllocator allocator(480, 48);
+
+    std::size_t offsets[5];
+    for (std::size_t& offset : offsets)
+    {
+        ASSERT_TRUE(allocator.Allocate(96, offset));
+    }
+
+    std::size_t offset = 0;
+    EXPECT_FALSE(allocator.Allocate(1, offset));
+
+    // two free ranges of 96 bytes can't hold 144 bytes, because they are not next to each other
+    allocator.Free(offsets[1], 96);
+    allocator.Free(offsets[3], 96);
+    EXPECT_FALSE(allocator.Allocate(144, offset));
+    EXPECT_TRUE(allocator.Allocate(96, offset));
+    EXPECT_EQ(offset, offsets[1]);
+}
+
+TEST_F(FreeListAllocatorTest, EveryAllocationIsAlignedToTheAlignment)
+{
+    // the capacity is rounded down to the alignment too
+    Cesium::FreeListAllocator allocator(1000, 48);
+    EXPECT_EQ(allocator.GetCapacity(), 960);
+
+    const std::size_t sizes[] = { 1, 47, 48, 49, 95, 100, 12, 0 };
+    std::size_t expectedOffset = 0;
+    for (std::size_t size : sizes)
+    {
+        std::size_t offset = 1;
+        ASSERT_TRUE(allocator.Allocate(size, offset));
+        EXPECT_EQ(offset % 48, 0);
+        EXPECT_EQ(offset, expectedOffset);
+        expectedOffset += (AZStd::max(size, std::size_t{ 1 }) + 47) / 48 * 48;
+    }
+
+    EXPECT_EQ(allocator.GetUsedSize(), expectedOffset);
+}
+
+TEST_F(FreeListAllocatorTest, DeferredFreesAreOnlyReusedAfterTheirFrame)
+{
+    // GeometryHeap defers the frees of frame N until NextFrame reaches N + FRAME_LATENCY, and releases up to N then
+    Cesium::FreeListAllocator allocator(480, 48);
+
+    std::size_t offsets[5];
+    for (std::size_t& offset : offsets)
+    {
+        ASSERT_TRUE(allocator.Allocate(96, offset));
+    }
+
+    allocator.FreeDeferred(offsets[0], 96, 1);
+    allocator.FreeDeferred(offsets[1], 96, 2);
+    allocator.FreeDeferred(offsets[3], 96, 4);
+
+    // a deferred range is still used, so it can't be allocated again
+    std::size_t offset = 0;
+    EXPECT_EQ(allocator.GetUsedSize(), 480);
+    EXPECT_FALSE(allocator.Allocate(96, offset));
+
+    allocator.ReleaseDeferredFrees(0);
+    EXPECT_EQ(allocator.GetUsedSize(), 480);
+
+    // releasing frame 2 frees the ranges of frames 1 and 2, which are merged, and keeps the one of frame 4
+    allocator.ReleaseDeferredFrees(2);
+    EXPECT_EQ(allocator.GetUsedSize(), 288);
+    EXPECT_EQ(allocator.GetFreeRangeCount(), 1);
+    EXPECT_EQ(allocator.GetLargestFreeRange(), 192);
+
+    allocator.ReleaseDeferredFrees(3);
+    EXPECT_EQ(allocator.GetUsedSize(), 288);
+
+    allocator.ReleaseDeferredFrees(4);
+    EXPECT_EQ(allocator.GetUsedSize(), 192);
+    EXPECT_EQ(allocator.GetFreeRangeCount(), 2);
+    ASSERT_TRUE(allocator.Allocate(192, offset));
+    EXPECT_EQ(offset, offsets[0]);
+}
@@ -0,0 +1,130 @@
+#include "Cesium/Gltf/GltfAccessorGather.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <cstring>
+
+// Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
+// This only happens with unity build
+#include <AzCore/PlatformDef.h>
+#ifdef AZ_COMPILER_MSVC
+#pragma push_macro("OPAQUE")
+#undef OPAQUE
+#endif
+
+#include <CesiumGltf/Model.h>
+
+#ifdef AZ_COMPILER_MSVC
+#pragma pop_macro("OPAQUE")
+#endif
+
+namespace
+{
+    template<typename ElementType>
+    std::int32_t AppendAccessor(
+        CesiumGltf::Model& model,
+        const AZStd::vector<ElementType>& elements,
+        std::int32_t componentType,
+        const std::string& type,
+        bool normalized = false)
+    {
+        if (model.buffers.empty())
+        {
+            model.buffers.emplace_back();
+        }
+
+        // keep every buffer view aligned to 4 bytes, as glTF requires for vertex attributes
+        std::vector<std::byte>& data = model.buffers.front().cesium.data;
+        std::size_t byteOffset = (data.size() + 3) / 4 * 4;
+        std::size_t byteLength = elements.size() * sizeof(ElementType);
+        data.resize(byteOffset + byteLength);
+        std::memcpy(data.data() + byteOffset, elements.data(), byteLength);
+        model.buffers.front().byteLength = static_cast<std::int64_t>(data.size());
+
+        CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+        bufferView.buffer = 0;
+        bufferView.byteOffset = static_cast<std::int64_t>(byteOffset);
+        bufferView.byteLength = static_cast<std::int64_t>(byteLength);
+
+        CesiumGltf::Accessor& accessor = model.accessors.emplace_back();
+        accessor.bufferView = static_cast<std::int32_t>(model.bufferViews.size() - 1);
+        accessor.componentType = componentType;
+        accessor.type = type;
+        accessor.normalized = normalized;
+        accessor.count = static_cast<std::int64_t>(elements.size());
+        return static_cast<std::int32_t>(model.accessors.size() - 1);
+    }
+} // namespace
+
+class GltfAccessorGatherTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(GltfAccessorGatherTest, NormalizedPositionsAreConvertedToFloat)
+{
+    CesiumGltf::Model model;
+    AZStd::vector<glm::u16vec3> quantized{ glm::u16vec3(0, 32768, 65535) };
+    std::int32_t accessor = AppendAccessor(
+        model, quantized, CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT, CesiumGltf::AccessorSpec::Type::VEC3, true);
+
+    AZStd::vector<glm::vec3> positions;
+    ASSERT_TRUE(Cesium::GltfAccessorGather::GatherPositions(model, model.accessors[accessor], positions));
+    ASSERT_EQ(positions.size(), 1);
+    EXPECT_FLOAT_EQ(positions[0].x, 0.0f);
+    EXPECT_NEAR(positions[0].y, 0.5f, 1e-4f);
+    EXPECT_FLOAT_EQ(positions[0].z, 1.0f);
+}
+
+TEST_F(GltfAccessorGatherTest, ColorsWithoutAlphaAreOpaque)
+{
+    CesiumGltf::Model model;
+    AZStd::vector<glm::vec3> floatColors{ glm::vec3(1.0f, 0.0f, 0.5f) };
+    std::int32_t accessor =
+        AppendAccessor(model, floatColors, CesiumGltf::AccessorSpec::ComponentType::FLOAT, CesiumGltf::AccessorSpec::Type::VEC3);
+
+    AZStd::vector<glm::u8vec4> colors;
+    ASSERT_TRUE(Cesium::GltfAccessorGather::GatherColors(model, model.accessors[accessor], colors));
+    ASSERT_EQ(colors.size(), 1);
+    EXPECT_EQ(colors[0].r, 255);
+    EXPECT_EQ(colors[0].g, 0);
+    EXPECT_EQ(colors[0].b, 128);
+    EXPECT_EQ(colors[0].a, 255);
+}
+
+TEST_F(GltfAccessorGatherTest, LineStripAndLoopAreConvertedToSegments)
+{
+    CesiumGltf::Model model;
+    CesiumGltf::MeshPrimitive primitive;
+    primitive.mode = CesiumGltf::MeshPrimitive::Mode::LINE_STRIP;
+
+    AZStd::vector<std::uint32_t> segments;
+    ASSERT_TRUE(Cesium::GltfAccessorGather::GatherLineSegments(model, primitive, 3, segments));
+    EXPECT_EQ(segments, AZStd::vector<std::uint32_t>({ 0, 1, 1, 2 }));
+
+    primitive.mode = CesiumGltf::MeshPrimitive::Mode::LINE_LOOP;
+    ASSERT_TRUE(Cesium::GltfAccessorGather::GatherLineSegments(model, primitive, 3, segments));
+    EXPECT_EQ(segments, AZStd::vector<std::uint32_t>({ 0, 1, 1, 2, 2, 0 }));
+}
+
+TEST_F(GltfAccessorGatherTest, LineSegmentsWithOutOfRangeIndicesAreDropped)
+{
+    CesiumGltf::Model model;
+    AZStd::vector<std::uint16_t> indices{ 0, 1, 2, 7, 3, 2 };
+    CesiumGltf::MeshPrimitive primitive;
+    primitive.mode = CesiumGltf::MeshPrimitive::Mode::LINES;
+    primitive.indices =
+        AppendAccessor(model, indices, CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT, CesiumGltf::AccessorSpec::Type::SCALAR);
+
+    AZStd::vector<std::uint32_t> segments;
+    ASSERT_TRUE(Cesium::GltfAccessorGather::GatherLineSegments(model, primitive, 4, segments));
+    EXPECT_EQ(segments, AZStd::vector<std::uint32_t>({ 0, 1, 3, 2 }));
+}
+
+TEST_F(GltfAccessorGatherTest, TrianglesAreNotLines)
+{
+    CesiumGltf::Model model;
+    CesiumGltf::MeshPrimitive primitive;
+    primitive.mode = CesiumGltf::MeshPrimitive::Mode::TRIANGLES;
+
+    AZStd::vector<std::uint32_t> segments;
+    EXPECT_FALSE(Cesium::GltfAccessorGather::GatherLineSegments(model, primitive, 3, segments));
+}
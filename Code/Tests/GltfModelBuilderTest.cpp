@@ -0,0 +1,664 @@
+#include "Cesium/Gltf/GltfModelBuilder.h"
+#include "Cesium/Gltf/GltfMaterialBuilder.h"
+#include "Cesium/Gltf/GltfPrimitiveBuilder.h"
+#include "Cesium/Gltf/GltfPrimitiveCache.h"
+#include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/BitangentAndTangentGenerator.h"
+#include "Cesium/Systems/CesiumSystem.h"
+#include "Cesium/Systems/CriticalAssetManager.h"
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAssetCreator.h>
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAsset.h>
+#include <AzCore/Asset/AssetManager.h>
+#include <AzCore/Memory/PoolAllocator.h>
+#include <AzCore/Name/NameDictionary.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+#include <cstring>
+#include <type_traits>
+
+// Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
+// This only happens with unity build
+#include <AzCore/PlatformDef.h>
+#ifdef AZ_COMPILER_MSVC
+#pragma push_macro("OPAQUE")
+#undef OPAQUE
+#endif
+
+#include <CesiumGltf/Model.h>
+
+#ifdef AZ_COMPILER_MSVC
+#pragma pop_macro("OPAQUE")
+#endif
+
+namespace
+{
+    // attributes of the synthetic primitives besides POSITION
+    enum SyntheticAttributes : std::int64_t
+    {
+        ATTRIBUTE_NORMALS = 1 << 0,
+        ATTRIBUTE_UVS = 1 << 1,
+        ATTRIBUTE_QUANTIZED_UVS = 1 << 2,
+        ATTRIBUTE_TANGENTS = 1 << 3,
+    };
+
+    // index component type of the synthetic primitives. Un-indexed primitives use 0
+    constexpr std::int64_t NO_INDICES = 0;
+
+    // Material builder that doesn't create material assets, since the material types are only available with the asset catalog.
+    // It lets the benchmarks choose whether primitives need tangents
+    class GeometryOnlyMaterialBuilder final : public Cesium::GltfMaterialBuilder
+    {
+    public:
+        GeometryOnlyMaterialBuilder(bool needTangents)
+            : m_needTangents{ needTangents }
+        {
+        }
+
+        const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& GetDefaultMaterialType() const override
+        {
+            return m_materialType;
+        }
+
+        void OverrideMaterialType([[maybe_unused]] const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& materialType) override
+        {
+        }
+
+        void Create(
+            [[maybe_unused]] const CesiumGltf::Model& model,
+            [[maybe_unused]] const CesiumGltf::Material& material,
+            [[maybe_unused]] AZStd::unordered_map<Cesium::TextureId, Cesium::GltfLoadTexture>& textureCache,
+            Cesium::GltfLoadMaterial& result) override
+        {
+            result.m_needTangents = m_needTangents;
+        }
+
+    private:
+        AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_materialType;
+        bool m_needTangents;
+    };
+
+    // The primitive builder needs the critical asset manager of the Cesium system and creates Atom assets with named streams
+    class ConversionEnvironment
+    {
+    public:
+        void SetUp()
+        {
+            AZ::AllocatorInstance<AZ::PoolAllocator>::Create();
+            AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Create();
+            AZ::NameDictionary::Create();
+            AZ::Data::AssetManager::Create(AZ::Data::AssetManager::Descriptor{});
+
+            m_cesiumSystem = AZStd::make_unique<Cesium::CesiumSystem>();
+            Cesium::CesiumInterface::Register(m_cesiumSystem.get());
+        }
+
+        void TearDown()
+        {
+            Cesium::CesiumInterface::Unregister(m_cesiumSystem.get());
+            m_cesiumSystem.reset();
+
+            AZ::Data::AssetManager::Destroy();
+            AZ::NameDictionary::Destroy();
+            AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Destroy();
+            AZ::AllocatorInstance<AZ::PoolAllocator>::Destroy();
+        }
+
+    private:
+        AZStd::unique_ptr<Cesium::CesiumSystem> m_cesiumSystem;
+    };
+
+    template<typename ElementType>
+    std::int32_t AppendAccessor(
+        CesiumGltf::Model& model,
+        const AZStd::vector<ElementType>& elements,
+        std::int32_t componentType,
+        const std::string& type,
+        bool normalized = false)
+    {
+        // keep every buffer view aligned to 4 bytes, as glTF requires for vertex attributes
+        std::vector<std::byte>& data = model.buffers.front().cesium.data;
+        std::size_t byteOffset = (data.size() + 3) / 4 * 4;
+        std::size_t byteLength = elements.size() * sizeof(ElementType);
+        data.resize(byteOffset + byteLength);
+        std::memcpy(data.data() + byteOffset, elements.data(), byteLength);
+        model.buffers.front().byteLength = static_cast<std::int64_t>(data.size());
+
+        CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+        bufferView.buffer = 0;
+        bufferView.byteOffset = static_cast<std::int64_t>(byteOffset);
+        bufferView.byteLength = static_cast<std::int64_t>(byteLength);
+
+        CesiumGltf::Accessor& accessor = model.accessors.emplace_back();
+        accessor.bufferView = static_cast<std::int32_t>(model.bufferViews.size() - 1);
+        accessor.componentType = componentType;
+        accessor.type = type;
+        accessor.normalized = normalized;
+        accessor.count = static_cast<std::int64_t>(elements.size());
+        return static_cast<std::int32_t>(model.accessors.size() - 1);
+    }
+
+    // Append a mesh made of a grid of quads on the XZ plane with a wave on Y
+    void AppendGridMesh(CesiumGltf::Model& model, std::uint32_t quadsPerSide, std::int64_t indexType, std::int64_t attributes)
+    {
+        std::uint32_t verticesPerSide = quadsPerSide + 1;
+        AZStd::vector<glm::vec3> positions;
+        AZStd::vector<glm::vec3> normals;
+        AZStd::vector<glm::vec2> uvs;
+        AZStd::vector<glm::u16vec2> quantizedUVs;
+        for (std::uint32_t z = 0; z < verticesPerSide; ++z)
+        {
+            for (std::uint32_t x = 0; x < verticesPerSide; ++x)
+            {
+                float u = static_cast<float>(x) / static_cast<float>(quadsPerSide);
+                float v = static_cast<float>(z) / static_cast<float>(quadsPerSide);
+                float height = 0.1f * glm::sin(u * 20.0f) * glm::cos(v * 20.0f);
+                positions.emplace_back(u, height, v);
+                normals.emplace_back(glm::normalize(glm::vec3(-2.0f * glm::cos(u * 20.0f) * glm::cos(v * 20.0f), 1.0f, 0.0f)));
+                uvs.emplace_back(u, v);
+                quantizedUVs.emplace_back(static_cast<std::uint16_t>(u * 65535.0f), static_cast<std::uint16_t>(v * 65535.0f));
+            }
+        }
+
+        AZStd::vector<std::uint32_t> indices;
+        indices.reserve(static_cast<std::size_t>(quadsPerSide) * quadsPerSide * 6);
+        for (std::uint32_t z = 0; z < quadsPerSide; ++z)
+        {
+            for (std::uint32_t x = 0; x < quadsPerSide; ++x)
+            {
+                std::uint32_t v0 = z * verticesPerSide + x;
+                std::uint32_t v1 = v0 + 1;
+                std::uint32_t v2 = v0 + verticesPerSide;
+                std::uint32_t v3 = v2 + 1;
+                indices.insert(indices.end(), { v0, v2, v1, v1, v2, v3 });
+            }
+        }
+
+        CesiumGltf::MeshPrimitive& primitive = model.meshes.emplace_back().primitives.emplace_back();
+        primitive.mode = CesiumGltf::MeshPrimitive::Mode::TRIANGLES;
+        primitive.material = 0;
+
+        // un-indexed primitives repeat the vertices of each triangle
+        if (indexType == NO_INDICES)
+        {
+            auto unindex = [&indices](const auto& elements)
+            {
+                std::decay_t<decltype(elements)> unindexed;
+                unindexed.reserve(indices.size());
+                for (std::uint32_t index : indices)
+                {
+                    unindexed.emplace_back(elements[index]);
+                }
+
+                return unindexed;
+            };
+
+            positions = unindex(positions);
+            normals = unindex(normals);
+            uvs = unindex(uvs);
+            quantizedUVs = unindex(quantizedUVs);
+        }
+        else if (indexType == CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT)
+        {
+            AZStd::vector<std::uint16_t> shortIndices(indices.begin(), indices.end());
+            primitive.indices = AppendAccessor(model, shortIndices, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, "SCALAR");
+        }
+        else
+        {
+            primitive.indices = AppendAccessor(model, indices, CesiumGltf::Accessor::ComponentType::UNSIGNED_INT, "SCALAR");
+        }
+
+        std::int32_t positionAccessor = AppendAccessor(model, positions, CesiumGltf::Accessor::ComponentType::FLOAT, "VEC3");
+        model.accessors[static_cast<std::size_t>(positionAccessor)].min = { 0.0, -0.1, 0.0 };
+        model.accessors[static_cast<std::size_t>(positionAccessor)].max = { 1.0, 0.1, 1.0 };
+        primitive.attributes["POSITION"] = positionAccessor;
+
+        if (attributes & ATTRIBUTE_NORMALS)
+        {
+            primitive.attributes["NORMAL"] = AppendAccessor(model, normals, CesiumGltf::Accessor::ComponentType::FLOAT, "VEC3");
+        }
+
+        if (attributes & ATTRIBUTE_QUANTIZED_UVS)
+        {
+            primitive.attributes["TEXCOORD_0"] =
+                AppendAccessor(model, quantizedUVs, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, "VEC2", true);
+        }
+        else if (attributes & ATTRIBUTE_UVS)
+        {
+            primitive.attributes["TEXCOORD_0"] = AppendAccessor(model, uvs, CesiumGltf::Accessor::ComponentType::FLOAT, "VEC2");
+        }
+    }
+
+    // Create a model with meshCount grid meshes, each referenced by its own node
+    CesiumGltf::Model CreateGridModel(std::uint32_t quadsPerSide, std::int64_t indexType, std::int64_t attributes, std::size_t meshCount)
+    {
+        CesiumGltf::Model model;
+        model.buffers.emplace_back();
+        model.materials.emplace_back();
+        CesiumGltf::Scene& scene = model.scenes.emplace_back();
+        model.scene = 0;
+        for (std::size_t i = 0; i < meshCount; ++i)
+        {
+            AppendGridMesh(model, quadsPerSide, indexType, attributes);
+
+            CesiumGltf::Node& node = model.nodes.emplace_back();
+            node.mesh = static_cast<std::int32_t>(i);
+            node.translation = { static_cast<double>(i), 0.0, 0.0 };
+            scene.nodes.emplace_back(static_cast<std::int32_t>(i));
+        }
+
+        return model;
+    }
+
+    template<typename ElementType>
+    AZStd::span<ElementType> GetAttributeData(CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, const std::string& name)
+    {
+        const CesiumGltf::Accessor& accessor = model.accessors[static_cast<std::size_t>(primitive.attributes.at(name))];
+        const CesiumGltf::BufferView& bufferView = model.bufferViews[static_cast<std::size_t>(accessor.bufferView)];
+        std::byte* data = model.buffers.front().cesium.data.data() + bufferView.byteOffset;
+        return AZStd::span<ElementType>(reinterpret_cast<ElementType*>(data), static_cast<std::size_t>(accessor.count));
+    }
+
+    std::size_t GetVertexCount(const CesiumGltf::Model& model)
+    {
+        std::size_t vertexCount = 0;
+        for (const CesiumGltf::Mesh& mesh : model.meshes)
+        {
+            for (const CesiumGltf::MeshPrimitive& primitive : mesh.primitives)
+            {
+                std::int32_t positionAccessor = primitive.attributes.at("POSITION");
+                vertexCount += static_cast<std::size_t>(model.accessors[static_cast<std::size_t>(positionAccessor)].count);
+            }
+        }
+
+        return vertexCount;
+    }
+
+    // Size of the buffer holding the vertex streams and indices of a primitive. The constant streams shared by every primitive
+    // are not counted
+    std::size_t GetPrimitiveBufferSize(const Cesium::GltfLoadPrimitive& primitive)
+    {
+        const AZ::Data::Asset<AZ::RPI::ModelLodAsset>& lodAsset = primitive.m_modelAsset->GetLodAssets().front();
+        return lodAsset->GetMeshes().front().GetIndexBufferAssetView().GetBufferAsset()->GetBuffer().size();
+    }
+
+    std::size_t GetModelBufferSize(const Cesium::GltfLoadModel& loadModel)
+    {
+        std::size_t bufferSize = 0;
+        for (const Cesium::GltfLoadMesh& mesh : loadModel.m_meshes)
+        {
+            for (const Cesium::GltfLoadPrimitive& primitive : mesh.m_primitives)
+            {
+                bufferSize += GetPrimitiveBufferSize(primitive);
+            }
+        }
+
+        return bufferSize;
+    }
+} // namespace
+
+class GltfModelBuilderTest : public UnitTest::AllocatorsTestFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::AllocatorsTestFixture::SetUp();
+        m_environment.SetUp();
+    }
+
+    void TearDown() override
+    {
+        m_environment.TearDown();
+        UnitTest::AllocatorsTestFixture::TearDown();
+    }
+
+private:
+    ConversionEnvironment m_environment;
+};
+
+TEST_F(GltfModelBuilderTest, GeneratedAssetIdsAreUnique)
+{
+    const Cesium::CriticalAssetManager& assetManager = Cesium::CesiumInterface::Get()->GetCriticalAssetManager();
+    AZStd::unordered_set<AZ::Data::AssetId> assetIds;
+    for (std::size_t i = 0; i < 1024; ++i)
+    {
+        AZ::Data::AssetId assetId = assetManager.GenerateAssetId();
+        ASSERT_TRUE(assetId.IsValid());
+        ASSERT_TRUE(assetIds.insert(assetId).second);
+    }
+}
+
+TEST_F(GltfModelBuilderTest, EveryMeshOfTheSceneIsBuilt)
+{
+    CesiumGltf::Model model = CreateGridModel(8, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, ATTRIBUTE_NORMALS, 3);
+
+    Cesium::GltfModelBuilder builder(AZStd::make_unique<GeometryOnlyMaterialBuilder>(false));
+    Cesium::GltfModelBuilderOption option{ glm::dmat4(1.0) };
+    Cesium::GltfLoadModel result;
+    builder.Create(model, option, result);
+
+    ASSERT_EQ(result.m_meshes.size(), 3);
+    for (std::size_t i = 0; i < result.m_meshes.size(); ++i)
+    {
+        ASSERT_EQ(result.m_meshes[i].m_primitives.size(), 1);
+        ASSERT_TRUE(result.m_meshes[i].m_primitives.front().m_modelAsset);
+
+        // nodes are translated along X, which is still X after converting from glTF Y up to O3DE Z up
+        ASSERT_EQ(result.m_meshes[i].m_transform[3].x, static_cast<double>(i));
+    }
+}
+
+TEST_F(GltfModelBuilderTest, NodesScaledToZeroAreSkipped)
+{
+    CesiumGltf::Model model = CreateGridModel(8, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, ATTRIBUTE_NORMALS, 2);
+    model.nodes[1].scale = { 0.0, 1.0, 1.0 };
+
+    for (bool mergePrimitives : { false, true })
+    {
+        Cesium::GltfModelBuilder builder(AZStd::make_unique<GeometryOnlyMaterialBuilder>(false));
+        Cesium::GltfModelBuilderOption option{ glm::dmat4(1.0) };
+        option.m_mergePrimitives = mergePrimitives;
+        Cesium::GltfLoadModel result;
+        builder.Create(model, option, result);
+
+        std::size_t builtMeshCount = 0;
+        for (const Cesium::GltfLoadMesh& mesh : result.m_meshes)
+        {
+            builtMeshCount += mesh.IsEmpty() ? 0 : 1;
+        }
+
+        ASSERT_EQ(builtMeshCount, 1);
+    }
+}
+
+TEST_F(GltfModelBuilderTest, IndicesAreWidenedTo32Bits)
+{
+    CesiumGltf::Model model = CreateGridModel(8, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, ATTRIBUTE_NORMALS, 1);
+
+    Cesium::GltfTrianglePrimitiveBuilder builder{ Cesium::GltfTrianglePrimitiveBuilderOption{} };
+    Cesium::GltfLoadMaterial material;
+    Cesium::GltfLoadPrimitive result;
+    builder.Create(model, model.meshes.front().primitives.front(), material, result);
+
+    ASSERT_TRUE(result.m_modelAsset);
+    const AZ::Data::Asset<AZ::RPI::ModelLodAsset>& lodAsset = result.m_modelAsset->GetLodAssets().front();
+    const AZ::RHI::BufferViewDescriptor& indices = lodAsset->GetMeshes().front().GetIndexBufferAssetView().GetBufferViewDescriptor();
+    ASSERT_EQ(indices.m_elementFormat, AZ::RHI::Format::R32_UINT);
+    ASSERT_EQ(indices.m_elementCount, 8 * 8 * 6);
+}
+
+TEST_F(GltfModelBuilderTest, TrianglesWithOutOfRangeIndicesAreDropped)
+{
+    CesiumGltf::Model model = CreateGridModel(8, CesiumGltf::Accessor::ComponentType::UNSIGNED_INT, ATTRIBUTE_NORMALS, 1);
+    const CesiumGltf::MeshPrimitive& primitive = model.meshes.front().primitives.front();
+    const CesiumGltf::Accessor& indicesAccessor = model.accessors[static_cast<std::size_t>(primitive.indices)];
+    const CesiumGltf::BufferView& indicesBufferView = model.bufferViews[static_cast<std::size_t>(indicesAccessor.bufferView)];
+    std::uint32_t* indices = reinterpret_cast<std::uint32_t*>(model.buffers.front().cesium.data.data() + indicesBufferView.byteOffset);
+    indices[4] = 9 * 9;
+
+    Cesium::GltfTrianglePrimitiveBuilderOption option;
+    option.m_buildRaycastBvh = true;
+    option.m_buildCollisionMesh = true;
+    option.m_clusterTriangleCount = 16;
+    Cesium::GltfTrianglePrimitiveBuilder builder{ option };
+    Cesium::GltfLoadMaterial material;
+    Cesium::GltfLoadPrimitive result;
+    builder.Create(model, primitive, material, result);
+
+    ASSERT_TRUE(result.m_modelAsset);
+    const AZ::Data::Asset<AZ::RPI::ModelLodAsset>& lodAsset = result.m_modelAsset->GetLodAssets().front();
+    const AZ::RHI::BufferViewDescriptor& indicesView = lodAsset->GetMeshes().front().GetIndexBufferAssetView().GetBufferViewDescriptor();
+    ASSERT_EQ(indicesView.m_elementCount, 8 * 8 * 6 - 3);
+}
+
+TEST_F(GltfModelBuilderTest, IdenticalPrimitivesShareTheirModel)
+{
+    // two copies of the same tile, as if a tileset repeated the same geometry
+    CesiumGltf::Model firstModel = CreateGridModel(8, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, ATTRIBUTE_NORMALS, 1);
+    CesiumGltf::Model secondModel = CreateGridModel(8, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, ATTRIBUTE_NORMALS, 1);
+
+    Cesium::GltfTrianglePrimitiveBuilderOption option;
+    option.m_primitiveCache = AZStd::make_shared<Cesium::GltfPrimitiveCache>();
+    Cesium::GltfTrianglePrimitiveBuilder builder{ option };
+    Cesium::GltfLoadMaterial material;
+    Cesium::GltfLoadPrimitive first;
+    Cesium::GltfLoadPrimitive second;
+    builder.Create(firstModel, firstModel.meshes.front().primitives.front(), material, first);
+    builder.Create(secondModel, secondModel.meshes.front().primitives.front(), material, second);
+
+    ASSERT_TRUE(first.m_modelAsset);
+    ASSERT_EQ(first.m_modelAsset.GetId(), second.m_modelAsset.GetId());
+    Cesium::GltfPrimitiveCacheStatistics statistics = option.m_primitiveCache->GetStatistics();
+    ASSERT_EQ(statistics.m_hitCount, 1);
+    ASSERT_GT(statistics.m_savedBytes, 0);
+
+    // a primitive that needs tangents has a different vertex layout, so it is built again
+    material.m_needTangents = true;
+    Cesium::GltfLoadPrimitive third;
+    builder.Create(secondModel, secondModel.meshes.front().primitives.front(), material, third);
+    ASSERT_TRUE(third.m_modelAsset);
+    ASSERT_NE(first.m_modelAsset.GetId(), third.m_modelAsset.GetId());
+
+    // the cache doesn't keep primitives alive once no model uses them
+    first = Cesium::GltfLoadPrimitive{};
+    second = Cesium::GltfLoadPrimitive{};
+    material.m_needTangents = false;
+    Cesium::GltfLoadPrimitive fourth;
+    builder.Create(firstModel, firstModel.meshes.front().primitives.front(), material, fourth);
+    ASSERT_EQ(option.m_primitiveCache->GetStatistics().m_hitCount, 1);
+}
+
+TEST_F(GltfModelBuilderTest, PrimitivesWithTheSameHashAreNotShared)
+{
+    Cesium::GltfPrimitiveCacheAccessor accessor;
+    accessor.m_count = 64;
+    accessor.m_componentType = CesiumGltf::Accessor::ComponentType::FLOAT;
+    accessor.m_componentCount = 3;
+    accessor.m_byteSize = 64 * 12;
+
+    AZStd::shared_ptr<Cesium::GltfSharedPrimitive> primitive = AZStd::make_shared<Cesium::GltfSharedPrimitive>();
+    primitive->m_key.m_hash = 42;
+    primitive->m_key.m_checksum = 7;
+    primitive->m_key.m_accessors.push_back(accessor);
+
+    Cesium::GltfPrimitiveCache cache;
+    cache.Add(primitive);
+    ASSERT_EQ(cache.Find(primitive->m_key), primitive);
+
+    // a collision of the hash alone is a miss
+    Cesium::GltfPrimitiveCacheKey key = primitive->m_key;
+    key.m_checksum = 8;
+    ASSERT_EQ(cache.Find(key), nullptr);
+
+    key = primitive->m_key;
+    key.m_accessors.front().m_count = 32;
+    ASSERT_EQ(cache.Find(key), nullptr);
+
+    Cesium::GltfPrimitiveCacheStatistics statistics = cache.GetStatistics();
+    ASSERT_EQ(statistics.m_hitCount, 1);
+    ASSERT_EQ(statistics.m_missCount, 2);
+}
+
+#if defined(HAVE_BENCHMARK)
+class GltfModelBuilderBenchmark : public UnitTest::AllocatorsBenchmarkFixture
+{
+public:
+    void SetUp(const benchmark::State& state) override
+    {
+        UnitTest::AllocatorsBenchmarkFixture::SetUp(state);
+        m_environment.SetUp();
+    }
+
+    void SetUp(benchmark::State& state) override
+    {
+        UnitTest::AllocatorsBenchmarkFixture::SetUp(state);
+        m_environment.SetUp();
+    }
+
+    void TearDown(const benchmark::State& state) override
+    {
+        m_environment.TearDown();
+        UnitTest::AllocatorsBenchmarkFixture::TearDown(state);
+    }
+
+    void TearDown(benchmark::State& state) override
+    {
+        m_environment.TearDown();
+        UnitTest::AllocatorsBenchmarkFixture::TearDown(state);
+    }
+
+private:
+    ConversionEnvironment m_environment;
+};
+
+// Input throughput is the size of the glTF buffer, and BytesPerVertex is the size of the vertex and index buffer built from it
+BENCHMARK_DEFINE_F(GltfModelBuilderBenchmark, TrianglePrimitiveBuilder)(benchmark::State& state)
+{
+    std::uint32_t quadsPerSide = static_cast<std::uint32_t>(state.range(0));
+    std::int64_t indexType = state.range(1);
+    std::int64_t attributes = state.range(2);
+    CesiumGltf::Model model = CreateGridModel(quadsPerSide, indexType, attributes, 1);
+    const CesiumGltf::MeshPrimitive& primitive = model.meshes.front().primitives.front();
+
+    Cesium::GltfLoadMaterial material;
+    material.m_needTangents = (attributes & ATTRIBUTE_TANGENTS) != 0;
+    Cesium::GltfTrianglePrimitiveBuilder builder{ Cesium::GltfTrianglePrimitiveBuilderOption{} };
+    std::size_t outputSize = 0;
+    for (auto _ : state)
+    {
+        Cesium::GltfLoadPrimitive result;
+        builder.Create(model, primitive, material, result);
+        outputSize = GetPrimitiveBufferSize(result);
+        benchmark::DoNotOptimize(result.m_modelAsset.Get());
+    }
+
+    std::size_t vertexCount = GetVertexCount(model);
+    state.counters["BytesPerVertex"] = static_cast<double>(outputSize) / static_cast<double>(vertexCount);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(vertexCount));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(model.buffers.front().cesium.data.size()));
+}
+
+BENCHMARK_REGISTER_F(GltfModelBuilderBenchmark, TrianglePrimitiveBuilder)
+    ->ArgNames({ "QuadsPerSide", "IndexType", "Attributes" })
+    ->Args({ 64, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, ATTRIBUTE_NORMALS | ATTRIBUTE_UVS })
+    ->Args({ 255, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, ATTRIBUTE_NORMALS | ATTRIBUTE_UVS })
+    ->Args({ 1024, CesiumGltf::Accessor::ComponentType::UNSIGNED_INT, ATTRIBUTE_NORMALS | ATTRIBUTE_UVS })
+    ->Args({ 255, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, ATTRIBUTE_NORMALS | ATTRIBUTE_QUANTIZED_UVS })
+    ->Args({ 255, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, 0 })
+    ->Args({ 255, NO_INDICES, ATTRIBUTE_NORMALS | ATTRIBUTE_UVS })
+    ->Args({ 255, NO_INDICES, 0 })
+    ->Args({ 255, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, ATTRIBUTE_NORMALS | ATTRIBUTE_UVS | ATTRIBUTE_TANGENTS })
+    ->Unit(benchmark::kMillisecond);
+
+// Whole model conversion, including the scene traversal, with many small meshes or a few large ones
+BENCHMARK_DEFINE_F(GltfModelBuilderBenchmark, ModelBuilder)(benchmark::State& state)
+{
+    std::uint32_t quadsPerSide = static_cast<std::uint32_t>(state.range(0));
+    std::size_t meshCount = static_cast<std::size_t>(state.range(1));
+    bool mergePrimitives = state.range(2) != 0;
+    CesiumGltf::Model model =
+        CreateGridModel(quadsPerSide, CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT, ATTRIBUTE_NORMALS | ATTRIBUTE_UVS, meshCount);
+
+    Cesium::GltfModelBuilder builder(AZStd::make_unique<GeometryOnlyMaterialBuilder>(false));
+    Cesium::GltfModelBuilderOption option{ glm::dmat4(1.0) };
+    option.m_mergePrimitives = mergePrimitives;
+    std::size_t outputSize = 0;
+    for (auto _ : state)
+    {
+        Cesium::GltfLoadModel result;
+        builder.Create(model, option, result);
+        outputSize = GetModelBufferSize(result);
+        benchmark::DoNotOptimize(result.m_meshes.data());
+    }
+
+    std::size_t vertexCount = GetVertexCount(model);
+    state.counters["BytesPerVertex"] = static_cast<double>(outputSize) / static_cast<double>(vertexCount);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(vertexCount));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(model.buffers.front().cesium.data.size()));
+}
+
+BENCHMARK_REGISTER_F(GltfModelBuilderBenchmark, ModelBuilder)
+    ->ArgNames({ "QuadsPerSide", "MeshCount", "MergePrimitives" })
+    ->Args({ 8, 256, 0 })
+    ->Args({ 8, 256, 1 })
+    ->Args({ 128, 16, 0 })
+    ->Args({ 128, 16, 1 })
+    ->Unit(benchmark::kMillisecond);
+
+// Creation of the buffer, LOD, model, material and image assets of a tile with small buffers, so the cost of their IDs dominates.
+// UseRandomIds measures the previous scheme, which generated a random UUID for each asset
+BENCHMARK_DEFINE_F(GltfModelBuilderBenchmark, TileAssetIds)(benchmark::State& state)
+{
+    static constexpr std::size_t ASSETS_PER_TILE = 5;
+    bool useRandomIds = state.range(0) != 0;
+    const Cesium::CriticalAssetManager& assetManager = Cesium::CesiumInterface::Get()->GetCriticalAssetManager();
+
+    AZStd::vector<std::byte> buffer(48, std::byte{ 0 });
+    AZ::RHI::BufferDescriptor bufferDescriptor;
+    bufferDescriptor.m_bindFlags = AZ::RHI::BufferBindFlags::InputAssembly;
+    bufferDescriptor.m_byteCount = buffer.size();
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < ASSETS_PER_TILE; ++i)
+        {
+            AZ::Data::AssetId assetId = useRandomIds ? AZ::Data::AssetId(AZ::Uuid::CreateRandom(), 0) : assetManager.GenerateAssetId();
+            AZ::RPI::BufferAssetCreator creator;
+            creator.Begin(assetId);
+            creator.SetBuffer(buffer.data(), buffer.size(), bufferDescriptor);
+            creator.SetBufferViewDescriptor(
+                AZ::RHI::BufferViewDescriptor::CreateTyped(0, static_cast<std::uint32_t>(buffer.size()), AZ::RHI::Format::R8_UINT));
+            AZ::Data::Asset<AZ::RPI::BufferAsset> bufferAsset;
+            creator.End(bufferAsset);
+            benchmark::DoNotOptimize(bufferAsset.Get());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(GltfModelBuilderBenchmark, TileAssetIds)->ArgNames({ "UseRandomIds" })->Arg(1)->Arg(0)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(GltfModelBuilderBenchmark, BitangentAndTangentGenerator)(benchmark::State& state)
+{
+    // tangents are generated for un-indexed triangles
+    std::uint32_t quadsPerSide = static_cast<std::uint32_t>(state.range(0));
+    bool quantizedUVs = state.range(1) != 0;
+    std::int64_t attributes = ATTRIBUTE_NORMALS | (quantizedUVs ? ATTRIBUTE_QUANTIZED_UVS : ATTRIBUTE_UVS);
+    CesiumGltf::Model model = CreateGridModel(quadsPerSide, NO_INDICES, attributes, 1);
+    const CesiumGltf::MeshPrimitive& primitive = model.meshes.front().primitives.front();
+
+    AZStd::span<glm::vec3> positions = GetAttributeData<glm::vec3>(model, primitive, "POSITION");
+    AZStd::span<glm::vec3> normals = GetAttributeData<glm::vec3>(model, primitive, "NORMAL");
+    AZStd::vector<glm::vec4> tangents(positions.size());
+    AZStd::vector<glm::vec3> bitangents(positions.size());
+    AZStd::span<glm::vec4> tangentsView{ tangents.data(), tangents.size() };
+    AZStd::span<glm::vec3> bitangentsView{ bitangents.data(), bitangents.size() };
+    for (auto _ : state)
+    {
+        if (quantizedUVs)
+        {
+            AZStd::span<glm::u16vec2> uvs = GetAttributeData<glm::u16vec2>(model, primitive, "TEXCOORD_0");
+            Cesium::BitangentAndTangentGenerator::Generate(positions, normals, uvs, tangentsView, bitangentsView);
+        }
+        else
+        {
+            AZStd::span<glm::vec2> uvs = GetAttributeData<glm::vec2>(model, primitive, "TEXCOORD_0");
+            Cesium::BitangentAndTangentGenerator::Generate(positions, normals, uvs, tangentsView, bitangentsView);
+        }
+
+        benchmark::DoNotOptimize(tangents.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()));
+}
+
+BENCHMARK_REGISTER_F(GltfModelBuilderBenchmark, BitangentAndTangentGenerator)
+    ->ArgNames({ "QuadsPerSide", "QuantizedUVs" })
+    ->Args({ 64, 0 })
+    ->Args({ 255, 0 })
+    ->Args({ 255, 1 })
+    ->Unit(benchmark::kMillisecond);
+#endif
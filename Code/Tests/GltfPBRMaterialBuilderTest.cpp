@@ -0,0 +1,48 @@
+#include "Cesium/Gltf/GltfPBRMaterialBuilder.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace
+{
+    // metallic-roughness texture whose pixels have distinct values in every channel: R = 10 + i, G = 100 + i, B = 200 + i
+    AZStd::vector<std::byte> CreateMetallicRoughnessImage(std::size_t pixelCount, std::uint32_t channelCount)
+    {
+        AZStd::vector<std::byte> image(pixelCount * channelCount);
+        for (std::size_t i = 0; i < pixelCount; ++i)
+        {
+            image[i * channelCount] = static_cast<std::byte>(10 + i);
+            image[i * channelCount + 1] = static_cast<std::byte>(100 + i);
+            image[i * channelCount + 2] = static_cast<std::byte>(200 + i);
+            if (channelCount == 4)
+            {
+                image[i * channelCount + 3] = static_cast<std::byte>(255);
+            }
+        }
+
+        return image;
+    }
+} // namespace
+
+class GltfPBRMaterialBuilderTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(GltfPBRMaterialBuilderTest, MetallicRoughnessIsPackedWithRoughnessInTheFirstChannel)
+{
+    constexpr std::size_t pixelCount = 16;
+    for (std::uint32_t channelCount : { 3u, 4u })
+    {
+        AZStd::vector<std::byte> image = CreateMetallicRoughnessImage(pixelCount, channelCount);
+        AZStd::vector<std::byte> packed(pixelCount * 2);
+        Cesium::GltfPBRMaterialBuilder::PackMetallicRoughness(
+            AZStd::span<const std::byte>{ image.data(), image.size() }, channelCount,
+            AZStd::span<std::byte>{ packed.data(), packed.size() });
+
+        // channel 0 is roughness from the source G, and channel 1 is metallic from the source B
+        for (std::size_t i = 0; i < pixelCount; ++i)
+        {
+            ASSERT_EQ(static_cast<std::size_t>(packed[i * 2]), 100 + i);
+            ASSERT_EQ(static_cast<std::size_t>(packed[i * 2 + 1]), 200 + i);
+        }
+    }
+}
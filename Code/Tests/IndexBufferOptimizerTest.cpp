@@ -0,0 +1,169 @@
+#include "Cesium/Gltf/IndexBufferOptimizer.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/sort.h>
+#include <algorithm>
+#include <array>
+#include <random>
+
+namespace
+{
+    struct GridMesh
+    {
+        AZStd::vector<glm::vec3> m_positions;
+        AZStd::vector<std::uint32_t> m_indices;
+    };
+
+    // Create a grid of quads whose triangles are shuffled, which is close to the worst case for the vertex cache
+    GridMesh CreateShuffledGrid(std::uint32_t quadsPerSide)
+    {
+        GridMesh grid;
+        std::uint32_t verticesPerSide = quadsPerSide + 1;
+        for (std::uint32_t y = 0; y < verticesPerSide; ++y)
+        {
+            for (std::uint32_t x = 0; x < verticesPerSide; ++x)
+            {
+                grid.m_positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+            }
+        }
+
+        AZStd::vector<std::array<std::uint32_t, 3>> triangles;
+        for (std::uint32_t y = 0; y < quadsPerSide; ++y)
+        {
+            for (std::uint32_t x = 0; x < quadsPerSide; ++x)
+            {
+                std::uint32_t v0 = y * verticesPerSide + x;
+                std::uint32_t v1 = v0 + 1;
+                std::uint32_t v2 = v0 + verticesPerSide;
+                std::uint32_t v3 = v2 + 1;
+                triangles.push_back({ v0, v1, v2 });
+                triangles.push_back({ v1, v3, v2 });
+            }
+        }
+
+        std::mt19937 random{ 42 };
+        std::shuffle(triangles.begin(), triangles.end(), random);
+        for (const auto& triangle : triangles)
+        {
+            grid.m_indices.insert(grid.m_indices.end(), triangle.begin(), triangle.end());
+        }
+
+        return grid;
+    }
+
+    // Triangles rotated to start with their smallest index and sorted, so that two index buffers can be compared
+    // regardless of the order of their triangles while still checking the winding
+    AZStd::vector<std::array<std::uint32_t, 3>> GetCanonicalTriangles(const AZStd::vector<std::uint32_t>& indices)
+    {
+        AZStd::vector<std::array<std::uint32_t, 3>> triangles;
+        for (std::size_t i = 0; i < indices.size(); i += 3)
+        {
+            std::array<std::uint32_t, 3> triangle{ indices[i], indices[i + 1], indices[i + 2] };
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.emplace_back(triangle);
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    void OptimizeGrid(GridMesh& grid)
+    {
+        AZStd::span<std::uint32_t> indices{ grid.m_indices.data(), grid.m_indices.size() };
+        AZStd::span<const glm::vec3> positions{ grid.m_positions.data(), grid.m_positions.size() };
+        AZStd::vector<std::uint32_t> clusterOffsets;
+        Cesium::IndexBufferOptimizer::OptimizeVertexCache(indices, grid.m_positions.size(), clusterOffsets);
+        Cesium::IndexBufferOptimizer::OptimizeOverdraw(indices, positions, clusterOffsets);
+    }
+
+    float CalculateGridACMR(const GridMesh& grid)
+    {
+        return Cesium::IndexBufferOptimizer::CalculateACMR(
+            AZStd::span<const std::uint32_t>{ grid.m_indices.data(), grid.m_indices.size() }, grid.m_positions.size(),
+            Cesium::IndexBufferOptimizer::VERTEX_CACHE_SIZE);
+    }
+} // namespace
+
+class IndexBufferOptimizerTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(IndexBufferOptimizerTest, OptimizationKeepsTheSameTriangles)
+{
+    GridMesh grid = CreateShuffledGrid(32);
+    AZStd::vector<std::array<std::uint32_t, 3>> originalTriangles = GetCanonicalTriangles(grid.m_indices);
+
+    OptimizeGrid(grid);
+
+    ASSERT_EQ(GetCanonicalTriangles(grid.m_indices), originalTriangles);
+}
+
+TEST_F(IndexBufferOptimizerTest, OptimizationReducesACMR)
+{
+    GridMesh grid = CreateShuffledGrid(32);
+    float originalACMR = CalculateGridACMR(grid);
+
+    OptimizeGrid(grid);
+
+    float optimizedACMR = CalculateGridACMR(grid);
+    ASSERT_LT(optimizedACMR, originalACMR);
+    ASSERT_LT(optimizedACMR, 1.0f);
+}
+
+TEST_F(IndexBufferOptimizerTest, VertexFetchRenumbersVerticesInFirstUseOrder)
+{
+    GridMesh grid = CreateShuffledGrid(8);
+    AZStd::vector<std::uint32_t> originalIndices = grid.m_indices;
+
+    AZStd::vector<std::uint32_t> vertexRemap;
+    Cesium::IndexBufferOptimizer::OptimizeVertexFetch(
+        AZStd::span<std::uint32_t>{ grid.m_indices.data(), grid.m_indices.size() }, grid.m_positions.size(), vertexRemap);
+
+    ASSERT_EQ(vertexRemap.size(), grid.m_positions.size());
+    std::uint32_t nextVertex = 0;
+    for (std::size_t i = 0; i < grid.m_indices.size(); ++i)
+    {
+        ASSERT_EQ(grid.m_indices[i], vertexRemap[originalIndices[i]]);
+        ASSERT_LE(grid.m_indices[i], nextVertex);
+        if (grid.m_indices[i] == nextVertex)
+        {
+            ++nextVertex;
+        }
+    }
+
+    AZStd::vector<std::uint32_t> sortedRemap = vertexRemap;
+    AZStd::sort(sortedRemap.begin(), sortedRemap.end());
+    for (std::uint32_t i = 0; i < sortedRemap.size(); ++i)
+    {
+        ASSERT_EQ(sortedRemap[i], i);
+    }
+}
+
+#if defined(HAVE_BENCHMARK)
+class IndexBufferOptimizerBenchmark : public UnitTest::AllocatorsBenchmarkFixture
+{
+};
+
+BENCHMARK_F(IndexBufferOptimizerBenchmark, OptimizeShuffledGrid)(benchmark::State& state)
+{
+    const GridMesh shuffledGrid = CreateShuffledGrid(256);
+    float optimizedACMR = 0.0f;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        GridMesh grid = shuffledGrid;
+        state.ResumeTiming();
+
+        OptimizeGrid(grid);
+
+        state.PauseTiming();
+        optimizedACMR = CalculateGridACMR(grid);
+        state.ResumeTiming();
+    }
+
+    // report the vertex cache efficiency before and after the optimization
+    state.counters["ACMR_Before"] = CalculateGridACMR(shuffledGrid);
+    state.counters["ACMR_After"] = optimizedACMR;
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(shuffledGrid.m_indices.size() / 3));
+}
+#endif
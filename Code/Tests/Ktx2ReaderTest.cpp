@@ -0,0 +1,113 @@
+#include "Cesium/Gltf/Ktx2Reader.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace
+{
+    constexpr std::uint32_t VK_FORMAT_UNDEFINED = 0;
+    constexpr std::uint32_t VK_FORMAT_BC1_RGB_SRGB_BLOCK = 132;
+    constexpr std::uint32_t VK_FORMAT_BC7_UNORM_BLOCK = 145;
+
+    void WriteLittleEndian(AZStd::vector<std::byte>& data, std::size_t offset, std::uint64_t value, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            data[offset + i] = static_cast<std::byte>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    // Build a KTX2 file of a 2D image whose levels are filled with their level index, stored from the smallest level as the
+    // specification recommends
+    AZStd::vector<std::byte> CreateKtx2(
+        std::uint32_t vkFormat,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t bytesPerBlock,
+        std::uint32_t levelCount,
+        std::uint32_t supercompressionScheme = 0)
+    {
+        static constexpr std::uint8_t identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+        std::size_t headerSize = 80 + std::size_t{ levelCount } * 24;
+        AZStd::vector<std::byte> data(headerSize);
+        for (std::size_t i = 0; i < sizeof(identifier); ++i)
+        {
+            data[i] = static_cast<std::byte>(identifier[i]);
+        }
+
+        WriteLittleEndian(data, 12, vkFormat, 4);
+        WriteLittleEndian(data, 16, 1, 4);
+        WriteLittleEndian(data, 20, width, 4);
+        WriteLittleEndian(data, 24, height, 4);
+        WriteLittleEndian(data, 36, 1, 4);
+        WriteLittleEndian(data, 40, levelCount, 4);
+        WriteLittleEndian(data, 44, supercompressionScheme, 4);
+
+        for (std::uint32_t level = levelCount; level-- > 0;)
+        {
+            std::uint64_t blockCountX = (AZStd::max(width >> level, 1u) + 3) / 4;
+            std::uint64_t blockCountY = (AZStd::max(height >> level, 1u) + 3) / 4;
+            std::uint64_t length = blockCountX * blockCountY * bytesPerBlock;
+            WriteLittleEndian(data, 80 + std::size_t{ level } * 24, data.size(), 8);
+            WriteLittleEndian(data, 80 + std::size_t{ level } * 24 + 8, length, 8);
+            WriteLittleEndian(data, 80 + std::size_t{ level } * 24 + 16, length, 8);
+            data.insert(data.end(), static_cast<std::size_t>(length), static_cast<std::byte>(level));
+        }
+
+        return data;
+    }
+
+    bool Read(const AZStd::vector<std::byte>& data, Cesium::Ktx2Image& image)
+    {
+        return Cesium::Ktx2Reader::Read(AZStd::span<const std::byte>{ data.data(), data.size() }, image);
+    }
+} // namespace
+
+class Ktx2ReaderTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(Ktx2ReaderTest, LevelsAreReturnedFromTheMostDetailedOne)
+{
+    AZStd::vector<std::byte> data = CreateKtx2(VK_FORMAT_BC1_RGB_SRGB_BLOCK, 16, 8, 8, 5);
+    Cesium::Ktx2Image image;
+    ASSERT_TRUE(Read(data, image));
+    ASSERT_EQ(image.m_format, AZ::RHI::Format::BC1_UNORM_SRGB);
+    ASSERT_EQ(image.m_width, 16);
+    ASSERT_EQ(image.m_height, 8);
+    ASSERT_EQ(image.m_mips.size(), 5);
+
+    // 16x8, 8x4, 4x2, 2x1 and 1x1 take 8, 2, 1, 1 and 1 blocks
+    const std::size_t blockCounts[] = { 8, 2, 1, 1, 1 };
+    for (std::size_t level = 0; level < image.m_mips.size(); ++level)
+    {
+        ASSERT_EQ(image.m_mips[level].size(), blockCounts[level] * 8);
+        ASSERT_EQ(static_cast<std::size_t>(image.m_mips[level][0]), level);
+    }
+}
+
+TEST_F(Ktx2ReaderTest, BasisUniversalPayloadsAreRejected)
+{
+    Cesium::Ktx2Image image;
+    ASSERT_FALSE(Read(CreateKtx2(VK_FORMAT_UNDEFINED, 16, 16, 16, 1), image));
+
+    // Zstandard supercompression
+    ASSERT_FALSE(Read(CreateKtx2(VK_FORMAT_BC7_UNORM_BLOCK, 16, 16, 16, 1, 2), image));
+    ASSERT_TRUE(Read(CreateKtx2(VK_FORMAT_BC7_UNORM_BLOCK, 16, 16, 16, 1), image));
+    ASSERT_EQ(image.m_format, AZ::RHI::Format::BC7_UNORM);
+}
+
+TEST_F(Ktx2ReaderTest, TruncatedFilesAreRejected)
+{
+    AZStd::vector<std::byte> data = CreateKtx2(VK_FORMAT_BC7_UNORM_BLOCK, 8, 8, 16, 4);
+    Cesium::Ktx2Image image;
+    ASSERT_TRUE(Read(data, image));
+
+    data.pop_back();
+    ASSERT_FALSE(Read(data, image));
+
+    data.resize(40);
+    ASSERT_FALSE(Read(data, image));
+    ASSERT_FALSE(Cesium::Ktx2Reader::IsKtx2(AZStd::span<const std::byte>{ data.data(), 8 }));
+}
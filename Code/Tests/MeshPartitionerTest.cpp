@@ -0,0 +1,145 @@
+#include "Cesium/Gltf/MeshPartitioner.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace
+{
+    struct GridMesh
+    {
+        AZStd::vector<glm::vec3> m_positions;
+        AZStd::vector<std::uint32_t> m_indices;
+    };
+
+    GridMesh CreateGrid(std::uint32_t quadsPerSide)
+    {
+        GridMesh grid;
+        std::uint32_t verticesPerSide = quadsPerSide + 1;
+        for (std::uint32_t y = 0; y < verticesPerSide; ++y)
+        {
+            for (std::uint32_t x = 0; x < verticesPerSide; ++x)
+            {
+                grid.m_positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.0f);
+            }
+        }
+
+        for (std::uint32_t y = 0; y < quadsPerSide; ++y)
+        {
+            for (std::uint32_t x = 0; x < quadsPerSide; ++x)
+            {
+                std::uint32_t v0 = y * verticesPerSide + x;
+                std::uint32_t v1 = v0 + 1;
+                std::uint32_t v2 = v0 + verticesPerSide;
+                std::uint32_t v3 = v2 + 1;
+                grid.m_indices.insert(grid.m_indices.end(), { v0, v1, v2, v1, v3, v2 });
+            }
+        }
+
+        return grid;
+    }
+
+    void Partition(GridMesh& grid, std::size_t maxTriangleCount, AZStd::vector<std::uint32_t>& clusterOffsets)
+    {
+        Cesium::MeshPartitioner::Partition(
+            AZStd::span<std::uint32_t>{ grid.m_indices.data(), grid.m_indices.size() },
+            AZStd::span<const glm::vec3>{ grid.m_positions.data(), grid.m_positions.size() }, maxTriangleCount, clusterOffsets);
+    }
+
+    AZStd::vector<std::array<std::uint32_t, 3>> SortedTriangles(const AZStd::vector<std::uint32_t>& indices)
+    {
+        AZStd::vector<std::array<std::uint32_t, 3>> triangles;
+        for (std::size_t i = 0; i < indices.size(); i += 3)
+        {
+            triangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+} // namespace
+
+class MeshPartitionerTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(MeshPartitionerTest, EveryTriangleIsKeptOnce)
+{
+    GridMesh grid = CreateGrid(32);
+    AZStd::vector<std::array<std::uint32_t, 3>> originalTriangles = SortedTriangles(grid.m_indices);
+
+    AZStd::vector<std::uint32_t> clusterOffsets;
+    Partition(grid, 100, clusterOffsets);
+
+    ASSERT_TRUE(SortedTriangles(grid.m_indices) == originalTriangles);
+}
+
+TEST_F(MeshPartitionerTest, ClustersCoverTheTrianglesWithinTheMaximumSize)
+{
+    GridMesh grid = CreateGrid(32);
+    std::size_t triangleCount = grid.m_indices.size() / 3;
+
+    AZStd::vector<std::uint32_t> clusterOffsets;
+    Partition(grid, 100, clusterOffsets);
+
+    ASSERT_GE(clusterOffsets.size(), 2);
+    ASSERT_EQ(clusterOffsets.front(), 0);
+    ASSERT_EQ(clusterOffsets.back(), triangleCount);
+    for (std::size_t i = 0; i + 1 < clusterOffsets.size(); ++i)
+    {
+        ASSERT_LT(clusterOffsets[i], clusterOffsets[i + 1]);
+        ASSERT_LE(clusterOffsets[i + 1] - clusterOffsets[i], 100);
+    }
+}
+
+TEST_F(MeshPartitionerTest, SmallMeshIsASingleCluster)
+{
+    GridMesh grid = CreateGrid(4);
+    AZStd::vector<std::uint32_t> originalIndices = grid.m_indices;
+
+    AZStd::vector<std::uint32_t> clusterOffsets;
+    Partition(grid, 100, clusterOffsets);
+
+    ASSERT_EQ(clusterOffsets.size(), 2);
+    ASSERT_EQ(clusterOffsets[1], grid.m_indices.size() / 3);
+    ASSERT_TRUE(grid.m_indices == originalIndices);
+}
+
+TEST_F(MeshPartitionerTest, ClustersAreSpatiallyCompact)
+{
+    GridMesh grid = CreateGrid(32);
+
+    AZStd::vector<std::uint32_t> clusterOffsets;
+    Partition(grid, 128, clusterOffsets);
+
+    // each cluster bounds a fraction of the grid, where a cluster of consecutive rows would span its full width
+    for (std::size_t i = 0; i + 1 < clusterOffsets.size(); ++i)
+    {
+        glm::vec3 minimum{ std::numeric_limits<float>::max() };
+        glm::vec3 maximum{ std::numeric_limits<float>::lowest() };
+        for (std::uint32_t index = clusterOffsets[i] * 3; index < clusterOffsets[i + 1] * 3; ++index)
+        {
+            minimum = glm::min(minimum, grid.m_positions[grid.m_indices[index]]);
+            maximum = glm::max(maximum, grid.m_positions[grid.m_indices[index]]);
+        }
+
+        glm::vec3 extent = maximum - minimum;
+        ASSERT_LT(extent.x * extent.y, 32.0f * 32.0f / 4.0f);
+    }
+}
+
+TEST_F(MeshPartitionerTest, OutOfRangeIndicesKeepASingleCluster)
+{
+    GridMesh grid = CreateGrid(32);
+    grid.m_indices[grid.m_indices.size() / 2] = static_cast<std::uint32_t>(grid.m_positions.size());
+    AZStd::vector<std::uint32_t> originalIndices = grid.m_indices;
+
+    AZStd::vector<std::uint32_t> clusterOffsets;
+    Partition(grid, 100, clusterOffsets);
+
+    ASSERT_EQ(clusterOffsets.size(), 2);
+    ASSERT_EQ(clusterOffsets[0], 0);
+    ASSERT_EQ(clusterOffsets[1], grid.m_indices.size() / 3);
+    ASSERT_TRUE(grid.m_indices == originalIndices);
+}
@@ -0,0 +1,120 @@
+#include "Cesium/Gltf/MeshSimplifier.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    struct GridMesh
+    {
+        AZStd::vector<glm::vec3> m_positions;
+        AZStd::vector<std::uint32_t> m_indices;
+    };
+
+    // Create a grid of quads on the XY plane, with a height given by heightFunction
+    template<typename HeightFunction>
+    GridMesh CreateGrid(std::uint32_t quadsPerSide, HeightFunction heightFunction)
+    {
+        GridMesh grid;
+        std::uint32_t verticesPerSide = quadsPerSide + 1;
+        for (std::uint32_t y = 0; y < verticesPerSide; ++y)
+        {
+            for (std::uint32_t x = 0; x < verticesPerSide; ++x)
+            {
+                float fx = static_cast<float>(x);
+                float fy = static_cast<float>(y);
+                grid.m_positions.emplace_back(fx, fy, heightFunction(fx, fy));
+            }
+        }
+
+        for (std::uint32_t y = 0; y < quadsPerSide; ++y)
+        {
+            for (std::uint32_t x = 0; x < quadsPerSide; ++x)
+            {
+                std::uint32_t v0 = y * verticesPerSide + x;
+                std::uint32_t v1 = v0 + 1;
+                std::uint32_t v2 = v0 + verticesPerSide;
+                std::uint32_t v3 = v2 + 1;
+                grid.m_indices.insert(grid.m_indices.end(), { v0, v1, v2, v1, v3, v2 });
+            }
+        }
+
+        return grid;
+    }
+
+    float Simplify(const GridMesh& grid, AZStd::vector<std::uint32_t>& simplified, std::size_t targetIndexCount, float targetError)
+    {
+        return Cesium::MeshSimplifier::Simplify(
+            simplified, AZStd::span<const std::uint32_t>{ grid.m_indices.data(), grid.m_indices.size() },
+            AZStd::span<const glm::vec3>{ grid.m_positions.data(), grid.m_positions.size() }, targetIndexCount, targetError);
+    }
+} // namespace
+
+class MeshSimplifierTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(MeshSimplifierTest, PlanarGridIsSimplifiedWithoutError)
+{
+    GridMesh grid = CreateGrid(
+        16,
+        [](float, float)
+        {
+            return 0.0f;
+        });
+
+    AZStd::vector<std::uint32_t> simplified;
+    float error = Simplify(grid, simplified, grid.m_indices.size() / 4, 0.01f);
+
+    ASSERT_LE(simplified.size(), grid.m_indices.size() / 2);
+    ASSERT_EQ(simplified.size() % 3, 0);
+    ASSERT_LT(error, 1e-4f);
+
+    // the border is locked, so the corners of the grid are still there
+    for (std::uint32_t corner : { 0u, 16u, 17u * 16u, 17u * 17u - 1u })
+    {
+        ASSERT_NE(std::find(simplified.begin(), simplified.end(), corner), simplified.end());
+    }
+
+    // no triangle is flipped
+    for (std::size_t i = 0; i < simplified.size(); i += 3)
+    {
+        const glm::vec3& p0 = grid.m_positions[simplified[i]];
+        const glm::vec3& p1 = grid.m_positions[simplified[i + 1]];
+        const glm::vec3& p2 = grid.m_positions[simplified[i + 2]];
+        ASSERT_GT(glm::cross(p1 - p0, p2 - p0).z, 0.0f);
+    }
+}
+
+TEST_F(MeshSimplifierTest, ErrorLimitStopsSimplification)
+{
+    GridMesh grid = CreateGrid(
+        16,
+        [](float x, float y)
+        {
+            return 4.0f * std::sin(x) * std::cos(y);
+        });
+
+    AZStd::vector<std::uint32_t> simplified;
+    float error = Simplify(grid, simplified, 0, 0.0f);
+
+    ASSERT_EQ(simplified, grid.m_indices);
+    ASSERT_EQ(error, 0.0f);
+}
+
+TEST_F(MeshSimplifierTest, ErrorStaysWithinTarget)
+{
+    GridMesh grid = CreateGrid(
+        32,
+        [](float x, float y)
+        {
+            return 0.5f * std::sin(x * 0.2f) * std::cos(y * 0.2f);
+        });
+
+    AZStd::vector<std::uint32_t> simplified;
+    float error = Simplify(grid, simplified, 0, 0.02f);
+
+    ASSERT_LT(simplified.size(), grid.m_indices.size());
+    ASSERT_LE(error, 0.02f);
+}
@@ -0,0 +1,288 @@
+#include "Cesium/Gltf/MeshoptDecoder.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace
+{
+    std::uint8_t ZigZag8(std::uint8_t value)
+    {
+        return static_cast<std::uint8_t>((value << 1) ^ static_cast<std::uint8_t>(static_cast<std::int8_t>(value) >> 7));
+    }
+
+    std::uint32_t ZigZag32(std::int32_t value)
+    {
+        return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+    }
+
+    void EncodeVByte(AZStd::vector<std::byte>& output, std::uint32_t value)
+    {
+        do
+        {
+            std::uint8_t group = static_cast<std::uint8_t>(value & 127);
+            value >>= 7;
+            output.push_back(static_cast<std::byte>(value ? group | 128 : group));
+        } while (value);
+    }
+
+    // Encode a group of 16 deltas with the mode that takes the least bytes
+    void EncodeByteGroup(AZStd::vector<std::byte>& output, const std::uint8_t* values, std::uint8_t& mode)
+    {
+        auto getSize = [values](std::uint32_t bits)
+        {
+            std::uint8_t sentinel = static_cast<std::uint8_t>((1u << bits) - 1);
+            std::size_t size = 16 * bits / 8;
+            size += std::count_if(
+                values, values + 16,
+                [sentinel](std::uint8_t value)
+                {
+                    return value >= sentinel;
+                });
+            return size;
+        };
+
+        if (std::all_of(
+                values, values + 16,
+                [](std::uint8_t value)
+                {
+                    return value == 0;
+                }))
+        {
+            mode = 0;
+            return;
+        }
+
+        std::size_t size2 = getSize(2);
+        std::size_t size4 = getSize(4);
+        if (size2 >= 16 && size4 >= 16)
+        {
+            mode = 3;
+            output.insert(output.end(), reinterpret_cast<const std::byte*>(values), reinterpret_cast<const std::byte*>(values) + 16);
+            return;
+        }
+
+        mode = size2 <= size4 ? 1 : 2;
+        std::uint32_t bits = mode == 1 ? 2 : 4;
+        std::uint8_t sentinel = static_cast<std::uint8_t>((1u << bits) - 1);
+        std::uint32_t valuesPerByte = 8 / bits;
+        for (std::size_t i = 0; i < 16; i += valuesPerByte)
+        {
+            std::uint8_t packed = 0;
+            for (std::size_t j = 0; j < valuesPerByte; ++j)
+            {
+                packed = static_cast<std::uint8_t>((packed << bits) | std::min(values[i + j], sentinel));
+            }
+
+            output.push_back(static_cast<std::byte>(packed));
+        }
+
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            if (values[i] >= sentinel)
+            {
+                output.push_back(static_cast<std::byte>(values[i]));
+            }
+        }
+    }
+
+    // Reference encoder of the ATTRIBUTES mode, using the first vertex as the base of the deltas
+    AZStd::vector<std::byte> EncodeVertexBuffer(const AZStd::vector<std::uint8_t>& vertices, std::size_t byteStride)
+    {
+        std::size_t count = vertices.size() / byteStride;
+        AZStd::vector<std::byte> output;
+        output.push_back(std::byte{ 0xA0 });
+
+        AZStd::vector<std::uint8_t> lastVertex(vertices.begin(), vertices.begin() + byteStride);
+        std::size_t blockSize = std::min<std::size_t>((8192 / byteStride) & ~std::size_t(15), 256);
+        for (std::size_t firstVertex = 0; firstVertex < count; firstVertex += blockSize)
+        {
+            std::size_t blockCount = std::min(blockSize, count - firstVertex);
+            std::size_t alignedBlockCount = (blockCount + 15) & ~std::size_t(15);
+            for (std::size_t k = 0; k < byteStride; ++k)
+            {
+                AZStd::vector<std::uint8_t> deltas(alignedBlockCount, 0);
+                for (std::size_t i = 0; i < blockCount; ++i)
+                {
+                    std::uint8_t value = vertices[(firstVertex + i) * byteStride + k];
+                    deltas[i] = ZigZag8(static_cast<std::uint8_t>(value - lastVertex[k]));
+                    lastVertex[k] = value;
+                }
+
+                std::size_t groupCount = alignedBlockCount / 16;
+                std::size_t headerOffset = output.size();
+                output.resize(output.size() + (groupCount + 3) / 4, std::byte{ 0 });
+                for (std::size_t group = 0; group < groupCount; ++group)
+                {
+                    std::uint8_t mode = 0;
+                    EncodeByteGroup(output, deltas.data() + group * 16, mode);
+                    output[headerOffset + group / 4] |= static_cast<std::byte>(mode << ((group % 4) * 2));
+                }
+            }
+        }
+
+        std::size_t tailSize = std::max<std::size_t>(byteStride, 32);
+        output.resize(output.size() + tailSize - byteStride, std::byte{ 0 });
+        const std::byte* firstVertex = reinterpret_cast<const std::byte*>(vertices.data());
+        output.insert(output.end(), firstVertex, firstVertex + byteStride);
+        return output;
+    }
+
+    // Reference encoder of the INDICES mode, using only the first of the two last indices
+    AZStd::vector<std::byte> EncodeIndexSequence(const AZStd::vector<std::uint32_t>& indices)
+    {
+        AZStd::vector<std::byte> output;
+        output.push_back(std::byte{ 0xD1 });
+        std::uint32_t last = 0;
+        for (std::uint32_t index : indices)
+        {
+            EncodeVByte(output, ZigZag32(static_cast<std::int32_t>(index - last)) << 1);
+            last = index;
+        }
+
+        output.resize(output.size() + 4, std::byte{ 0 });
+        return output;
+    }
+
+    AZStd::vector<std::uint8_t> CreateVertices(std::size_t count, std::size_t byteStride)
+    {
+        // smooth values with some noise, similar to quantized positions of a mesh
+        std::mt19937 random{ 7 };
+        AZStd::vector<std::uint8_t> vertices(count * byteStride);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t k = 0; k < byteStride; ++k)
+            {
+                vertices[i * byteStride + k] = static_cast<std::uint8_t>(i * (k + 1) / 3 + random() % 4);
+            }
+        }
+
+        return vertices;
+    }
+} // namespace
+
+class MeshoptDecoderTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(MeshoptDecoderTest, DecodeVertexBufferAcrossSeveralBlocks)
+{
+    static constexpr std::size_t byteStride = 12;
+    AZStd::vector<std::uint8_t> vertices = CreateVertices(1000, byteStride);
+    AZStd::vector<std::byte> encoded = EncodeVertexBuffer(vertices, byteStride);
+
+    AZStd::vector<std::byte> decoded(vertices.size());
+    ASSERT_TRUE(Cesium::MeshoptDecoder::DecodeVertexBuffer(
+        AZStd::span<std::byte>{ decoded.data(), decoded.size() }, 1000, byteStride,
+        AZStd::span<const std::byte>{ encoded.data(), encoded.size() }));
+    ASSERT_EQ(std::memcmp(decoded.data(), vertices.data(), vertices.size()), 0);
+}
+
+TEST_F(MeshoptDecoderTest, DecodeVertexBufferRejectsTruncatedData)
+{
+    static constexpr std::size_t byteStride = 8;
+    AZStd::vector<std::uint8_t> vertices = CreateVertices(100, byteStride);
+    AZStd::vector<std::byte> encoded = EncodeVertexBuffer(vertices, byteStride);
+    encoded.erase(encoded.begin() + encoded.size() / 2);
+
+    AZStd::vector<std::byte> decoded(vertices.size());
+    ASSERT_FALSE(Cesium::MeshoptDecoder::DecodeVertexBuffer(
+        AZStd::span<std::byte>{ decoded.data(), decoded.size() }, 100, byteStride,
+        AZStd::span<const std::byte>{ encoded.data(), encoded.size() }));
+}
+
+TEST_F(MeshoptDecoderTest, DecodeIndexBuffer)
+{
+    // Two triangles (0, 1, 2) and (2, 1, 3). The first one has three new vertices, which is the first code of the auxiliary
+    // table. The second one reuses the edge (2, 1), which is the second newest edge of the FIFO, with a new vertex
+    AZStd::vector<std::byte> encoded{ std::byte{ 0xE1 }, std::byte{ 0xF0 }, std::byte{ 0x10 } };
+    const std::uint8_t codeAuxTable[16] = { 0x00, 0x76, 0x87, 0x56, 0x67, 0x78, 0xA9, 0x86, 0x65, 0x89, 0x68, 0x98, 0x01, 0x69, 0, 0 };
+    encoded.insert(encoded.end(), reinterpret_cast<const std::byte*>(codeAuxTable), reinterpret_cast<const std::byte*>(codeAuxTable) + 16);
+
+    std::uint16_t indices[6] = {};
+    ASSERT_TRUE(Cesium::MeshoptDecoder::DecodeIndexBuffer(
+        AZStd::span<std::byte>{ reinterpret_cast<std::byte*>(indices), sizeof(indices) }, 6, sizeof(std::uint16_t),
+        AZStd::span<const std::byte>{ encoded.data(), encoded.size() }));
+
+    const std::uint16_t expected[6] = { 0, 1, 2, 2, 1, 3 };
+    ASSERT_EQ(std::memcmp(indices, expected, sizeof(indices)), 0);
+}
+
+TEST_F(MeshoptDecoderTest, DecodeIndexSequence)
+{
+    AZStd::vector<std::uint32_t> indices{ 5, 6, 7, 100, 3, 70000, 69999, 0 };
+    AZStd::vector<std::byte> encoded = EncodeIndexSequence(indices);
+
+    AZStd::vector<std::uint32_t> decoded(indices.size());
+    ASSERT_TRUE(Cesium::MeshoptDecoder::DecodeIndexSequence(
+        AZStd::span<std::byte>{ reinterpret_cast<std::byte*>(decoded.data()), decoded.size() * sizeof(std::uint32_t) }, indices.size(),
+        sizeof(std::uint32_t), AZStd::span<const std::byte>{ encoded.data(), encoded.size() }));
+    ASSERT_EQ(decoded, indices);
+}
+
+TEST_F(MeshoptDecoderTest, DecodeOctahedralFilterProducesUnitVectors)
+{
+    // the third component stores 1.0. The center of the octahedral map is the +Z axis, and its corners are the -Z axis
+    std::int8_t normals[8] = { 0, 0, 127, 0, 127, 127, 127, 0 };
+    ASSERT_TRUE(Cesium::MeshoptDecoder::DecodeOctahedralFilter(AZStd::span<std::byte>{ reinterpret_cast<std::byte*>(normals), 8 }, 2, 4));
+    ASSERT_EQ(normals[0], 0);
+    ASSERT_EQ(normals[1], 0);
+    ASSERT_EQ(normals[2], 127);
+    ASSERT_EQ(normals[4], 0);
+    ASSERT_EQ(normals[5], 0);
+    ASSERT_EQ(normals[6], -127);
+}
+
+TEST_F(MeshoptDecoderTest, DecodeExponentialFilter)
+{
+    // mantissa 3 with exponent -1, and mantissa -5 with exponent 2
+    std::uint32_t values[2] = { (0xFFu << 24) | 3u, (2u << 24) | (0x00FFFFFFu & static_cast<std::uint32_t>(-5)) };
+    ASSERT_TRUE(Cesium::MeshoptDecoder::DecodeExponentialFilter(AZStd::span<std::byte>{ reinterpret_cast<std::byte*>(values), 8 }, 2, 4));
+
+    float decoded[2];
+    std::memcpy(decoded, values, sizeof(decoded));
+    ASSERT_FLOAT_EQ(decoded[0], 1.5f);
+    ASSERT_FLOAT_EQ(decoded[1], -20.0f);
+}
+
+#if defined(HAVE_BENCHMARK)
+class MeshoptDecoderBenchmark : public UnitTest::AllocatorsBenchmarkFixture
+{
+};
+
+BENCHMARK_F(MeshoptDecoderBenchmark, DecodeVertexBuffer)(benchmark::State& state)
+{
+    static constexpr std::size_t byteStride = 16;
+    static constexpr std::size_t vertexCount = 1 << 16;
+    AZStd::vector<std::uint8_t> vertices = CreateVertices(vertexCount, byteStride);
+    AZStd::vector<std::byte> encoded = EncodeVertexBuffer(vertices, byteStride);
+    AZStd::vector<std::byte> decoded(vertices.size());
+    for (auto _ : state)
+    {
+        Cesium::MeshoptDecoder::DecodeVertexBuffer(
+            AZStd::span<std::byte>{ decoded.data(), decoded.size() }, vertexCount, byteStride,
+            AZStd::span<const std::byte>{ encoded.data(), encoded.size() });
+        benchmark::DoNotOptimize(decoded.data());
+    }
+
+    state.counters["CompressionRatio"] = static_cast<double>(vertices.size()) / static_cast<double>(encoded.size());
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(vertices.size()));
+}
+
+// Baseline of an uncompressed buffer view, which only needs to be copied into the vertex buffer
+BENCHMARK_F(MeshoptDecoderBenchmark, CopyUncompressedVertexBuffer)(benchmark::State& state)
+{
+    static constexpr std::size_t byteStride = 16;
+    static constexpr std::size_t vertexCount = 1 << 16;
+    AZStd::vector<std::uint8_t> vertices = CreateVertices(vertexCount, byteStride);
+    AZStd::vector<std::byte> copied(vertices.size());
+    for (auto _ : state)
+    {
+        std::memcpy(copied.data(), vertices.data(), vertices.size());
+        benchmark::DoNotOptimize(copied.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(vertices.size()));
+}
+#endif
@@ -0,0 +1,132 @@
+#include "Cesium/Gltf/StreamingImageBuilder.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    AZStd::vector<std::byte> CreateImage(std::uint32_t width, std::uint32_t height, std::uint32_t channelCount, std::uint8_t value)
+    {
+        return AZStd::vector<std::byte>(std::size_t{ width } * height * channelCount, static_cast<std::byte>(value));
+    }
+
+    AZStd::vector<std::byte> Downsample(
+        const AZStd::vector<std::byte>& image, std::uint32_t width, std::uint32_t height, std::uint32_t channelCount, bool isSrgb)
+    {
+        AZStd::vector<std::byte> mip(std::size_t{ AZStd::max(width / 2, 1u) } * AZStd::max(height / 2, 1u) * channelCount);
+        Cesium::StreamingImageBuilder::Downsample(
+            AZStd::span<const std::byte>{ image.data(), image.size() }, width, height, channelCount, isSrgb,
+            AZStd::span<std::byte>{ mip.data(), mip.size() });
+        return mip;
+    }
+
+    float SrgbToLinear(float srgb)
+    {
+        return srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+    }
+} // namespace
+
+class StreamingImageBuilderTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(StreamingImageBuilderTest, MipLevelCountGoesDownToOnePixel)
+{
+    ASSERT_EQ(Cesium::StreamingImageBuilder::GetMipLevelCount(1, 1), 1);
+    ASSERT_EQ(Cesium::StreamingImageBuilder::GetMipLevelCount(256, 256), 9);
+    ASSERT_EQ(Cesium::StreamingImageBuilder::GetMipLevelCount(256, 64), 9);
+    ASSERT_EQ(Cesium::StreamingImageBuilder::GetMipLevelCount(300, 17), 9);
+}
+
+TEST_F(StreamingImageBuilderTest, UniformImageKeepsItsValue)
+{
+    for (std::uint32_t value = 0; value < 256; ++value)
+    {
+        AZStd::vector<std::byte> image = CreateImage(4, 4, 4, static_cast<std::uint8_t>(value));
+        AZStd::vector<std::byte> srgbMip = Downsample(image, 4, 4, 4, true);
+        AZStd::vector<std::byte> linearMip = Downsample(image, 4, 4, 4, false);
+        for (std::size_t i = 0; i < srgbMip.size(); ++i)
+        {
+            ASSERT_EQ(static_cast<std::uint32_t>(srgbMip[i]), value);
+            ASSERT_EQ(static_cast<std::uint32_t>(linearMip[i]), value);
+        }
+    }
+}
+
+TEST_F(StreamingImageBuilderTest, SrgbColorsAreAveragedInLinearSpace)
+{
+    // a checkerboard of black and white averages to half the light, which is brighter than the code 128
+    AZStd::vector<std::byte> image = CreateImage(2, 2, 4, 0);
+    for (std::size_t pixel : { 0, 3 })
+    {
+        for (std::size_t channel = 0; channel < 4; ++channel)
+        {
+            image[pixel * 4 + channel] = static_cast<std::byte>(255);
+        }
+    }
+
+    AZStd::vector<std::byte> srgbMip = Downsample(image, 2, 2, 4, true);
+    AZStd::vector<std::byte> linearMip = Downsample(image, 2, 2, 4, false);
+    ASSERT_EQ(srgbMip.size(), 4);
+    for (std::size_t channel = 0; channel < 3; ++channel)
+    {
+        float linear = SrgbToLinear(static_cast<float>(srgbMip[channel]) / 255.0f);
+        ASSERT_NEAR(linear, 0.5f, 0.005f);
+        ASSERT_EQ(static_cast<std::uint32_t>(linearMip[channel]), 128);
+    }
+
+    // alpha is linear
+    ASSERT_EQ(static_cast<std::uint32_t>(srgbMip[3]), 128);
+}
+
+TEST_F(StreamingImageBuilderTest, OddSizesRepeatTheLastRowAndColumn)
+{
+    // 3x1 image of a single channel is downsampled to 1x1 from its first two pixels
+    AZStd::vector<std::byte> image{ std::byte{ 10 }, std::byte{ 30 }, std::byte{ 250 } };
+    AZStd::vector<std::byte> mip = Downsample(image, 3, 1, 1, false);
+    ASSERT_EQ(mip.size(), 1);
+    ASSERT_EQ(static_cast<std::uint32_t>(mip[0]), 20);
+
+    // 1x3 image keeps its width
+    mip = Downsample(image, 1, 3, 1, false);
+    ASSERT_EQ(mip.size(), 1);
+    ASSERT_EQ(static_cast<std::uint32_t>(mip[0]), 20);
+}
+
+#if defined(HAVE_BENCHMARK)
+class StreamingImageBuilderBenchmark : public UnitTest::AllocatorsBenchmarkFixture
+{
+};
+
+// Items processed are the pixels of the most detailed mip, so the rate is the cost of a full mip chain per source pixel
+BENCHMARK_DEFINE_F(StreamingImageBuilderBenchmark, GenerateMipChain)(benchmark::State& state)
+{
+    std::uint32_t size = static_cast<std::uint32_t>(state.range(0));
+    bool isSrgb = state.range(1) != 0;
+    AZStd::vector<std::byte> image(std::size_t{ size } * size * 4);
+    for (std::size_t i = 0; i < image.size(); ++i)
+    {
+        image[i] = static_cast<std::byte>(std::rand() & 0xFF);
+    }
+
+    for (auto _ : state)
+    {
+        AZStd::vector<std::byte> mip = Downsample(image, size, size, 4, isSrgb);
+        for (std::uint32_t mipSize = size / 2; mipSize > 1; mipSize /= 2)
+        {
+            mip = Downsample(mip, mipSize, mipSize, 4, isSrgb);
+        }
+
+        benchmark::DoNotOptimize(mip.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size) * size);
+}
+
+BENCHMARK_REGISTER_F(StreamingImageBuilderBenchmark, GenerateMipChain)
+    ->ArgNames({ "Size", "IsSrgb" })
+    ->Args({ 256, 1 })
+    ->Args({ 1024, 0 })
+    ->Args({ 1024, 1 });
+#endif
@@ -0,0 +1,293 @@
+#include "Cesium/Gltf/TextureBlockCompressor.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/vector.h>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    void DecodeRgb565(std::uint32_t packed, std::int32_t (&color)[3])
+    {
+        std::int32_t r = (packed >> 11) & 31;
+        std::int32_t g = (packed >> 5) & 63;
+        std::int32_t b = packed & 31;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    // Decode the color block of BC1 or BC3 into the RGB channels of 16 pixels
+    void DecodeColorBlock(const std::uint8_t* block, std::int32_t (&pixels)[16][3])
+    {
+        std::uint32_t color0 = block[0] | (block[1] << 8);
+        std::uint32_t color1 = block[2] | (block[3] << 8);
+        std::int32_t palette[4][3];
+        DecodeRgb565(color0, palette[0]);
+        DecodeRgb565(color1, palette[1]);
+        for (std::size_t channel = 0; channel < 3; ++channel)
+        {
+            if (color0 > color1)
+            {
+                palette[2][channel] = (2 * palette[0][channel] + palette[1][channel]) / 3;
+                palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel]) / 3;
+            }
+            else
+            {
+                palette[2][channel] = (palette[0][channel] + palette[1][channel]) / 2;
+                palette[3][channel] = 0;
+            }
+        }
+
+        std::uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<std::uint32_t>(block[7]) << 24);
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            std::uint32_t index = (indices >> (i * 2)) & 3;
+            for (std::size_t channel = 0; channel < 3; ++channel)
+            {
+                pixels[i][channel] = palette[index][channel];
+            }
+        }
+    }
+
+    void DecodeSingleChannelBlock(const std::uint8_t* block, std::int32_t (&values)[16])
+    {
+        std::int32_t palette[8];
+        palette[0] = block[0];
+        palette[1] = block[1];
+        for (std::int32_t i = 2; i < 8; ++i)
+        {
+            palette[i] = block[0] > block[1] ? ((8 - i) * block[0] + (i - 1) * block[1]) / 7 : 0;
+        }
+
+        std::uint64_t indices = 0;
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            indices |= static_cast<std::uint64_t>(block[2 + i]) << (i * 8);
+        }
+
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            values[i] = palette[(indices >> (i * 3)) & 7];
+        }
+    }
+
+    AZStd::vector<std::byte> CreateGradient(std::uint32_t size, std::uint32_t channelCount)
+    {
+        AZStd::vector<std::byte> image(std::size_t{ size } * size * channelCount);
+        for (std::uint32_t y = 0; y < size; ++y)
+        {
+            for (std::uint32_t x = 0; x < size; ++x)
+            {
+                std::byte* pixel = image.data() + (std::size_t{ y } * size + x) * channelCount;
+                pixel[0] = static_cast<std::byte>(x * 255 / (size - 1));
+                for (std::uint32_t channel = 1; channel < channelCount; ++channel)
+                {
+                    pixel[channel] = static_cast<std::byte>((channel == 3 ? y : (x + y * channel) / 2) * 255 / (size - 1));
+                }
+            }
+        }
+
+        return image;
+    }
+
+    AZStd::vector<std::byte> Compress(
+        const AZStd::vector<std::byte>& image, std::uint32_t size, AZ::RHI::Format format, Cesium::TextureCompressionQuality quality)
+    {
+        AZStd::vector<std::byte> blocks(Cesium::TextureBlockCompressor::GetCompressedSize(size, size, format));
+        Cesium::TextureBlockCompressor::Compress(
+            AZStd::span<const std::byte>{ image.data(), image.size() }, size, size, format, quality,
+            AZStd::span<std::byte>{ blocks.data(), blocks.size() });
+        return blocks;
+    }
+
+    // Root mean square error of the RGB channels of a BC1 image, or of the color blocks of a BC3 image
+    float CalculateColorError(const AZStd::vector<std::byte>& image, const AZStd::vector<std::byte>& blocks, std::uint32_t size, bool isBC3)
+    {
+        double squaredError = 0.0;
+        std::size_t blockSize = isBC3 ? 16 : 8;
+        std::size_t blockIndex = 0;
+        for (std::uint32_t blockY = 0; blockY < size; blockY += 4)
+        {
+            for (std::uint32_t blockX = 0; blockX < size; blockX += 4)
+            {
+                std::int32_t pixels[16][3];
+                const std::uint8_t* block = reinterpret_cast<const std::uint8_t*>(blocks.data()) + blockIndex * blockSize;
+                DecodeColorBlock(isBC3 ? block + 8 : block, pixels);
+                for (std::uint32_t i = 0; i < 16; ++i)
+                {
+                    const std::byte* pixel = image.data() + (std::size_t{ blockY + i / 4 } * size + blockX + i % 4) * 4;
+                    for (std::size_t channel = 0; channel < 3; ++channel)
+                    {
+                        double difference = pixels[i][channel] - static_cast<std::int32_t>(pixel[channel]);
+                        squaredError += difference * difference;
+                    }
+                }
+
+                ++blockIndex;
+            }
+        }
+
+        return static_cast<float>(std::sqrt(squaredError / (std::size_t{ size } * size * 3)));
+    }
+} // namespace
+
+class TextureBlockCompressorTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(TextureBlockCompressorTest, FormatsAreSelectedFromTheAlpha)
+{
+    ASSERT_EQ(
+        Cesium::TextureBlockCompressor::GetCompressedFormat(AZ::RHI::Format::R8G8B8A8_UNORM_SRGB, false), AZ::RHI::Format::BC1_UNORM_SRGB);
+    ASSERT_EQ(
+        Cesium::TextureBlockCompressor::GetCompressedFormat(AZ::RHI::Format::R8G8B8A8_UNORM_SRGB, true), AZ::RHI::Format::BC3_UNORM_SRGB);
+    ASSERT_EQ(Cesium::TextureBlockCompressor::GetCompressedFormat(AZ::RHI::Format::R8_UNORM, false), AZ::RHI::Format::BC4_UNORM);
+    ASSERT_EQ(Cesium::TextureBlockCompressor::GetCompressedFormat(AZ::RHI::Format::R32_FLOAT, false), AZ::RHI::Format::Unknown);
+    ASSERT_EQ(Cesium::TextureBlockCompressor::GetCompressedSize(8, 8, AZ::RHI::Format::BC1_UNORM), 32);
+    ASSERT_EQ(Cesium::TextureBlockCompressor::GetCompressedSize(6, 2, AZ::RHI::Format::BC3_UNORM), 32);
+    ASSERT_EQ(Cesium::TextureBlockCompressor::GetCompressedSize(1, 1, AZ::RHI::Format::BC4_UNORM), 8);
+}
+
+TEST_F(TextureBlockCompressorTest, SolidColorIsKeptWithinTheEndpointPrecision)
+{
+    AZStd::vector<std::byte> image(4 * 4 * 4);
+    for (std::size_t i = 0; i < image.size(); i += 4)
+    {
+        image[i] = std::byte{ 200 };
+        image[i + 1] = std::byte{ 100 };
+        image[i + 2] = std::byte{ 16 };
+        image[i + 3] = std::byte{ 255 };
+    }
+
+    for (Cesium::TextureCompressionQuality quality : { Cesium::TextureCompressionQuality::Fast, Cesium::TextureCompressionQuality::High })
+    {
+        AZStd::vector<std::byte> blocks = Compress(image, 4, AZ::RHI::Format::BC1_UNORM, quality);
+        ASSERT_EQ(blocks.size(), 8);
+        ASSERT_LE(CalculateColorError(image, blocks, 4, false), 4.0f);
+    }
+}
+
+TEST_F(TextureBlockCompressorTest, HighQualityIsAtLeastAsAccurateAsFast)
+{
+    std::srand(7);
+    AZStd::vector<std::byte> image = CreateGradient(64, 4);
+    for (std::size_t i = 0; i < image.size(); ++i)
+    {
+        image[i] = static_cast<std::byte>(AZStd::clamp(static_cast<std::int32_t>(image[i]) + std::rand() % 17 - 8, 0, 255));
+    }
+
+    float fastError = CalculateColorError(
+        image, Compress(image, 64, AZ::RHI::Format::BC1_UNORM, Cesium::TextureCompressionQuality::Fast), 64, false);
+    float highError = CalculateColorError(
+        image, Compress(image, 64, AZ::RHI::Format::BC1_UNORM, Cesium::TextureCompressionQuality::High), 64, false);
+    ASSERT_LT(fastError, 8.0f);
+    ASSERT_LE(highError, fastError);
+}
+
+TEST_F(TextureBlockCompressorTest, AlphaIsStoredInTheFirstHalfOfBC3Blocks)
+{
+    AZStd::vector<std::byte> image = CreateGradient(64, 4);
+    AZStd::vector<std::byte> blocks = Compress(image, 64, AZ::RHI::Format::BC3_UNORM, Cesium::TextureCompressionQuality::Fast);
+    ASSERT_EQ(blocks.size(), 16 * 16 * 16);
+    ASSERT_LT(CalculateColorError(image, blocks, 64, true), 8.0f);
+
+    std::int32_t alpha[16];
+    DecodeSingleChannelBlock(reinterpret_cast<const std::uint8_t*>(blocks.data()), alpha);
+    for (std::uint32_t i = 0; i < 16; ++i)
+    {
+        std::int32_t expected = static_cast<std::int32_t>(image[(std::size_t{ i / 4 } * 64 + i % 4) * 4 + 3]);
+        ASSERT_LE(std::abs(alpha[i] - expected), 3);
+    }
+}
+
+TEST_F(TextureBlockCompressorTest, SingleChannelUsesTheFullRangeOfTheBlock)
+{
+    AZStd::vector<std::byte> image = CreateGradient(4, 1);
+    AZStd::vector<std::byte> blocks = Compress(image, 4, AZ::RHI::Format::BC4_UNORM, Cesium::TextureCompressionQuality::Fast);
+    std::int32_t values[16];
+    DecodeSingleChannelBlock(reinterpret_cast<const std::uint8_t*>(blocks.data()), values);
+    for (std::uint32_t i = 0; i < 16; ++i)
+    {
+        ASSERT_LE(std::abs(values[i] - static_cast<std::int32_t>(image[i])), 19);
+    }
+}
+
+TEST_F(TextureBlockCompressorTest, TwoChannelsAreCompressedToIndependentBlocks)
+{
+    // red rises while green falls, so a shared palette couldn't fit both
+    AZStd::vector<std::byte> image(32);
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        image[i * 2] = static_cast<std::byte>(i * 17);
+        image[i * 2 + 1] = static_cast<std::byte>(255 - i * 17);
+    }
+
+    AZStd::vector<std::byte> blocks(16);
+    Cesium::TextureBlockCompressor::Compress(
+        AZStd::span<const std::byte>{ image.data(), image.size() }, 4, 4, AZ::RHI::Format::BC5_UNORM,
+        Cesium::TextureCompressionQuality::Fast, AZStd::span<std::byte>{ blocks.data(), blocks.size() });
+
+    std::int32_t red[16];
+    std::int32_t green[16];
+    DecodeSingleChannelBlock(reinterpret_cast<const std::uint8_t*>(blocks.data()), red);
+    DecodeSingleChannelBlock(reinterpret_cast<const std::uint8_t*>(blocks.data()) + 8, green);
+    for (std::int32_t i = 0; i < 16; ++i)
+    {
+        ASSERT_LE(std::abs(red[i] - i * 17), 19);
+        ASSERT_LE(std::abs(green[i] - (255 - i * 17)), 19);
+    }
+}
+
+TEST_F(TextureBlockCompressorTest, PartialBlocksRepeatTheEdges)
+{
+    AZStd::vector<std::byte> image{ std::byte{ 40 }, std::byte{ 200 } };
+    AZStd::vector<std::byte> blocks(8);
+    Cesium::TextureBlockCompressor::Compress(
+        AZStd::span<const std::byte>{ image.data(), image.size() }, 2, 1, AZ::RHI::Format::BC4_UNORM,
+        Cesium::TextureCompressionQuality::Fast, AZStd::span<std::byte>{ blocks.data(), blocks.size() });
+
+    std::int32_t values[16];
+    DecodeSingleChannelBlock(reinterpret_cast<const std::uint8_t*>(blocks.data()), values);
+    ASSERT_EQ(values[0], 40);
+    ASSERT_EQ(values[1], 200);
+    ASSERT_EQ(values[15], 200);
+}
+
+#if defined(HAVE_BENCHMARK)
+class TextureBlockCompressorBenchmark : public UnitTest::AllocatorsBenchmarkFixture
+{
+};
+
+// Items processed are pixels, which sizes the worker pool needed for a given texture load rate
+BENCHMARK_DEFINE_F(TextureBlockCompressorBenchmark, Compress)(benchmark::State& state)
+{
+    static constexpr std::uint32_t size = 512;
+    AZ::RHI::Format format = static_cast<AZ::RHI::Format>(state.range(0));
+    Cesium::TextureCompressionQuality quality = static_cast<Cesium::TextureCompressionQuality>(state.range(1));
+    std::uint32_t channelCount = format == AZ::RHI::Format::BC4_UNORM ? 1 : 4;
+    AZStd::vector<std::byte> image = CreateGradient(size, channelCount);
+    for (std::size_t i = 0; i < image.size(); ++i)
+    {
+        image[i] = static_cast<std::byte>(AZStd::clamp(static_cast<std::int32_t>(image[i]) + std::rand() % 17 - 8, 0, 255));
+    }
+
+    AZStd::vector<std::byte> blocks(Cesium::TextureBlockCompressor::GetCompressedSize(size, size, format));
+    for (auto _ : state)
+    {
+        Cesium::TextureBlockCompressor::Compress(
+            AZStd::span<const std::byte>{ image.data(), image.size() }, size, size, format, quality,
+            AZStd::span<std::byte>{ blocks.data(), blocks.size() });
+        benchmark::DoNotOptimize(blocks.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size) * size);
+}
+
+BENCHMARK_REGISTER_F(TextureBlockCompressorBenchmark, Compress)
+    ->ArgNames({ "Format", "Quality" })
+    ->Args({ static_cast<std::int64_t>(AZ::RHI::Format::BC1_UNORM), static_cast<std::int64_t>(Cesium::TextureCompressionQuality::Fast) })
+    ->Args({ static_cast<std::int64_t>(AZ::RHI::Format::BC1_UNORM), static_cast<std::int64_t>(Cesium::TextureCompressionQuality::High) })
+    ->Args({ static_cast<std::int64_t>(AZ::RHI::Format::BC3_UNORM), static_cast<std::int64_t>(Cesium::TextureCompressionQuality::Fast) })
+    ->Args({ static_cast<std::int64_t>(AZ::RHI::Format::BC4_UNORM), static_cast<std::int64_t>(Cesium::TextureCompressionQuality::Fast) });
+#endif
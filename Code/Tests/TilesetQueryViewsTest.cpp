@@ -0,0 +1,84 @@
+#include "Cesium/TilesetUtility/TilesetQueryViews.h"
+#include <Cesium/Math/GeospatialHelper.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <glm/gtc/constants.hpp>
+
+namespace
+{
+    // view looking straight down from 1 km above a position on the ellipsoid, with the tileset in ECEF
+    Cesium3DTilesSelection::ViewState CreateViewAbove(double longitude, double latitude)
+    {
+        glm::dvec3 position = Cesium::GeospatialHelper::CartographicToECEFCartesian(Cesium::Cartographic(longitude, latitude, 1000.0));
+        return Cesium::TilesetQueryViews::CreateDownwardViewState(position, glm::dmat4(1.0));
+    }
+
+    // tile of 100 meters on the ellipsoid
+    Cesium3DTilesSelection::BoundingVolume CreateTileAt(double longitude, double latitude)
+    {
+        glm::dvec3 center = Cesium::GeospatialHelper::CartographicToECEFCartesian(Cesium::Cartographic(longitude, latitude, 0.0));
+        return CesiumGeometry::BoundingSphere(center, 100.0);
+    }
+} // namespace
+
+class TilesetQueryViewsTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(TilesetQueryViewsTest, PositionsAreSortedAlongTheMortonCurve)
+{
+    // the four quadrants of the globe, given out of order. The curve goes west to east, then south to north
+    const double quarter = glm::half_pi<double>();
+    AZStd::vector<Cesium::Cartographic> positions{
+        Cesium::Cartographic(quarter, quarter * 0.5, 0.0),
+        Cesium::Cartographic(-quarter, -quarter * 0.5, 0.0),
+        Cesium::Cartographic(-quarter, quarter * 0.5, 0.0),
+        Cesium::Cartographic(quarter, -quarter * 0.5, 0.0),
+    };
+
+    AZStd::vector<std::uint32_t> order = Cesium::TilesetQueryViews::SortAlongMortonCurve(positions);
+    ASSERT_EQ(order.size(), 4);
+    EXPECT_EQ(order[0], 1);
+    EXPECT_EQ(order[1], 3);
+    EXPECT_EQ(order[2], 2);
+    EXPECT_EQ(order[3], 0);
+
+    EXPECT_TRUE(Cesium::TilesetQueryViews::SortAlongMortonCurve({}).empty());
+}
+
+TEST_F(TilesetQueryViewsTest, NearbyPositionsAreSortedNextToEachOther)
+{
+    // two clusters of positions interleaved in the request, on both sides of the globe
+    AZStd::vector<Cesium::Cartographic> positions;
+    for (std::uint32_t i = 0; i < 8; ++i)
+    {
+        double offset = 1e-6 * i;
+        double longitude = i % 2 == 0 ? -2.0 + offset : 2.0 + offset;
+        positions.emplace_back(longitude, 0.5 + offset, 0.0);
+    }
+
+    AZStd::vector<std::uint32_t> order = Cesium::TilesetQueryViews::SortAlongMortonCurve(positions);
+    ASSERT_EQ(order.size(), 8);
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(order[i] % 2, 0);
+        EXPECT_EQ(order[i + 4] % 2, 1);
+    }
+}
+
+TEST_F(TilesetQueryViewsTest, TilesOnlySelectedByQueryViewsAreNotVisible)
+{
+    std::vector<Cesium3DTilesSelection::ViewState> cameraViewStates{ CreateViewAbove(0.0, 0.0) };
+    Cesium3DTilesSelection::ViewState queryViewState = CreateViewAbove(glm::half_pi<double>(), 0.0);
+    Cesium3DTilesSelection::BoundingVolume tileUnderCamera = CreateTileAt(0.0, 0.0);
+    Cesium3DTilesSelection::BoundingVolume tileUnderQuery = CreateTileAt(glm::half_pi<double>(), 0.0);
+
+    // the query view selects the tile under it, which no camera sees
+    ASSERT_TRUE(queryViewState.isBoundingVolumeVisible(tileUnderQuery));
+    ASSERT_FALSE(cameraViewStates.front().isBoundingVolumeVisible(tileUnderQuery));
+    EXPECT_FALSE(Cesium::TilesetQueryViews::IsVisibleFromCameras(cameraViewStates, true, tileUnderQuery));
+
+    // tiles that a camera sees are rendered, whether there are query views or not
+    EXPECT_TRUE(Cesium::TilesetQueryViews::IsVisibleFromCameras(cameraViewStates, true, tileUnderCamera));
+    EXPECT_TRUE(Cesium::TilesetQueryViews::IsVisibleFromCameras(cameraViewStates, false, tileUnderCamera));
+}
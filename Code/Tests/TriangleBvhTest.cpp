@@ -0,0 +1,187 @@
+#include "Cesium/Gltf/TriangleBvh.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    struct GridMesh
+    {
+        AZStd::vector<glm::vec3> m_positions;
+        AZStd::vector<std::uint32_t> m_indices;
+    };
+
+    // Create a grid of quads on the XY plane, with a height given by heightFunction
+    template<typename HeightFunction>
+    GridMesh CreateGrid(std::uint32_t quadsPerSide, HeightFunction heightFunction)
+    {
+        GridMesh grid;
+        std::uint32_t verticesPerSide = quadsPerSide + 1;
+        for (std::uint32_t y = 0; y < verticesPerSide; ++y)
+        {
+            for (std::uint32_t x = 0; x < verticesPerSide; ++x)
+            {
+                float fx = static_cast<float>(x);
+                float fy = static_cast<float>(y);
+                grid.m_positions.emplace_back(fx, fy, heightFunction(fx, fy));
+            }
+        }
+
+        for (std::uint32_t y = 0; y < quadsPerSide; ++y)
+        {
+            for (std::uint32_t x = 0; x < quadsPerSide; ++x)
+            {
+                std::uint32_t v0 = y * verticesPerSide + x;
+                std::uint32_t v1 = v0 + 1;
+                std::uint32_t v2 = v0 + verticesPerSide;
+                std::uint32_t v3 = v2 + 1;
+                grid.m_indices.insert(grid.m_indices.end(), { v0, v1, v2, v1, v3, v2 });
+            }
+        }
+
+        return grid;
+    }
+
+    Cesium::TriangleBvh BuildBvh(const GridMesh& grid)
+    {
+        Cesium::TriangleBvh bvh;
+        bvh.Build(
+            AZStd::span<const glm::vec3>{ grid.m_positions.data(), grid.m_positions.size() },
+            AZStd::span<const std::uint32_t>{ grid.m_indices.data(), grid.m_indices.size() });
+        return bvh;
+    }
+
+    // Closest hit of every triangle, without the hierarchy
+    bool RaycastBruteForce(const GridMesh& grid, const glm::vec3& origin, const glm::vec3& direction, float& distance)
+    {
+        bool isHit = false;
+        distance = std::numeric_limits<float>::max();
+        for (std::size_t i = 0; i + 2 < grid.m_indices.size(); i += 3)
+        {
+            const glm::vec3& p0 = grid.m_positions[grid.m_indices[i]];
+            glm::vec3 edge1 = grid.m_positions[grid.m_indices[i + 1]] - p0;
+            glm::vec3 edge2 = grid.m_positions[grid.m_indices[i + 2]] - p0;
+            glm::vec3 p = glm::cross(direction, edge2);
+            float determinant = glm::dot(edge1, p);
+            if (std::abs(determinant) < 1e-12f)
+            {
+                continue;
+            }
+
+            float inverseDeterminant = 1.0f / determinant;
+            glm::vec3 s = origin - p0;
+            float u = glm::dot(s, p) * inverseDeterminant;
+            glm::vec3 q = glm::cross(s, edge1);
+            float v = glm::dot(direction, q) * inverseDeterminant;
+            float t = glm::dot(edge2, q) * inverseDeterminant;
+            if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < distance)
+            {
+                distance = t;
+                isHit = true;
+            }
+        }
+
+        return isHit;
+    }
+} // namespace
+
+class TriangleBvhTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(TriangleBvhTest, EmptyMeshIsNeverHit)
+{
+    Cesium::TriangleBvh bvh;
+    bvh.Build({}, {});
+    ASSERT_TRUE(bvh.IsEmpty());
+
+    Cesium::TriangleBvhHit hit;
+    ASSERT_FALSE(bvh.Raycast(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), std::numeric_limits<float>::max(), hit));
+}
+
+TEST_F(TriangleBvhTest, RayHitsFlatGridFromBothSides)
+{
+    GridMesh grid = CreateGrid(
+        32,
+        [](float, float)
+        {
+            return 0.0f;
+        });
+    Cesium::TriangleBvh bvh = BuildBvh(grid);
+    ASSERT_EQ(bvh.GetTriangleCount(), grid.m_indices.size() / 3);
+
+    Cesium::TriangleBvhHit hit;
+    ASSERT_TRUE(bvh.Raycast(glm::vec3(10.3f, 20.7f, 5.0f), glm::vec3(0.0f, 0.0f, -2.0f), std::numeric_limits<float>::max(), hit));
+    ASSERT_NEAR(hit.m_distance, 2.5f, 1e-5f);
+    ASSERT_NEAR(hit.m_normal.z, 1.0f, 1e-5f);
+
+    ASSERT_TRUE(bvh.Raycast(glm::vec3(10.3f, 20.7f, -5.0f), glm::vec3(0.0f, 0.0f, 1.0f), std::numeric_limits<float>::max(), hit));
+    ASSERT_NEAR(hit.m_distance, 5.0f, 1e-5f);
+    ASSERT_NEAR(hit.m_normal.z, -1.0f, 1e-5f);
+
+    // out of range and missing rays
+    ASSERT_FALSE(bvh.Raycast(glm::vec3(10.3f, 20.7f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f), 4.0f, hit));
+    ASSERT_FALSE(bvh.Raycast(glm::vec3(10.3f, 20.7f, 5.0f), glm::vec3(0.0f, 0.0f, 1.0f), std::numeric_limits<float>::max(), hit));
+    ASSERT_FALSE(bvh.Raycast(glm::vec3(40.0f, 20.7f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f), std::numeric_limits<float>::max(), hit));
+}
+
+TEST_F(TriangleBvhTest, ClosestHitMatchesBruteForce)
+{
+    GridMesh grid = CreateGrid(
+        48,
+        [](float x, float y)
+        {
+            return 4.0f * std::sin(x * 0.3f) * std::cos(y * 0.2f);
+        });
+    Cesium::TriangleBvh bvh = BuildBvh(grid);
+
+    for (std::uint32_t i = 0; i < 256; ++i)
+    {
+        // rays from above the grid in directions that cross several ridges
+        float angle = static_cast<float>(i) * 0.7f;
+        glm::vec3 origin{ 24.0f + 20.0f * std::cos(angle), 24.0f + 20.0f * std::sin(angle * 1.3f), 10.0f };
+        glm::vec3 direction{ std::cos(angle * 2.1f), std::sin(angle * 2.1f), -0.3f - 0.002f * static_cast<float>(i) };
+
+        float expectedDistance = 0.0f;
+        bool expectedHit = RaycastBruteForce(grid, origin, direction, expectedDistance);
+
+        Cesium::TriangleBvhHit hit;
+        bool isHit = bvh.Raycast(origin, direction, std::numeric_limits<float>::max(), hit);
+        ASSERT_EQ(isHit, expectedHit);
+        if (isHit)
+        {
+            ASSERT_NEAR(hit.m_distance, expectedDistance, 1e-3f);
+        }
+    }
+}
+
+TEST_F(TriangleBvhTest, DegenerateMeshIsBuiltAndHit)
+{
+    // many identical triangles cannot be separated by any split
+    GridMesh grid;
+    grid.m_positions = { glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+    for (std::uint32_t i = 0; i < 10000; ++i)
+    {
+        grid.m_indices.insert(grid.m_indices.end(), { 0, 1, 2 });
+    }
+
+    Cesium::TriangleBvh bvh = BuildBvh(grid);
+    ASSERT_EQ(bvh.GetTriangleCount(), 10000);
+
+    Cesium::TriangleBvhHit hit;
+    ASSERT_TRUE(bvh.Raycast(glm::vec3(0.2f, 0.2f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f), std::numeric_limits<float>::max(), hit));
+    ASSERT_NEAR(hit.m_distance, 1.0f, 1e-5f);
+}
+
+TEST_F(TriangleBvhTest, OutOfRangeIndicesAreSkipped)
+{
+    AZStd::vector<glm::vec3> positions{ glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+    AZStd::vector<std::uint32_t> indices{ 0, 1, 2, 0, 1, 7 };
+
+    Cesium::TriangleBvh bvh;
+    bvh.Build(
+        AZStd::span<const glm::vec3>{ positions.data(), positions.size() },
+        AZStd::span<const std::uint32_t>{ indices.data(), indices.size() });
+    ASSERT_EQ(bvh.GetTriangleCount(), 1);
+}
@@ -6,6 +6,11 @@ set(FILES
     Source/Editor/Systems/CesiumIonSession.h
     Source/Editor/Systems/CesiumIonSession.cpp
 
+    Source/Editor/Builders/GltfAssetBuilderWorker.h
+    Source/Editor/Builders/GltfAssetBuilderWorker.cpp
+    Source/Editor/Builders/GltfAssetBuilderComponent.h
+    Source/Editor/Builders/GltfAssetBuilderComponent.cpp
+
     Source/Editor/Widgets/MatrixInputWidget.h
     Source/Editor/Widgets/MatrixInputWidget.cpp
     Source/Editor/Widgets/MathReflectPropertyWidget.h
@@ -49,12 +49,44 @@ set(FILES
 
     Source/Cesium/Gltf/BitangentAndTangentGenerator.h
     Source/Cesium/Gltf/BitangentAndTangentGenerator.cpp
+    Source/Cesium/Gltf/GltfBakedModelAsset.h
+    Source/Cesium/Gltf/GltfBakedModelAsset.cpp
+    Source/Cesium/Gltf/FreeListAllocator.h
+    Source/Cesium/Gltf/FreeListAllocator.cpp
+    Source/Cesium/Gltf/GeometryHeap.h
+    Source/Cesium/Gltf/GeometryHeap.cpp
+    Source/Cesium/Gltf/GltfModelCache.h
+    Source/Cesium/Gltf/GltfModelCache.cpp
+    Source/Cesium/Gltf/GltfPrimitiveCache.h
+    Source/Cesium/Gltf/GltfPrimitiveCache.cpp
+    Source/Cesium/Gltf/IndexBufferOptimizer.h
+    Source/Cesium/Gltf/IndexBufferOptimizer.cpp
+    Source/Cesium/Gltf/MeshPartitioner.h
+    Source/Cesium/Gltf/MeshPartitioner.cpp
+    Source/Cesium/Gltf/MeshSimplifier.h
+    Source/Cesium/Gltf/MeshSimplifier.cpp
+    Source/Cesium/Gltf/StreamingImageBuilder.h
+    Source/Cesium/Gltf/StreamingImageBuilder.cpp
+    Source/Cesium/Gltf/TextureBlockCompressor.h
+    Source/Cesium/Gltf/TextureBlockCompressor.cpp
+    Source/Cesium/Gltf/Ktx2Reader.h
+    Source/Cesium/Gltf/Ktx2Reader.cpp
+    Source/Cesium/Gltf/TriangleBvh.h
+    Source/Cesium/Gltf/TriangleBvh.cpp
+    Source/Cesium/Gltf/MeshoptDecoder.h
+    Source/Cesium/Gltf/MeshoptDecoder.cpp
     Source/Cesium/Gltf/GltfLoadContext.h
     Source/Cesium/Gltf/GltfLoadContext.cpp
     Source/Cesium/Gltf/GltfModel.h
     Source/Cesium/Gltf/GltfModel.cpp
     Source/Cesium/Gltf/GltfPrimitiveBuilder.h
     Source/Cesium/Gltf/GltfPrimitiveBuilder.cpp
+    Source/Cesium/Gltf/GltfAccessorGather.h
+    Source/Cesium/Gltf/GltfAccessorGather.cpp
+    Source/Cesium/Gltf/GltfPointPrimitiveBuilder.h
+    Source/Cesium/Gltf/GltfPointPrimitiveBuilder.cpp
+    Source/Cesium/Gltf/GltfLinePrimitiveBuilder.h
+    Source/Cesium/Gltf/GltfLinePrimitiveBuilder.cpp
     Source/Cesium/Gltf/GltfMaterialBuilder.h
     Source/Cesium/Gltf/GltfMaterialBuilder.cpp
     Source/Cesium/Gltf/GltfPBRMaterialBuilder.h
@@ -64,6 +96,8 @@ set(FILES
 
     Source/Cesium/TilesetUtility/TilesetCameraConfigurations.h
     Source/Cesium/TilesetUtility/TilesetCameraConfigurations.cpp
+    Source/Cesium/TilesetUtility/TilesetQueryViews.h
+    Source/Cesium/TilesetUtility/TilesetQueryViews.cpp
     Source/Cesium/TilesetUtility/GltfRasterMaterialBuilder.h
     Source/Cesium/TilesetUtility/GltfRasterMaterialBuilder.cpp
     Source/Cesium/TilesetUtility/RenderResourcesPreparer.h
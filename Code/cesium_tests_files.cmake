@@ -4,4 +4,17 @@ set(FILES
     Tests/HttpManagerTest.cpp
     Tests/HttpAssetAccessorTest.cpp
     Tests/TaskProcessorTest.cpp
+    Tests/IndexBufferOptimizerTest.cpp
+    Tests/MeshoptDecoderTest.cpp
+    Tests/MeshPartitionerTest.cpp
+    Tests/MeshSimplifierTest.cpp
+    Tests/StreamingImageBuilderTest.cpp
+    Tests/TextureBlockCompressorTest.cpp
+    Tests/Ktx2ReaderTest.cpp
+    Tests/GltfPBRMaterialBuilderTest.cpp
+    Tests/GltfModelBuilderTest.cpp
+    Tests/GltfAccessorGatherTest.cpp
+    Tests/TriangleBvhTest.cpp
+    Tests/TilesetQueryViewsTest.cpp
+    Tests/FreeListAllocatorTest.cpp
 )